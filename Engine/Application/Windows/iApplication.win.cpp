@@ -323,7 +323,7 @@ eae6320::cResult eae6320::Application::iApplication::PopulateGraphicsInitializat
 {
 	EAE6320_ASSERT( m_mainWindow != NULL );
 	o_initializationParameters.mainWindow = m_mainWindow;
-#if defined( EAE6320_PLATFORM_D3D )
+#if defined( EAE6320_PLATFORM_D3D ) || defined( EAE6320_PLATFORM_SOFTWARE )
 	o_initializationParameters.resolutionWidth = m_resolutionWidth;
 	o_initializationParameters.resolutionHeight = m_resolutionHeight;
 #elif defined( EAE6320_PLATFORM_GL )
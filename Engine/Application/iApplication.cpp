@@ -6,8 +6,14 @@
 #include <algorithm>
 #include <cstdlib>
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/cAsyncLoader.h>
+#include <Engine/Assets/Configuration.h>
+#include <Engine/Assets/cPackFile.h>
+#include <Engine/Assets/ManagerLookupBenchmark.h>
+#include <Engine/Assets/ManagerResolveBenchmark.h>
 #include <Engine/Graphics/Graphics.h>
 #include <Engine/Logging/Logging.h>
+#include <Engine/Platform/Platform.h>
 #include <Engine/ScopeGuard/cScopeGuard.h>
 #include <Engine/Time/Time.h>
 #include <Engine/UserOutput/UserOutput.h>
@@ -163,6 +169,9 @@ void eae6320::Application::iApplication::UpdateUntilExit()
 		// Calculate the simulation time that has elapsed based on the simulation rate
 		const auto tickCount_toSimulate_elapsedSinceLastLoop =
 			static_cast<uint64_t>( static_cast<float>( tickCount_systemTime_elapsedSinceLastLoop ) * m_simulationRate );
+		// Let the application know about any assets that have finished loading asynchronously
+		// (the callbacks are called on this thread so that they can change application state)
+		Assets::cAsyncLoader::GetDefault().DispatchCompletions();
 		// Update any application state that isn't part of the simulation
 		{
 			UpdateBasedOnTime( static_cast<float>( Time::ConvertTicksToSeconds( tickCount_systemTime_elapsedSinceLastLoop ) ) );
@@ -326,6 +335,31 @@ eae6320::cResult eae6320::Application::iApplication::Initialize_engine()
 {
 	auto result = Results::Success;
 
+	// Asset Pack
+	// (it is mounted before anything else so that every asset is loaded from it;
+	// if the assets haven't been packed they are loaded from their own files)
+	if ( Platform::DoesFileExist( Assets::PackFormat::defaultPath ) )
+	{
+		std::string errorMessage;
+		if ( !Assets::cPackFile::Mount( Assets::PackFormat::defaultPath, &errorMessage ) )
+		{
+			EAE6320_ASSERTF( false, errorMessage.c_str() );
+			Logging::OutputError( "The asset pack \"%s\" couldn't be mounted (assets will be loaded from their own files): %s",
+				Assets::PackFormat::defaultPath, errorMessage.c_str() );
+		}
+	}
+	// Asynchronous Asset Loading
+	if ( !( result = Assets::cAsyncLoader::GetDefault().Initialize() ) )
+	{
+		EAE6320_ASSERTF( false, "Application can't be initialized without the asynchronous asset loader" );
+		return result;
+	}
+#ifdef EAE6320_ASSETS_SHOULDRUNMANAGERLOOKUPBENCHMARK
+	Assets::ManagerLookupBenchmark::RunAndLogStandardSizes();
+#endif
+#ifdef EAE6320_ASSETS_SHOULDRUNMANAGERRESOLVEBENCHMARK
+	Assets::ManagerResolveBenchmark::RunAndLogStandardThreadCounts();
+#endif
 	// User Output
 	{
 		UserOutput::sInitializationParameters initializationParameters;
@@ -454,6 +488,19 @@ eae6320::cResult eae6320::Application::iApplication::CleanUp_engine()
 {
 	auto result = Results::Success;
 
+	// Asynchronous Asset Loading
+	// (the application has already been cleaned up, and so any loads that haven't finished are discarded)
+	{
+		const auto result_asyncLoader = Assets::cAsyncLoader::GetDefault().CleanUp();
+		if ( !result_asyncLoader )
+		{
+			EAE6320_ASSERTF( false, "The asynchronous asset loader wasn't successfully cleaned up" );
+			if ( result )
+			{
+				result = result_asyncLoader;
+			}
+		}
+	}
 	// Graphics
 	{
 		const auto result_graphics = Graphics::CleanUp();
@@ -477,6 +524,9 @@ eae6320::cResult eae6320::Application::iApplication::CleanUp_engine()
 			}
 		}
 	}
+	// Asset Pack
+	// (it is unmounted last because assets can use it until they are cleaned up)
+	Assets::cPackFile::Unmount();
 
 	return result;
 }
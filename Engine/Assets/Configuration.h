@@ -0,0 +1,21 @@
+/*
+	This file provides configurable settings
+	that can be used to modify the assets project
+*/
+
+#ifndef EAE6320_ASSETS_CONFIGURATION_H
+#define EAE6320_ASSETS_CONFIGURATION_H
+
+// If this is defined then a microbenchmark of finding already-loaded assets runs when the application is initialized
+// and its results are written to the log
+// (it compares the asset managers' key index with an std::map at 10,000 and 100,000 loaded assets;
+// see ManagerLookupBenchmark.h)
+// #define EAE6320_ASSETS_SHOULDRUNMANAGERLOOKUPBENCHMARK
+
+// If this is defined then a microbenchmark of resolving handles on 1, 4, 8, and 16 threads runs when the application is initialized
+// and its results are written to the log
+// (it compares the asset managers' lock-free Get() with a mutex that is locked for every resolve,
+// and then stress tests Get() while assets are being loaded and released; see ManagerResolveBenchmark.h)
+// #define EAE6320_ASSETS_SHOULDRUNMANAGERRESOLVEBENCHMARK
+
+#endif	// EAE6320_ASSETS_CONFIGURATION_H
@@ -0,0 +1,180 @@
+// Includes
+//=========
+
+#include "ManagerLookupBenchmark.h"
+
+#include "cManager.h"
+#include "ReferenceCountedAssets.h"
+
+#include <algorithm>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Time/Time.h>
+#include <map>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// This stands in for an asset that is loaded from a file
+	class cStandInAsset
+	{
+	public:
+
+		EAE6320_ASSETS_DECLAREREFERENCECOUNTINGFUNCTIONS();
+
+		static eae6320::cResult Load( const std::string& i_path, cStandInAsset*& o_asset );
+
+	private:
+
+		cStandInAsset() = default;
+		~cStandInAsset() = default;
+
+		EAE6320_ASSETS_DECLAREREFERENCECOUNT();
+	};
+
+	// This finds keys the way that the manager used to
+	class cMapLookup
+	{
+	public:
+
+		void Add( const std::string& i_key );
+		bool Load( const std::string& i_key, uint32_t& o_index );
+		void Release( const uint32_t i_index );
+
+	private:
+
+		std::map<std::string, uint32_t> m_map_keysToIndices;
+		std::vector<uint16_t> m_referenceCounts;
+		eae6320::Concurrency::cMutex m_mutex;
+	};
+}
+
+// Interface
+//==========
+
+eae6320::Assets::ManagerLookupBenchmark::sResults eae6320::Assets::ManagerLookupBenchmark::Run(
+	const unsigned int i_assetCount, const unsigned int i_lookupCount )
+{
+	EAE6320_ASSERT( ( i_assetCount > 0 ) && ( i_lookupCount > 0 ) );
+
+	sResults results;
+	results.assetCount = i_assetCount;
+	results.lookupCount = i_lookupCount;
+
+	std::vector<std::string> keys( i_assetCount );
+	for ( unsigned int i = 0; i < i_assetCount; ++i )
+	{
+		keys[i] = "data/meshes/level" + std::to_string( i % 16 ) + "/asset" + std::to_string( i ) + ".mesh";
+	}
+	std::vector<unsigned int> order( i_assetCount );
+	for ( unsigned int i = 0; i < i_assetCount; ++i )
+	{
+		order[i] = i;
+	}
+	std::shuffle( order.begin(), order.end(), std::mt19937( 6320 ) );
+
+	// Key index
+	{
+		cManager<cStandInAsset> manager;
+		manager.Initialize();
+		std::vector<cHandle<cStandInAsset>> handles( i_assetCount );
+		for ( unsigned int i = 0; i < i_assetCount; ++i )
+		{
+			manager.Load( keys[i], handles[i] );
+		}
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		for ( unsigned int i = 0; i < i_lookupCount; ++i )
+		{
+			cHandle<cStandInAsset> handle;
+			manager.Load( keys[order[i % i_assetCount]], handle );
+			manager.Release( handle );
+		}
+		results.secondsPerLookup_keyIndex = Time::ConvertTicksToSeconds( Time::GetCurrentSystemTimeTickCount() - tickCount_start ) / i_lookupCount;
+		for ( auto& handle : handles )
+		{
+			manager.Release( handle );
+		}
+		manager.CleanUp();
+	}
+	// Map
+	{
+		cMapLookup mapLookup;
+		for ( const auto& key : keys )
+		{
+			mapLookup.Add( key );
+		}
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		for ( unsigned int i = 0; i < i_lookupCount; ++i )
+		{
+			uint32_t index;
+			if ( mapLookup.Load( keys[order[i % i_assetCount]], index ) )
+			{
+				mapLookup.Release( index );
+			}
+		}
+		results.secondsPerLookup_map = Time::ConvertTicksToSeconds( Time::GetCurrentSystemTimeTickCount() - tickCount_start ) / i_lookupCount;
+	}
+
+	return results;
+}
+
+void eae6320::Assets::ManagerLookupBenchmark::RunAndLogStandardSizes()
+{
+	constexpr unsigned int assetCounts[] = { 10000, 100000 };
+	for ( const auto assetCount : assetCounts )
+	{
+		const auto results = Run( assetCount );
+		Logging::OutputMessage( "Looking up %u loaded assets: %.1f ns per lookup with the key index, %.1f ns per lookup with an std::map",
+			results.assetCount, results.secondsPerLookup_keyIndex * 1e9, results.secondsPerLookup_map * 1e9 );
+	}
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	// cStandInAsset
+	//--------------
+
+	eae6320::cResult cStandInAsset::Load( const std::string&, cStandInAsset*& o_asset )
+	{
+		o_asset = new ( std::nothrow ) cStandInAsset();
+		return o_asset ? eae6320::Results::Success : eae6320::Results::OutOfMemory;
+	}
+
+	// cMapLookup
+	//-----------
+
+	void cMapLookup::Add( const std::string& i_key )
+	{
+		const auto index = static_cast<uint32_t>( m_referenceCounts.size() );
+		m_map_keysToIndices.insert( std::make_pair( i_key, index ) );
+		m_referenceCounts.push_back( 1 );
+	}
+
+	bool cMapLookup::Load( const std::string& i_key, uint32_t& o_index )
+	{
+		eae6320::Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		const auto iterator = m_map_keysToIndices.find( i_key );
+		if ( iterator != m_map_keysToIndices.end() )
+		{
+			o_index = iterator->second;
+			++m_referenceCounts[o_index];
+			return true;
+		}
+		return false;
+	}
+
+	void cMapLookup::Release( const uint32_t i_index )
+	{
+		eae6320::Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		--m_referenceCounts[i_index];
+	}
+}
@@ -0,0 +1,50 @@
+/*
+	This microbenchmark measures how long it takes an asset manager
+	to find an asset that has already been loaded
+
+	Every lookup is a Load() of a key that is already loaded followed by a Release() of the returned handle
+	(which is what happens whenever a second thing asks for an asset that something else is already using).
+	It is run two ways:
+		* With the manager's key index (see cKeyIndex.h)
+		* With an std::map from keys to handles that is locked the same way
+			(this is how the manager used to find keys)
+	The keys are paths like the ones that the game loads,
+	and they are looked up in a shuffled order so that consecutive lookups don't touch the same memory.
+	The assets are stand-ins that don't load anything,
+	and so the benchmark doesn't need any files or a graphics device.
+*/
+
+#ifndef EAE6320_ASSETS_MANAGERLOOKUPBENCHMARK_H
+#define EAE6320_ASSETS_MANAGERLOOKUPBENCHMARK_H
+
+// Includes
+//=========
+
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace ManagerLookupBenchmark
+		{
+			struct sResults
+			{
+				unsigned int assetCount = 0;
+				unsigned int lookupCount = 0;
+				// The average time of a single lookup
+				double secondsPerLookup_keyIndex = 0.0;
+				double secondsPerLookup_map = 0.0;
+			};
+
+			sResults Run( const unsigned int i_assetCount, const unsigned int i_lookupCount = 1000000 );
+			// Runs with 10,000 and 100,000 loaded assets and logs the results
+			void RunAndLogStandardSizes();
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETS_MANAGERLOOKUPBENCHMARK_H
@@ -0,0 +1,346 @@
+// Includes
+//=========
+
+#include "ManagerResolveBenchmark.h"
+
+#include "cManager.h"
+#include "ReferenceCountedAssets.h"
+
+#include <atomic>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Time/Time.h>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// This stands in for an asset that is loaded from a file
+	class cStandInAsset
+	{
+	public:
+
+		EAE6320_ASSETS_DECLAREREFERENCECOUNTINGFUNCTIONS();
+
+		static eae6320::cResult Load( const std::string& i_path, cStandInAsset*& o_asset );
+
+	private:
+
+		cStandInAsset() = default;
+		~cStandInAsset() = default;
+
+		EAE6320_ASSETS_DECLAREREFERENCECOUNT();
+	};
+
+	// This resolves handles the way that the manager used to
+	class cLockedRecords
+	{
+	public:
+
+		void Add( cStandInAsset* const i_asset );
+		cStandInAsset* Get( const uint32_t i_index );
+
+	private:
+
+		std::vector<cStandInAsset*> m_assets;
+		eae6320::Concurrency::cMutex m_mutex;
+	};
+
+	// Every thread waits until all of them have started
+	// so that thread creation isn't timed
+	class cStartingLine
+	{
+	public:
+
+		cStartingLine( const unsigned int i_threadCount ) : m_waitingThreadCount( i_threadCount ) {}
+		void WaitForStart();
+		void WaitForThreadsThenStart();
+
+	private:
+
+		std::atomic<unsigned int> m_waitingThreadCount;
+		std::atomic<bool> m_hasStarted{ false };
+	};
+
+	// A cheap pseudo-random sequence of indices
+	// (every thread starts at a different place)
+	uint32_t GetNextIndex( uint32_t& io_state, const uint32_t i_count );
+
+	template <typename tResolve>
+	double MeasureResolvesPerSecond( const unsigned int i_threadCount, const unsigned int i_assetCount,
+		const unsigned int i_resolveCountPerThread, const tResolve& i_resolve );
+
+	// This keeps the resolved assets from being optimized away
+	std::atomic<uintptr_t> s_sink{ 0 };
+}
+
+// Interface
+//==========
+
+eae6320::Assets::ManagerResolveBenchmark::sResults eae6320::Assets::ManagerResolveBenchmark::Run(
+	const unsigned int i_threadCount, const unsigned int i_assetCount, const unsigned int i_resolveCountPerThread )
+{
+	EAE6320_ASSERT( ( i_threadCount > 0 ) && ( i_assetCount > 0 ) && ( i_resolveCountPerThread > 0 ) );
+
+	sResults results;
+	results.threadCount = i_threadCount;
+	results.assetCount = i_assetCount;
+	results.resolveCount = static_cast<uint64_t>( i_threadCount ) * i_resolveCountPerThread;
+
+	cManager<cStandInAsset> manager;
+	manager.Initialize();
+	std::vector<cHandle<cStandInAsset>> handles( i_assetCount );
+	for ( unsigned int i = 0; i < i_assetCount; ++i )
+	{
+		manager.Load( "benchmark/asset" + std::to_string( i ), handles[i] );
+	}
+
+	// Lock-free
+	results.resolvesPerSecond_lockFree = MeasureResolvesPerSecond( i_threadCount, i_assetCount, i_resolveCountPerThread,
+		[&manager, &handles]( const uint32_t i_index )
+		{
+			return manager.Get( handles[i_index] );
+		} );
+	// Locked
+	{
+		cLockedRecords lockedRecords;
+		for ( const auto handle : handles )
+		{
+			lockedRecords.Add( manager.Get( handle ) );
+		}
+		results.resolvesPerSecond_locked = MeasureResolvesPerSecond( i_threadCount, i_assetCount, i_resolveCountPerThread,
+			[&lockedRecords]( const uint32_t i_index )
+			{
+				return lockedRecords.Get( i_index );
+			} );
+	}
+
+	for ( auto& handle : handles )
+	{
+		manager.Release( handle );
+	}
+	manager.CleanUp();
+
+	return results;
+}
+
+bool eae6320::Assets::ManagerResolveBenchmark::RunStressTest( const unsigned int i_threadCount, const unsigned int i_churnCount )
+{
+	EAE6320_ASSERT( i_threadCount > 0 );
+
+	cManager<cStandInAsset> manager;
+	manager.Initialize();
+
+	// The resolved handles are loaded before any of the other threads start
+	// and are only released after they have all finished
+	constexpr unsigned int resolvedAssetCount = 1000;
+	std::vector<cHandle<cStandInAsset>> handles( resolvedAssetCount );
+	std::vector<cStandInAsset*> expectedAssets( resolvedAssetCount );
+	for ( unsigned int i = 0; i < resolvedAssetCount; ++i )
+	{
+		manager.Load( "stress/resolved" + std::to_string( i ), handles[i] );
+		expectedAssets[i] = manager.Get( handles[i] );
+	}
+
+	std::atomic<bool> isChurning{ true };
+	std::atomic<uint64_t> resolveCount{ 0 };
+	std::atomic<uint64_t> wrongResolveCount{ 0 };
+	std::vector<std::thread> resolvingThreads;
+	resolvingThreads.reserve( i_threadCount );
+	for ( unsigned int t = 0; t < i_threadCount; ++t )
+	{
+		resolvingThreads.emplace_back( [&, t]
+			{
+				uint32_t state = ( t + 1 ) * 0x9e3779b9u;
+				uint64_t resolveCount_thread = 0;
+				uint64_t wrongResolveCount_thread = 0;
+				do
+				{
+					for ( unsigned int i = 0; i < 1024; ++i )
+					{
+						const auto index = GetNextIndex( state, resolvedAssetCount );
+						if ( manager.Get( handles[index] ) != expectedAssets[index] )
+						{
+							++wrongResolveCount_thread;
+						}
+						if ( manager.UnsafeGet( handles[index].GetIndex() ) != expectedAssets[index] )
+						{
+							++wrongResolveCount_thread;
+						}
+					}
+					resolveCount_thread += 2 * 1024;
+				} while ( isChurning.load( std::memory_order_relaxed ) );
+				resolveCount += resolveCount_thread;
+				wrongResolveCount += wrongResolveCount_thread;
+			} );
+	}
+
+	// Assets are loaded and released while the handles are being resolved.
+	// Some of each batch are kept until the end so that the number of records keeps growing
+	// (and new chunks are allocated),
+	// and the rest are released so that their records are re-used by the next batch.
+	{
+		constexpr unsigned int batchSize = 4096;
+		std::vector<cHandle<cStandInAsset>> keptHandles;
+		std::vector<cHandle<cStandInAsset>> batchHandles( batchSize );
+		unsigned int keyNumber = 0;
+		for ( unsigned int c = 0; c < i_churnCount; ++c )
+		{
+			for ( auto& handle : batchHandles )
+			{
+				manager.Load( "stress/churned" + std::to_string( keyNumber++ ), handle );
+			}
+			for ( unsigned int i = 0; i < batchSize; ++i )
+			{
+				if ( ( i % 4 ) == 0 )
+				{
+					keptHandles.push_back( batchHandles[i] );
+					batchHandles[i] = cHandle<cStandInAsset>();
+				}
+				else
+				{
+					manager.Release( batchHandles[i] );
+				}
+			}
+		}
+		isChurning = false;
+		for ( auto& resolvingThread : resolvingThreads )
+		{
+			resolvingThread.join();
+		}
+		for ( auto& handle : keptHandles )
+		{
+			manager.Release( handle );
+		}
+	}
+
+	for ( auto& handle : handles )
+	{
+		manager.Release( handle );
+	}
+	manager.CleanUp();
+
+	if ( wrongResolveCount > 0 )
+	{
+		EAE6320_ASSERTF( false, "The stress test resolved handles to the wrong assets" );
+		Logging::OutputError( "Resolving handles on %u threads while assets were being loaded and released: %llu of %llu resolves returned the wrong asset",
+			i_threadCount, static_cast<unsigned long long>( wrongResolveCount ), static_cast<unsigned long long>( resolveCount ) );
+		return false;
+	}
+	else
+	{
+		Logging::OutputMessage( "Resolving handles on %u threads while assets were being loaded and released: all %llu resolves returned the right asset",
+			i_threadCount, static_cast<unsigned long long>( resolveCount ) );
+		return true;
+	}
+}
+
+void eae6320::Assets::ManagerResolveBenchmark::RunAndLogStandardThreadCounts()
+{
+	constexpr unsigned int threadCounts[] = { 1, 4, 8, 16 };
+	for ( const auto threadCount : threadCounts )
+	{
+		const auto results = Run( threadCount );
+		Logging::OutputMessage( "Resolving %u loaded assets on %u threads: %.1f million resolves per second lock-free, %.1f million locked",
+			results.assetCount, results.threadCount, results.resolvesPerSecond_lockFree * 1e-6, results.resolvesPerSecond_locked * 1e-6 );
+	}
+	RunStressTest( 16 );
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	// cStandInAsset
+	//--------------
+
+	eae6320::cResult cStandInAsset::Load( const std::string&, cStandInAsset*& o_asset )
+	{
+		o_asset = new ( std::nothrow ) cStandInAsset();
+		return o_asset ? eae6320::Results::Success : eae6320::Results::OutOfMemory;
+	}
+
+	// cLockedRecords
+	//---------------
+
+	void cLockedRecords::Add( cStandInAsset* const i_asset )
+	{
+		m_assets.push_back( i_asset );
+	}
+
+	cStandInAsset* cLockedRecords::Get( const uint32_t i_index )
+	{
+		eae6320::Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		return ( i_index < m_assets.size() ) ? m_assets[i_index] : nullptr;
+	}
+
+	// cStartingLine
+	//--------------
+
+	void cStartingLine::WaitForStart()
+	{
+		--m_waitingThreadCount;
+		while ( !m_hasStarted.load( std::memory_order_acquire ) )
+		{
+			std::this_thread::yield();
+		}
+	}
+
+	void cStartingLine::WaitForThreadsThenStart()
+	{
+		while ( m_waitingThreadCount.load( std::memory_order_acquire ) > 0 )
+		{
+			std::this_thread::yield();
+		}
+		m_hasStarted.store( true, std::memory_order_release );
+	}
+
+	// Resolving
+	//----------
+
+	uint32_t GetNextIndex( uint32_t& io_state, const uint32_t i_count )
+	{
+		// xorshift32
+		io_state ^= io_state << 13;
+		io_state ^= io_state >> 17;
+		io_state ^= io_state << 5;
+		return static_cast<uint32_t>( ( static_cast<uint64_t>( io_state ) * i_count ) >> 32 );
+	}
+
+	template <typename tResolve>
+	double MeasureResolvesPerSecond( const unsigned int i_threadCount, const unsigned int i_assetCount,
+		const unsigned int i_resolveCountPerThread, const tResolve& i_resolve )
+	{
+		cStartingLine startingLine( i_threadCount );
+		std::vector<std::thread> threads;
+		threads.reserve( i_threadCount );
+		for ( unsigned int t = 0; t < i_threadCount; ++t )
+		{
+			threads.emplace_back( [&, t]
+				{
+					uint32_t state = ( t + 1 ) * 0x9e3779b9u;
+					uintptr_t sum = 0;
+					startingLine.WaitForStart();
+					for ( unsigned int i = 0; i < i_resolveCountPerThread; ++i )
+					{
+						sum += reinterpret_cast<uintptr_t>( i_resolve( GetNextIndex( state, i_assetCount ) ) );
+					}
+					s_sink += sum;
+				} );
+		}
+		startingLine.WaitForThreadsThenStart();
+		const auto tickCount_start = eae6320::Time::GetCurrentSystemTimeTickCount();
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+		const auto secondCount = eae6320::Time::ConvertTicksToSeconds( eae6320::Time::GetCurrentSystemTimeTickCount() - tickCount_start );
+		return ( static_cast<double>( i_threadCount ) * i_resolveCountPerThread ) / secondCount;
+	}
+}
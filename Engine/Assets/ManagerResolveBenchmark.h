@@ -0,0 +1,59 @@
+/*
+	This microbenchmark measures how many handles an asset manager can resolve per second
+	when several threads are resolving them at the same time
+
+	Every resolve is a Get() of a handle that is already loaded
+	(which is what happens whenever something that holds a handle needs to use its asset).
+	It is run two ways:
+		* With the manager's Get(), which doesn't lock anything
+		* With records that are locked by a mutex on every resolve
+			(this is how the manager used to resolve handles)
+	The handles are resolved in a pseudo-random order so that consecutive resolves don't touch the same memory.
+	The assets are stand-ins that don't load anything,
+	and so the benchmark doesn't need any files or a graphics device.
+
+	There is also a stress test that resolves handles on many threads
+	while another thread keeps loading and releasing other assets
+	(which creates new chunks of records and re-uses freed records),
+	and checks that every resolve returns the asset that the handle was loaded with.
+*/
+
+#ifndef EAE6320_ASSETS_MANAGERRESOLVEBENCHMARK_H
+#define EAE6320_ASSETS_MANAGERRESOLVEBENCHMARK_H
+
+// Includes
+//=========
+
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace ManagerResolveBenchmark
+		{
+			struct sResults
+			{
+				unsigned int threadCount = 0;
+				unsigned int assetCount = 0;
+				uint64_t resolveCount = 0;
+				// The total number of resolves that every thread together did per second
+				double resolvesPerSecond_lockFree = 0.0;
+				double resolvesPerSecond_locked = 0.0;
+			};
+
+			sResults Run( const unsigned int i_threadCount, const unsigned int i_assetCount = 10000,
+				const unsigned int i_resolveCountPerThread = 4000000 );
+			// This returns false if any resolve returned the wrong asset
+			bool RunStressTest( const unsigned int i_threadCount, const unsigned int i_churnCount = 64 );
+			// Runs with 1, 4, 8, and 16 threads and logs the results
+			// (and then runs the stress test with 16 threads)
+			void RunAndLogStandardThreadCounts();
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETS_MANAGERRESOLVEBENCHMARK_H
@@ -0,0 +1,47 @@
+// Includes
+//=========
+
+#include "PackFormat.h"
+
+// Interface
+//==========
+
+std::string eae6320::Assets::PackFormat::NormalizePath( const char* const i_path )
+{
+	std::string normalizedPath;
+	if ( i_path )
+	{
+		for ( auto* character = i_path; *character != '\0'; ++character )
+		{
+			if ( ( *character == '/' ) || ( *character == '\\' ) )
+			{
+				if ( normalizedPath.empty() || ( normalizedPath.back() != '/' ) )
+				{
+					normalizedPath += '/';
+				}
+			}
+			else if ( ( *character >= 'A' ) && ( *character <= 'Z' ) )
+			{
+				normalizedPath += static_cast<char>( *character - 'A' + 'a' );
+			}
+			else
+			{
+				normalizedPath += *character;
+			}
+		}
+	}
+	return normalizedPath;
+}
+
+uint64_t eae6320::Assets::PackFormat::CalculatePathHash( const char* const i_normalizedPath, const size_t i_length )
+{
+	constexpr uint64_t offsetBasis = 0xcbf29ce484222325;
+	constexpr uint64_t prime = 0x100000001b3;
+	auto hash = offsetBasis;
+	for ( size_t i = 0; i < i_length; ++i )
+	{
+		hash ^= static_cast<uint8_t>( i_normalizedPath[i] );
+		hash *= prime;
+	}
+	return hash;
+}
@@ -0,0 +1,95 @@
+/*
+	This file defines the layout of the asset pack
+	that AssetBuildExe writes after every asset has been built and cPackFile reads
+
+	An asset pack is:
+		* sHeader
+		* sEntry[entryCount] (sorted by path hash and then by path so that an asset can be found with a binary search)
+		* The paths (at pathsOffset; each entry's path is pathLength characters at pathOffset, not NUL-terminated)
+		* The payloads (each one is a built asset file, starting at an offset that is a multiple of payloadAlignment)
+
+	Paths are normalized before they are stored or looked up (see NormalizePath()),
+	and so "data/Meshes/Mole.mesh" and "data\meshes\mole.mesh" are the same asset.
+
+	The pack is mapped into memory (see Platform::MapFile()),
+	and because the start of the mapping is page-aligned and every payload is page-aligned
+	an asset in the pack can be used directly from the mapped pages with the same alignment it would have as its own file.
+*/
+
+#ifndef EAE6320_ASSETS_PACKFORMAT_H
+#define EAE6320_ASSETS_PACKFORMAT_H
+
+// Includes
+//=========
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Format Definitions
+//===================
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace PackFormat
+		{
+			// "PACK" when the file is viewed as text
+			constexpr uint32_t fileIdentifier = 0x4b434150;
+			// This changes whenever the layout does so that old packs fail to mount instead of being misread
+			constexpr uint16_t fileVersion = 1;
+			constexpr uint64_t payloadAlignment = 4096;
+			// AssetBuildExe writes the pack here (relative to the game's installation directory)
+			// and the game mounts it from here when it starts
+			constexpr const char* const defaultPath = "data.pack";
+
+			// How an entry's payload is stored
+			enum class eCompression : uint16_t
+			{
+				// The payload is the built asset file byte for byte
+				// (assets that benefit from compression, like meshes, are already compressed by their builders)
+				None,
+			};
+
+			struct sHeader
+			{
+				uint32_t identifier = fileIdentifier;
+				uint16_t version = fileVersion;
+				uint16_t unused = 0;
+				uint32_t entryCount = 0;
+				uint32_t pathsSize = 0;
+				uint64_t pathsOffset = 0;
+			};
+			static_assert( sizeof( sHeader ) == 24, "The header is read and written directly" );
+
+			struct sEntry
+			{
+				uint64_t pathHash = 0;
+				uint64_t payloadOffset = 0;
+				uint64_t payloadSize = 0;
+				// The size of the asset after it is decompressed
+				// (this is the same as the payload size if the payload isn't compressed)
+				uint64_t assetSize = 0;
+				// The offset is from the start of the paths
+				uint32_t pathOffset = 0;
+				uint16_t pathLength = 0;
+				eCompression compression = eCompression::None;
+			};
+			static_assert( sizeof( sEntry ) == 40, "The entries are read and written directly" );
+
+			constexpr uint64_t AlignPayloadOffset( const uint64_t i_offset )
+			{
+				return ( ( i_offset + ( payloadAlignment - 1 ) ) / payloadAlignment ) * payloadAlignment;
+			}
+
+			// Paths are lower case with single forward slashes
+			// (this matches the paths that the asset build system writes built assets to)
+			std::string NormalizePath( const char* const i_path );
+			// 64-bit FNV-1a of a normalized path
+			uint64_t CalculatePathHash( const char* const i_normalizedPath, const size_t i_length );
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETS_PACKFORMAT_H
@@ -0,0 +1,219 @@
+// Includes
+//=========
+
+#include "cAsyncLoader.h"
+
+#include <algorithm>
+#include <Engine/Asserts/Asserts.h>
+#include <utility>
+
+// Static Data
+//============
+
+namespace
+{
+	eae6320::Assets::cAsyncLoader s_defaultLoader;
+}
+
+// Interface
+//==========
+
+// Submit
+//-------
+
+void eae6320::Assets::cAsyncLoader::SubmitWork( fWork i_work )
+{
+	EAE6320_ASSERT( i_work );
+	m_pendingCount.fetch_add( 1, std::memory_order_acq_rel );
+	if ( m_workerThreads.empty() )
+	{
+		// If there aren't any workers the work is executed immediately on the calling thread
+		// (this is slower but it means that loading still works)
+		i_work();
+		OnFinished( 1 );
+		return;
+	}
+	{
+		std::lock_guard<std::mutex> lock( m_mutex_work );
+		m_work.push_back( std::move( i_work ) );
+	}
+	m_condition_workSubmitted.notify_one();
+}
+
+void eae6320::Assets::cAsyncLoader::SubmitRenderThreadWork( fWork i_work )
+{
+	EAE6320_ASSERT( i_work );
+	m_pendingCount.fetch_add( 1, std::memory_order_acq_rel );
+	{
+		std::lock_guard<std::mutex> lock( m_mutex_mainThreads );
+		m_renderThreadWork.push_back( std::move( i_work ) );
+	}
+	m_condition_flush.notify_all();
+}
+
+void eae6320::Assets::cAsyncLoader::SubmitCompletion( fWork i_completion )
+{
+	EAE6320_ASSERT( i_completion );
+	m_pendingCount.fetch_add( 1, std::memory_order_acq_rel );
+	{
+		std::lock_guard<std::mutex> lock( m_mutex_mainThreads );
+		m_completions.push_back( std::move( i_completion ) );
+	}
+	m_condition_flush.notify_all();
+}
+
+// Execute
+//--------
+
+void eae6320::Assets::cAsyncLoader::ExecuteRenderThreadWork()
+{
+	Execute( m_renderThreadWork );
+}
+
+void eae6320::Assets::cAsyncLoader::DispatchCompletions()
+{
+	Execute( m_completions );
+}
+
+void eae6320::Assets::cAsyncLoader::Flush()
+{
+	while ( true )
+	{
+		ExecuteRenderThreadWork();
+		DispatchCompletions();
+		std::unique_lock<std::mutex> lock( m_mutex_mainThreads );
+		m_condition_flush.wait( lock, [this]
+			{
+				return !m_renderThreadWork.empty() || !m_completions.empty() || ( GetPendingCount() == 0 );
+			} );
+		if ( m_renderThreadWork.empty() && m_completions.empty() )
+		{
+			EAE6320_ASSERT( GetPendingCount() == 0 );
+			return;
+		}
+	}
+}
+
+// Access
+//-------
+
+eae6320::Assets::cAsyncLoader& eae6320::Assets::cAsyncLoader::GetDefault()
+{
+	return s_defaultLoader;
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Assets::cAsyncLoader::Initialize( const unsigned int i_workerCount )
+{
+	EAE6320_ASSERTF( m_workerThreads.empty(), "The loader is already initialized" );
+
+	auto workerCount = i_workerCount;
+	if ( workerCount == 0 )
+	{
+		workerCount = std::max( std::thread::hardware_concurrency(), 1u );
+	}
+	{
+		std::lock_guard<std::mutex> lock( m_mutex_work );
+		m_shouldWorkersExit = false;
+	}
+	m_workerThreads.reserve( workerCount );
+	for ( unsigned int i = 0; i < workerCount; ++i )
+	{
+		m_workerThreads.emplace_back( &cAsyncLoader::WorkerThreadFunction, this );
+	}
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Assets::cAsyncLoader::CleanUp()
+{
+	{
+		std::lock_guard<std::mutex> lock( m_mutex_work );
+		m_shouldWorkersExit = true;
+	}
+	m_condition_workSubmitted.notify_all();
+	for ( auto& workerThread : m_workerThreads )
+	{
+		workerThread.join();
+	}
+	m_workerThreads.clear();
+
+	// Anything that hasn't started is discarded
+	// (the assets that it was loading never finish loading)
+	m_work.clear();
+	{
+		std::lock_guard<std::mutex> lock( m_mutex_mainThreads );
+		m_renderThreadWork.clear();
+		m_completions.clear();
+	}
+	m_pendingCount.store( 0, std::memory_order_release );
+
+	return Results::Success;
+}
+
+eae6320::Assets::cAsyncLoader::~cAsyncLoader()
+{
+	const auto result = CleanUp();
+	EAE6320_ASSERT( result );
+}
+
+// Implementation
+//===============
+
+void eae6320::Assets::cAsyncLoader::WorkerThreadFunction()
+{
+	while ( true )
+	{
+		fWork work;
+		{
+			std::unique_lock<std::mutex> lock( m_mutex_work );
+			m_condition_workSubmitted.wait( lock, [this] { return m_shouldWorkersExit || !m_work.empty(); } );
+			if ( m_shouldWorkersExit )
+			{
+				return;
+			}
+			work = std::move( m_work.front() );
+			m_work.pop_front();
+		}
+		work();
+		OnFinished( 1 );
+	}
+}
+
+void eae6320::Assets::cAsyncLoader::Execute( std::vector<fWork>& io_functions )
+{
+	// Most frames there is nothing to do
+	if ( GetPendingCount() == 0 )
+	{
+		return;
+	}
+	// The functions are swapped out so that they can submit more work while they execute
+	// (anything that they submit to the same list is executed the next time)
+	std::vector<fWork> functions;
+	{
+		std::lock_guard<std::mutex> lock( m_mutex_mainThreads );
+		functions.swap( io_functions );
+	}
+	if ( !functions.empty() )
+	{
+		for ( auto& function : functions )
+		{
+			function();
+		}
+		OnFinished( static_cast<uint32_t>( functions.size() ) );
+	}
+}
+
+void eae6320::Assets::cAsyncLoader::OnFinished( const uint32_t i_count )
+{
+	EAE6320_ASSERT( GetPendingCount() >= i_count );
+	if ( m_pendingCount.fetch_sub( i_count, std::memory_order_acq_rel ) == i_count )
+	{
+		// The lock is acquired so that a thread in Flush() can't miss the notification
+		// between checking the count and waiting
+		std::lock_guard<std::mutex> lock( m_mutex_mainThreads );
+		m_condition_flush.notify_all();
+	}
+}
@@ -0,0 +1,134 @@
+/*
+	An asynchronous loader runs the work of loading assets on a pool of worker threads
+	so that the thread that asks for an asset doesn't wait for it to be read and decoded
+
+	A load has up to three stages, and each one runs on a different thread:
+		* Work
+			(reading files and decoding them; this runs on any one of the worker threads)
+		* Render thread work
+			(creating graphics API objects; this runs when the render thread calls ExecuteRenderThreadWork(),
+			which Graphics::RenderFrame() does before it starts rendering a frame)
+		* Completions
+			(letting the code that asked for the asset know that it is ready; this runs when the application loop calls DispatchCompletions(),
+			and so completion callbacks can safely change game state)
+	Each stage submits the next one before it returns.
+
+	cManager::LoadAsync() uses a loader, and most code doesn't need to use one directly.
+	The engine initializes the default loader (see GetDefault()) when the application starts.
+*/
+
+#ifndef EAE6320_ASSETS_CASYNCLOADER_H
+#define EAE6320_ASSETS_CASYNCLOADER_H
+
+// Includes
+//=========
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <Engine/Results/Results.h>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		class cAsyncLoader
+		{
+			// Interface
+			//==========
+
+		public:
+
+			using fWork = std::function<void()>;
+
+			// Submit
+			//-------
+
+			// These can be called from any thread (including from work that is being executed)
+			void SubmitWork( fWork i_work );
+			void SubmitRenderThreadWork( fWork i_work );
+			void SubmitCompletion( fWork i_completion );
+
+			// Execute
+			//--------
+
+			// This must only be called by the render thread
+			void ExecuteRenderThreadWork();
+			// This must only be called by the application loop thread
+			void DispatchCompletions();
+			// This blocks until everything that has been submitted has finished,
+			// executing the render thread work and dispatching the completions on the calling thread while it waits.
+			// It must only be called by a thread that is allowed to do both
+			// (e.g. while the application is being initialized, before the application loop thread has started),
+			// and it lets a batch of assets be loaded in parallel when a game starts.
+			void Flush();
+
+			// Access
+			//-------
+
+			unsigned int GetWorkerCount() const { return static_cast<unsigned int>( m_workerThreads.size() ); }
+			// How many stages of work have been submitted but haven't finished yet
+			uint32_t GetPendingCount() const { return m_pendingCount.load( std::memory_order_acquire ); }
+
+			// The loader that the engine initializes and cleans up
+			static cAsyncLoader& GetDefault();
+
+			// Initialize / Clean Up
+			//----------------------
+
+			// A worker count of 0 means one for every hardware thread
+			cResult Initialize( const unsigned int i_workerCount = 0 );
+			// The workers finish the work that they are executing,
+			// but anything that hasn't started is discarded
+			cResult CleanUp();
+
+			cAsyncLoader() = default;
+			~cAsyncLoader();
+
+			// Data
+			//=====
+
+		private:
+
+			std::vector<std::thread> m_workerThreads;
+			std::deque<fWork> m_work;
+			std::mutex m_mutex_work;
+			std::condition_variable m_condition_workSubmitted;
+			bool m_shouldWorkersExit = false;
+
+			std::vector<fWork> m_renderThreadWork;
+			std::vector<fWork> m_completions;
+			std::mutex m_mutex_mainThreads;
+			// This is notified when there is something for Flush() to do
+			// (or when there is nothing left to wait for)
+			std::condition_variable m_condition_flush;
+
+			std::atomic<uint32_t> m_pendingCount{ 0 };
+
+			// Implementation
+			//===============
+
+		private:
+
+			void WorkerThreadFunction();
+			// Executes and removes every function in the list
+			void Execute( std::vector<fWork>& io_functions );
+			void OnFinished( const uint32_t i_count );
+
+			cAsyncLoader( const cAsyncLoader& ) = delete;
+			cAsyncLoader( cAsyncLoader&& ) = delete;
+			cAsyncLoader& operator =( const cAsyncLoader& ) = delete;
+			cAsyncLoader& operator =( cAsyncLoader&& ) = delete;
+		};
+	}
+}
+
+#endif	// EAE6320_ASSETS_CASYNCLOADER_H
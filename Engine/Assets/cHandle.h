@@ -122,7 +122,7 @@ namespace eae6320
 			//========
 
 			// Nothing should ever worry about the IDs except asset managers
-			template <class tAsset, class tKey> friend class cManager;
+			template <class tManagedAsset, class tKey> friend class cManager;
 		};
 	}
 };
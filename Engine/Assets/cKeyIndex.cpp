@@ -0,0 +1,131 @@
+// Includes
+//=========
+
+#include "cKeyIndex.h"
+
+#include "PackFormat.h"
+
+#include <algorithm>
+#include <Engine/Asserts/Asserts.h>
+#include <utility>
+
+// Interface
+//==========
+
+uint64_t eae6320::Assets::CalculateKeyHash( const std::string& i_key )
+{
+	// The path hash works with any string
+	// (the key isn't normalized, and so different spellings of a path are different keys)
+	return PackFormat::CalculatePathHash( i_key.c_str(), i_key.length() );
+}
+
+// Changes
+//--------
+
+void eae6320::Assets::cKeyIndex::Insert( const uint64_t i_keyHash, const uint32_t i_recordIndex )
+{
+	EAE6320_ASSERT( i_recordIndex != InvalidRecordIndex );
+
+	// The index is kept at most 7/8 full
+	if ( ( ( m_count + 1 ) * 8 ) > ( m_slots.size() * 7 ) )
+	{
+		Grow();
+	}
+
+	const auto mask = m_slots.size() - 1;
+	sSlot entry;
+	{
+		entry.keyHash = i_keyHash;
+		entry.recordIndex = i_recordIndex;
+	}
+	auto slotIndex = GetIdealSlot( i_keyHash );
+	for ( size_t probeLength = 0; ; ++probeLength, slotIndex = ( slotIndex + 1 ) & mask )
+	{
+		auto& slot = m_slots[slotIndex];
+		if ( slot.recordIndex == InvalidRecordIndex )
+		{
+			slot = entry;
+			++m_count;
+			return;
+		}
+		// An entry that is closer to its ideal slot gives its slot up to the entry being inserted
+		// and then continues looking for a slot itself
+		const auto probeLength_existing = GetProbeLength( slotIndex );
+		if ( probeLength_existing < probeLength )
+		{
+			std::swap( slot, entry );
+			probeLength = probeLength_existing;
+		}
+	}
+}
+
+bool eae6320::Assets::cKeyIndex::Remove( const uint64_t i_keyHash, const uint32_t i_recordIndex )
+{
+	if ( m_count == 0 )
+	{
+		return false;
+	}
+
+	const auto mask = m_slots.size() - 1;
+	auto slotIndex = GetIdealSlot( i_keyHash );
+	for ( size_t probeLength = 0; ; ++probeLength, slotIndex = ( slotIndex + 1 ) & mask )
+	{
+		const auto& slot = m_slots[slotIndex];
+		if ( ( slot.recordIndex == InvalidRecordIndex ) || ( GetProbeLength( slotIndex ) < probeLength ) )
+		{
+			return false;
+		}
+		if ( ( slot.keyHash == i_keyHash ) && ( slot.recordIndex == i_recordIndex ) )
+		{
+			break;
+		}
+	}
+	// The following entries are shifted back into the removed entry's slot
+	// until one is found that is already in its ideal slot
+	// (this keeps the probe lengths the same as if the removed entry had never been inserted)
+	while ( true )
+	{
+		const auto nextSlotIndex = ( slotIndex + 1 ) & mask;
+		const auto& nextSlot = m_slots[nextSlotIndex];
+		if ( ( nextSlot.recordIndex == InvalidRecordIndex ) || ( GetProbeLength( nextSlotIndex ) == 0 ) )
+		{
+			break;
+		}
+		m_slots[slotIndex] = nextSlot;
+		slotIndex = nextSlotIndex;
+	}
+	m_slots[slotIndex] = sSlot();
+	--m_count;
+	return true;
+}
+
+void eae6320::Assets::cKeyIndex::Clear()
+{
+	m_slots.clear();
+	m_count = 0;
+	m_shift = 64;
+}
+
+// Implementation
+//===============
+
+void eae6320::Assets::cKeyIndex::Grow()
+{
+	constexpr size_t minimumSlotCount = 16;
+	const auto slotCount = std::max( m_slots.size() * 2, minimumSlotCount );
+	std::vector<sSlot> oldSlots( slotCount );
+	oldSlots.swap( m_slots );
+	m_count = 0;
+	m_shift = 64;
+	for ( auto count = slotCount; count > 1; count >>= 1 )
+	{
+		--m_shift;
+	}
+	for ( const auto& oldSlot : oldSlots )
+	{
+		if ( oldSlot.recordIndex != InvalidRecordIndex )
+		{
+			Insert( oldSlot.keyHash, oldSlot.recordIndex );
+		}
+	}
+}
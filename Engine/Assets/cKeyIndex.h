@@ -0,0 +1,98 @@
+/*
+	A key index finds an asset manager's record for a key
+
+	It is a flat open-addressing hash table (using Robin Hood hashing)
+	that only stores each key's 64-bit hash and the index of its record:
+		* The hash is calculated once when a key is looked up or inserted (see CalculateKeyHash())
+		* A lookup probes neighboring slots in a single array
+			and only compares keys (by calling back to the manager) when the hashes match
+		* Robin Hood hashing keeps the probe lengths short and even,
+			and a lookup for a key that isn't in the index stops as soon as it reaches a slot that is closer to its ideal position
+	Entries are removed as soon as their records are freed,
+	and so the index never contains stale entries.
+*/
+
+#ifndef EAE6320_ASSETS_CKEYINDEX_H
+#define EAE6320_ASSETS_CKEYINDEX_H
+
+// Includes
+//=========
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		// Keys that are strings (i.e. paths) use 64-bit FNV-1a,
+		// and any other kind of key uses std::hash
+		uint64_t CalculateKeyHash( const std::string& i_key );
+			template <class tKey>
+		uint64_t CalculateKeyHash( const tKey& i_key ) { return static_cast<uint64_t>( std::hash<tKey>()( i_key ) ); }
+
+		class cKeyIndex
+		{
+			// Interface
+			//==========
+
+		public:
+
+			static constexpr uint32_t InvalidRecordIndex = ~uint32_t( 0 );
+
+			// Access
+			//-------
+
+			// i_isMatch( recordIndex ) is called for every entry with the given hash until it returns true,
+			// and this returns the matching record index or InvalidRecordIndex
+				template <typename tIsMatch>
+			uint32_t Find( const uint64_t i_keyHash, const tIsMatch& i_isMatch ) const;
+			size_t GetCount() const { return m_count; }
+
+			// Changes
+			//--------
+
+			// The caller must make sure that the key isn't already in the index
+			void Insert( const uint64_t i_keyHash, const uint32_t i_recordIndex );
+			// This returns false if the record isn't in the index
+			bool Remove( const uint64_t i_keyHash, const uint32_t i_recordIndex );
+			void Clear();
+
+			// Data
+			//=====
+
+		private:
+
+			struct sSlot
+			{
+				uint64_t keyHash = 0;
+				uint32_t recordIndex = InvalidRecordIndex;
+			};
+			// The slot count is always a power of two
+			std::vector<sSlot> m_slots;
+			size_t m_count = 0;
+			// The ideal slot is found from the high bits of the hash multiplied by a large odd constant
+			// (this spreads keys whose hashes only differ in a few bits)
+			unsigned int m_shift = 64;
+
+			// Implementation
+			//===============
+
+		private:
+
+			size_t GetIdealSlot( const uint64_t i_keyHash ) const;
+			size_t GetProbeLength( const size_t i_slotIndex ) const;
+			void Grow();
+		};
+	}
+}
+
+#include "cKeyIndex.inl"
+
+#endif	// EAE6320_ASSETS_CKEYINDEX_H
@@ -0,0 +1,52 @@
+#ifndef EAE6320_ASSETS_CKEYINDEX_INL
+#define EAE6320_ASSETS_CKEYINDEX_INL
+
+// Includes
+//=========
+
+#include "cKeyIndex.h"
+
+// Interface
+//==========
+
+// Access
+//-------
+
+	template <typename tIsMatch>
+uint32_t eae6320::Assets::cKeyIndex::Find( const uint64_t i_keyHash, const tIsMatch& i_isMatch ) const
+{
+	if ( m_count == 0 )
+	{
+		return InvalidRecordIndex;
+	}
+	const auto mask = m_slots.size() - 1;
+	auto slotIndex = GetIdealSlot( i_keyHash );
+	for ( size_t probeLength = 0; ; ++probeLength, slotIndex = ( slotIndex + 1 ) & mask )
+	{
+		const auto& slot = m_slots[slotIndex];
+		// If the key were in the index it would have displaced any entry that is closer to its own ideal slot
+		if ( ( slot.recordIndex == InvalidRecordIndex ) || ( GetProbeLength( slotIndex ) < probeLength ) )
+		{
+			return InvalidRecordIndex;
+		}
+		if ( ( slot.keyHash == i_keyHash ) && i_isMatch( slot.recordIndex ) )
+		{
+			return slot.recordIndex;
+		}
+	}
+}
+
+// Implementation
+//===============
+
+inline size_t eae6320::Assets::cKeyIndex::GetIdealSlot( const uint64_t i_keyHash ) const
+{
+	return static_cast<size_t>( ( i_keyHash * 0x9e3779b97f4a7c15 ) >> m_shift );
+}
+
+inline size_t eae6320::Assets::cKeyIndex::GetProbeLength( const size_t i_slotIndex ) const
+{
+	return ( i_slotIndex - GetIdealSlot( m_slots[i_slotIndex].keyHash ) ) & ( m_slots.size() - 1 );
+}
+
+#endif	// EAE6320_ASSETS_CKEYINDEX_INL
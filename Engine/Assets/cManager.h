@@ -6,6 +6,9 @@
 			and can return the asset's actual pointer given its handle
 		* When every handle to an asset has been released
 			the manager releases its own reference to the asset so that it can be unloaded
+			(or, if the manager has a residency budget, keeps it cached until the memory is needed; see SetResidencyBudget())
+		* An asset can be loaded asynchronously (see LoadAsync()),
+			in which case its handle is returned immediately and the asset is loaded by a cAsyncLoader
 */
 
 #ifndef EAE6320_ASSETS_CMANAGER_H
@@ -14,13 +17,19 @@
 // Includes
 //=========
 
+#include "cAsyncLoader.h"
 #include "cHandle.h"
+#include "cKeyIndex.h"
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <Engine/Concurrency/cMutex.h>
 #include <Engine/Results/Results.h>
-#include <map>
+#include <functional>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 // Interface
@@ -30,6 +39,13 @@ namespace eae6320
 {
 	namespace Assets
 	{
+		// An asset type can report how much memory it uses by providing size_t GetResidentByteCount() const
+		// (see cManager::SetResidencyBudget())
+			template <class tAsset, typename = void>
+		struct sHasResidentByteCount : std::false_type {};
+			template <class tAsset>
+		struct sHasResidentByteCount<tAsset, std::void_t<decltype( std::declval<const tAsset&>().GetResidentByteCount() )>> : std::true_type {};
+
 			template <class tAsset, class tKey = std::string>
 		class cManager
 		{
@@ -43,10 +59,16 @@ namespace eae6320
 
 			// This function returns the actual pointer to the asset associated with the handle
 			// or NULL if the handle doesn't point to a valid asset
+			// (or if the asset is still loading or failed to load asynchronously).
+			// It doesn't lock the manager's mutex,
+			// and so any number of threads can get assets at the same time as each other and as loads and releases
+			// (as long as the handle being resolved isn't released while Get() is called with it).
 			tAsset* Get( const cHandle<tAsset> i_handle );
+			bool IsLoading( const cHandle<tAsset> i_handle );
 
 			// Every handle returned from a successful call to Load() with a given key
 			// must be passed to Release() when the caller is finished with it
+			// (if the key is still being loaded by LoadAsync() the returned handle is pending)
 				template <typename... tConstructorArguments>
 			cResult Load( const tKey& i_key, cHandle<tAsset>& o_handle, tConstructorArguments&&... i_constructorArguments );
 			cResult Release( cHandle<tAsset>& io_handle );
@@ -54,6 +76,61 @@ namespace eae6320
 			// must be passed to Release() when the caller is finished with it
 			cResult Duplicate( const cHandle<tAsset> i_handle, cHandle<tAsset>& o_handle );
 
+			// Asynchronous Loading
+			//---------------------
+
+			// The callback is given the handle that was returned from LoadAsync() and the result of loading the asset.
+			// It is called from cAsyncLoader::DispatchCompletions()
+			// (which, for the default loader, is called by the application loop thread),
+			// and it isn't called if every handle to the asset is released before the asset finishes loading.
+			using fLoadCallback = std::function<void( const cHandle<tAsset> i_handle, const cResult i_result )>;
+
+			// The returned handle is pending:
+			// Get() returns NULL until the asset has been loaded,
+			// but the handle can be kept, duplicated into other loads of the same key, and released like any other handle.
+			// If the asset has already been loaded (or is already loading) the existing asset is used
+			// (and the callback is still called, even though there is nothing to wait for).
+			// To be loaded asynchronously an asset type must provide:
+			//	* A tAsset::sLoadedData struct
+			//	* static cResult tAsset::LoadData( const tKey&, tAsset::sLoadedData&, tConstructorArguments... )
+			//		(this reads and decodes the asset's data on a worker thread)
+			//	* static cResult tAsset::CreateFromLoadedData( const tKey&, tAsset::sLoadedData&, tAsset*& )
+			//		(this creates the asset from the loaded data on the render thread)
+			// The constructor arguments are copied so that they can be used on the worker thread.
+				template <typename... tConstructorArguments>
+			cResult LoadAsync( const tKey& i_key, cHandle<tAsset>& o_handle, fLoadCallback i_callback,
+				tConstructorArguments&&... i_constructorArguments );
+
+			// Residency
+			//----------
+
+			// By default an asset is freed as soon as every handle to it has been released.
+			// If the manager has a residency budget then an asset that was loaded with a key is cached instead
+			// (so that loading the key again is instant),
+			// and cached assets are only freed (least recently used first)
+			// when the memory of every asset that the manager holds is more than the budget.
+			// The memory of an asset is tAsset::GetResidentByteCount() if the asset type provides it
+			// or sizeof( tAsset ) if it doesn't.
+			struct sResidencyStatistics
+			{
+				// Loads of a key whose asset was cached
+				uint64_t hitCount = 0;
+				// Loads of a key that wasn't loaded (and so had to be loaded from its file)
+				// (loads of a key whose asset is still being used are neither)
+				uint64_t missCount = 0;
+				// Cached assets that were freed to stay within the budget
+				uint64_t evictionCount = 0;
+				// The memory of every asset that the manager holds (both used and cached)
+				size_t residentByteCount = 0;
+				// The memory of the assets that are only held by the cache
+				size_t cachedByteCount = 0;
+				unsigned int cachedAssetCount = 0;
+			};
+
+			// A budget of zero (the default) turns the cache off and frees every cached asset
+			void SetResidencyBudget( const size_t i_byteCount );
+			sResidencyStatistics GetResidencyStatistics();
+
 			// Unsafe Access
 			//--------------
 
@@ -63,6 +140,7 @@ namespace eae6320
 			// To ensure correct (i.e. safe) behavior the caller must:
 			//	* Always call UnsafeIncrementReferenceCount() while the handle is known to be valid
 			//	* Have a matching call to UnsafeDecrementReferenceCount() for every time the count was incremented
+			// UnsafeGet() doesn't lock the manager's mutex (the same as Get()).
 			tAsset* UnsafeGet( const uint_fast32_t i_index );
 			void UnsafeIncrementReferenceCount( const uint_fast32_t i_index );
 			void UnsafeDecrementReferenceCount( const uint_fast32_t i_index );
@@ -70,7 +148,11 @@ namespace eae6320
 			// Initialize / Clean Up
 			//----------------------
 
-			cResult Initialize();
+			// Assets are loaded asynchronously by the given loader
+			// or by cAsyncLoader::GetDefault() if one isn't given
+			cResult Initialize( cAsyncLoader* const i_asyncLoader = nullptr );
+			// If any assets are still loading asynchronously the loader is flushed first
+			// (and so this must be called from a thread that can call cAsyncLoader::Flush())
 			cResult CleanUp();
 
 			cManager() = default;
@@ -83,25 +165,83 @@ namespace eae6320
 
 			struct sAssetRecord
 			{
-				tAsset* asset = nullptr;
-				uint16_t id = cHandle<tAsset>::InvalidValue;
+				// The asset and ID can be read without locking the mutex (see Get()),
+				// but everything else (and any change) requires the mutex
+				std::atomic<tAsset*> asset{ nullptr };
+				std::atomic<uint16_t> id{ 0 };
 				uint16_t referenceCount = 0;
-
-				sAssetRecord( tAsset* const i_asset, const uint16_t i_id, const uint16_t i_referenceCount );
+				// An asset that is loading asynchronously has a record but no asset yet
+				bool isLoading = false;
+				// A record is in the key index if it was loaded with a key
+				// (duplicated assets don't have keys)
+				bool isIndexed = false;
+				// A record is cached if every handle to its asset has been released but the asset hasn't been freed,
+				// in which case it is in the least-recently-used list
+				bool isCached = false;
+				std::vector<fLoadCallback> loadCallbacks;
+				tKey key;
+				uint64_t keyHash = 0;
+				size_t residentByteCount = 0;
+				uint32_t lruPrevious = cKeyIndex::InvalidRecordIndex;
+				uint32_t lruNext = cKeyIndex::InvalidRecordIndex;
 			};
-			std::vector<sAssetRecord> m_assetRecords;
-			std::vector<uint16_t> m_unusedAssetRecordIndices;
-			std::map< tKey, cHandle<tAsset> > m_map_keysToHandles;	// An std::map is not cache friendly. This is probably a poor choice for a real game.
+			// The records are allocated in fixed-size chunks that never move,
+			// and so a record can be found without locking the mutex:
+			// A chunk is published before any of its records are counted,
+			// and a record is initialized before it is counted
+			static constexpr uint_fast32_t RecordsPerChunk = 1024;
+			static constexpr uint_fast32_t MaxChunkCount = ( cHandle<tAsset>::InvalidIndex + RecordsPerChunk - 1 ) / RecordsPerChunk;
+			std::atomic<sAssetRecord*> m_assetRecordChunks[MaxChunkCount] = {};
+			std::atomic<uint32_t> m_assetRecordCount{ 0 };
+			std::vector<uint32_t> m_unusedAssetRecordIndices;
+			cKeyIndex m_keyIndex;
 			eae6320::Concurrency::cMutex m_mutex;
+			cAsyncLoader* m_asyncLoader = nullptr;
+			unsigned int m_loadingAssetCount = 0;
+			// The least recently used cached record is the head of the list
+			// and the most recently used is the tail
+			uint32_t m_lruHead = cKeyIndex::InvalidRecordIndex;
+			uint32_t m_lruTail = cKeyIndex::InvalidRecordIndex;
+			size_t m_residencyBudget = 0;
+			sResidencyStatistics m_residencyStatistics;
 
 			// Implementation
 			//===============
 
+			// Access
+			//-------
+
+			sAssetRecord& GetAssetRecord( const uint_fast32_t i_index ) const;
+
 			// Initialize / Clean Up
 			//----------------------
 
 			cResult GetHandleForNewAsset( tAsset& i_asset, cHandle<tAsset>& o_handle );
 			void OnAssetReferenceCountDecrementedToZero( const uint_fast32_t i_index );
+			void FreeAssetRecord( const uint_fast32_t i_index );
+
+			// These functions must be called while the mutex is locked
+			// (they are used by both Load() and LoadAsync())
+			sAssetRecord* FindExistingAsset( const tKey& i_key, const uint64_t i_keyHash, cHandle<tAsset>& o_handle );
+			cResult IncrementReferenceCountForLoad( const uint_fast32_t i_index );
+			cResult CreateAssetRecord( tAsset* const i_asset, cHandle<tAsset>& o_handle );
+			void AddToKeyIndex( const tKey& i_key, const uint64_t i_keyHash, const uint_fast32_t i_index );
+			void RemoveFromKeyIndex( const uint_fast32_t i_index );
+
+			// Residency
+			//----------
+
+			// These functions must be called while the mutex is locked
+			static size_t CalculateResidentByteCount( const tAsset& i_asset );
+			void OnAssetBecameResident( const uint_fast32_t i_index );
+			void AddToCache( const uint_fast32_t i_index );
+			void RemoveFromCache( const uint_fast32_t i_index );
+			void EvictCachedAssets();
+
+			// Asynchronous Loading
+			//---------------------
+
+			void OnAsyncLoadFinished( const cHandle<tAsset> i_handle, tAsset* const i_newAsset, const cResult i_result );
 
 			cManager( const cManager& ) = delete;
 			cManager( cManager&& ) = delete;
@@ -9,6 +9,10 @@
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Logging/Logging.h>
 #include <limits>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <utility>
 
 // Interface
 //==========
@@ -20,19 +24,30 @@
 tAsset* eae6320::Assets::cManager<tAsset, tKey>::Get( const cHandle<tAsset> i_handle )
 {
 	EAE6320_ASSERTF( i_handle, "This handle is invalid (it has never been associated with a valid asset)" );
-	// Lock the collections
-	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+	// The mutex isn't locked
+	// (a record is never moved or freed once it has been counted)
 	{
 		const auto index = i_handle.GetIndex();
-		const auto assetCount = m_assetRecords.size();
+		const auto assetCount = m_assetRecordCount.load( std::memory_order_acquire );
 		if ( index < assetCount )
 		{
-			auto& assetRecord = m_assetRecords[index];
-			const auto id_assetRecord = assetRecord.id;
+			const auto& assetRecord = GetAssetRecord( index );
+			const auto id_assetRecord = assetRecord.id.load( std::memory_order_acquire );
 			const auto id_handle = i_handle.GetId();
 			if ( id_handle == id_assetRecord )
 			{
-				return assetRecord.asset;
+				auto* const asset = assetRecord.asset.load( std::memory_order_acquire );
+				// If the record was freed and re-used while the asset was being read
+				// then the asset belongs to a different handle
+				// (this can only happen if the handle is released by another thread during this call)
+				if ( assetRecord.id.load( std::memory_order_relaxed ) == id_assetRecord )
+				{
+					return asset;
+				}
+				else
+				{
+					EAE6320_ASSERTF( false, "A handle (at index %u) was released while its asset was being gotten", index );
+				}
 			}
 			else
 			{
@@ -50,50 +65,48 @@ tAsset* eae6320::Assets::cManager<tAsset, tKey>::Get( const cHandle<tAsset> i_ha
 	return nullptr;
 }
 
+	template <class tAsset, class tKey>
+bool eae6320::Assets::cManager<tAsset, tKey>::IsLoading( const cHandle<tAsset> i_handle )
+{
+	EAE6320_ASSERTF( i_handle, "This handle is invalid (it has never been associated with a valid asset)" );
+	// Lock the collections
+	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+	{
+		const auto index = i_handle.GetIndex();
+		if ( index < m_assetRecordCount.load( std::memory_order_relaxed ) )
+		{
+			const auto& assetRecord = GetAssetRecord( index );
+			return ( i_handle.GetId() == assetRecord.id.load( std::memory_order_relaxed ) ) && assetRecord.isLoading;
+		}
+	}
+	return false;
+}
+
 	template <class tAsset, class tKey> template <typename... tConstructorArguments>
 eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::Load( const tKey& i_key, cHandle<tAsset>& o_handle, tConstructorArguments&&... i_constructorArguments )
 {
 	EAE6320_ASSERTF( !o_handle, "The output handle isn't invalid (this probably indicates that a resource leak is about to happen)" );
 
+	// The key's hash is only calculated once
+	const auto keyHash = CalculateKeyHash( i_key );
+
 	// Get the existing asset if the path has already been loaded
 	{
 		// Lock the collections
 		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
 		{
-			auto iterator = m_map_keysToHandles.find( i_key );
-			if ( iterator != m_map_keysToHandles.end() )
+			cHandle<tAsset> existingHandle;
+			if ( FindExistingAsset( i_key, keyHash, existingHandle ) )
 			{
-				// Even if an entry exists it may no longer be valid
-				// (the map doesn't get cleared when an asset is deleted)
-				const auto existingHandle = iterator->second;
-				const auto index = existingHandle.GetIndex();
-				const auto assetCount = m_assetRecords.size();
-				if ( index < assetCount )
+				// (if the asset is still loading asynchronously the returned handle is pending)
+				const auto result = IncrementReferenceCountForLoad( existingHandle.GetIndex() );
+				if ( result )
 				{
-					auto& assetRecord = m_assetRecords[index];
-					const auto id_assetRecord = assetRecord.id;
-					const auto id_handle = existingHandle.GetId();
-					if ( id_handle == id_assetRecord )
-					{
-						EAE6320_ASSERT( assetRecord.asset );
-						const auto referenceCount = assetRecord.referenceCount;
-						if ( referenceCount < std::numeric_limits<decltype( assetRecord.referenceCount )>::max() )
-						{
-							assetRecord.referenceCount = referenceCount + 1;
-							o_handle = existingHandle;
-							return Results::Success;
-						}
-						else
-						{
-							EAE6320_ASSERTF( false, "An asset has been loaded too many times (the manager's reference count is too big)" );
-							Logging::OutputError( "A new instance couldn't be loaded because the manager's reference count was too big" );
-							return Results::Failure;
-						}
-					}
+					o_handle = existingHandle;
 				}
-				// If this code is reached it means that the existing entry is invalid
-				m_map_keysToHandles.erase( iterator );
+				return result;
 			}
+			++m_residencyStatistics.missCount;
 		}
 	}
 
@@ -110,7 +123,14 @@ eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::Load( const tKey& i_ke
 			// Lock the collections
 			Concurrency::cMutex::cScopeLock autoLock( m_mutex );
 			{
-				m_map_keysToHandles.insert( std::make_pair( i_key, o_handle ) );
+				// If another thread loaded the same key at the same time
+				// then the first one to finish is the one that later loads get
+				// (the other asset is still valid but it won't be shared)
+				cHandle<tAsset> existingHandle;
+				if ( !FindExistingAsset( i_key, keyHash, existingHandle ) )
+				{
+					AddToKeyIndex( i_key, keyHash, o_handle.GetIndex() );
+				}
 			}
 		}
 		else
@@ -124,6 +144,91 @@ eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::Load( const tKey& i_ke
 		EAE6320_ASSERT( newAsset == nullptr );
 	}
 
+	return result;
+}
+
+	template <class tAsset, class tKey> template <typename... tConstructorArguments>
+eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::LoadAsync( const tKey& i_key, cHandle<tAsset>& o_handle, fLoadCallback i_callback,
+	tConstructorArguments&&... i_constructorArguments )
+{
+	EAE6320_ASSERTF( !o_handle, "The output handle isn't invalid (this probably indicates that a resource leak is about to happen)" );
+
+	auto result = Results::Success;
+
+	auto& asyncLoader = m_asyncLoader ? *m_asyncLoader : cAsyncLoader::GetDefault();
+	const auto keyHash = CalculateKeyHash( i_key );
+	cHandle<tAsset> handle;
+	// Lock the collections
+	{
+		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		{
+			// Get the existing asset if the key has already been loaded (or is already loading)
+			if ( auto* const assetRecord = FindExistingAsset( i_key, keyHash, handle ) )
+			{
+				if ( result = IncrementReferenceCountForLoad( handle.GetIndex() ) )
+				{
+					o_handle = handle;
+					if ( i_callback )
+					{
+						if ( assetRecord->isLoading )
+						{
+							assetRecord->loadCallbacks.push_back( std::move( i_callback ) );
+						}
+						else
+						{
+							// The callback is dispatched the same way it would have been if the asset had needed to load
+							asyncLoader.SubmitCompletion( [callback = std::move( i_callback ), handle]
+								{
+									callback( handle, Results::Success );
+								} );
+						}
+					}
+				}
+				return result;
+			}
+			// Otherwise the record is created now (with no asset)
+			// so that any other loads of the same key wait for this one
+			++m_residencyStatistics.missCount;
+			if ( !( result = CreateAssetRecord( nullptr, handle ) ) )
+			{
+				return result;
+			}
+			auto& assetRecord = GetAssetRecord( handle.GetIndex() );
+			assetRecord.isLoading = true;
+			if ( i_callback )
+			{
+				assetRecord.loadCallbacks.push_back( std::move( i_callback ) );
+			}
+			++m_loadingAssetCount;
+			AddToKeyIndex( i_key, keyHash, handle.GetIndex() );
+		}
+	}
+	o_handle = handle;
+
+	// The asset's data is loaded on a worker thread
+	// and then the asset is created from it on the render thread
+	asyncLoader.SubmitWork( [this, &asyncLoader, key = i_key, handle,
+		constructorArguments = std::make_tuple( std::forward<tConstructorArguments>( i_constructorArguments )... )]() mutable
+		{
+			auto loadedData = std::make_shared<typename tAsset::sLoadedData>();
+			const auto result_loadData = std::apply( [&key, &loadedData]( auto&... i_constructorArguments )
+				{
+					return tAsset::LoadData( key, *loadedData, i_constructorArguments... );
+				}, constructorArguments );
+			if ( !result_loadData )
+			{
+				OnAsyncLoadFinished( handle, nullptr, result_loadData );
+				return;
+			}
+			asyncLoader.SubmitRenderThreadWork( [this, key = std::move( key ), handle, loadedData = std::move( loadedData )]
+				{
+					tAsset* newAsset = nullptr;
+					const auto result_create = tAsset::CreateFromLoadedData( key, *loadedData, newAsset );
+					EAE6320_ASSERT( result_create ? ( newAsset != nullptr ) : ( newAsset == nullptr ) );
+					OnAsyncLoadFinished( handle, newAsset, result_create );
+				} );
+		} );
+
 	return result;
 }
 
@@ -138,11 +243,11 @@ eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::Release( cHandle<tAsse
 		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
 		{
 			const auto index = io_handle.GetIndex();
-			const auto assetCount = m_assetRecords.size();
+			const auto assetCount = m_assetRecordCount.load( std::memory_order_relaxed );
 			if ( index < assetCount )
 			{
-				auto& assetRecord = m_assetRecords[index];
-				const auto id_assetRecord = assetRecord.id;
+				auto& assetRecord = GetAssetRecord( index );
+				const auto id_assetRecord = assetRecord.id.load( std::memory_order_relaxed );
 				const auto id_handle = io_handle.GetId();
 				if ( id_handle == id_assetRecord )
 				{
@@ -210,28 +315,50 @@ eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::Duplicate( const cHand
 	}
 }
 
-// Unsafe Access
-//--------------
+// Residency
+//----------
 
 	template <class tAsset, class tKey>
-tAsset* eae6320::Assets::cManager<tAsset, tKey>::UnsafeGet( const uint_fast32_t i_index )
+void eae6320::Assets::cManager<tAsset, tKey>::SetResidencyBudget( const size_t i_byteCount )
+{
+	// Lock the collections
+	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+	{
+		m_residencyBudget = i_byteCount;
+		// If the budget is smaller than before some cached assets may have to be freed now
+		EvictCachedAssets();
+	}
+}
+
+	template <class tAsset, class tKey>
+typename eae6320::Assets::cManager<tAsset, tKey>::sResidencyStatistics eae6320::Assets::cManager<tAsset, tKey>::GetResidencyStatistics()
 {
 	// Lock the collections
 	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
 	{
-		EAE6320_ASSERT( i_index < m_assetRecords.size() );
-		return m_assetRecords[i_index].asset;
+		return m_residencyStatistics;
 	}
 }
 
+// Unsafe Access
+//--------------
+
+	template <class tAsset, class tKey>
+tAsset* eae6320::Assets::cManager<tAsset, tKey>::UnsafeGet( const uint_fast32_t i_index )
+{
+	// The mutex isn't locked (see Get())
+	EAE6320_ASSERT( i_index < m_assetRecordCount.load( std::memory_order_acquire ) );
+	return GetAssetRecord( i_index ).asset.load( std::memory_order_acquire );
+}
+
 	template <class tAsset, class tKey>
 void eae6320::Assets::cManager<tAsset, tKey>::UnsafeIncrementReferenceCount( const uint_fast32_t i_index )
 {
 	// Lock the collections
 	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
 	{
-		EAE6320_ASSERT( i_index < m_assetRecords.size() );
-		++m_assetRecords[i_index].referenceCount;
+		EAE6320_ASSERT( i_index < m_assetRecordCount.load( std::memory_order_relaxed ) );
+		++GetAssetRecord( i_index ).referenceCount;
 	}
 }
 
@@ -241,8 +368,8 @@ void eae6320::Assets::cManager<tAsset, tKey>::UnsafeDecrementReferenceCount( con
 	// Lock the collections
 	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
 	{
-		EAE6320_ASSERT( i_index < m_assetRecords.size() );
-		const auto newReferenceCount = --m_assetRecords[i_index].referenceCount;
+		EAE6320_ASSERT( i_index < m_assetRecordCount.load( std::memory_order_relaxed ) );
+		const auto newReferenceCount = --GetAssetRecord( i_index ).referenceCount;
 		if ( newReferenceCount == 0 )
 		{
 			OnAssetReferenceCountDecrementedToZero( i_index );
@@ -254,8 +381,10 @@ void eae6320::Assets::cManager<tAsset, tKey>::UnsafeDecrementReferenceCount( con
 //----------------------
 
 	template <class tAsset, class tKey>
-eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::Initialize()
+eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::Initialize( cAsyncLoader* const i_asyncLoader )
 {
+	m_asyncLoader = i_asyncLoader;
+
 	return Results::Success;
 }
 
@@ -264,6 +393,20 @@ eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::CleanUp()
 {
 	auto result = Results::Success;
 
+	// The loads that haven't finished refer to this manager
+	{
+		unsigned int loadingAssetCount = 0;
+		{
+			Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+			loadingAssetCount = m_loadingAssetCount;
+		}
+		if ( loadingAssetCount > 0 )
+		{
+			EAE6320_ASSERTF( false, "A manager is being cleaned up while %u assets are still loading", loadingAssetCount );
+			Logging::OutputError( "A manager was cleaned up while %u assets were still loading (it will wait for them)", loadingAssetCount );
+			( m_asyncLoader ? *m_asyncLoader : cAsyncLoader::GetDefault() ).Flush();
+		}
+	}
 	{
 		auto wereThereStillAssets = false;
 
@@ -271,9 +414,17 @@ eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::CleanUp()
 		{
 			Concurrency::cMutex::cScopeLock autoLock( m_mutex );
 			{
-				for ( auto& assetRecord : m_assetRecords )
+				// Cached assets aren't leaks,
+				// and so they are freed before looking for assets that haven't been released
+				m_residencyBudget = 0;
+				EvictCachedAssets();
+				EAE6320_ASSERT( ( m_lruHead == cKeyIndex::InvalidRecordIndex ) && ( m_residencyStatistics.cachedAssetCount == 0 ) );
+
+				const auto assetRecordCount = m_assetRecordCount.load( std::memory_order_relaxed );
+				for ( uint_fast32_t i = 0; i < assetRecordCount; ++i )
 				{
-					if ( assetRecord.asset )
+					auto& assetRecord = GetAssetRecord( i );
+					if ( assetRecord.asset.load( std::memory_order_relaxed ) )
 					{
 						EAE6320_ASSERTF( false, "A manager still has a record of an asset that hasn't been released" );
 						result = Results::Failure;
@@ -281,17 +432,19 @@ eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::CleanUp()
 						// The asset's reference count could be decremented until it gets destroyed,
 						// but there's no way of knowing that the asset still isn't being used
 						// and so the asset will leak
-						assetRecord.asset = nullptr;
-						// The following shouldn't be necessary since the manager is being cleaned up,
-						// but it doesn't hurt to be safe
-						assetRecord.id = cHandle<tAsset>::IncrementId( assetRecord.id );
-						assetRecord.referenceCount = 0;
 					}
 				}
 
-				m_assetRecords.clear();
+				// The chunks are freed
+				// (the manager must not be used by any other thread while it is being cleaned up)
+				m_assetRecordCount.store( 0, std::memory_order_relaxed );
+				for ( auto& assetRecordChunk : m_assetRecordChunks )
+				{
+					delete [] assetRecordChunk.exchange( nullptr, std::memory_order_relaxed );
+				}
 				m_unusedAssetRecordIndices.clear();
-				m_map_keysToHandles.clear();
+				m_keyIndex.Clear();
+				m_residencyStatistics = sResidencyStatistics();
 			}
 		}
 
@@ -314,12 +467,18 @@ eae6320::Assets::cManager<tAsset, tKey>::~cManager<tAsset, tKey>()
 // Implementation
 //===============
 
+// Access
+//-------
+
 	template <class tAsset, class tKey>
-eae6320::Assets::cManager<tAsset, tKey>::sAssetRecord::sAssetRecord( tAsset* const i_asset, const uint16_t i_id, const uint16_t i_referenceCount )
-	:
-	asset( i_asset ), id( i_id ), referenceCount( i_referenceCount )
+typename eae6320::Assets::cManager<tAsset, tKey>::sAssetRecord& eae6320::Assets::cManager<tAsset, tKey>::GetAssetRecord(
+	const uint_fast32_t i_index ) const
 {
-
+	// The caller must make sure that the index has been counted,
+	// and so its chunk has already been published
+	auto* const assetRecordChunk = m_assetRecordChunks[i_index / RecordsPerChunk].load( std::memory_order_acquire );
+	EAE6320_ASSERT( assetRecordChunk != nullptr );
+	return assetRecordChunk[i_index % RecordsPerChunk];
 }
 
 // Initialize / Clean Up
@@ -333,6 +492,139 @@ eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::GetHandleForNewAsset(
 	// Lock the collections
 	Concurrency::cMutex::cScopeLock autoLock( m_mutex );
 
+	return CreateAssetRecord( &i_asset, o_handle );
+}
+
+	template <class tAsset, class tKey>
+void eae6320::Assets::cManager<tAsset, tKey>::OnAssetReferenceCountDecrementedToZero( const uint_fast32_t i_index )
+{
+	// The mutex should be locked when this function is called
+	auto& assetRecord = GetAssetRecord( i_index );
+	EAE6320_ASSERT( assetRecord.referenceCount == 0 );
+
+	// If the asset is still loading the record can't be re-used until the load finishes
+	// (see OnAsyncLoadFinished()),
+	// but nobody is waiting for it anymore
+	if ( assetRecord.isLoading )
+	{
+		assetRecord.loadCallbacks.clear();
+		return;
+	}
+	// If the manager has a residency budget an asset that can be loaded again by its key is cached
+	// (there is no asset if it failed to load asynchronously, and a duplicated asset has no key)
+	if ( ( m_residencyBudget > 0 ) && assetRecord.isIndexed && assetRecord.asset.load( std::memory_order_relaxed ) )
+	{
+		AddToCache( i_index );
+		EvictCachedAssets();
+		return;
+	}
+	// Otherwise every client that has asked to load the asset has now released it,
+	// and the manager can free the asset itself
+	FreeAssetRecord( i_index );
+}
+
+	template <class tAsset, class tKey>
+void eae6320::Assets::cManager<tAsset, tKey>::FreeAssetRecord( const uint_fast32_t i_index )
+{
+	// The mutex should be locked when this function is called
+	auto& assetRecord = GetAssetRecord( i_index );
+	EAE6320_ASSERT( ( assetRecord.referenceCount == 0 ) && !assetRecord.isLoading && !assetRecord.isCached );
+
+	// (there is no asset if it failed to load asynchronously)
+	if ( auto* const asset = assetRecord.asset.load( std::memory_order_relaxed ) )
+	{
+		asset->DecrementReferenceCount();
+	}
+	// The key no longer refers to the record
+	// (this is done now rather than the next time the key is looked up
+	// so that the index never has to skip entries for records that have been freed)
+	RemoveFromKeyIndex( i_index );
+	EAE6320_ASSERT( m_residencyStatistics.residentByteCount >= assetRecord.residentByteCount );
+	m_residencyStatistics.residentByteCount -= assetRecord.residentByteCount;
+	assetRecord.residentByteCount = 0;
+	// The existing asset record has already been allocated,
+	// and can be re-used for a new asset
+	{
+		// (the asset is cleared before the ID changes so that Get() can never return it for a later handle)
+		assetRecord.asset.store( nullptr, std::memory_order_release );
+		assetRecord.id.store( static_cast<uint16_t>( cHandle<tAsset>::IncrementId( assetRecord.id.load( std::memory_order_relaxed ) ) ),
+			std::memory_order_release );
+		m_unusedAssetRecordIndices.push_back( i_index );
+	}
+}
+
+	template <class tAsset, class tKey>
+typename eae6320::Assets::cManager<tAsset, tKey>::sAssetRecord* eae6320::Assets::cManager<tAsset, tKey>::FindExistingAsset(
+	const tKey& i_key, const uint64_t i_keyHash, cHandle<tAsset>& o_handle )
+{
+	// The keys are only compared when their hashes match
+	const auto index = m_keyIndex.Find( i_keyHash, [this, &i_key]( const uint32_t i_index )
+		{
+			return GetAssetRecord( i_index ).key == i_key;
+		} );
+	if ( index != cKeyIndex::InvalidRecordIndex )
+	{
+		auto& assetRecord = GetAssetRecord( index );
+		// Records are removed from the index when they are freed,
+		// and so an indexed record always has an asset (or is loading one)
+		EAE6320_ASSERT( assetRecord.isIndexed && ( assetRecord.asset.load( std::memory_order_relaxed ) || assetRecord.isLoading ) );
+		o_handle = cHandle<tAsset>( index, assetRecord.id.load( std::memory_order_relaxed ) );
+		return &assetRecord;
+	}
+	return nullptr;
+}
+
+	template <class tAsset, class tKey>
+eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::IncrementReferenceCountForLoad( const uint_fast32_t i_index )
+{
+	auto& assetRecord = GetAssetRecord( i_index );
+	const auto referenceCount = assetRecord.referenceCount;
+	if ( referenceCount < std::numeric_limits<decltype( assetRecord.referenceCount )>::max() )
+	{
+		assetRecord.referenceCount = referenceCount + 1;
+		// A cached asset is being used again
+		if ( assetRecord.isCached )
+		{
+			RemoveFromCache( i_index );
+			++m_residencyStatistics.hitCount;
+		}
+		return Results::Success;
+	}
+	else
+	{
+		EAE6320_ASSERTF( false, "An asset has been loaded too many times (the manager's reference count is too big)" );
+		Logging::OutputError( "A new instance couldn't be loaded because the manager's reference count was too big" );
+		return Results::Failure;
+	}
+}
+
+	template <class tAsset, class tKey>
+void eae6320::Assets::cManager<tAsset, tKey>::AddToKeyIndex( const tKey& i_key, const uint64_t i_keyHash, const uint_fast32_t i_index )
+{
+	auto& assetRecord = GetAssetRecord( i_index );
+	EAE6320_ASSERT( !assetRecord.isIndexed );
+	assetRecord.key = i_key;
+	assetRecord.keyHash = i_keyHash;
+	assetRecord.isIndexed = true;
+	m_keyIndex.Insert( i_keyHash, static_cast<uint32_t>( i_index ) );
+}
+
+	template <class tAsset, class tKey>
+void eae6320::Assets::cManager<tAsset, tKey>::RemoveFromKeyIndex( const uint_fast32_t i_index )
+{
+	auto& assetRecord = GetAssetRecord( i_index );
+	if ( assetRecord.isIndexed )
+	{
+		const auto wasRemoved = m_keyIndex.Remove( assetRecord.keyHash, static_cast<uint32_t>( i_index ) );
+		EAE6320_ASSERT( wasRemoved );
+		assetRecord.isIndexed = false;
+		assetRecord.key = tKey();
+	}
+}
+
+	template <class tAsset, class tKey>
+eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::CreateAssetRecord( tAsset* const i_asset, cHandle<tAsset>& o_handle )
+{
 	// Look for an existing asset record that is unused
 	if ( !m_unusedAssetRecordIndices.empty() )
 	{
@@ -340,27 +632,52 @@ eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::GetHandleForNewAsset(
 		{
 			m_unusedAssetRecordIndices.pop_back();
 		}
-		auto& assetRecord = m_assetRecords[index];
+		auto& assetRecord = GetAssetRecord( index );
 		{
-			assetRecord.asset = &i_asset;
+			assetRecord.asset.store( i_asset, std::memory_order_release );
 			assetRecord.referenceCount = 1;
 		}
-		o_handle = cHandle<tAsset>( index, assetRecord.id );
+		o_handle = cHandle<tAsset>( index, assetRecord.id.load( std::memory_order_relaxed ) );
+		if ( i_asset )
+		{
+			OnAssetBecameResident( index );
+		}
 	}
 	else
 	{
 		// Create a new asset record
-		const auto assetRecordCount = m_assetRecords.size();
+		const auto assetRecordCount = m_assetRecordCount.load( std::memory_order_relaxed );
 		if ( assetRecordCount < cHandle<tAsset>::InvalidIndex )
 		{
+			const auto index = static_cast<uint_fast32_t>( assetRecordCount );
+			// A new chunk is allocated when the previous one is full
+			// (chunks are never reallocated, and so a pointer to a record stays valid while other records are created)
+			auto& assetRecordChunk = m_assetRecordChunks[index / RecordsPerChunk];
+			if ( !assetRecordChunk.load( std::memory_order_relaxed ) )
+			{
+				auto* const newAssetRecordChunk = new ( std::nothrow ) sAssetRecord[RecordsPerChunk];
+				if ( !newAssetRecordChunk )
+				{
+					EAE6320_ASSERTF( false, "Couldn't allocate memory for more asset records" );
+					Logging::OutputError( "A new asset couldn't be loaded because there wasn't enough memory for another chunk of asset records" );
+					return Results::OutOfMemory;
+				}
+				assetRecordChunk.store( newAssetRecordChunk, std::memory_order_release );
+			}
+			auto& assetRecord = GetAssetRecord( index );
 			constexpr uint16_t id = 0;
 			{
-				constexpr uint16_t referenceCount = 1;
-				m_assetRecords.emplace_back( &i_asset, id, referenceCount );
+				assetRecord.asset.store( i_asset, std::memory_order_relaxed );
+				assetRecord.id.store( id, std::memory_order_relaxed );
+				assetRecord.referenceCount = 1;
 			}
+			// The record is initialized before it is counted,
+			// and so Get() never sees a record that isn't ready
+			m_assetRecordCount.store( assetRecordCount + 1, std::memory_order_release );
+			o_handle = cHandle<tAsset>( index, id );
+			if ( i_asset )
 			{
-				const auto index = static_cast<uint_fast32_t>( assetRecordCount );
-				o_handle = cHandle<tAsset>( index, id );
+				OnAssetBecameResident( index );
 			}
 		}
 		else
@@ -374,27 +691,151 @@ eae6320::cResult eae6320::Assets::cManager<tAsset, tKey>::GetHandleForNewAsset(
 	return Results::Success;
 }
 
+// Residency
+//----------
+
 	template <class tAsset, class tKey>
-void eae6320::Assets::cManager<tAsset, tKey>::OnAssetReferenceCountDecrementedToZero( const uint_fast32_t i_index )
+size_t eae6320::Assets::cManager<tAsset, tKey>::CalculateResidentByteCount( const tAsset& i_asset )
 {
-	// The mutex should be locked when this function is called
-	EAE6320_ASSERT( m_assetRecords[i_index].referenceCount == 0 );
+	if constexpr ( sHasResidentByteCount<tAsset>::value )
+	{
+		return static_cast<size_t>( i_asset.GetResidentByteCount() );
+	}
+	else
+	{
+		return sizeof( tAsset );
+	}
+}
 
-	auto& assetRecord = m_assetRecords[i_index];
+	template <class tAsset, class tKey>
+void eae6320::Assets::cManager<tAsset, tKey>::OnAssetBecameResident( const uint_fast32_t i_index )
+{
+	auto& assetRecord = GetAssetRecord( i_index );
+	EAE6320_ASSERT( ( assetRecord.residentByteCount == 0 ) && !assetRecord.isCached );
+	auto* const asset = assetRecord.asset.load( std::memory_order_relaxed );
+	EAE6320_ASSERT( asset );
+	assetRecord.residentByteCount = CalculateResidentByteCount( *asset );
+	m_residencyStatistics.residentByteCount += assetRecord.residentByteCount;
+	// A new asset can push the manager over its budget
+	EvictCachedAssets();
+}
 
-	// If the manager's reference count is zero it means that
-	// every client that has asked to load the asset has now released it,
-	// and the manager can free the asset itself
+	template <class tAsset, class tKey>
+void eae6320::Assets::cManager<tAsset, tKey>::AddToCache( const uint_fast32_t i_index )
+{
+	auto& assetRecord = GetAssetRecord( i_index );
+	EAE6320_ASSERT( !assetRecord.isCached && ( assetRecord.referenceCount == 0 ) );
+	// The record becomes the most recently used
+	assetRecord.isCached = true;
+	assetRecord.lruPrevious = m_lruTail;
+	assetRecord.lruNext = cKeyIndex::InvalidRecordIndex;
+	if ( m_lruTail != cKeyIndex::InvalidRecordIndex )
 	{
-		EAE6320_ASSERT( assetRecord.asset );
-		assetRecord.asset->DecrementReferenceCount();
+		GetAssetRecord( m_lruTail ).lruNext = static_cast<uint32_t>( i_index );
 	}
-	// The existing asset record has already been allocated,
-	// and can be re-used for a new asset
+	else
 	{
-		assetRecord.asset = nullptr;
-		assetRecord.id = static_cast<uint16_t>( cHandle<tAsset>::IncrementId( assetRecord.id ) );
-		m_unusedAssetRecordIndices.push_back( i_index );
+		m_lruHead = static_cast<uint32_t>( i_index );
+	}
+	m_lruTail = static_cast<uint32_t>( i_index );
+	m_residencyStatistics.cachedByteCount += assetRecord.residentByteCount;
+	++m_residencyStatistics.cachedAssetCount;
+}
+
+	template <class tAsset, class tKey>
+void eae6320::Assets::cManager<tAsset, tKey>::RemoveFromCache( const uint_fast32_t i_index )
+{
+	auto& assetRecord = GetAssetRecord( i_index );
+	EAE6320_ASSERT( assetRecord.isCached );
+	if ( assetRecord.lruPrevious != cKeyIndex::InvalidRecordIndex )
+	{
+		GetAssetRecord( assetRecord.lruPrevious ).lruNext = assetRecord.lruNext;
+	}
+	else
+	{
+		m_lruHead = assetRecord.lruNext;
+	}
+	if ( assetRecord.lruNext != cKeyIndex::InvalidRecordIndex )
+	{
+		GetAssetRecord( assetRecord.lruNext ).lruPrevious = assetRecord.lruPrevious;
+	}
+	else
+	{
+		m_lruTail = assetRecord.lruPrevious;
+	}
+	assetRecord.lruPrevious = assetRecord.lruNext = cKeyIndex::InvalidRecordIndex;
+	assetRecord.isCached = false;
+	EAE6320_ASSERT( ( m_residencyStatistics.cachedByteCount >= assetRecord.residentByteCount ) && ( m_residencyStatistics.cachedAssetCount > 0 ) );
+	m_residencyStatistics.cachedByteCount -= assetRecord.residentByteCount;
+	--m_residencyStatistics.cachedAssetCount;
+}
+
+	template <class tAsset, class tKey>
+void eae6320::Assets::cManager<tAsset, tKey>::EvictCachedAssets()
+{
+	// Cached assets are freed starting with the least recently used
+	// until the manager is within its budget
+	// (if the budget is zero the cache is off and every cached asset is freed)
+	while ( ( m_lruHead != cKeyIndex::InvalidRecordIndex )
+		&& ( ( m_residencyBudget == 0 ) || ( m_residencyStatistics.residentByteCount > m_residencyBudget ) ) )
+	{
+		const auto index = m_lruHead;
+		RemoveFromCache( index );
+		FreeAssetRecord( index );
+		++m_residencyStatistics.evictionCount;
+	}
+}
+
+// Asynchronous Loading
+//---------------------
+
+	template <class tAsset, class tKey>
+void eae6320::Assets::cManager<tAsset, tKey>::OnAsyncLoadFinished( const cHandle<tAsset> i_handle, tAsset* const i_newAsset,
+	const cResult i_result )
+{
+	auto& asyncLoader = m_asyncLoader ? *m_asyncLoader : cAsyncLoader::GetDefault();
+	std::vector<fLoadCallback> loadCallbacks;
+	// Lock the collections
+	{
+		Concurrency::cMutex::cScopeLock autoLock( m_mutex );
+		{
+			const auto index = i_handle.GetIndex();
+			EAE6320_ASSERT( index < m_assetRecordCount.load( std::memory_order_relaxed ) );
+			auto& assetRecord = GetAssetRecord( index );
+			// The record can't be re-used while the asset is loading, and so the handle is still valid
+			EAE6320_ASSERT( ( assetRecord.id.load( std::memory_order_relaxed ) == i_handle.GetId() ) && assetRecord.isLoading
+				&& ( assetRecord.asset.load( std::memory_order_relaxed ) == nullptr ) );
+			assetRecord.isLoading = false;
+			EAE6320_ASSERT( m_loadingAssetCount > 0 );
+			--m_loadingAssetCount;
+			if ( i_result )
+			{
+				EAE6320_ASSERT( i_newAsset );
+				// The asset is published to Get() after it has been completely created
+				assetRecord.asset.store( i_newAsset, std::memory_order_release );
+				OnAssetBecameResident( index );
+			}
+			else
+			{
+				// Another load of the key will try again instead of getting the failed record
+				RemoveFromKeyIndex( index );
+			}
+			if ( assetRecord.referenceCount == 0 )
+			{
+				// Every handle was released while the asset was loading
+				OnAssetReferenceCountDecrementedToZero( index );
+				return;
+			}
+			loadCallbacks.swap( assetRecord.loadCallbacks );
+		}
+	}
+	// (if the asset failed to load the asset type has already logged why)
+	for ( auto& loadCallback : loadCallbacks )
+	{
+		asyncLoader.SubmitCompletion( [loadCallback = std::move( loadCallback ), i_handle, i_result]
+			{
+				loadCallback( i_handle, i_result );
+			} );
 	}
 }
 
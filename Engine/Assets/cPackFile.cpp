@@ -0,0 +1,197 @@
+// Includes
+//=========
+
+#include "cPackFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <sstream>
+#include <utility>
+
+// Static Data
+//============
+
+namespace
+{
+	eae6320::Assets::cPackFile s_mountedPack;
+}
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	eae6320::cResult ValidatePack( const void* const i_data, const size_t i_size, std::string* const o_errorMessage );
+}
+
+// Interface
+//==========
+
+// Access
+//-------
+
+bool eae6320::Assets::cPackFile::Find( const char* const i_path, sView& o_view ) const
+{
+	o_view = sView();
+	if ( !m_header )
+	{
+		return false;
+	}
+
+	const auto path = PackFormat::NormalizePath( i_path );
+	const auto pathHash = PackFormat::CalculatePathHash( path.c_str(), path.length() );
+	const auto* const entries_end = m_entries + m_header->entryCount;
+	// Different paths can have the same hash,
+	// and so every entry with the hash is checked
+	for ( auto* entry = std::lower_bound( m_entries, entries_end, pathHash,
+			[]( const PackFormat::sEntry& i_entry, const uint64_t i_pathHash ) { return i_entry.pathHash < i_pathHash; } );
+		( entry != entries_end ) && ( entry->pathHash == pathHash ); ++entry )
+	{
+		if ( ( entry->pathLength == path.length() ) && ( memcmp( m_paths + entry->pathOffset, path.c_str(), path.length() ) == 0 ) )
+		{
+			o_view.data = static_cast<const uint8_t*>( m_file.data ) + entry->payloadOffset;
+			o_view.size = static_cast<size_t>( entry->payloadSize );
+			return true;
+		}
+	}
+	return false;
+}
+
+// Mounted Pack
+//-------------
+
+eae6320::cResult eae6320::Assets::cPackFile::Mount( const char* const i_path, std::string* const o_errorMessage )
+{
+	EAE6320_ASSERTF( !s_mountedPack.IsOpen(), "A pack is already mounted" );
+	return s_mountedPack.Open( i_path, o_errorMessage );
+}
+
+void eae6320::Assets::cPackFile::Unmount()
+{
+	s_mountedPack.Close();
+}
+
+bool eae6320::Assets::cPackFile::FindInMountedPack( const char* const i_path, sView& o_view )
+{
+	return s_mountedPack.Find( i_path, o_view );
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Assets::cPackFile::Open( const char* const i_path, std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	Close();
+
+	Platform::sMappedFile file;
+	if ( !( result = Platform::MapFile( i_path, file, o_errorMessage ) ) )
+	{
+		return result;
+	}
+	if ( !( result = ValidatePack( file.data, file.size, o_errorMessage ) ) )
+	{
+		return result;
+	}
+
+	m_file = std::move( file );
+	m_header = static_cast<const PackFormat::sHeader*>( m_file.data );
+	m_entries = reinterpret_cast<const PackFormat::sEntry*>( m_header + 1 );
+	m_paths = static_cast<const char*>( m_file.data ) + m_header->pathsOffset;
+
+	return result;
+}
+
+void eae6320::Assets::cPackFile::Close()
+{
+	m_header = nullptr;
+	m_entries = nullptr;
+	m_paths = nullptr;
+	m_file.Unmap();
+}
+
+eae6320::Assets::cPackFile::~cPackFile()
+{
+	Close();
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	eae6320::cResult ValidatePack( const void* const i_data, const size_t i_size, std::string* const o_errorMessage )
+	{
+		using namespace eae6320::Assets::PackFormat;
+
+		const auto outputError = [o_errorMessage]( const std::ostringstream& i_errorMessage )
+		{
+			if ( o_errorMessage )
+			{
+				*o_errorMessage = i_errorMessage.str();
+			}
+			return eae6320::Results::InvalidFile;
+		};
+
+		if ( ( i_data == nullptr ) || ( i_size < sizeof( sHeader ) ) )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The pack is " << i_size << " bytes, which is too small for a header";
+			return outputError( errorMessage );
+		}
+		const auto& header = *static_cast<const sHeader*>( i_data );
+		if ( ( header.identifier != fileIdentifier ) || ( header.version != fileVersion ) )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The file isn't a version " << fileVersion << " pack (the assets must be rebuilt)";
+			return outputError( errorMessage );
+		}
+		// The sizes are calculated with 64 bits so that a corrupt pack can't make them wrap around
+		const auto entriesEnd = sizeof( sHeader ) + ( uint64_t( header.entryCount ) * sizeof( sEntry ) );
+		if ( ( entriesEnd > i_size ) || ( header.pathsOffset < entriesEnd ) || ( header.pathsOffset > i_size )
+			|| ( header.pathsSize > ( i_size - header.pathsOffset ) ) )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The pack's table of contents (" << header.entryCount << " entries and " << header.pathsSize
+				<< " bytes of paths) doesn't fit in the " << i_size << " byte file";
+			return outputError( errorMessage );
+		}
+		const auto* const entries = reinterpret_cast<const sEntry*>( &header + 1 );
+		for ( uint32_t i = 0; i < header.entryCount; ++i )
+		{
+			const auto& entry = entries[i];
+			if ( ( uint64_t( entry.pathOffset ) + entry.pathLength ) > header.pathsSize )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "The path of entry #" << i << " is outside of the pack's paths";
+				return outputError( errorMessage );
+			}
+			if ( ( ( entry.payloadOffset % payloadAlignment ) != 0 ) || ( entry.payloadOffset > i_size )
+				|| ( entry.payloadSize > ( i_size - entry.payloadOffset ) ) )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "The payload of entry #" << i << " (" << entry.payloadSize << " bytes at offset " << entry.payloadOffset
+					<< ") isn't an aligned part of the " << i_size << " byte file";
+				return outputError( errorMessage );
+			}
+			if ( ( entry.compression != eCompression::None ) || ( entry.assetSize != entry.payloadSize ) )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "The payload of entry #" << i << " uses an unsupported compression ("
+					<< static_cast<unsigned int>( entry.compression ) << ")";
+				return outputError( errorMessage );
+			}
+			// The binary search depends on the order
+			if ( ( i > 0 ) && ( entries[i - 1].pathHash > entry.pathHash ) )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "The pack's entries aren't sorted (entry #" << i << " is out of order)";
+				return outputError( errorMessage );
+			}
+		}
+
+		return eae6320::Results::Success;
+	}
+}
@@ -0,0 +1,103 @@
+/*
+	A pack file is a single file that contains every built asset (see PackFormat.h)
+
+	The pack is mapped into memory when it is opened,
+	and finding an asset returns a view of its bytes in the mapped pages
+	(loading an asset from a pack is the same as loading it from its own file
+	except that there is no file to open and nothing is copied).
+
+	A game mounts a single pack when it starts
+	and the asset loaders look for their files in it before looking on disk.
+*/
+
+#ifndef EAE6320_ASSETS_CPACKFILE_H
+#define EAE6320_ASSETS_CPACKFILE_H
+
+// Includes
+//=========
+
+#include "PackFormat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Platform/Platform.h>
+#include <Engine/Results/Results.h>
+#include <string>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		class cPackFile
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// The same thing that Platform::LoadBinaryFile() would have loaded,
+			// but it is only valid while the pack is open
+			// (and its start has the same alignment as a mapped file)
+			struct sView
+			{
+				const void* data = nullptr;
+				size_t size = 0;
+			};
+
+			// Access
+			//-------
+
+			// This returns false if the pack doesn't contain the path
+			bool Find( const char* const i_path, sView& o_view ) const;
+			uint32_t GetEntryCount() const { return m_header ? m_header->entryCount : 0; }
+			bool IsOpen() const { return m_header != nullptr; }
+
+			// Mounted Pack
+			//-------------
+
+			// Only one pack can be mounted at a time.
+			// The loaders look for files in it without locking,
+			// and so it must be mounted before any assets are loaded and unmounted after they have all been cleaned up.
+			static cResult Mount( const char* const i_path, std::string* const o_errorMessage = nullptr );
+			static void Unmount();
+			// This returns false if no pack is mounted or if the mounted pack doesn't contain the path
+			static bool FindInMountedPack( const char* const i_path, sView& o_view );
+
+			// Initialize / Clean Up
+			//----------------------
+
+			// Every entry is validated when the pack is opened
+			// so that a corrupt pack fails to open instead of returning views outside of the file
+			cResult Open( const char* const i_path, std::string* const o_errorMessage = nullptr );
+			void Close();
+
+			cPackFile() = default;
+			~cPackFile();
+
+			// Data
+			//=====
+
+		private:
+
+			Platform::sMappedFile m_file;
+			const PackFormat::sHeader* m_header = nullptr;
+			const PackFormat::sEntry* m_entries = nullptr;
+			const char* m_paths = nullptr;
+
+			// Implementation
+			//===============
+
+		private:
+
+			cPackFile( const cPackFile& ) = delete;
+			cPackFile( cPackFile&& ) = delete;
+			cPackFile& operator =( const cPackFile& ) = delete;
+			cPackFile& operator =( cPackFile&& ) = delete;
+		};
+	}
+}
+
+#endif	// EAE6320_ASSETS_CPACKFILE_H
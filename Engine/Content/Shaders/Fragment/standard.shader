@@ -8,10 +8,7 @@
 
 FRAGMENT_MAIN
 {
-	// Output solid white
-	o_color = VECTOR4(
-		// RGB (color)
-		1.0, 1.0, 1.0,
-		// Alpha (opacity)
-		1.0);
+	// Output the material's color
+	// (draw calls without a material use a default material that is solid white)
+	o_color = g_color;
 }
\ No newline at end of file
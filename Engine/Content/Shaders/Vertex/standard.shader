@@ -6,20 +6,32 @@
 			* The GPU will use this to decide which fragments (i.e. pixels) need to be shaded for a given triangle
 		* Providing any data that a corresponding fragment shader will need
 			* This data will be interpolated across the triangle and thus vary for each fragment of a triangle that gets shaded
+
+	The INSTANCED variant is for instanced draw calls:
+	its local-to-world transform comes from the instances constant buffer
+	(every instance of the draw call has its own transform)
 */
 
+#keywords INSTANCED
+
 #include <Shaders/shaders.inc>
 
+#if INSTANCED
+VERTEX_MAIN_INSTANCED
+#else
 VERTEX_MAIN
+#endif
 {
 	// Transform the local vertex into world space
 	VECTOR4 vertexPosition_world;
 	{
-	// This will be done in a future assignment.
-	// For now, however, local space is treated as if it is the same as world space.
-	VECTOR4 vertexPosition_local = VECTOR4(i_vertexPosition_local, 1.0);
-	vertexPosition_world = MULTIPLY(g_transform_localToWorld, vertexPosition_local);
-}
+		VECTOR4 vertexPosition_local = VECTOR4(i_vertexPosition_local, 1.0);
+#if INSTANCED
+		vertexPosition_world = MULTIPLY(g_transforms_localToWorld[INSTANCE_ID], vertexPosition_local);
+#else
+		vertexPosition_world = MULTIPLY(g_transform_localToWorld, vertexPosition_local);
+#endif
+	}
 	// Calculate the position of this vertex projected onto the display
 	{
 		// Transform the vertex from world space into camera space
@@ -31,4 +43,4 @@ VERTEX_MAIN
 		gl_Position = MULTIPLY(g_transform_cameraToProjected, vertexPosition_camera);
 #endif
 	}
-}
\ No newline at end of file
+}
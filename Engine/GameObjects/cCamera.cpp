@@ -163,6 +163,16 @@ eae6320::Math::cMatrix_transformation eae6320::GameObjects::cCamera::GetTransfor
 	return m_transform_cameraToProjected;
 }
 
+eae6320::Math::cMatrix_transformation eae6320::GameObjects::cCamera::GetTransformWorldToProjected()
+{
+	return m_transform_cameraToProjected * m_transform_worldToCamera;
+}
+
+eae6320::Graphics::FrustumCulling::sFrustum eae6320::GameObjects::cCamera::GetFrustum()
+{
+	return Graphics::FrustumCulling::CreateFrustum(GetTransformWorldToProjected());
+}
+
 // Helper Class Definition
 //========================
 
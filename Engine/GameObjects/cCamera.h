@@ -2,6 +2,7 @@
 
 #include <Engine/Physics/sRigidBodyState.h>
 #include <Engine/Assets/ReferenceCountedAssets.h>
+#include <Engine/Graphics/FrustumCulling.h>
 #include <Engine/Results/Results.h>
 #include <Engine/Math/cMatrix_transformation.h>
 #include <Engine/Math/cQuaternion.h>
@@ -30,6 +31,10 @@ namespace eae6320
 
 			Math::cMatrix_transformation GetTransformWorldToCamera();
 			Math::cMatrix_transformation GetTransformCameraToProjected();
+			Math::cMatrix_transformation GetTransformWorldToProjected();
+			// The frustum is calculated from the current world-to-camera transform
+			// (and so it should be called after PredictForRender() when culling what will be rendered)
+			Graphics::FrustumCulling::sFrustum GetFrustum();
 
 		private:
 			cCamera();
@@ -128,20 +128,13 @@ eae6320::cResult eae6320::GameObjects::cRenderableObject::CleanUp()
 {
 	for (unsigned int i = 0; i < m_effctsCount; i++)
 	{
-		if (m_ppEffect[i] != nullptr)
-		{
-			m_ppEffect[i]->DecrementReferenceCount();
-			m_ppEffect[i] = nullptr;
-		}
+		// The effect might be referenced by a frame that hasn't been rendered yet
+		Graphics::ReleaseAfterInFlightFramesHaveBeenRendered(m_ppEffect[i]);
 	}
 
 	for (unsigned int i = 0; i < m_meshesCount; i++)
 	{
-		if (m_ppMesh[i] != nullptr)
-		{
-			m_ppMesh[i]->DecrementReferenceCount();
-			m_ppMesh[i] = nullptr;
-		}
+		Graphics::ReleaseAfterInFlightFramesHaveBeenRendered(m_ppMesh[i]);
 	}
 
 	delete m_ppEffect;
@@ -198,14 +191,25 @@ void eae6320::GameObjects::cRenderableObject::SetMeshIndex(const unsigned int i_
 eae6320::Graphics::sEffectDrawCallAndMesh eae6320::GameObjects::cRenderableObject::GetRenderData(const float i_elapsedSecondCount_sinceLastSimulationUpdate)
 {
 	Graphics::sEffectDrawCallAndMesh effectDrawCallAndMesh;
+	// The draw call doesn't hold references;
+	// this object's references keep the effect and mesh alive until the frame has been rendered
+	// (see Graphics::ReleaseAfterInFlightFramesHaveBeenRendered())
 	effectDrawCallAndMesh.m_effect = m_ppEffect[m_effectIndex];
-	effectDrawCallAndMesh.m_effect->IncrementReferenceCount();
 	effectDrawCallAndMesh.m_constantData_drawCall.g_transform_localToWorld = PredictFutureTransform(i_elapsedSecondCount_sinceLastSimulationUpdate);
 	effectDrawCallAndMesh.m_mesh = m_ppMesh[m_meshIndex];
-	effectDrawCallAndMesh.m_mesh->IncrementReferenceCount();
 	return effectDrawCallAndMesh;
 }
 
+eae6320::Graphics::cEffect* eae6320::GameObjects::cRenderableObject::GetEffect() const
+{
+	return m_ppEffect[m_effectIndex];
+}
+
+eae6320::Graphics::cMesh* eae6320::GameObjects::cRenderableObject::GetMesh() const
+{
+	return m_ppMesh[m_meshIndex];
+}
+
 // Helper Class Definition
 //========================
 
@@ -39,6 +39,10 @@ namespace eae6320
 
 			Graphics::sEffectDrawCallAndMesh GetRenderData(const float i_elapsedSecondCount_sinceLastSimulationUpdate);
 
+			// These return the current effect and mesh without changing their reference counts
+			Graphics::cEffect* GetEffect() const;
+			Graphics::cMesh* GetMesh() const;
+
 		private:
 			cRenderableObject();
 			~cRenderableObject();
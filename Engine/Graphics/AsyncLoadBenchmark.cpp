@@ -0,0 +1,180 @@
+// Includes
+//=========
+
+#include "AsyncLoadBenchmark.h"
+
+#include "cMesh.h"
+
+#include <algorithm>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/cAsyncLoader.h>
+#include <Engine/Assets/cManager.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Platform/Platform.h>
+#include <Engine/Time/Time.h>
+#include <thread>
+#include <vector>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	eae6320::cResult LoadSynchronously( const std::vector<std::string>& i_paths );
+	eae6320::cResult LoadAsynchronously( const std::vector<std::string>& i_paths, const unsigned int i_workerCount );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Graphics::AsyncLoadBenchmark::Run( const std::string& i_directory, sResults& o_results, const unsigned int i_passCount )
+{
+	EAE6320_ASSERT( i_passCount > 0 );
+	auto result = Results::Success;
+
+	o_results = sResults();
+	o_results.passCount = i_passCount;
+	o_results.workerCount_many = std::max( std::thread::hardware_concurrency(), 1u );
+
+	// Find the mesh files
+	std::vector<std::string> paths;
+	{
+		std::string errorMessage;
+		if ( !( result = Platform::GetFilesInDirectory( i_directory, paths, true, &errorMessage ) ) )
+		{
+			Logging::OutputError( "The asynchronous load benchmark couldn't find the files in \"%s\": %s", i_directory.c_str(), errorMessage.c_str() );
+			return result;
+		}
+		constexpr char extension[] = ".mesh";
+		constexpr auto extensionLength = sizeof( extension ) - 1;
+		paths.erase( std::remove_if( paths.begin(), paths.end(), [&extension, extensionLength]( const std::string& i_path )
+			{
+				return ( i_path.size() < extensionLength ) || ( i_path.compare( i_path.size() - extensionLength, extensionLength, extension ) != 0 );
+			} ), paths.end() );
+		if ( paths.empty() )
+		{
+			result = Results::FileDoesntExist;
+			Logging::OutputError( "The asynchronous load benchmark didn't find any mesh files in \"%s\"", i_directory.c_str() );
+			return result;
+		}
+		o_results.meshCount = static_cast<unsigned int>( paths.size() );
+	}
+	// Every file is loaded once without being timed
+	// so that every way reads the files from the file cache
+	// (this also checks that every file is valid)
+	if ( !( result = LoadSynchronously( paths ) ) )
+	{
+		return result;
+	}
+
+	const auto timePasses = [i_passCount]( double& o_secondsPerPass, auto&& i_load )
+	{
+		auto result = Results::Success;
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		for ( unsigned int pass = 0; pass < i_passCount; ++pass )
+		{
+			if ( !( result = i_load() ) )
+			{
+				return result;
+			}
+		}
+		o_secondsPerPass = Time::ConvertTicksToSeconds( Time::GetCurrentSystemTimeTickCount() - tickCount_start ) / i_passCount;
+		return result;
+	};
+	if ( !( result = timePasses( o_results.secondsPerPass_synchronous, [&paths] { return LoadSynchronously( paths ); } ) )
+		|| !( result = timePasses( o_results.secondsPerPass_oneWorker, [&paths] { return LoadAsynchronously( paths, 1 ); } ) )
+		|| !( result = timePasses( o_results.secondsPerPass_manyWorkers,
+			[&paths, &o_results] { return LoadAsynchronously( paths, o_results.workerCount_many ); } ) ) )
+	{
+		return result;
+	}
+
+	return result;
+}
+
+void eae6320::Graphics::AsyncLoadBenchmark::RunAndLog( const std::string& i_directory )
+{
+	sResults results;
+	if ( Run( i_directory, results ) )
+	{
+		Logging::OutputMessage( "Loading %u meshes from \"%s\": %.3f ms synchronously, %.3f ms with 1 worker, %.3f ms with %u workers",
+			results.meshCount, i_directory.c_str(), results.secondsPerPass_synchronous * 1000.0, results.secondsPerPass_oneWorker * 1000.0,
+			results.secondsPerPass_manyWorkers * 1000.0, results.workerCount_many );
+	}
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	eae6320::cResult LoadSynchronously( const std::vector<std::string>& i_paths )
+	{
+		auto result = eae6320::Results::Success;
+
+		for ( const auto& path : i_paths )
+		{
+			eae6320::Graphics::cMesh* mesh = nullptr;
+			if ( !( result = eae6320::Graphics::cMesh::Load( mesh, path ) ) )
+			{
+				eae6320::Logging::OutputError( "The asynchronous load benchmark couldn't load \"%s\"", path.c_str() );
+				return result;
+			}
+			mesh->DecrementReferenceCount();
+		}
+
+		return result;
+	}
+
+	eae6320::cResult LoadAsynchronously( const std::vector<std::string>& i_paths, const unsigned int i_workerCount )
+	{
+		auto result = eae6320::Results::Success;
+
+		// The workers are started and stopped every pass
+		// because a game that starts only does it once
+		eae6320::Assets::cAsyncLoader asyncLoader;
+		if ( !( result = asyncLoader.Initialize( i_workerCount ) ) )
+		{
+			return result;
+		}
+		eae6320::Assets::cManager<eae6320::Graphics::cMesh> manager;
+		if ( !( result = manager.Initialize( &asyncLoader ) ) )
+		{
+			return result;
+		}
+		std::vector<eae6320::Assets::cHandle<eae6320::Graphics::cMesh>> handles( i_paths.size() );
+		unsigned int loadedMeshCount = 0;
+		for ( size_t i = 0; i < i_paths.size(); ++i )
+		{
+			if ( !( result = manager.LoadAsync( i_paths[i], handles[i],
+				[&loadedMeshCount]( const eae6320::Assets::cHandle<eae6320::Graphics::cMesh>, const eae6320::cResult i_result )
+				{
+					if ( i_result )
+					{
+						++loadedMeshCount;
+					}
+				} ) ) )
+			{
+				break;
+			}
+		}
+		asyncLoader.Flush();
+		if ( result && ( loadedMeshCount != i_paths.size() ) )
+		{
+			result = eae6320::Results::Failure;
+			eae6320::Logging::OutputError( "The asynchronous load benchmark only loaded %u of %u meshes",
+				loadedMeshCount, static_cast<unsigned int>( i_paths.size() ) );
+		}
+		for ( auto& handle : handles )
+		{
+			if ( handle )
+			{
+				manager.Release( handle );
+			}
+		}
+		manager.CleanUp();
+		asyncLoader.CleanUp();
+
+		return result;
+	}
+}
@@ -0,0 +1,55 @@
+/*
+	This benchmark measures how long it takes to load every mesh file in a directory
+	the way a game would load them when it starts
+
+	It is run three ways:
+		* Synchronously
+			(every mesh is loaded with cMesh::Load() on the calling thread, one after another)
+		* Asynchronously with one worker
+		* Asynchronously with one worker for every hardware thread
+	The asynchronous ways ask a cManager to load every mesh with LoadAsync()
+	and then flush its cAsyncLoader on the calling thread,
+	which creates the meshes' graphics objects while the workers read and decode the files.
+	The meshes are really created, and so the benchmark must run on the render thread after Graphics has been initialized.
+	The files are loaded once before anything is timed,
+	and so it measures loading from the file cache rather than from the disk.
+*/
+
+#ifndef EAE6320_GRAPHICS_ASYNCLOADBENCHMARK_H
+#define EAE6320_GRAPHICS_ASYNCLOADBENCHMARK_H
+
+// Includes
+//=========
+
+#include <Engine/Results/Results.h>
+#include <string>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace AsyncLoadBenchmark
+		{
+			struct sResults
+			{
+				unsigned int meshCount = 0;
+				unsigned int passCount = 0;
+				unsigned int workerCount_many = 0;
+				// The average time to load every mesh once
+				double secondsPerPass_synchronous = 0.0;
+				double secondsPerPass_oneWorker = 0.0;
+				double secondsPerPass_manyWorkers = 0.0;
+			};
+
+			// Every file in the directory (and its subdirectories) whose extension is ".mesh" is loaded i_passCount times each way
+			cResult Run( const std::string& i_directory, sResults& o_results, const unsigned int i_passCount = 4 );
+			// Runs and logs the results
+			void RunAndLog( const std::string& i_directory );
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_ASYNCLOADBENCHMARK_H
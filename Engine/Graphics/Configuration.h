@@ -17,4 +17,34 @@
 	#define EAE6320_GRAPHICS_AREDEBUGSHADERSENABLED
 #endif
 
+// This is how many frames of render data there are.
+// The application loop thread can submit data for up to (this - 1) frames
+// before it has to wait for the render thread to finish rendering one of them
+// (it must be at least 2; more frames means less waiting but more latency and memory)
+#define EAE6320_GRAPHICS_SUBMISSIONFRAMECOUNT 3
+
+// A constant buffer ring (see cConstantBuffer::BeginRingUpload()) in OpenGL has this many segments
+// so that the CPU never writes to memory that the GPU might still be reading from for a previous frame
+#define EAE6320_GRAPHICS_CONSTANTBUFFERRINGSEGMENTCOUNT 3
+
+// This is how many threads the software platform rasterizes with
+// (the render thread is one of them; 0 means one for every hardware thread)
+#define EAE6320_GRAPHICS_SOFTWARERASTERIZERTHREADCOUNT 0
+
+// If this is defined then a microbenchmark of draw call submission runs when Graphics is initialized
+// and its results are written to the log
+// (it compares per-draw reference counting with frame-lifetime ownership at 10,000 and 100,000 draw calls;
+// see SubmissionBenchmark.h)
+// #define EAE6320_GRAPHICS_SHOULDRUNSUBMISSIONBENCHMARK
+
+// If this is defined then a benchmark of loading every mesh in this directory runs when Graphics is initialized
+// and its results are written to the log
+// (it compares reading and copying each file with mapping it; see MeshLoadBenchmark.h)
+// #define EAE6320_GRAPHICS_MESHLOADBENCHMARKDIRECTORY "data/Meshes/"
+
+// If this is defined then a benchmark of loading every mesh in this directory at startup runs when Graphics is initialized
+// and its results are written to the log
+// (it compares loading synchronously with loading asynchronously with one worker and with many; see AsyncLoadBenchmark.h)
+// #define EAE6320_GRAPHICS_ASYNCLOADBENCHMARKDIRECTORY "data/Meshes/"
+
 #endif	// EAE6320_GRAPHICS_CONFIGURATION_H
@@ -36,11 +36,32 @@ namespace eae6320
 				float padding[2];
 			};
 
+			// Data that comes from an authored material
+			// (it is shared by every draw call that uses the material)
+			struct sMaterial
+			{
+				// RGBA
+				float g_color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+			};
+
 			// Data that is constant for a single draw call
 			struct sDrawCall
 			{
 				Math::cMatrix_transformation g_transform_localToWorld;
 			};
+
+			// Data for every instance of an instanced draw call
+			// (this must match EAE6320_MAXINSTANCECOUNT in shaders.inc;
+			// 256 transforms is the 16 KB that OpenGL guarantees a uniform block can hold)
+			constexpr unsigned int maxInstanceCountPerDrawCall = 256;
+			struct sInstances
+			{
+				Math::cMatrix_transformation g_transforms_localToWorld[maxInstanceCountPerDrawCall];
+			};
+			// An instance's data is the same as a single draw call's data
+			// so that an array of sDrawCall can be copied directly into sInstances
+			static_assert( sizeof( sDrawCall ) == sizeof( Math::cMatrix_transformation ),
+				"An array of sDrawCall must have the same layout as sInstances" );
 		}
 	}
 }
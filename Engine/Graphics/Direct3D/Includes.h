@@ -9,6 +9,7 @@
 #include <Engine/Windows/Includes.h>
 
 #include <d3d11.h>
+#include <d3d11_1.h>
 #include <dxgi.h>
 
 #endif	// EAE6320_ENGINE_GRAPHICS_D3D_INCLUDES_H
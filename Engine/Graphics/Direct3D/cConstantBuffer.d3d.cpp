@@ -25,6 +25,7 @@ void eae6320::Graphics::cConstantBuffer::Bind( const uint_fast8_t i_shaderTypesT
 	EAE6320_ASSERT( direct3dImmediateContext );
 
 	EAE6320_ASSERT( m_buffer );
+	EAE6320_ASSERTF( !m_isRing, "A constant buffer ring must be bound with BindRingRange()" );
 
 	constexpr unsigned int bufferCount = 1;
 	if ( i_shaderTypesToBindTo & static_cast<decltype( i_shaderTypesToBindTo )>( eShaderType::Vertex ) )
@@ -37,12 +38,14 @@ void eae6320::Graphics::cConstantBuffer::Bind( const uint_fast8_t i_shaderTypesT
 	}
 }
 
-void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
+void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data, const size_t i_size )
 {
 	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
 	EAE6320_ASSERT( direct3dImmediateContext );
 
 	EAE6320_ASSERT( m_buffer );
+	EAE6320_ASSERT( i_size <= m_size );
+	EAE6320_ASSERTF( !m_isRing, "A constant buffer ring must be updated with BeginRingUpload() and EndRingUpload()" );
 
 	auto mustConstantBufferBeUnmapped = false;
 	cScopeGuard scopeGuard( [this, direct3dImmediateContext, &mustConstantBufferBeUnmapped]
@@ -80,7 +83,32 @@ void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
 		memoryToWriteTo = mappedSubResource.pData;
 	}
 	// Copy the new data to the memory that Direct3D has provided
-	memcpy( memoryToWriteTo, i_data, m_size );
+	// (the rest of the buffer is left undefined by the discard, which is fine as long as the shaders don't read it)
+	memcpy( memoryToWriteTo, i_data, i_size );
+}
+
+void eae6320::Graphics::cConstantBuffer::BindRingRange( const unsigned int i_rangeIndex, const uint_fast8_t i_shaderTypesToBindTo )
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext1;
+	EAE6320_ASSERT( direct3dImmediateContext );
+
+	EAE6320_ASSERT( m_buffer && m_isRing );
+	EAE6320_ASSERT( i_rangeIndex < m_ringRangeCount_lastUpload );
+
+	// Direct3D measures offsets in shader constants (16 bytes each)
+	// and both the offset and the size must be a multiple of 16 constants
+	constexpr unsigned int bytesPerConstant = 16;
+	const auto firstConstant = static_cast<unsigned int>( ( m_ringUploadOffset + ( i_rangeIndex * m_ringRangeStride ) ) / bytesPerConstant );
+	const auto constantCount = static_cast<unsigned int>( m_ringRangeStride / bytesPerConstant );
+	constexpr unsigned int bufferCount = 1;
+	if ( i_shaderTypesToBindTo & static_cast<decltype( i_shaderTypesToBindTo )>( eShaderType::Vertex ) )
+	{
+		direct3dImmediateContext->VSSetConstantBuffers1( static_cast<unsigned int>( m_type ), bufferCount, &m_buffer, &firstConstant, &constantCount );
+	}
+	if ( i_shaderTypesToBindTo & static_cast<decltype( i_shaderTypesToBindTo )>( eShaderType::Fragment ) )
+	{
+		direct3dImmediateContext->PSSetConstantBuffers1( static_cast<unsigned int>( m_type ), bufferCount, &m_buffer, &firstConstant, &constantCount );
+	}
 }
 
 // Initialize / Clean Up
@@ -95,6 +123,7 @@ eae6320::cResult eae6320::Graphics::cConstantBuffer::CleanUp()
 		m_buffer->Release();
 		m_buffer = nullptr;
 	}
+	CleanUpRing();
 
 	return result;
 }
@@ -156,3 +185,72 @@ eae6320::cResult eae6320::Graphics::cConstantBuffer::Initialize_platformSpecific
 		return Results::Failure;
 	}
 }
+
+size_t eae6320::Graphics::cConstantBuffer::GetRingRangeAlignment_platformSpecific() const
+{
+	// VSSetConstantBuffers1() can only bind offsets that are multiples of 16 constants (256 bytes)
+	return 256;
+}
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::ResizeRing_platformSpecific( const unsigned int i_rangeCapacity )
+{
+	auto* const direct3dDevice = sContext::g_context.direct3dDevice;
+	EAE6320_ASSERT( direct3dDevice );
+
+	// Direct3D renames the buffer every time that it is mapped with D3D11_MAP_WRITE_DISCARD,
+	// and so (unlike OpenGL) the buffer only needs room for a single upload
+	const auto byteWidth = static_cast<size_t>( i_rangeCapacity ) * m_ringRangeStride;
+	if ( byteWidth > std::numeric_limits<unsigned int>::max() )
+	{
+		EAE6320_ASSERTF( false, "A constant buffer ring with %u ranges is too large", i_rangeCapacity );
+		Logging::OutputError( "A constant buffer ring with %u ranges is too large for a D3D11_BUFFER_DESC", i_rangeCapacity );
+		return Results::Failure;
+	}
+	D3D11_BUFFER_DESC bufferDescription{};
+	{
+		bufferDescription.ByteWidth = static_cast<unsigned int>( byteWidth );
+		bufferDescription.Usage = D3D11_USAGE_DYNAMIC;	// The CPU must be able to update the buffer
+		bufferDescription.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+		bufferDescription.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;	// The CPU must write, but doesn't read
+		bufferDescription.MiscFlags = 0;
+		bufferDescription.StructureByteStride = 0;	// Not used
+	}
+	ID3D11Buffer* newBuffer = nullptr;
+	const auto d3dResult = direct3dDevice->CreateBuffer( &bufferDescription, nullptr, &newBuffer );
+	if ( FAILED( d3dResult ) )
+	{
+		EAE6320_ASSERTF( false, "Couldn't create constant buffer ring (HRESULT %#010x)", d3dResult );
+		Logging::OutputError( "Direct3D failed to create a constant buffer ring with HRESULT %#010x", d3dResult );
+		return Results::Failure;
+	}
+	if ( m_buffer )
+	{
+		m_buffer->Release();
+	}
+	m_buffer = newBuffer;
+
+	return Results::Success;
+}
+
+void eae6320::Graphics::cConstantBuffer::UploadRing_platformSpecific( const size_t i_byteCount )
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	EAE6320_ASSERT( direct3dImmediateContext );
+	EAE6320_ASSERT( m_buffer );
+
+	// Discarding gives the CPU new memory to write to
+	// while the GPU can keep reading from the memory of previous frames
+	constexpr unsigned int noSubResources = 0;
+	constexpr unsigned int noFlags = 0;
+	D3D11_MAPPED_SUBRESOURCE mappedSubResource;
+	const auto d3dResult = direct3dImmediateContext->Map( m_buffer, noSubResources, D3D11_MAP_WRITE_DISCARD, noFlags, &mappedSubResource );
+	if ( FAILED( d3dResult ) )
+	{
+		EAE6320_ASSERTF( false, "Couldn't map constant buffer ring" );
+		Logging::OutputError( "Direct3D failed to map a constant buffer ring" );
+		return;
+	}
+	memcpy( mappedSubResource.pData, m_ringData_cpu, i_byteCount );
+	direct3dImmediateContext->Unmap( m_buffer, noSubResources );
+	m_ringUploadOffset = 0;
+}
@@ -8,7 +8,7 @@
 #include <Engine/Logging/Logging.h>
 
 
-void eae6320::Graphics::cMesh::DrawGeometry()
+void eae6320::Graphics::cMesh::Bind() const
 {
 	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
 	// Bind a specific vertex buffer to the device as a data source
@@ -26,7 +26,7 @@ void eae6320::Graphics::cMesh::DrawGeometry()
 	// Bind a specific index buffer to the device as a data source
 	{
 		EAE6320_ASSERT(s_indexBuffer);
-		constexpr DXGI_FORMAT indexFormat = DXGI_FORMAT_R16_UINT;
+		const auto indexFormat = (m_indexSize == sizeof(uint32_t)) ? DXGI_FORMAT_R32_UINT : DXGI_FORMAT_R16_UINT;
 		// The indices start at the beginning of the buffer
 		constexpr unsigned int offset = 0;
 		direct3dImmediateContext->IASetIndexBuffer(s_indexBuffer, indexFormat, offset);
@@ -44,6 +44,11 @@ void eae6320::Graphics::cMesh::DrawGeometry()
 		// (meaning that every primitive is a triangle and will be defined by three vertices)
 		direct3dImmediateContext->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	}
+}
+
+void eae6320::Graphics::cMesh::Draw() const
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
 	/*
 	// Render triangles from the currently-bound vertex buffer
 	{
@@ -65,8 +70,21 @@ void eae6320::Graphics::cMesh::DrawGeometry()
 	}
 }
 
+void eae6320::Graphics::cMesh::DrawInstanced(const unsigned int i_instanceCount) const
+{
+	auto* const direct3dImmediateContext = sContext::g_context.direct3dImmediateContext;
+	constexpr unsigned int indexOfFirstIndexToUse = 0;
+	constexpr unsigned int offsetToAddToEachIndex = 0;
+	// Each instance can find its data using SV_InstanceID
+	// (which always starts at zero, regardless of the start instance location)
+	constexpr unsigned int indexOfFirstInstance = 0;
+	direct3dImmediateContext->DrawIndexedInstanced(static_cast<unsigned int>(m_indexCount), i_instanceCount,
+		indexOfFirstIndexToUse, offsetToAddToEachIndex, indexOfFirstInstance);
+}
 
-eae6320::cResult eae6320::Graphics::cMesh::Initialize(VertexFormats::sVertex_mesh* vertexData, uint16_t* indexData, const int vertexCount, const int indexCount)
+
+eae6320::cResult eae6320::Graphics::cMesh::Initialize(const VertexFormats::sVertex_mesh* const vertexData, const void* const indexData, const unsigned int vertexCount, const unsigned int indexCount,
+	const unsigned int indexSize)
 {
 	auto result = eae6320::Results::Success;
 
@@ -121,7 +139,8 @@ eae6320::cResult eae6320::Graphics::cMesh::Initialize(VertexFormats::sVertex_mes
 	}
 	//Index Buffer
 	{	
-		auto bufferSize = sizeof(indexData[0]) * indexCount;
+		auto bufferSize = static_cast<size_t>(indexSize) * indexCount;
+		EAE6320_ASSERT(bufferSize <= std::numeric_limits<decltype(D3D11_BUFFER_DESC::ByteWidth)>::max());
 		auto bufferDescription = [bufferSize]
 		{
 			D3D11_BUFFER_DESC bufferDescription{};
@@ -16,23 +16,23 @@
 // Initialize / Clean Up
 //----------------------
 
-eae6320::cResult eae6320::Graphics::cShader::Initialize( const std::string& i_path, const Platform::sDataFromFile& i_loadedShader )
+eae6320::cResult eae6320::Graphics::cShader::Initialize( const std::string& i_path, const void* const i_compiledShader, const size_t i_compiledShaderSize )
 {
 	auto* const direct3dDevice = sContext::g_context.direct3dDevice;
 	EAE6320_ASSERT( direct3dDevice != nullptr );
 
 	// Create the vertex shader object
 	{
-		const auto result_createShader = [this, &i_loadedShader, direct3dDevice]
+		const auto result_createShader = [this, i_compiledShader, i_compiledShaderSize, direct3dDevice]
 		{
 			ID3D11ClassLinkage* const noInterfaces = nullptr;
 			switch ( m_type )
 			{
 			case eShaderType::Vertex:
-				return direct3dDevice->CreateVertexShader(i_loadedShader.data, i_loadedShader.size, noInterfaces, &m_shaderObject.vertex );
+				return direct3dDevice->CreateVertexShader(i_compiledShader, i_compiledShaderSize, noInterfaces, &m_shaderObject.vertex );
 				break;
 			case eShaderType::Fragment:
-				return direct3dDevice->CreatePixelShader(i_loadedShader.data, i_loadedShader.size, noInterfaces, &m_shaderObject.fragment );
+				return direct3dDevice->CreatePixelShader(i_compiledShader, i_compiledShaderSize, noInterfaces, &m_shaderObject.fragment );
 				break;
 			default:
 				EAE6320_ASSERTF( false, "Invalid shader type" );
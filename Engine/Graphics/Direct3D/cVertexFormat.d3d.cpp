@@ -5,6 +5,7 @@
 
 #include "Includes.h"
 #include "../sContext.h"
+#include "../ShaderFormats.h"
 #include "../VertexFormats.h"
 
 #include <Engine/Asserts/Asserts.h>
@@ -45,35 +46,92 @@ eae6320::cResult eae6320::Graphics::cVertexFormat::Initialize( const eVertexType
 	std::string errorMessage;
 	if ( result = Platform::LoadBinaryFile( i_vertexShaderPath, vertexShaderDataFromFile, &errorMessage ) )
 	{
+		// The shader file can have several variants,
+		// and the input layout is created from the one without any keywords
+		const void* compiledShader;
+		size_t compiledShaderSize;
+		constexpr uint32_t variantKey_noKeywords = 0;
+		if ( !( result = ShaderFormats::GetVariantProgram( vertexShaderDataFromFile.data, vertexShaderDataFromFile.size, variantKey_noKeywords,
+			compiledShader, compiledShaderSize, &errorMessage ) ) )
+		{
+			EAE6320_ASSERTF( false, errorMessage.c_str() );
+			Logging::OutputError( "A vertex input layout shader couldn't be loaded: %s", errorMessage.c_str() );
+			return result;
+		}
+
 		// Create the vertex layout
 
 		switch ( i_type )
 		{
 		case eVertexType::Mesh:
 			{
-				constexpr unsigned int vertexElementCount = 1;
+				constexpr unsigned int vertexElementCount = 4;
 				D3D11_INPUT_ELEMENT_DESC layoutDescription[vertexElementCount] = {};
 				{
 					// Slot 0
 
 					// POSITION
-					// 3 floats == 12 bytes
+					// 4 uint16_ts == 8 bytes
 					// Offset = 0
 					{
 						auto& positionElement = layoutDescription[0];
 
 						positionElement.SemanticName = "POSITION";
 						positionElement.SemanticIndex = 0;	// (Semantics without modifying indices at the end can always use zero)
-						positionElement.Format = DXGI_FORMAT_R32G32B32_FLOAT;
+						// The normalized integers are converted to floats between 0 and 1
+						// (the draw call's transform converts those to the mesh's local space)
+						positionElement.Format = DXGI_FORMAT_R16G16B16A16_UNORM;
 						positionElement.InputSlot = 0;
 						positionElement.AlignedByteOffset = offsetof( VertexFormats::sVertex_mesh, x );
 						positionElement.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
 						positionElement.InstanceDataStepRate = 0;	// (Must be zero for per-vertex data)
 					}
+					// NORMAL
+					// 2 int16_ts == 4 bytes
+					// Offset = 8
+					{
+						auto& normalElement = layoutDescription[1];
+
+						normalElement.SemanticName = "NORMAL";
+						normalElement.SemanticIndex = 0;
+						normalElement.Format = DXGI_FORMAT_R16G16_SNORM;
+						normalElement.InputSlot = 0;
+						normalElement.AlignedByteOffset = offsetof( VertexFormats::sVertex_mesh, nx );
+						normalElement.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+						normalElement.InstanceDataStepRate = 0;
+					}
+					// TEXCOORD
+					// 2 half floats == 4 bytes
+					// Offset = 12
+					{
+						auto& texcoordElement = layoutDescription[2];
+
+						texcoordElement.SemanticName = "TEXCOORD";
+						texcoordElement.SemanticIndex = 0;
+						texcoordElement.Format = DXGI_FORMAT_R16G16_FLOAT;
+						texcoordElement.InputSlot = 0;
+						texcoordElement.AlignedByteOffset = offsetof( VertexFormats::sVertex_mesh, u );
+						texcoordElement.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+						texcoordElement.InstanceDataStepRate = 0;
+					}
+					// COLOR
+					// 4 uint8_ts == 4 bytes
+					// Offset = 16
+					{
+						auto& colorElement = layoutDescription[3];
+
+						colorElement.SemanticName = "COLOR";
+						colorElement.SemanticIndex = 0;
+						colorElement.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+						colorElement.InputSlot = 0;
+						colorElement.AlignedByteOffset = offsetof( VertexFormats::sVertex_mesh, r );
+						colorElement.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+						colorElement.InstanceDataStepRate = 0;
+					}
 				}
 
 				const auto d3dResult = direct3dDevice->CreateInputLayout( layoutDescription, vertexElementCount,
-					vertexShaderDataFromFile.data, vertexShaderDataFromFile.size, &m_vertexInputLayout );
+					compiledShader, compiledShaderSize, &m_vertexInputLayout );
 				if ( FAILED( d3dResult ) )
 				{
 					result = Results::Failure;
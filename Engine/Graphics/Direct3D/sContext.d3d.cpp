@@ -42,6 +42,11 @@ eae6320::cResult eae6320::Graphics::sContext::CleanUp()
 {
 	auto result = Results::Success;
 
+	if ( direct3dImmediateContext1 )
+	{
+		direct3dImmediateContext1->Release();
+		direct3dImmediateContext1 = nullptr;
+	}
 	if ( direct3dImmediateContext )
 	{
 		direct3dImmediateContext->Release();
@@ -120,15 +125,23 @@ namespace
 		const auto result_create = D3D11CreateDeviceAndSwapChain( useDefaultAdapter, useHardwareRendering, dontUseSoftwareRendering,
 			flags, useDefaultFeatureLevels, requestedFeatureLevelCount, sdkVersion, &swapChainDescription,
 			&g_context.swapChain, &g_context.direct3dDevice, &highestSupportedFeatureLevel, &g_context.direct3dImmediateContext );
-		if ( SUCCEEDED( result_create ) )
-		{
-			return eae6320::Results::Success;
-		}
-		else
+		if ( FAILED( result_create ) )
 		{
 			EAE6320_ASSERT( false );
 			eae6320::Logging::OutputError( "Direct3D failed to create a Direct3D11 device with HRESULT %#010x", result_create );
 			return eae6320::Results::Failure;
 		}
+		// Binding part of a constant buffer requires the Direct3D 11.1 interface
+		{
+			const auto result_query = g_context.direct3dImmediateContext->QueryInterface( __uuidof( ID3D11DeviceContext1 ),
+				reinterpret_cast<void**>( &g_context.direct3dImmediateContext1 ) );
+			if ( FAILED( result_query ) )
+			{
+				EAE6320_ASSERT( false );
+				eae6320::Logging::OutputError( "The Direct3D device doesn't support Direct3D 11.1 (QueryInterface() returned HRESULT %#010x)", result_query );
+				return eae6320::Results::Failure;
+			}
+		}
+		return eae6320::Results::Success;
 	}
 }
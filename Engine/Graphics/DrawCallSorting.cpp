@@ -0,0 +1,147 @@
+// Includes
+//=========
+
+#include "DrawCallSorting.h"
+
+#include "cRenderState.h"
+
+#include <cstring>
+#include <utility>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// Key Layout
+	//-----------
+
+	// The most significant bit separates opaque draw calls (which are drawn first) from transparent ones
+	constexpr uint64_t s_transparentBit = uint64_t( 1 ) << 63;
+
+	// The IDs are truncated to fit; two IDs that share their low bits are only sorted less tightly
+	// (the renderer compares pointers before skipping a bind, and so it never skips one that it shouldn't)
+	constexpr uint64_t s_idMask = 0xfff;
+
+	// Opaque: [ 0 | render state (8) | effect (12) | material (12) | mesh (12) | depth (16) | unused (3) ]
+	constexpr unsigned int s_shift_opaque_renderState = 55;
+	constexpr unsigned int s_shift_opaque_effect = 43;
+	constexpr unsigned int s_shift_opaque_material = 31;
+	constexpr unsigned int s_shift_opaque_mesh = 19;
+	constexpr unsigned int s_shift_opaque_depth = 3;
+
+	// Transparent: [ 1 | inverted depth (16) | render state (8) | effect (12) | material (12) | mesh (12) | unused (3) ]
+	constexpr unsigned int s_shift_transparent_depth = 47;
+	constexpr unsigned int s_shift_transparent_renderState = 39;
+	constexpr unsigned int s_shift_transparent_effect = 27;
+	constexpr unsigned int s_shift_transparent_material = 15;
+	constexpr unsigned int s_shift_transparent_mesh = 3;
+
+	uint16_t QuantizeDepth( const float i_depth );
+}
+
+// Interface
+//==========
+
+uint64_t eae6320::Graphics::DrawCallSorting::CreateKey( const uint8_t i_renderStateBits, const uint16_t i_effectId, const uint16_t i_materialId,
+	const uint16_t i_meshId, const float i_depth )
+{
+	const auto depth = QuantizeDepth( i_depth );
+	const auto effectId = i_effectId & s_idMask, materialId = i_materialId & s_idMask, meshId = i_meshId & s_idMask;
+	if ( !RenderStates::IsAlphaTransparencyEnabled( i_renderStateBits ) )
+	{
+		return ( uint64_t( i_renderStateBits ) << s_shift_opaque_renderState )
+			| ( effectId << s_shift_opaque_effect )
+			| ( materialId << s_shift_opaque_material )
+			| ( meshId << s_shift_opaque_mesh )
+			| ( uint64_t( depth ) << s_shift_opaque_depth );
+	}
+	else
+	{
+		// Inverting the depth makes farther draw calls sort first
+		return s_transparentBit
+			| ( uint64_t( static_cast<uint16_t>( ~depth ) ) << s_shift_transparent_depth )
+			| ( uint64_t( i_renderStateBits ) << s_shift_transparent_renderState )
+			| ( effectId << s_shift_transparent_effect )
+			| ( materialId << s_shift_transparent_material )
+			| ( meshId << s_shift_transparent_mesh );
+	}
+}
+
+void eae6320::Graphics::DrawCallSorting::RadixSort( sSortEntry* const io_entries, sSortEntry* const io_scratch, const size_t i_count )
+{
+	if ( i_count < 2 )
+	{
+		return;
+	}
+
+	// This is a least-significant-digit radix sort that uses one byte of the key per pass.
+	// The histograms for every pass are built up front with a single read of the keys
+	constexpr unsigned int passCount = sizeof( uint64_t );
+	constexpr unsigned int bucketCount = 256;
+	uint32_t histograms[passCount][bucketCount] = {};
+	for ( size_t i = 0; i < i_count; ++i )
+	{
+		auto key = io_entries[i].key;
+		for ( unsigned int pass = 0; pass < passCount; ++pass )
+		{
+			++histograms[pass][key & 0xff];
+			key >>= 8;
+		}
+	}
+
+	auto* source = io_entries;
+	auto* destination = io_scratch;
+	for ( unsigned int pass = 0; pass < passCount; ++pass )
+	{
+		auto& histogram = histograms[pass];
+		// If every key has the same byte for this pass then the pass wouldn't change the order
+		// (in practice this skips most passes because most of the key bits are shared)
+		{
+			const auto firstByte = static_cast<unsigned int>( ( source[0].key >> ( pass * 8 ) ) & 0xff );
+			if ( histogram[firstByte] == i_count )
+			{
+				continue;
+			}
+		}
+		// Convert the counts into starting offsets
+		{
+			uint32_t offset = 0;
+			for ( auto& count : histogram )
+			{
+				const auto bucketSize = count;
+				count = offset;
+				offset += bucketSize;
+			}
+		}
+		for ( size_t i = 0; i < i_count; ++i )
+		{
+			const auto byte = static_cast<unsigned int>( ( source[i].key >> ( pass * 8 ) ) & 0xff );
+			destination[histogram[byte]++] = source[i];
+		}
+		std::swap( source, destination );
+	}
+
+	// An odd number of passes leaves the sorted entries in the scratch memory
+	if ( source != io_entries )
+	{
+		memcpy( io_entries, source, sizeof( sSortEntry ) * i_count );
+	}
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	uint16_t QuantizeDepth( const float i_depth )
+	{
+		// The bit pattern of a positive float increases with its value,
+		// and so the top bits (the exponent and the start of the mantissa)
+		// work as a logarithmic depth bucket without needing to know the far plane
+		const auto depth = ( i_depth > 0.0f ) ? i_depth : 0.0f;
+		uint32_t bits;
+		memcpy( &bits, &depth, sizeof( bits ) );
+		return static_cast<uint16_t>( bits >> 16 );
+	}
+}
@@ -0,0 +1,50 @@
+/*
+	Draw calls are sorted before they are rendered
+	so that successive draw calls share as much GPU state as possible
+
+	Every draw call is given a 64-bit key, and sorting by key groups the draw calls:
+		* Opaque draw calls are sorted by render state, then by effect, then by material, then by mesh,
+			and then front-to-back (so that hidden fragments can be rejected by the depth test)
+		* Transparent draw calls are always drawn after opaque ones
+			and are sorted back-to-front (so that they blend correctly)
+*/
+
+#ifndef EAE6320_GRAPHICS_DRAWCALLSORTING_H
+#define EAE6320_GRAPHICS_DRAWCALLSORTING_H
+
+// Includes
+//=========
+
+#include <cstddef>
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace DrawCallSorting
+		{
+			struct sSortEntry
+			{
+				uint64_t key = 0;
+				// The index of the draw call in the submitted array
+				uint32_t drawCallIndex = 0;
+			};
+
+			// i_depth is the distance in front of the camera
+			// (anything behind the camera is treated as a depth of zero).
+			// A material ID of 0 means that the draw call doesn't have a material
+			uint64_t CreateKey( const uint8_t i_renderStateBits, const uint16_t i_effectId, const uint16_t i_materialId, const uint16_t i_meshId,
+				const float i_depth );
+
+			// Sorts the entries by key (in ascending order).
+			// The sort is stable, and io_scratch must have space for at least i_count entries
+			void RadixSort( sSortEntry* const io_entries, sSortEntry* const io_scratch, const size_t i_count );
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_DRAWCALLSORTING_H
@@ -0,0 +1,184 @@
+// Includes
+//=========
+
+#include "FrustumCulling.h"
+
+#include <cmath>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+
+// Four spheres are tested at a time.
+// Every x64 CPU has SSE2; other CPUs test the four spheres one at a time
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#define EAE6320_GRAPHICS_FRUSTUMCULLING_ISSSE2AVAILABLE
+	#include <emmintrin.h>
+#endif
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// The matrix is stored as columns (see cMatrix_transformation.h)
+	void GetElements( const eae6320::Math::cMatrix_transformation& i_transform, float ( &o_elements )[16] );
+	// Returns a bit for every sphere in the block that is outside of at least one plane
+	unsigned int CullSphereBlock( const eae6320::Graphics::FrustumCulling::sFrustum& i_frustum,
+		const eae6320::Graphics::FrustumCulling::sSphereBlock& i_block );
+}
+
+// Interface
+//==========
+
+eae6320::Graphics::FrustumCulling::sFrustum eae6320::Graphics::FrustumCulling::CreateFrustum(
+	const Math::cMatrix_transformation& i_transform_worldToProjected )
+{
+	// A point is inside the frustum if its projected position is inside the clip volume:
+	//	-w <= x <= w, -w <= y <= w, and then the near and far planes depend on the platform's depth range.
+	// Each of those inequalities is a plane made from two rows of the matrix
+	float m[16];
+	GetElements( i_transform_worldToProjected, m );
+	const auto GetRow = [&m]( const int i_row, float ( &o_row )[4] )
+	{
+		for ( int column = 0; column < 4; ++column )
+		{
+			o_row[column] = m[( column * 4 ) + i_row];
+		}
+	};
+	float rows[4][4];
+	for ( int row = 0; row < 4; ++row )
+	{
+		GetRow( row, rows[row] );
+	}
+
+	sFrustum frustum;
+	for ( int i = 0; i < 4; ++i )
+	{
+		// Left and right
+		frustum.planes[0][i] = rows[3][i] + rows[0][i];
+		frustum.planes[1][i] = rows[3][i] - rows[0][i];
+		// Bottom and top
+		frustum.planes[2][i] = rows[3][i] + rows[1][i];
+		frustum.planes[3][i] = rows[3][i] - rows[1][i];
+		// Near
+		// (this matches the depth range of Math::cMatrix_transformation::CreateCameraToProjectedTransform_perspective())
+#if defined( EAE6320_PLATFORM_GL )
+		frustum.planes[4][i] = rows[3][i] + rows[2][i];
+#else
+		frustum.planes[4][i] = rows[2][i];
+#endif
+		// Far
+		frustum.planes[5][i] = rows[3][i] - rows[2][i];
+	}
+	// The planes are normalized so that the distance to a plane can be compared with a radius
+	for ( auto& plane : frustum.planes )
+	{
+		const auto length = std::sqrt( ( plane[0] * plane[0] ) + ( plane[1] * plane[1] ) + ( plane[2] * plane[2] ) );
+		if ( length > 0.0f )
+		{
+			for ( auto& value : plane )
+			{
+				value /= length;
+			}
+		}
+	}
+	return frustum;
+}
+
+void eae6320::Graphics::FrustumCulling::SetSphere( sSphereBlock* const io_blocks, const size_t i_index,
+	const MeshFormats::sBounds& i_bounds_local, const Math::cMatrix_transformation& i_transform_localToWorld )
+{
+	EAE6320_ASSERT( io_blocks != nullptr );
+	float m[16];
+	GetElements( i_transform_localToWorld, m );
+	const auto* const center = i_bounds_local.sphereCenter;
+	auto& block = io_blocks[i_index / sphereCountPerBlock];
+	const auto lane = i_index % sphereCountPerBlock;
+	block.centerX[lane] = ( m[0] * center[0] ) + ( m[4] * center[1] ) + ( m[8] * center[2] ) + m[12];
+	block.centerY[lane] = ( m[1] * center[0] ) + ( m[5] * center[1] ) + ( m[9] * center[2] ) + m[13];
+	block.centerZ[lane] = ( m[2] * center[0] ) + ( m[6] * center[1] ) + ( m[10] * center[2] ) + m[14];
+	// The transforms in our class are usually rigid, but a scaled transform must scale the radius
+	float scaleSquared = 0.0f;
+	for ( int column = 0; column < 3; ++column )
+	{
+		const auto* const axis = m + ( column * 4 );
+		const auto lengthSquared = ( axis[0] * axis[0] ) + ( axis[1] * axis[1] ) + ( axis[2] * axis[2] );
+		scaleSquared = ( lengthSquared > scaleSquared ) ? lengthSquared : scaleSquared;
+	}
+	block.radius[lane] = i_bounds_local.sphereRadius * std::sqrt( scaleSquared );
+}
+
+uint32_t eae6320::Graphics::FrustumCulling::CullSpheres( const sFrustum& i_frustum, const sSphereBlock* const i_blocks, const uint32_t i_sphereCount,
+	uint32_t* const o_visibleIndices )
+{
+	EAE6320_ASSERT( ( i_blocks != nullptr ) || ( i_sphereCount == 0 ) );
+	EAE6320_ASSERT( ( o_visibleIndices != nullptr ) || ( i_sphereCount == 0 ) );
+	uint32_t visibleCount = 0;
+	const auto blockCount = static_cast<uint32_t>( CalculateSphereBlockCount( i_sphereCount ) );
+	for ( uint32_t blockIndex = 0; blockIndex < blockCount; ++blockIndex )
+	{
+		const auto firstSphere = blockIndex * sphereCountPerBlock;
+		const auto sphereCountInBlock = ( ( i_sphereCount - firstSphere ) < sphereCountPerBlock ) ? ( i_sphereCount - firstSphere ) : sphereCountPerBlock;
+		const auto validMask = ( 1u << sphereCountInBlock ) - 1;
+		auto visibleMask = ~CullSphereBlock( i_frustum, i_blocks[blockIndex] ) & validMask;
+		// Only the bits of visible spheres are visited
+		while ( visibleMask != 0 )
+		{
+			unsigned int lane = 0;
+			while ( ( visibleMask & ( 1u << lane ) ) == 0 )
+			{
+				++lane;
+			}
+			o_visibleIndices[visibleCount++] = firstSphere + lane;
+			visibleMask &= visibleMask - 1;
+		}
+	}
+	return visibleCount;
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	void GetElements( const eae6320::Math::cMatrix_transformation& i_transform, float ( &o_elements )[16] )
+	{
+		static_assert( sizeof( o_elements ) == sizeof( i_transform ), "A transform must be 16 floats" );
+		memcpy( o_elements, &i_transform, sizeof( o_elements ) );
+	}
+
+	unsigned int CullSphereBlock( const eae6320::Graphics::FrustumCulling::sFrustum& i_frustum,
+		const eae6320::Graphics::FrustumCulling::sSphereBlock& i_block )
+	{
+#if defined( EAE6320_GRAPHICS_FRUSTUMCULLING_ISSSE2AVAILABLE )
+		const auto centerX = _mm_load_ps( i_block.centerX );
+		const auto centerY = _mm_load_ps( i_block.centerY );
+		const auto centerZ = _mm_load_ps( i_block.centerZ );
+		const auto negativeRadius = _mm_sub_ps( _mm_setzero_ps(), _mm_load_ps( i_block.radius ) );
+		auto isOutside = _mm_setzero_ps();
+		for ( const auto& plane : i_frustum.planes )
+		{
+			const auto distance = _mm_add_ps(
+				_mm_add_ps( _mm_mul_ps( centerX, _mm_set1_ps( plane[0] ) ), _mm_mul_ps( centerY, _mm_set1_ps( plane[1] ) ) ),
+				_mm_add_ps( _mm_mul_ps( centerZ, _mm_set1_ps( plane[2] ) ), _mm_set1_ps( plane[3] ) ) );
+			isOutside = _mm_or_ps( isOutside, _mm_cmplt_ps( distance, negativeRadius ) );
+		}
+		return static_cast<unsigned int>( _mm_movemask_ps( isOutside ) );
+#else
+		unsigned int isOutside = 0;
+		for ( unsigned int lane = 0; lane < eae6320::Graphics::FrustumCulling::sphereCountPerBlock; ++lane )
+		{
+			for ( const auto& plane : i_frustum.planes )
+			{
+				const auto distance = ( i_block.centerX[lane] * plane[0] ) + ( i_block.centerY[lane] * plane[1] )
+					+ ( i_block.centerZ[lane] * plane[2] ) + plane[3];
+				if ( distance < -i_block.radius[lane] )
+				{
+					isOutside |= 1u << lane;
+					break;
+				}
+			}
+		}
+		return isOutside;
+#endif
+	}
+}
@@ -0,0 +1,73 @@
+/*
+	Frustum culling removes draw calls whose meshes can't be seen by the camera
+	before they are submitted
+
+	Every mesh has a bounding sphere (see MeshFormats.h),
+	and the spheres are tested against the six planes of the view frustum four at a time:
+	the spheres are stored as structures of arrays
+	so that a single SIMD instruction can do the same step of the test for four spheres.
+	A sphere is only culled if it is entirely outside of one of the planes,
+	and so a few spheres that are near the corners of the frustum are drawn even though they can't be seen.
+*/
+
+#ifndef EAE6320_GRAPHICS_FRUSTUMCULLING_H
+#define EAE6320_GRAPHICS_FRUSTUMCULLING_H
+
+// Includes
+//=========
+
+#include "MeshFormats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Math/cMatrix_transformation.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace FrustumCulling
+		{
+			// Every plane is ( normal x, normal y, normal z, distance ) in world space,
+			// and the normals point into the frustum
+			// (a point is inside a plane when Dot( normal, point ) + distance >= 0)
+			struct sFrustum
+			{
+				float planes[6][4] = {};
+			};
+			// The planes are extracted from a world-to-projected transform
+			// (i.e. camera-to-projected * world-to-camera)
+			sFrustum CreateFrustum( const Math::cMatrix_transformation& i_transform_worldToProjected );
+
+			// Four spheres, stored as a structure of arrays
+			constexpr unsigned int sphereCountPerBlock = 4;
+			struct alignas( 16 ) sSphereBlock
+			{
+				float centerX[sphereCountPerBlock];
+				float centerY[sphereCountPerBlock];
+				float centerZ[sphereCountPerBlock];
+				float radius[sphereCountPerBlock];
+			};
+			constexpr size_t CalculateSphereBlockCount( const size_t i_sphereCount )
+			{
+				return ( i_sphereCount + ( sphereCountPerBlock - 1 ) ) / sphereCountPerBlock;
+			}
+			// Stores a mesh's bounding sphere in world space as sphere i_index
+			// (the radius is scaled by the transform's largest scale)
+			void SetSphere( sSphereBlock* const io_blocks, const size_t i_index,
+				const MeshFormats::sBounds& i_bounds_local, const Math::cMatrix_transformation& i_transform_localToWorld );
+
+			// Writes the indices of the spheres that might be visible (in ascending order)
+			// and returns how many there are.
+			// o_visibleIndices must have space for i_sphereCount indices
+			// (any unused spheres in the last block are ignored)
+			uint32_t CullSpheres( const sFrustum& i_frustum, const sSphereBlock* const i_blocks, const uint32_t i_sphereCount,
+				uint32_t* const o_visibleIndices );
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_FRUSTUMCULLING_H
@@ -3,23 +3,34 @@
 
 #include "Graphics.h"
 
+#include "AsyncLoadBenchmark.h"
 #include "cConstantBuffer.h"
 #include "ConstantBufferFormats.h"
 #include "cShader.h"
 #include "cMesh.h"
 #include "cEffect.h"
+#include "cFrameArena.h"
+#include "cMaterial.h"
 #include "cRenderTarget.h"
+#include "DrawCallSorting.h"
+#include "FrustumCulling.h"
+#include "MeshLoadBenchmark.h"
 #include "sContext.h"
+#include "SubmissionBenchmark.h"
 #include "VertexFormats.h"
 
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/cAsyncLoader.h>
 #include <Engine/Concurrency/cEvent.h>
+#include <Engine/Concurrency/cMutex.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Platform/Platform.h>
 #include <Engine/ScopeGuard/cScopeGuard.h>
 #include <Engine/Time/Time.h>
 #include <Engine/UserOutput/UserOutput.h>
+#include <atomic>
 #include <utility>
+#include <vector>
 
 // Static Data
 //============
@@ -27,37 +38,135 @@ namespace
 {
 	// Constant buffer object
 	eae6320::Graphics::cConstantBuffer s_constantBuffer_frame(eae6320::Graphics::ConstantBufferTypes::Frame);
+	eae6320::Graphics::cConstantBuffer s_constantBuffer_material(eae6320::Graphics::ConstantBufferTypes::Material);
 	eae6320::Graphics::cConstantBuffer s_constantBuffer_drawCall(eae6320::Graphics::ConstantBufferTypes::DrawCall);
+	eae6320::Graphics::cConstantBuffer s_constantBuffer_instances(eae6320::Graphics::ConstantBufferTypes::Instances);
+
+	// Draw calls without a material use the default values
+	const eae6320::Graphics::ConstantBufferFormats::sMaterial s_constantData_defaultMaterial;
 
 	// Submission Data
 	//----------------
 
+	// Every instance of an instanced draw call uses the same effect (or material) and mesh
+	struct sInstancedDrawCall
+	{
+		eae6320::Graphics::cEffect* m_effect = nullptr;
+		eae6320::Graphics::cMesh* m_mesh = nullptr;
+		eae6320::Graphics::cMaterial* m_material = nullptr;
+		// The instances are stored contiguously in the frame's instance arena
+		uint32_t m_firstInstance = 0;
+		uint32_t m_instanceCount = 0;
+	};
+
 	// This struct's data is populated at submission time;
 	// it must cache whatever is necessary in order to render a frame
 	struct sDataRequiredToRenderAFrame
 	{
 		eae6320::Graphics::ConstantBufferFormats::sFrame constantData_frame;
 		float clearColor[4];
-		int effectsDrawCallsAndMeshesCount = 0;
-		eae6320::Graphics::sEffectDrawCallAndMesh* effectsDrawCallsAndMeshes = nullptr;
+		// The draw calls are reserved from an arena that is reset after the frame has been rendered
+		// (the memory is reused from frame to frame instead of being allocated and freed every time)
+		eae6320::Graphics::cFrameArena<eae6320::Graphics::sEffectDrawCallAndMesh> effectsDrawCallsAndMeshes;
+		eae6320::Graphics::cFrameArena<sInstancedDrawCall> instancedDrawCalls;
+		eae6320::Graphics::cFrameArena<eae6320::Graphics::ConstantBufferFormats::sDrawCall> instances;
 	};
-	// In our class there will be two copies of the data required to render a frame:
-	//	* One of them will be in the process of being populated by the data currently being submitted by the application loop thread
-	//	* One of them will be fully populated and in the process of being rendered from in the render thread
-	// (In other words, one is being produced while the other is being consumed)
-	sDataRequiredToRenderAFrame s_dataRequiredToRenderAFrame[2];
+	// This is how many draw calls the arenas can hold before they have to grow
+	constexpr size_t s_initialDrawCallCapacity = 256;
+	// The copies of the data required to render a frame are used as a ring:
+	//	* The application loop thread populates the copy after the last one that it submitted
+	//	* The render thread renders from the oldest copy that has been submitted but not rendered yet
+	// (In other words, frames are produced and consumed in order,
+	// and the producer can get up to s_frameCount - 1 frames ahead of the consumer)
+	constexpr unsigned int s_frameCount = EAE6320_GRAPHICS_SUBMISSIONFRAMECOUNT;
+	static_assert(s_frameCount >= 2, "There must be at least one frame to submit to while another is being rendered");
+	sDataRequiredToRenderAFrame s_dataRequiredToRenderAFrame[s_frameCount];
 	auto* s_dataBeingSubmittedByApplicationThread = &s_dataRequiredToRenderAFrame[0];
-	auto* s_dataBeingRenderedByRenderThread = &s_dataRequiredToRenderAFrame[1];
-	// The following two events work together to make sure that
-	// the main/render thread and the application loop thread can work in parallel but stay in sync:
+	auto* s_dataBeingRenderedByRenderThread = &s_dataRequiredToRenderAFrame[0];
+	// These two counters are the fences that keep the threads in sync without a lock:
+	//	* The application loop thread is the only one that increments the submitted count
+	//		(after it has finished populating a frame)
+	//	* The render thread is the only one that increments the rendered count
+	//		(after it has finished rendering a frame and has cleaned it up)
+	// A frame's copy is (frame index % s_frameCount),
+	// and so a copy can be submitted to when (submitted - rendered) < s_frameCount
+	// and can be rendered from when (submitted - rendered) > 0
+	std::atomic<uint64_t> s_submittedFrameCount( 0 );
+	std::atomic<uint64_t> s_renderedFrameCount( 0 );
+	// The events are only used to sleep instead of spinning while a fence isn't ready;
+	// the counters are always checked again after a thread wakes up:
 	// This event is signaled by the application loop thread when it has finished submitting render data for a frame
-	// (the main/render thread waits for the signal)
+	// (the main/render thread waits for the signal when there is nothing to render)
 	eae6320::Concurrency::cEvent s_whenAllDataHasBeenSubmittedFromApplicationThread;
-	// This event is signaled by the main/render thread when it has swapped render data pointers.
-	// This means that the renderer is now working with all the submitted data it needs to render the next frame,
-	// and the application loop thread can start submitting data for the following frame
-	// (the application loop thread waits for the signal)
+	// This event is signaled by the main/render thread when it has finished with a frame's data
+	// (the application loop thread waits for the signal when every copy is in use)
 	eae6320::Concurrency::cEvent s_whenDataForANewFrameCanBeSubmittedFromApplicationThread;
+	// Wait times are measured in ticks and are only written by the thread that waited
+	std::atomic<uint64_t> s_applicationThreadWaitTicks_lastFrame( 0 );
+	std::atomic<uint64_t> s_applicationThreadWaitTicks_total( 0 );
+	std::atomic<uint64_t> s_renderThreadWaitTicks_lastFrame( 0 );
+	std::atomic<uint64_t> s_renderThreadWaitTicks_total( 0 );
+	// The application loop may need to call WaitUntilDataForANewFrameCanBeSubmitted() more than once for a single frame
+	// (if it times out), and so its wait time is accumulated until a frame can be submitted
+	uint64_t s_applicationThreadWaitTicks_currentFrame = 0;
+
+	// Asset Lifetime
+	//---------------
+
+	// Draw calls don't hold references to their effects, materials, and meshes
+	// (that would be four interlocked operations per draw call per frame,
+	// on cache lines that are shared between the two threads).
+	// Instead, an asset that might be referenced by a frame that is in flight
+	// has its release deferred until every frame that could reference it has been rendered:
+	// the release is tagged with the rendered count that means the frame currently being submitted has been rendered
+	// and it happens on the render thread as soon as that frame has been rendered
+	// (the final release of an asset frees platform resources, which must be done by the thread that owns the graphics context)
+	struct sDeferredRelease
+	{
+		eae6320::Graphics::cEffect* effect = nullptr;
+		eae6320::Graphics::cMesh* mesh = nullptr;
+		eae6320::Graphics::cMaterial* material = nullptr;
+		uint64_t renderedFrameCountWhenSafe = 0;
+	};
+	// The releases are in the order that they were deferred, and so their rendered counts never decrease
+	std::vector<sDeferredRelease> s_deferredReleases;
+	// Releases are usually deferred by the application loop thread
+	// (and an application might clean up its assets from the main thread after the loop has exited)
+	// but they are always released by the render thread
+	eae6320::Concurrency::cMutex s_deferredReleasesMutex;
+
+	// Culling Data
+	//-------------
+
+	// These are only used by the application loop thread while it submits draw calls
+	// (the memory is reused every time that draw calls are culled)
+	eae6320::Graphics::cFrameArena<eae6320::Graphics::FrustumCulling::sSphereBlock> s_cullingSphereBlocks;
+	eae6320::Graphics::cFrameArena<uint32_t> s_cullingVisibleIndices;
+	eae6320::Graphics::cFrameArena<eae6320::Graphics::ConstantBufferFormats::sDrawCall> s_cullingVisibleInstances;
+	// The statistics are accumulated while a frame is being submitted
+	// and then copied when the frame has been submitted
+	eae6320::Graphics::sCullingStatistics s_cullingStatistics_currentFrame;
+	eae6320::Graphics::sCullingStatistics s_cullingStatistics;
+	eae6320::Concurrency::cMutex s_cullingStatisticsMutex;
+
+	// Sorting Data
+	//-------------
+
+	// These are only used by the render thread
+	// (the draw calls are sorted indirectly so that the submitted array itself doesn't move)
+	// A sort entry refers to an instanced draw call (instead of a single one) if its index has this bit set
+	constexpr uint32_t s_instancedDrawCallIndexBit = uint32_t(1) << 31;
+	eae6320::Graphics::cFrameArena<eae6320::Graphics::DrawCallSorting::sSortEntry> s_sortEntries;
+	eae6320::Graphics::cFrameArena<eae6320::Graphics::DrawCallSorting::sSortEntry> s_sortScratch;
+	// Every (non-instanced) draw call's constant data is in a range of the draw call constant buffer ring;
+	// this is the range index of each draw call (indexed the same as the submitted draw calls)
+	eae6320::Graphics::cFrameArena<uint32_t> s_drawCallRangeIndices;
+
+	// Statistics
+	//-----------
+
+	eae6320::Graphics::sRenderStatistics s_renderStatistics;
+	eae6320::Concurrency::cMutex s_renderStatisticsMutex;
 
 	// Geometry Data
 	//--------------
@@ -79,6 +188,33 @@ namespace
 	eae6320::cResult InitializeGeometry();
 	eae6320::cResult InitializeShadingData()
 	*/
+
+	// A draw call with a material uses the material's effect
+	eae6320::Graphics::cEffect* GetEffectToDrawWith( eae6320::Graphics::cEffect* const i_effect, const eae6320::Graphics::cMaterial* const i_material );
+	// Resets the arenas of a frame's draw calls so that they can be reused
+	void ReleaseDrawCalls( sDataRequiredToRenderAFrame& io_dataRequiredToRenderAFrame );
+	// Adds a release to the deferred queue
+	void DeferRelease( const sDeferredRelease& i_deferredRelease );
+	// Releases every deferred asset that can't be referenced by a frame that hasn't been rendered
+	// (or every deferred asset, regardless of the rendered count, if it should release everything)
+	void ReleaseDeferredAssets( const uint64_t i_renderedFrameCount, const bool i_shouldReleaseEverything = false );
+	// Calculates the world-space bounding spheres of i_count draw calls or instances
+	// (by calling i_setSphere( blocks, index ) for each one) and culls them.
+	// It returns the indices of the visible ones, or NULL if there isn't enough memory to cull
+	template <typename tSetSphere>
+	const uint32_t* CullSpheres( const unsigned int i_count, const eae6320::Graphics::FrustumCulling::sFrustum& i_frustum,
+		const tSetSphere& i_setSphere, uint32_t& o_visibleCount );
+	// Returns the instances that are visible
+	// (or all of the instances if there isn't enough memory to cull)
+	const eae6320::Graphics::ConstantBufferFormats::sDrawCall* CullInstances( const eae6320::Graphics::cMesh* const i_mesh,
+		const eae6320::Graphics::ConstantBufferFormats::sDrawCall* const i_instances, const unsigned int i_instanceCount,
+		const eae6320::Graphics::FrustumCulling::sFrustum& i_frustum, unsigned int& o_visibleInstanceCount );
+	// Fills s_sortEntries with the submitted draw calls in the order they should be drawn
+	eae6320::cResult SortDrawCalls( const sDataRequiredToRenderAFrame& i_dataRequiredToRenderAFrame );
+	// Copies the constant data of every sorted draw call to the draw call constant buffer ring with a single upload
+	// and fills s_drawCallRangeIndices
+	eae6320::cResult UploadDrawCallConstantData( const sDataRequiredToRenderAFrame& i_dataRequiredToRenderAFrame,
+		eae6320::Graphics::sRenderStatistics& io_renderStatistics );
 }
 
 // Interface
@@ -102,11 +238,70 @@ void eae6320::Graphics::SubmitClearColor(const float* i_clearColor)
 	memcpy(clearColor, i_clearColor, 4 * sizeof(float));
 }
 
-void eae6320::Graphics::SubmitEffectsDrawCallsAndMeshes(sEffectDrawCallAndMesh* i_effectsDrawCallsAndMeshes, const int i_effectsDrawCallsAndMeshesCount)
+eae6320::Graphics::sEffectDrawCallAndMesh* eae6320::Graphics::AllocateDrawCalls(const unsigned int i_count)
+{
+	EAE6320_ASSERT(s_dataBeingSubmittedByApplicationThread);
+	return s_dataBeingSubmittedByApplicationThread->effectsDrawCallsAndMeshes.Allocate(i_count);
+}
+
+void eae6320::Graphics::SubmitEffectsDrawCallsAndMeshes(const sEffectDrawCallAndMesh* i_effectsDrawCallsAndMeshes, const int i_effectsDrawCallsAndMeshesCount)
+{
+	EAE6320_ASSERT((i_effectsDrawCallsAndMeshes != nullptr) || (i_effectsDrawCallsAndMeshesCount == 0));
+	EAE6320_ASSERT(i_effectsDrawCallsAndMeshesCount >= 0);
+	if (auto* const drawCalls = AllocateDrawCalls(static_cast<unsigned int>(i_effectsDrawCallsAndMeshesCount)))
+	{
+		for (int i = 0; i < i_effectsDrawCallsAndMeshesCount; i++)
+		{
+			drawCalls[i] = i_effectsDrawCallsAndMeshes[i];
+		}
+	}
+}
+
+void eae6320::Graphics::SubmitInstancedDrawCalls(cEffect* const i_effect, cMesh* const i_mesh,
+	const ConstantBufferFormats::sDrawCall* const i_instances, const unsigned int i_instanceCount)
 {
 	EAE6320_ASSERT(s_dataBeingSubmittedByApplicationThread);
-	s_dataBeingSubmittedByApplicationThread->effectsDrawCallsAndMeshesCount = i_effectsDrawCallsAndMeshesCount;
-	s_dataBeingSubmittedByApplicationThread->effectsDrawCallsAndMeshes = i_effectsDrawCallsAndMeshes;
+	EAE6320_ASSERT((i_effect != nullptr) && (i_mesh != nullptr));
+	EAE6320_ASSERT((i_instances != nullptr) || (i_instanceCount == 0));
+	if (i_instanceCount == 0)
+	{
+		return;
+	}
+
+	auto& dataRequiredToRenderAFrame = *s_dataBeingSubmittedByApplicationThread;
+	// The draw call is reserved before the instances
+	// so that a failure can't leave instances in the arena that no draw call refers to
+	auto* const instancedDrawCall = dataRequiredToRenderAFrame.instancedDrawCalls.Allocate(1);
+	if (!instancedDrawCall)
+	{
+		return;
+	}
+	const auto firstInstance = dataRequiredToRenderAFrame.instances.GetCount();
+	auto* const instances = dataRequiredToRenderAFrame.instances.Allocate(i_instanceCount);
+	if (!instances)
+	{
+		dataRequiredToRenderAFrame.instancedDrawCalls.ReleaseLast(1);
+		return;
+	}
+	memcpy(instances, i_instances, sizeof(*i_instances) * i_instanceCount);
+	instancedDrawCall->m_effect = i_effect;
+	instancedDrawCall->m_mesh = i_mesh;
+	instancedDrawCall->m_firstInstance = static_cast<uint32_t>(firstInstance);
+	instancedDrawCall->m_instanceCount = i_instanceCount;
+}
+
+void eae6320::Graphics::SubmitInstancedDrawCalls(cMaterial* const i_material, cMesh* const i_mesh,
+	const ConstantBufferFormats::sDrawCall* const i_instances, const unsigned int i_instanceCount)
+{
+	EAE6320_ASSERT(s_dataBeingSubmittedByApplicationThread);
+	EAE6320_ASSERT(i_material != nullptr);
+	auto& instancedDrawCalls = s_dataBeingSubmittedByApplicationThread->instancedDrawCalls;
+	const auto instancedDrawCallCount = instancedDrawCalls.GetCount();
+	SubmitInstancedDrawCalls(i_material->GetEffect(), i_mesh, i_instances, i_instanceCount);
+	if (instancedDrawCalls.GetCount() > instancedDrawCallCount)
+	{
+		instancedDrawCalls.GetElements()[instancedDrawCallCount].m_material = i_material;
+	}
 }
 
 void eae6320::Graphics::SubmitCamera(const Math::cMatrix_transformation i_transform_worldToCamera, const Math::cMatrix_transformation i_transform_cameraToProjected)
@@ -117,14 +312,128 @@ void eae6320::Graphics::SubmitCamera(const Math::cMatrix_transformation i_transf
 	constantData_frame.g_transform_cameraToProjected = i_transform_cameraToProjected;
 }
 
+// Frustum Culling
+//----------------
+
+void eae6320::Graphics::SubmitVisibleEffectsDrawCallsAndMeshes(const sEffectDrawCallAndMesh* const i_effectsDrawCallsAndMeshes, const unsigned int i_count,
+	const FrustumCulling::sFrustum& i_frustum)
+{
+	EAE6320_ASSERT(s_dataBeingSubmittedByApplicationThread);
+	EAE6320_ASSERT((i_effectsDrawCallsAndMeshes != nullptr) || (i_count == 0));
+	if (i_count == 0)
+	{
+		return;
+	}
+	uint32_t visibleCount = 0;
+	const auto* const visibleIndices = CullSpheres(i_count, i_frustum,
+		[i_effectsDrawCallsAndMeshes](FrustumCulling::sSphereBlock* const io_blocks, const unsigned int i_index)
+		{
+			const auto& drawCall = i_effectsDrawCallsAndMeshes[i_index];
+			EAE6320_ASSERT(drawCall.m_mesh != nullptr);
+			FrustumCulling::SetSphere(io_blocks, i_index, drawCall.m_mesh->GetBounds(), drawCall.m_constantData_drawCall.g_transform_localToWorld);
+		}, visibleCount);
+	if (!visibleIndices)
+	{
+		// If the draw calls can't be culled then they are all drawn
+		SubmitEffectsDrawCallsAndMeshes(i_effectsDrawCallsAndMeshes, static_cast<int>(i_count));
+		return;
+	}
+	if (auto* const drawCalls = AllocateDrawCalls(visibleCount))
+	{
+		for (uint32_t i = 0; i < visibleCount; i++)
+		{
+			drawCalls[i] = i_effectsDrawCallsAndMeshes[visibleIndices[i]];
+		}
+	}
+}
+
+void eae6320::Graphics::SubmitVisibleInstancedDrawCalls(cEffect* const i_effect, cMesh* const i_mesh,
+	const ConstantBufferFormats::sDrawCall* const i_instances, const unsigned int i_instanceCount, const FrustumCulling::sFrustum& i_frustum)
+{
+	unsigned int visibleInstanceCount = 0;
+	const auto* const visibleInstances = CullInstances(i_mesh, i_instances, i_instanceCount, i_frustum, visibleInstanceCount);
+	SubmitInstancedDrawCalls(i_effect, i_mesh, visibleInstances, visibleInstanceCount);
+}
+
+void eae6320::Graphics::SubmitVisibleInstancedDrawCalls(cMaterial* const i_material, cMesh* const i_mesh,
+	const ConstantBufferFormats::sDrawCall* const i_instances, const unsigned int i_instanceCount, const FrustumCulling::sFrustum& i_frustum)
+{
+	unsigned int visibleInstanceCount = 0;
+	const auto* const visibleInstances = CullInstances(i_mesh, i_instances, i_instanceCount, i_frustum, visibleInstanceCount);
+	SubmitInstancedDrawCalls(i_material, i_mesh, visibleInstances, visibleInstanceCount);
+}
+
+// Asset Lifetime
+//---------------
+
+void eae6320::Graphics::ReleaseAfterInFlightFramesHaveBeenRendered(cEffect*& io_effect)
+{
+	if (io_effect)
+	{
+		sDeferredRelease deferredRelease;
+		deferredRelease.effect = io_effect;
+		DeferRelease(deferredRelease);
+		io_effect = nullptr;
+	}
+}
+
+void eae6320::Graphics::ReleaseAfterInFlightFramesHaveBeenRendered(cMaterial*& io_material)
+{
+	if (io_material)
+	{
+		sDeferredRelease deferredRelease;
+		deferredRelease.material = io_material;
+		DeferRelease(deferredRelease);
+		io_material = nullptr;
+	}
+}
+
+void eae6320::Graphics::ReleaseAfterInFlightFramesHaveBeenRendered(cMesh*& io_mesh)
+{
+	if (io_mesh)
+	{
+		sDeferredRelease deferredRelease;
+		deferredRelease.mesh = io_mesh;
+		DeferRelease(deferredRelease);
+		io_mesh = nullptr;
+	}
+}
+
 
 eae6320::cResult eae6320::Graphics::WaitUntilDataForANewFrameCanBeSubmitted(const unsigned int i_timeToWait_inMilliseconds)
 {
-	return Concurrency::WaitForEvent(s_whenDataForANewFrameCanBeSubmittedFromApplicationThread, i_timeToWait_inMilliseconds);
+	// Only the application loop thread changes the submitted count
+	const auto submittedFrameCount = s_submittedFrameCount.load(std::memory_order_relaxed);
+	const auto tickCount_beforeWaiting = Time::GetCurrentSystemTimeTickCount();
+	auto result = Results::Success;
+	// The rendered count must be acquired so that the render thread's clean up of the frame is visible
+	while ((submittedFrameCount - s_renderedFrameCount.load(std::memory_order_acquire)) >= s_frameCount)
+	{
+		if (!(result = Concurrency::WaitForEvent(s_whenDataForANewFrameCanBeSubmittedFromApplicationThread, i_timeToWait_inMilliseconds)))
+		{
+			break;
+		}
+	}
+	s_applicationThreadWaitTicks_currentFrame += Time::GetCurrentSystemTimeTickCount() - tickCount_beforeWaiting;
+	if (result)
+	{
+		s_applicationThreadWaitTicks_lastFrame.store(s_applicationThreadWaitTicks_currentFrame, std::memory_order_relaxed);
+		s_applicationThreadWaitTicks_total.fetch_add(s_applicationThreadWaitTicks_currentFrame, std::memory_order_relaxed);
+		s_applicationThreadWaitTicks_currentFrame = 0;
+		s_dataBeingSubmittedByApplicationThread = &s_dataRequiredToRenderAFrame[submittedFrameCount % s_frameCount];
+	}
+	return result;
 }
 
 eae6320::cResult eae6320::Graphics::SignalThatAllDataForAFrameHasBeenSubmitted()
 {
+	{
+		Concurrency::cMutex::cScopeLock scopeLock(s_cullingStatisticsMutex);
+		s_cullingStatistics = s_cullingStatistics_currentFrame;
+	}
+	s_cullingStatistics_currentFrame = sCullingStatistics();
+	// The submitted count must be released so that the submitted data is visible to the render thread
+	s_submittedFrameCount.fetch_add(1, std::memory_order_release);
 	return s_whenAllDataHasBeenSubmittedFromApplicationThread.Signal();
 }
 
@@ -135,31 +444,33 @@ void eae6320::Graphics::RenderFrame()
 {
 	// Wait for the application loop to submit data to be rendered
 	{
-		if (Concurrency::WaitForEvent(s_whenAllDataHasBeenSubmittedFromApplicationThread))
+		// Only the render thread changes the rendered count
+		const auto renderedFrameCount = s_renderedFrameCount.load(std::memory_order_relaxed);
+		const auto tickCount_beforeWaiting = Time::GetCurrentSystemTimeTickCount();
+		// The submitted count must be acquired so that the application's submitted data is visible
+		while (s_submittedFrameCount.load(std::memory_order_acquire) == renderedFrameCount)
 		{
-			// Switch the render data pointers so that
-			// the data that the application just submitted becomes the data that will now be rendered
-			std::swap(s_dataBeingSubmittedByApplicationThread, s_dataBeingRenderedByRenderThread);
-			// Once the pointers have been swapped the application loop can submit new data
-			if (!s_whenDataForANewFrameCanBeSubmittedFromApplicationThread.Signal())
+			if (!Concurrency::WaitForEvent(s_whenAllDataHasBeenSubmittedFromApplicationThread))
 			{
-				EAE6320_ASSERTF(false, "Couldn't signal that new graphics data can be submitted");
-				Logging::OutputError("Failed to signal that new render data can be submitted");
-				UserOutput::Print("The renderer failed to signal to the application that new graphics data can be submitted."
+				EAE6320_ASSERTF(false, "Waiting for the graphics data to be submitted failed");
+				Logging::OutputError("Waiting for the application loop to submit data to be rendered failed");
+				UserOutput::Print("The renderer failed to wait for the application to submit data to be rendered."
 					" The application is probably in a bad state and should be exited");
 				return;
 			}
 		}
-		else
-		{
-			EAE6320_ASSERTF(false, "Waiting for the graphics data to be submitted failed");
-			Logging::OutputError("Waiting for the application loop to submit data to be rendered failed");
-			UserOutput::Print("The renderer failed to wait for the application to submit data to be rendered."
-				" The application is probably in a bad state and should be exited");
-			return;
-		}
+		const auto waitTicks = Time::GetCurrentSystemTimeTickCount() - tickCount_beforeWaiting;
+		s_renderThreadWaitTicks_lastFrame.store(waitTicks, std::memory_order_relaxed);
+		s_renderThreadWaitTicks_total.fetch_add(waitTicks, std::memory_order_relaxed);
+		// The oldest submitted frame is the one that will now be rendered
+		s_dataBeingRenderedByRenderThread = &s_dataRequiredToRenderAFrame[renderedFrameCount % s_frameCount];
 	}
 
+	// Create the graphics objects for any assets that have finished loading asynchronously
+	// (this is done before anything is bound for the frame,
+	// and the assets can't be in this frame's draw calls because they didn't exist when it was submitted)
+	Assets::cAsyncLoader::GetDefault().ExecuteRenderThreadWork();
+
 	auto& clearColor = s_dataBeingRenderedByRenderThread->clearColor;
 
 	s_renderTarget->ClearBuffer(clearColor);
@@ -172,19 +483,132 @@ void eae6320::Graphics::RenderFrame()
 		auto& constantData_frame = s_dataBeingRenderedByRenderThread->constantData_frame;
 		s_constantBuffer_frame.Update(&constantData_frame);
 	}
+	sRenderStatistics renderStatistics;
+	renderStatistics.constantDataByteCount_uploaded += sizeof(s_dataBeingRenderedByRenderThread->constantData_frame);
 
 
-	for (int i = 0; i < s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshesCount; i++)
+	if (SortDrawCalls(*s_dataBeingRenderedByRenderThread))
 	{
-		// Bind the shading data
-		EAE6320_ASSERT(s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshes[i].m_effect != nullptr);
-		s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshes[i].m_effect->Bind();
-		//Update the draw call constant buffer
-		auto& constantData_drawCall = s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshes[i].m_constantData_drawCall;
-		s_constantBuffer_drawCall.Update(&constantData_drawCall);
-		// Draw the geometry
-		EAE6320_ASSERT(s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshes[i].m_mesh != nullptr);
-		s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshes[i].m_mesh->DrawGeometry();
+		const auto* const drawCalls = s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshes.GetElements();
+		const auto* const instancedDrawCalls = s_dataBeingRenderedByRenderThread->instancedDrawCalls.GetElements();
+		auto* const instances = s_dataBeingRenderedByRenderThread->instances.GetElements();
+		const auto* const sortEntries = s_sortEntries.GetElements();
+		const auto sortEntryCount = s_sortEntries.GetCount();
+		// If the draw call constant data couldn't be uploaded then only instanced draw calls can be drawn
+		const auto canDrawCallsBeDrawn = static_cast<bool>(UploadDrawCallConstantData(*s_dataBeingRenderedByRenderThread, renderStatistics));
+		const auto* const drawCallRangeIndices = s_drawCallRangeIndices.GetElements();
+		// Sorting puts draw calls that share an effect or a mesh next to each other,
+		// and so only a change from the previous draw call needs to be bound
+		const cEffect* boundEffect = nullptr;
+		const cMesh* boundMesh = nullptr;
+		// NULL is the default material, and so whether any material has been set is tracked separately
+		const cMaterial* boundMaterial = nullptr;
+		bool isMaterialBound = false;
+		// Draw calls that are next to each other and have identical constant data share a range
+		constexpr uint32_t noRangeBound = ~uint32_t(0);
+		uint32_t boundDrawCallRangeIndex = noRangeBound;
+		for (size_t i = 0; i < sortEntryCount; i++)
+		{
+			const auto drawCallIndex = sortEntries[i].drawCallIndex;
+			const auto isInstanced = (drawCallIndex & s_instancedDrawCallIndexBit) != 0;
+			if (!isInstanced && !canDrawCallsBeDrawn)
+			{
+				continue;
+			}
+			const sEffectDrawCallAndMesh* const drawCall = !isInstanced ? &drawCalls[drawCallIndex] : nullptr;
+			const sInstancedDrawCall* const instancedDrawCall = isInstanced ? &instancedDrawCalls[drawCallIndex & ~s_instancedDrawCallIndexBit] : nullptr;
+			const auto* const material = !isInstanced ? drawCall->m_material : instancedDrawCall->m_material;
+			auto* const effect = !isInstanced ? GetEffectToDrawWith(drawCall->m_effect, material) : instancedDrawCall->m_effect;
+			const auto* const mesh = !isInstanced ? drawCall->m_mesh : instancedDrawCall->m_mesh;
+			// Bind the shading data
+			EAE6320_ASSERT(effect != nullptr);
+			if (effect != boundEffect)
+			{
+				effect->Bind();
+				boundEffect = effect;
+				++renderStatistics.effectBindsIssued;
+			}
+			else
+			{
+				++renderStatistics.effectBindsSkipped;
+			}
+			// Update the material constant data
+			// (sorting puts draw calls with the same material next to each other,
+			// and so the constant buffer is only updated once for every run of the same material)
+			if (!isMaterialBound || (material != boundMaterial))
+			{
+				const auto& constantData_material = material ? material->GetConstantData() : s_constantData_defaultMaterial;
+				s_constantBuffer_material.Update(&constantData_material);
+				boundMaterial = material;
+				isMaterialBound = true;
+				++renderStatistics.materialUpdatesIssued;
+				renderStatistics.constantDataByteCount_uploaded += sizeof(constantData_material);
+			}
+			else
+			{
+				++renderStatistics.materialUpdatesSkipped;
+			}
+			// Bind the geometry
+			EAE6320_ASSERT(mesh != nullptr);
+			if (mesh != boundMesh)
+			{
+				mesh->Bind();
+				boundMesh = mesh;
+				++renderStatistics.meshBindsIssued;
+			}
+			else
+			{
+				++renderStatistics.meshBindsSkipped;
+			}
+			if (!isInstanced)
+			{
+				// Bind the range of the draw call constant buffer ring that has this draw call's data
+				const auto drawCallRangeIndex = drawCallRangeIndices[drawCallIndex];
+				if (drawCallRangeIndex != boundDrawCallRangeIndex)
+				{
+					s_constantBuffer_drawCall.BindRingRange(drawCallRangeIndex,
+						// In our class both vertex and fragment shaders use per-draw-call constant data
+						static_cast<uint_fast8_t>(eShaderType::Vertex) | static_cast<uint_fast8_t>(eShaderType::Fragment));
+					boundDrawCallRangeIndex = drawCallRangeIndex;
+				}
+				else
+				{
+					++renderStatistics.drawCallConstantBindsSkipped;
+				}
+				// Draw the geometry
+				mesh->Draw();
+				++renderStatistics.drawCallCount;
+			}
+			else
+			{
+				// The mesh's positions are dequantized by each instance's transform (see cMesh::FoldPositionDequantization());
+				// the instances are only used for this frame, and so they are changed in place
+				auto* const instancesToDraw = instances + instancedDrawCall->m_firstInstance;
+				for (uint32_t i = 0; i < instancedDrawCall->m_instanceCount; ++i)
+				{
+					instancesToDraw[i].g_transform_localToWorld = mesh->FoldPositionDequantization(instancesToDraw[i].g_transform_localToWorld);
+				}
+				// Every instance's transform is copied with a single update
+				// (unless there are more instances than fit in the constant buffer)
+				for (uint32_t instancesDrawn = 0; instancesDrawn < instancedDrawCall->m_instanceCount; )
+				{
+					const auto instancesRemaining = instancedDrawCall->m_instanceCount - instancesDrawn;
+					const auto instanceCount = (instancesRemaining < ConstantBufferFormats::maxInstanceCountPerDrawCall) ?
+						instancesRemaining : ConstantBufferFormats::maxInstanceCountPerDrawCall;
+					s_constantBuffer_instances.Update(instancesToDraw + instancesDrawn, sizeof(*instancesToDraw) * instanceCount);
+					renderStatistics.constantDataByteCount_uploaded += sizeof(*instancesToDraw) * instanceCount;
+					mesh->DrawInstanced(instanceCount);
+					instancesDrawn += instanceCount;
+					++renderStatistics.drawCallCount;
+					++renderStatistics.instancedDrawCallCount;
+				}
+				renderStatistics.instanceCount += instancedDrawCall->m_instanceCount;
+			}
+		}
+	}
+	{
+		Concurrency::cMutex::cScopeLock scopeLock(s_renderStatisticsMutex);
+		s_renderStatistics = renderStatistics;
 	}
 
 	s_renderTarget->SwapBuffer();
@@ -193,28 +617,64 @@ void eae6320::Graphics::RenderFrame()
 	// you must make sure that it is all cleaned up and cleared out
 	// so that the struct can be re-used (i.e. so that data for a new frame can be submitted to it)
 	{
-		// (At this point in the class there isn't anything that needs to be cleaned up)
-		//dataRequiredToRenderFrame	// TODO
-		if (s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshes)
+		ReleaseDrawCalls(*s_dataBeingRenderedByRenderThread);
+	}
+
+	// Once the frame has been cleaned up the application loop can submit new data to it
+	{
+		// The rendered count must be released so that the clean up is visible to the application loop thread
+		const auto renderedFrameCount = s_renderedFrameCount.fetch_add(1, std::memory_order_release) + 1;
+		// Any asset whose release was deferred until the frame that has just been rendered can be released now
+		// (this is the only place that the rendered count changes, and so it is the only place that deferred releases need to be checked)
+		ReleaseDeferredAssets(renderedFrameCount);
+		if (!s_whenDataForANewFrameCanBeSubmittedFromApplicationThread.Signal())
 		{
-			for (int i = 0; i < s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshesCount; i++)
-			{
-				if (s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshes[i].m_effect != nullptr)
-				{
-					s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshes[i].m_effect->DecrementReferenceCount();
-					s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshes[i].m_effect = nullptr;
-				}
-				if (s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshes[i].m_mesh != nullptr)
-				{
-					s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshes[i].m_mesh->DecrementReferenceCount();
-					s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshes[i].m_mesh = nullptr;
-				}
-			}
-			delete[] s_dataBeingRenderedByRenderThread->effectsDrawCallsAndMeshes;
+			EAE6320_ASSERTF(false, "Couldn't signal that new graphics data can be submitted");
+			Logging::OutputError("Failed to signal that new render data can be submitted");
+			UserOutput::Print("The renderer failed to signal to the application that new graphics data can be submitted."
+				" The application is probably in a bad state and should be exited");
+			return;
 		}
 	}
 }
 
+// Statistics
+//-----------
+
+uint64_t eae6320::Graphics::GetDrawCallHeapAllocationCount()
+{
+	uint64_t heapAllocationCount = 0;
+	for (const auto& dataRequiredToRenderAFrame : s_dataRequiredToRenderAFrame)
+	{
+		heapAllocationCount += dataRequiredToRenderAFrame.effectsDrawCallsAndMeshes.GetHeapAllocationCount();
+	}
+	return heapAllocationCount;
+}
+
+eae6320::Graphics::sRenderStatistics eae6320::Graphics::GetRenderStatistics()
+{
+	Concurrency::cMutex::cScopeLock scopeLock(s_renderStatisticsMutex);
+	return s_renderStatistics;
+}
+
+eae6320::Graphics::sCullingStatistics eae6320::Graphics::GetCullingStatistics()
+{
+	Concurrency::cMutex::cScopeLock scopeLock(s_cullingStatisticsMutex);
+	return s_cullingStatistics;
+}
+
+eae6320::Graphics::sSubmissionStatistics eae6320::Graphics::GetSubmissionStatistics()
+{
+	sSubmissionStatistics submissionStatistics;
+	submissionStatistics.applicationThreadWaitSeconds_lastFrame = Time::ConvertTicksToSeconds(s_applicationThreadWaitTicks_lastFrame.load(std::memory_order_relaxed));
+	submissionStatistics.renderThreadWaitSeconds_lastFrame = Time::ConvertTicksToSeconds(s_renderThreadWaitTicks_lastFrame.load(std::memory_order_relaxed));
+	submissionStatistics.applicationThreadWaitSeconds_total = Time::ConvertTicksToSeconds(s_applicationThreadWaitTicks_total.load(std::memory_order_relaxed));
+	submissionStatistics.renderThreadWaitSeconds_total = Time::ConvertTicksToSeconds(s_renderThreadWaitTicks_total.load(std::memory_order_relaxed));
+	submissionStatistics.submittedFrameCount = s_submittedFrameCount.load(std::memory_order_relaxed);
+	submissionStatistics.renderedFrameCount = s_renderedFrameCount.load(std::memory_order_relaxed);
+	return submissionStatistics;
+}
+
 // Initialize / Clean Up
 //--------------------------
 
@@ -244,19 +704,78 @@ eae6320::cResult eae6320::Graphics::Initialize(const sInitializationParameters&
 			return result;
 		}
 
-		if (result = s_constantBuffer_drawCall.Initialize())
+		if (result = s_constantBuffer_material.Initialize())
 		{
-			// There is only a single frame constant buffer that is reused
-			// and so it can be bound at initialization time and never unbound
-			s_constantBuffer_drawCall.Bind(
-				// In our class both vertex and fragment shaders use per-frame constant data
+			// There is only a single material constant buffer,
+			// and so it is bound once and then updated whenever the material changes
+			s_constantBuffer_material.Bind(
+				// In our class both vertex and fragment shaders use per-material constant data
 				static_cast<uint_fast8_t>(eShaderType::Vertex) | static_cast<uint_fast8_t>(eShaderType::Fragment));
 		}
 		else
+		{
+			EAE6320_ASSERTF(false, "Can't initialize Graphics without material constant buffer");
+			return result;
+		}
+
+		// Every draw call's constant data is uploaded into a ring once per frame,
+		// and each draw call binds its own range
+		if (!(result = s_constantBuffer_drawCall.InitializeRing(static_cast<unsigned int>(s_initialDrawCallCapacity))))
 		{
 			EAE6320_ASSERTF(false, "Can't initialize Graphics without drawCall constant buffer");
 			return result;
 		}
+
+		if (result = s_constantBuffer_instances.Initialize())
+		{
+			// The instance constant buffer is also only bound once;
+			// it is updated before every instanced draw call
+			s_constantBuffer_instances.Bind(
+				// Only vertex shaders need the instance transforms
+				static_cast<uint_fast8_t>(eShaderType::Vertex));
+		}
+		else
+		{
+			EAE6320_ASSERTF(false, "Can't initialize Graphics without instances constant buffer");
+			return result;
+		}
+	}
+	// Initialize the per-frame draw call memory
+	{
+		for (auto& dataRequiredToRenderAFrame : s_dataRequiredToRenderAFrame)
+		{
+			if (!(result = dataRequiredToRenderAFrame.effectsDrawCallsAndMeshes.Initialize(s_initialDrawCallCapacity)))
+			{
+				EAE6320_ASSERTF(false, "Can't initialize Graphics without memory for draw calls");
+				return result;
+			}
+		}
+		for (auto& dataRequiredToRenderAFrame : s_dataRequiredToRenderAFrame)
+		{
+			if (!(result = dataRequiredToRenderAFrame.instancedDrawCalls.Initialize(s_initialDrawCallCapacity))
+				|| !(result = dataRequiredToRenderAFrame.instances.Initialize(s_initialDrawCallCapacity)))
+			{
+				EAE6320_ASSERTF(false, "Can't initialize Graphics without memory for instanced draw calls");
+				return result;
+			}
+		}
+		if (!(result = s_sortEntries.Initialize(s_initialDrawCallCapacity)) || !(result = s_sortScratch.Initialize(s_initialDrawCallCapacity)))
+		{
+			EAE6320_ASSERTF(false, "Can't initialize Graphics without memory for sorting draw calls");
+			return result;
+		}
+		if (!(result = s_drawCallRangeIndices.Initialize(s_initialDrawCallCapacity)))
+		{
+			EAE6320_ASSERTF(false, "Can't initialize Graphics without memory for draw call constant buffer ranges");
+			return result;
+		}
+		if (!(result = s_cullingSphereBlocks.Initialize(FrustumCulling::CalculateSphereBlockCount(s_initialDrawCallCapacity)))
+			|| !(result = s_cullingVisibleIndices.Initialize(s_initialDrawCallCapacity))
+			|| !(result = s_cullingVisibleInstances.Initialize(s_initialDrawCallCapacity)))
+		{
+			EAE6320_ASSERTF(false, "Can't initialize Graphics without memory for culling draw calls");
+			return result;
+		}
 	}
 	// Initialize the events
 	{
@@ -265,8 +784,7 @@ eae6320::cResult eae6320::Graphics::Initialize(const sInitializationParameters&
 			EAE6320_ASSERTF(false, "Can't initialize Graphics without event for when data has been submitted from the application thread");
 			return result;
 		}
-		if (!(result = s_whenDataForANewFrameCanBeSubmittedFromApplicationThread.Initialize(Concurrency::EventType::ResetAutomaticallyAfterBeingSignaled,
-			Concurrency::EventState::Signaled)))
+		if (!(result = s_whenDataForANewFrameCanBeSubmittedFromApplicationThread.Initialize(Concurrency::EventType::ResetAutomaticallyAfterBeingSignaled)))
 		{
 			EAE6320_ASSERTF(false, "Can't initialize Graphics without event for when data can be submitted from the application thread");
 			return result;
@@ -282,6 +800,16 @@ eae6320::cResult eae6320::Graphics::Initialize(const sInitializationParameters&
 		}
 	}
 
+#ifdef EAE6320_GRAPHICS_SHOULDRUNSUBMISSIONBENCHMARK
+	SubmissionBenchmark::RunAndLogStandardSizes();
+#endif
+#ifdef EAE6320_GRAPHICS_MESHLOADBENCHMARKDIRECTORY
+	MeshLoadBenchmark::RunAndLog(EAE6320_GRAPHICS_MESHLOADBENCHMARKDIRECTORY);
+#endif
+#ifdef EAE6320_GRAPHICS_ASYNCLOADBENCHMARKDIRECTORY
+	AsyncLoadBenchmark::RunAndLog(EAE6320_GRAPHICS_ASYNCLOADBENCHMARKDIRECTORY);
+#endif
+
 	return result;
 }
 
@@ -297,24 +825,28 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 
 	// data submitted for a frame that never gets rendered, clean up thems
 	{
-		if (s_dataBeingSubmittedByApplicationThread->effectsDrawCallsAndMeshes != nullptr)
+		for (auto& dataRequiredToRenderAFrame : s_dataRequiredToRenderAFrame)
 		{
-			for (int i = 0; i < s_dataBeingSubmittedByApplicationThread->effectsDrawCallsAndMeshesCount; i++)
-			{
-				if (s_dataBeingSubmittedByApplicationThread->effectsDrawCallsAndMeshes[i].m_effect != nullptr)
-				{
-					s_dataBeingSubmittedByApplicationThread->effectsDrawCallsAndMeshes[i].m_effect->DecrementReferenceCount();
-					s_dataBeingSubmittedByApplicationThread->effectsDrawCallsAndMeshes[i].m_effect = nullptr;
-				}
-				if (s_dataBeingSubmittedByApplicationThread->effectsDrawCallsAndMeshes[i].m_mesh != nullptr)
-				{				
-					s_dataBeingSubmittedByApplicationThread->effectsDrawCallsAndMeshes[i].m_mesh->DecrementReferenceCount();
-					s_dataBeingSubmittedByApplicationThread->effectsDrawCallsAndMeshes[i].m_mesh = nullptr;
-				}
-			}
-			delete[] s_dataBeingSubmittedByApplicationThread->effectsDrawCallsAndMeshes;
+			ReleaseDrawCalls(dataRequiredToRenderAFrame);
+			dataRequiredToRenderAFrame.effectsDrawCallsAndMeshes.CleanUp();
+			dataRequiredToRenderAFrame.instancedDrawCalls.CleanUp();
+			dataRequiredToRenderAFrame.instances.CleanUp();
 		}
+		s_sortEntries.Reset();
+		s_sortEntries.CleanUp();
+		s_sortScratch.Reset();
+		s_sortScratch.CleanUp();
+		s_drawCallRangeIndices.Reset();
+		s_drawCallRangeIndices.CleanUp();
+		s_cullingSphereBlocks.Reset();
+		s_cullingSphereBlocks.CleanUp();
+		s_cullingVisibleIndices.Reset();
+		s_cullingVisibleIndices.CleanUp();
+		s_cullingVisibleInstances.Reset();
+		s_cullingVisibleInstances.CleanUp();
 	}
+	// None of the frames that might reference deferred assets will be rendered now
+	ReleaseDeferredAssets(s_renderedFrameCount.load(std::memory_order_acquire), true);
 
 	{
 		const auto result_constantBuffer_frame = s_constantBuffer_frame.CleanUp();
@@ -328,6 +860,18 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 		}
 	}
 
+	{
+		const auto result_constantBuffer_material = s_constantBuffer_material.CleanUp();
+		if (!result_constantBuffer_material)
+		{
+			EAE6320_ASSERT(false);
+			if (result)
+			{
+				result = result_constantBuffer_material;
+			}
+		}
+	}
+
 	{
 		const auto result_constantBuffer_drawCall = s_constantBuffer_drawCall.CleanUp();
 		if (!result_constantBuffer_drawCall)
@@ -340,6 +884,18 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 		}
 	}
 
+	{
+		const auto result_constantBuffer_instances = s_constantBuffer_instances.CleanUp();
+		if (!result_constantBuffer_instances)
+		{
+			EAE6320_ASSERT(false);
+			if (result)
+			{
+				result = result_constantBuffer_instances;
+			}
+		}
+	}
+
 	{
 		const auto result_context = sContext::g_context.CleanUp();
 		if (!result_context)
@@ -359,7 +915,250 @@ eae6320::cResult eae6320::Graphics::CleanUp()
 //===================
 
 namespace
-
 {
-	
-}
\ No newline at end of file
+	eae6320::Graphics::cEffect* GetEffectToDrawWith(eae6320::Graphics::cEffect* const i_effect, const eae6320::Graphics::cMaterial* const i_material)
+	{
+		return i_material ? i_material->GetEffect() : i_effect;
+	}
+
+	void ReleaseDrawCalls(sDataRequiredToRenderAFrame& io_dataRequiredToRenderAFrame)
+	{
+		// The draw calls only have plain pointers to their effects, materials, and meshes
+		// (see ReleaseAfterInFlightFramesHaveBeenRendered()),
+		// and so nothing needs to be released per draw call
+		io_dataRequiredToRenderAFrame.effectsDrawCallsAndMeshes.Reset();
+		io_dataRequiredToRenderAFrame.instancedDrawCalls.Reset();
+		io_dataRequiredToRenderAFrame.instances.Reset();
+	}
+
+	void DeferRelease(const sDeferredRelease& i_deferredRelease)
+	{
+		eae6320::Concurrency::cMutex::cScopeLock scopeLock(s_deferredReleasesMutex);
+		s_deferredReleases.push_back(i_deferredRelease);
+		// The frame currently being submitted (or the next one, if none is) is the last one that could reference the asset,
+		// and it has been rendered when the rendered count is greater than its index
+		s_deferredReleases.back().renderedFrameCountWhenSafe = s_submittedFrameCount.load(std::memory_order_relaxed) + 1;
+	}
+
+	void ReleaseDeferredAssets(const uint64_t i_renderedFrameCount, const bool i_shouldReleaseEverything)
+	{
+		eae6320::Concurrency::cMutex::cScopeLock scopeLock(s_deferredReleasesMutex);
+		size_t releasedCount = 0;
+		for (auto& deferredRelease : s_deferredReleases)
+		{
+			if (!i_shouldReleaseEverything && (deferredRelease.renderedFrameCountWhenSafe > i_renderedFrameCount))
+			{
+				break;
+			}
+			if (deferredRelease.effect)
+			{
+				deferredRelease.effect->DecrementReferenceCount();
+			}
+			if (deferredRelease.mesh)
+			{
+				deferredRelease.mesh->DecrementReferenceCount();
+			}
+			if (deferredRelease.material)
+			{
+				deferredRelease.material->DecrementReferenceCount();
+			}
+			++releasedCount;
+		}
+		if (releasedCount > 0)
+		{
+			s_deferredReleases.erase(s_deferredReleases.begin(), s_deferredReleases.begin() + releasedCount);
+		}
+	}
+
+	template <typename tSetSphere>
+	const uint32_t* CullSpheres(const unsigned int i_count, const eae6320::Graphics::FrustumCulling::sFrustum& i_frustum,
+		const tSetSphere& i_setSphere, uint32_t& o_visibleCount)
+	{
+		const auto tickCount_beforeCulling = eae6320::Time::GetCurrentSystemTimeTickCount();
+		s_cullingSphereBlocks.Reset();
+		s_cullingVisibleIndices.Reset();
+		auto* const sphereBlocks = s_cullingSphereBlocks.Allocate(eae6320::Graphics::FrustumCulling::CalculateSphereBlockCount(i_count));
+		auto* const visibleIndices = s_cullingVisibleIndices.Allocate(i_count);
+		if (!sphereBlocks || !visibleIndices)
+		{
+			EAE6320_ASSERTF(false, "Couldn't allocate memory to cull %u draw calls", i_count);
+			eae6320::Logging::OutputError("Failed to allocate memory to cull %u draw calls", i_count);
+			return nullptr;
+		}
+		// The spheres are calculated first and then tested four at a time
+		for (unsigned int i = 0; i < i_count; i++)
+		{
+			i_setSphere(sphereBlocks, i);
+		}
+		o_visibleCount = eae6320::Graphics::FrustumCulling::CullSpheres(i_frustum, sphereBlocks, i_count, visibleIndices);
+
+		auto& cullingStatistics = s_cullingStatistics_currentFrame;
+		cullingStatistics.testedCount += i_count;
+		cullingStatistics.visibleCount += o_visibleCount;
+		cullingStatistics.culledCount += i_count - o_visibleCount;
+		cullingStatistics.cullingSeconds +=
+			eae6320::Time::ConvertTicksToSeconds(eae6320::Time::GetCurrentSystemTimeTickCount() - tickCount_beforeCulling);
+		return visibleIndices;
+	}
+
+	const eae6320::Graphics::ConstantBufferFormats::sDrawCall* CullInstances(const eae6320::Graphics::cMesh* const i_mesh,
+		const eae6320::Graphics::ConstantBufferFormats::sDrawCall* const i_instances, const unsigned int i_instanceCount,
+		const eae6320::Graphics::FrustumCulling::sFrustum& i_frustum, unsigned int& o_visibleInstanceCount)
+	{
+		EAE6320_ASSERT(i_mesh != nullptr);
+		EAE6320_ASSERT((i_instances != nullptr) || (i_instanceCount == 0));
+		o_visibleInstanceCount = i_instanceCount;
+		if (i_instanceCount == 0)
+		{
+			return i_instances;
+		}
+		// Every instance has the same mesh, and so the same local bounds
+		const auto& bounds_local = i_mesh->GetBounds();
+		uint32_t visibleCount = 0;
+		const auto* const visibleIndices = CullSpheres(i_instanceCount, i_frustum,
+			[i_instances, &bounds_local](eae6320::Graphics::FrustumCulling::sSphereBlock* const io_blocks, const unsigned int i_index)
+			{
+				eae6320::Graphics::FrustumCulling::SetSphere(io_blocks, i_index, bounds_local, i_instances[i_index].g_transform_localToWorld);
+			}, visibleCount);
+		if (!visibleIndices)
+		{
+			return i_instances;
+		}
+		// The visible instances are copied next to each other
+		// so that they can be submitted with a single instanced draw call
+		s_cullingVisibleInstances.Reset();
+		auto* const visibleInstances = s_cullingVisibleInstances.Allocate(visibleCount);
+		if (!visibleInstances)
+		{
+			return i_instances;
+		}
+		for (uint32_t i = 0; i < visibleCount; i++)
+		{
+			visibleInstances[i] = i_instances[visibleIndices[i]];
+		}
+		o_visibleInstanceCount = visibleCount;
+		return visibleInstances;
+	}
+
+	eae6320::cResult SortDrawCalls(const sDataRequiredToRenderAFrame& i_dataRequiredToRenderAFrame)
+	{
+		const auto& arena = i_dataRequiredToRenderAFrame.effectsDrawCallsAndMeshes;
+		const auto* const drawCalls = arena.GetElements();
+		const auto drawCallCount = arena.GetCount();
+		const auto& instancedArena = i_dataRequiredToRenderAFrame.instancedDrawCalls;
+		const auto* const instancedDrawCalls = instancedArena.GetElements();
+		const auto instancedDrawCallCount = instancedArena.GetCount();
+		const auto* const instances = i_dataRequiredToRenderAFrame.instances.GetElements();
+		const auto sortEntryCount = drawCallCount + instancedDrawCallCount;
+
+		s_sortEntries.Reset();
+		s_sortScratch.Reset();
+		auto* const sortEntries = s_sortEntries.Allocate(sortEntryCount);
+		auto* const sortScratch = s_sortScratch.Allocate(sortEntryCount);
+		if ((sortEntryCount > 0) && (!sortEntries || !sortScratch))
+		{
+			s_sortEntries.Reset();
+			EAE6320_ASSERTF(false, "Couldn't allocate memory to sort %u draw calls", static_cast<unsigned int>(sortEntryCount));
+			eae6320::Logging::OutputError("Failed to allocate memory to sort %u draw calls", static_cast<unsigned int>(sortEntryCount));
+			return eae6320::Results::OutOfMemory;
+		}
+		EAE6320_ASSERT(drawCallCount < s_instancedDrawCallIndexBit);
+
+		// The depth of a draw call is the distance of its origin in front of the camera
+		// (the camera looks down the negative Z axis)
+		const auto& transform_worldToCamera = i_dataRequiredToRenderAFrame.constantData_frame.g_transform_worldToCamera;
+		for (size_t i = 0; i < drawCallCount; i++)
+		{
+			const auto& drawCall = drawCalls[i];
+			const auto* const effect = GetEffectToDrawWith(drawCall.m_effect, drawCall.m_material);
+			EAE6320_ASSERT((effect != nullptr) && (drawCall.m_mesh != nullptr));
+			const auto position_camera = transform_worldToCamera * drawCall.m_constantData_drawCall.g_transform_localToWorld.GetTranslation();
+			sortEntries[i].key = eae6320::Graphics::DrawCallSorting::CreateKey(effect->GetRenderStateBits(), effect->GetSortId(),
+				drawCall.m_material ? drawCall.m_material->GetSortId() : 0, drawCall.m_mesh->GetSortId(), -position_camera.z);
+			sortEntries[i].drawCallIndex = static_cast<uint32_t>(i);
+		}
+		// An instanced draw call's depth is the depth of its first instance
+		for (size_t i = 0; i < instancedDrawCallCount; i++)
+		{
+			const auto& instancedDrawCall = instancedDrawCalls[i];
+			EAE6320_ASSERT((instancedDrawCall.m_effect != nullptr) && (instancedDrawCall.m_mesh != nullptr));
+			const auto& firstInstance = instances[instancedDrawCall.m_firstInstance];
+			const auto position_camera = transform_worldToCamera * firstInstance.g_transform_localToWorld.GetTranslation();
+			auto& sortEntry = sortEntries[drawCallCount + i];
+			sortEntry.key = eae6320::Graphics::DrawCallSorting::CreateKey(instancedDrawCall.m_effect->GetRenderStateBits(),
+				instancedDrawCall.m_effect->GetSortId(), instancedDrawCall.m_material ? instancedDrawCall.m_material->GetSortId() : 0,
+				instancedDrawCall.m_mesh->GetSortId(), -position_camera.z);
+			sortEntry.drawCallIndex = static_cast<uint32_t>(i) | s_instancedDrawCallIndexBit;
+		}
+		eae6320::Graphics::DrawCallSorting::RadixSort(sortEntries, sortScratch, sortEntryCount);
+
+		return eae6320::Results::Success;
+	}
+
+	eae6320::cResult UploadDrawCallConstantData(const sDataRequiredToRenderAFrame& i_dataRequiredToRenderAFrame,
+		eae6320::Graphics::sRenderStatistics& io_renderStatistics)
+	{
+		const auto& arena = i_dataRequiredToRenderAFrame.effectsDrawCallsAndMeshes;
+		const auto* const drawCalls = arena.GetElements();
+		const auto drawCallCount = static_cast<unsigned int>(arena.GetCount());
+		s_drawCallRangeIndices.Reset();
+		if (drawCallCount == 0)
+		{
+			return eae6320::Results::Success;
+		}
+		auto* const rangeIndices = s_drawCallRangeIndices.Allocate(drawCallCount);
+		auto* const ringData = static_cast<uint8_t*>(s_constantBuffer_drawCall.BeginRingUpload(drawCallCount));
+		if (!rangeIndices || !ringData)
+		{
+			EAE6320_ASSERTF(false, "Couldn't allocate memory to upload the constant data of %u draw calls", drawCallCount);
+			eae6320::Logging::OutputError("Failed to allocate memory to upload the constant data of %u draw calls", drawCallCount);
+			return eae6320::Results::OutOfMemory;
+		}
+		const auto rangeStride = s_constantBuffer_drawCall.GetRingRangeStride();
+
+		// The ranges are written in the order that the draw calls will be drawn,
+		// and a draw call whose data is identical to the previous draw call's reuses its range
+		// (e.g. the same mesh drawn with the same transform by several effects)
+		const auto* const sortEntries = s_sortEntries.GetElements();
+		const auto sortEntryCount = s_sortEntries.GetCount();
+		eae6320::Graphics::ConstantBufferFormats::sDrawCall constantData_previous;
+		bool isThereAPreviousRange = false;
+		unsigned int rangeCount = 0;
+		for (size_t i = 0; i < sortEntryCount; i++)
+		{
+			const auto drawCallIndex = sortEntries[i].drawCallIndex;
+			if ((drawCallIndex & s_instancedDrawCallIndexBit) != 0)
+			{
+				continue;
+			}
+			// The mesh's positions are dequantized by the draw call's transform (see cMesh::FoldPositionDequantization())
+			const auto& drawCall = drawCalls[drawCallIndex];
+			eae6320::Graphics::ConstantBufferFormats::sDrawCall constantData_drawCall;
+			constantData_drawCall.g_transform_localToWorld = drawCall.m_mesh->FoldPositionDequantization(drawCall.m_constantData_drawCall.g_transform_localToWorld);
+			if (isThereAPreviousRange && (memcmp(&constantData_previous, &constantData_drawCall, sizeof(constantData_drawCall)) == 0))
+			{
+				rangeIndices[drawCallIndex] = rangeCount - 1;
+				++io_renderStatistics.drawCallConstantRangesShared;
+			}
+			else
+			{
+				memcpy(ringData + (rangeCount * rangeStride), &constantData_drawCall, sizeof(constantData_drawCall));
+				rangeIndices[drawCallIndex] = rangeCount;
+				++rangeCount;
+				constantData_previous = constantData_drawCall;
+				isThereAPreviousRange = true;
+			}
+		}
+		uint64_t byteCount_uploaded = 0;
+		const auto result = s_constantBuffer_drawCall.EndRingUpload(rangeCount, byteCount_uploaded);
+		if (!result)
+		{
+			return result;
+		}
+		io_renderStatistics.drawCallConstantRangeCount = rangeCount;
+		io_renderStatistics.isDrawCallConstantUploadSkipped = (byteCount_uploaded == 0);
+		io_renderStatistics.constantDataByteCount_uploaded += byteCount_uploaded;
+
+		return eae6320::Results::Success;
+	}
+}
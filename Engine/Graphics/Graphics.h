@@ -10,8 +10,10 @@
 
 #include "Configuration.h"
 #include "cEffect.h"
+#include "cMaterial.h"
 #include "cMesh.h"
 #include "ConstantBufferFormats.h"
+#include "FrustumCulling.h"
 
 #include <cstdint>
 #include <Engine/Results/Results.h>
@@ -44,15 +46,70 @@ namespace eae6320
 		void SubmitCamera(const Math::cMatrix_transformation i_transform_worldToCamera, const Math::cMatrix_transformation i_transform_cameraToProjected);
 
 		//one effect with multiple meshes using it.
+		// (The draw call has plain pointers and doesn't hold references to the effect, material, or mesh;
+		// see the asset lifetime functions below)
+		// If the draw call has a material then the material's effect is used and m_effect is ignored;
+		// otherwise the draw call uses the default material (ConstantBufferFormats::sMaterial's default values)
 		struct sEffectDrawCallAndMesh
 		{
 			eae6320::Graphics::cEffect* m_effect = nullptr;
 			eae6320::Graphics::ConstantBufferFormats::sDrawCall m_constantData_drawCall;
 			eae6320::Graphics::cMesh* m_mesh = nullptr;
+			eae6320::Graphics::cMaterial* m_material = nullptr;
 		};
 
+		// Reserves space for draw calls in the frame currently being submitted
+		// and returns a pointer to the first one (or NULL if memory couldn't be allocated).
+		// The memory is owned by the graphics system and is reused every frame;
+		// the returned pointer is only valid until the next call to AllocateDrawCalls()
+		// or until SignalThatAllDataForAFrameHasBeenSubmitted() is called
+		sEffectDrawCallAndMesh* AllocateDrawCalls( const unsigned int i_count );
 		// Submit Effects and Meshes
-		void SubmitEffectsDrawCallsAndMeshes(sEffectDrawCallAndMesh* i_effectsDrawCallsAndMeshes, const int i_effectsDrawCallsAndMeshesCount);
+		// (the draw calls are copied into the current frame;
+		// the caller still owns the array that is passed in)
+		void SubmitEffectsDrawCallsAndMeshes(const sEffectDrawCallAndMesh* i_effectsDrawCallsAndMeshes, const int i_effectsDrawCallsAndMeshesCount);
+		// Submit many instances of the same mesh drawn with the same effect.
+		// The instances' transforms are uploaded with a single buffer write and drawn with a single instanced draw call
+		// (or a few if there are more than ConstantBufferFormats::maxInstanceCountPerDrawCall).
+		// The effect must use a vertex shader that reads the instance transforms
+		// (e.g. the INSTANCED variant of Shaders/Vertex/standard.shader).
+		// The transforms are copied;
+		// the effect and mesh aren't referenced (see the asset lifetime functions below)
+		void SubmitInstancedDrawCalls(cEffect* const i_effect, cMesh* const i_mesh,
+			const ConstantBufferFormats::sDrawCall* const i_instances, const unsigned int i_instanceCount);
+		// Every instance uses the material (and the material's effect)
+		void SubmitInstancedDrawCalls(cMaterial* const i_material, cMesh* const i_mesh,
+			const ConstantBufferFormats::sDrawCall* const i_instances, const unsigned int i_instanceCount);
+
+		// Frustum Culling
+		//----------------
+
+		// These are the same as the submission functions above
+		// except that a draw call (or an instance) is only submitted
+		// if its mesh's bounding sphere is at least partly inside of the frustum
+		// (e.g. the frustum from GameObjects::cCamera::GetFrustum()).
+		// The spheres are tested four at a time (see FrustumCulling.h)
+		void SubmitVisibleEffectsDrawCallsAndMeshes( const sEffectDrawCallAndMesh* const i_effectsDrawCallsAndMeshes, const unsigned int i_count,
+			const FrustumCulling::sFrustum& i_frustum );
+		void SubmitVisibleInstancedDrawCalls( cEffect* const i_effect, cMesh* const i_mesh,
+			const ConstantBufferFormats::sDrawCall* const i_instances, const unsigned int i_instanceCount, const FrustumCulling::sFrustum& i_frustum );
+		void SubmitVisibleInstancedDrawCalls( cMaterial* const i_material, cMesh* const i_mesh,
+			const ConstantBufferFormats::sDrawCall* const i_instances, const unsigned int i_instanceCount, const FrustumCulling::sFrustum& i_frustum );
+
+		// Asset Lifetime
+		//---------------
+
+		// Submitting a draw call doesn't change the reference counts of its effect, material, and mesh,
+		// and so the application must keep them alive until every frame that they were submitted in has been rendered.
+		// Instead of calling DecrementReferenceCount() on an effect, material, or mesh that might have been submitted
+		// the application should pass its reference to one of these functions
+		// (the pointer is set to NULL).
+		// The reference is released once the frame currently being submitted (and every one before it) has been rendered,
+		// which costs one queue entry per released asset instead of reference counting every draw call of every frame.
+		// An asset must not be submitted after its reference has been given away
+		void ReleaseAfterInFlightFramesHaveBeenRendered( cEffect*& io_effect );
+		void ReleaseAfterInFlightFramesHaveBeenRendered( cMaterial*& io_material );
+		void ReleaseAfterInFlightFramesHaveBeenRendered( cMesh*& io_mesh );
 
 		// When the application is ready to submit data for a new frame
 		// it should call this before submitting anything
@@ -74,6 +131,73 @@ namespace eae6320
 		void RenderFrameSpecifics2();
 
 
+		// Statistics
+		//-----------
+
+		// This returns how many times the per-frame draw call memory has had to be allocated from the heap
+		// (once the memory has grown large enough for a typical frame this should stop changing)
+		uint64_t GetDrawCallHeapAllocationCount();
+
+		// Draw calls are sorted before they are rendered,
+		// and a bind is skipped when it would bind the same thing as the previous draw call
+		struct sRenderStatistics
+		{
+			// This counts every draw call made to the GPU (an instanced draw call counts once)
+			uint32_t drawCallCount = 0;
+			uint32_t instancedDrawCallCount = 0;
+			uint32_t instanceCount = 0;
+			uint32_t effectBindsIssued = 0;
+			uint32_t effectBindsSkipped = 0;
+			uint32_t meshBindsIssued = 0;
+			uint32_t meshBindsSkipped = 0;
+			// The material constant buffer is only updated when the material changes
+			// (draw calls without a material all share the default material)
+			uint32_t materialUpdatesIssued = 0;
+			uint32_t materialUpdatesSkipped = 0;
+			// The constant data of every (non-instanced) draw call is copied to the GPU with a single upload
+			// into a range of the draw call constant buffer ring;
+			// draw calls next to each other with identical data share a range
+			// and the upload is skipped entirely if every range is the same as the previous upload
+			uint32_t drawCallConstantRangeCount = 0;
+			uint32_t drawCallConstantRangesShared = 0;
+			uint32_t drawCallConstantBindsSkipped = 0;
+			bool isDrawCallConstantUploadSkipped = false;
+			// How many bytes of constant data (of every type) were copied to the GPU
+			uint64_t constantDataByteCount_uploaded = 0;
+		};
+		// This returns the statistics of the most recently rendered frame
+		sRenderStatistics GetRenderStatistics();
+
+		// Culling happens on the application loop thread while a frame is being submitted
+		struct sCullingStatistics
+		{
+			// Every draw call and every instance counts once
+			uint32_t testedCount = 0;
+			uint32_t visibleCount = 0;
+			uint32_t culledCount = 0;
+			// How long culling took (including calculating the world-space bounding spheres)
+			double cullingSeconds = 0.0;
+		};
+		// This returns the statistics of the most recently submitted frame
+		sCullingStatistics GetCullingStatistics();
+
+		// The application loop thread and the render thread only wait for each other
+		// when the application is EAE6320_GRAPHICS_SUBMISSIONFRAMECOUNT - 1 frames ahead
+		// or when the renderer has rendered everything that was submitted
+		struct sSubmissionStatistics
+		{
+			// How long each thread waited for the other one before its most recent frame
+			double applicationThreadWaitSeconds_lastFrame = 0.0;
+			double renderThreadWaitSeconds_lastFrame = 0.0;
+			// How long each thread has waited in total
+			// (dividing by the frame counts gives the average wait per frame)
+			double applicationThreadWaitSeconds_total = 0.0;
+			double renderThreadWaitSeconds_total = 0.0;
+			uint64_t submittedFrameCount = 0;
+			uint64_t renderedFrameCount = 0;
+		};
+		sSubmissionStatistics GetSubmissionStatistics();
+
 		// Initialize / Clean Up
 		//----------------------
 
@@ -86,6 +210,11 @@ namespace eae6320
 	#elif defined( EAE6320_PLATFORM_GL )
 			HINSTANCE thisInstanceOfTheApplication = NULL;
 	#endif
+#endif
+#if defined( EAE6320_PLATFORM_SOFTWARE )
+			// The software platform renders into its own buffers
+			// (there might not be a window to get the size from)
+			uint16_t resolutionWidth = 0, resolutionHeight = 0;
 #endif
 		};
 
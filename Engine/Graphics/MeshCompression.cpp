@@ -0,0 +1,467 @@
+// Includes
+//=========
+
+#include "MeshCompression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// Every block decodes to at most this many bytes
+	// (this keeps the scratch buffer in cache and the LZ offsets in 16 bits)
+	constexpr size_t s_maxBlockSize = 64 * 1024;
+	constexpr auto s_wordCountPerVertex = sizeof( eae6320::Graphics::VertexFormats::sVertex_mesh ) / sizeof( uint16_t );
+	static_assert( ( sizeof( eae6320::Graphics::VertexFormats::sVertex_mesh ) % sizeof( uint16_t ) ) == 0,
+		"Vertices are encoded as 16 bit elements" );
+	constexpr auto s_vertexCountPerBlock = static_cast<uint32_t>( s_maxBlockSize / sizeof( eae6320::Graphics::VertexFormats::sVertex_mesh ) );
+	// An index takes at most 5 bytes
+	constexpr size_t s_maxVarintSize = 5;
+	constexpr auto s_indexCountPerBlock = static_cast<uint32_t>( s_maxBlockSize / s_maxVarintSize );
+
+	// Blocks
+	//-------
+
+	// Each block starts with the size that it is in the file and the size that it decodes to
+	// (if the two are the same then the block wasn't compressed)
+	constexpr size_t s_blockHeaderSize = 2 * sizeof( uint32_t );
+	void AppendBlock( const uint8_t* const i_data, const size_t i_size, std::vector<uint8_t>& io_encoded );
+	// o_data points either into the encoded data or into io_scratch (which must be s_maxBlockSize bytes)
+	bool ReadBlock( const uint8_t*& io_encoded, const uint8_t* const i_encodedEnd, uint8_t* const io_scratch,
+		const uint8_t*& o_data, size_t& o_size );
+
+	// LZ
+	//---
+
+	// Each sequence is:
+	//	* A token byte (the high nibble is the literal count and the low nibble is the match length minus 4;
+	//		15 means that more bytes follow that are added until one isn't 255)
+	//	* The literal bytes
+	//	* The match offset (2 bytes, little-endian)
+	// The last sequence of a block ends after its literals
+	constexpr size_t s_minMatchLength = 4;
+	void CompressLz( const uint8_t* const i_data, const size_t i_size, std::vector<uint8_t>& io_compressed );
+	bool DecompressLz( const uint8_t* const i_compressed, const size_t i_compressedSize, uint8_t* const o_data, const size_t i_size );
+
+	// Integers
+	//---------
+
+	// ZigZag encoding stores small negative differences as small positive numbers
+	// (0, -1, 1, -2, 2, ... become 0, 1, 2, 3, 4, ...)
+	uint16_t ZigZag( const uint16_t i_difference );
+	uint16_t UnZigZag( const uint16_t i_value );
+	uint32_t ZigZag( const uint32_t i_difference );
+	uint32_t UnZigZag( const uint32_t i_value );
+	// Each byte holds 7 bits, and the high bit is set when another byte follows
+	void AppendVarint( uint32_t i_value, std::vector<uint8_t>& io_data );
+	bool ReadVarint( const uint8_t*& io_data, const uint8_t* const i_end, uint32_t& o_value );
+}
+
+// Interface
+//==========
+
+// Encoding
+//---------
+
+void eae6320::Graphics::MeshCompression::EncodeVertices( const VertexFormats::sVertex_mesh* const i_vertices, const uint32_t i_vertexCount,
+	std::vector<uint8_t>& io_encoded )
+{
+	EAE6320_ASSERT( ( i_vertices != nullptr ) || ( i_vertexCount == 0 ) );
+	uint16_t previousWords[s_wordCountPerVertex] = {};
+	std::vector<uint8_t> block;
+	for ( uint32_t firstVertex = 0; firstVertex < i_vertexCount; firstVertex += s_vertexCountPerBlock )
+	{
+		const auto vertexCount = std::min( s_vertexCountPerBlock, i_vertexCount - firstVertex );
+		block.resize( static_cast<size_t>( vertexCount ) * sizeof( *i_vertices ) );
+		// The low bytes of a word for every vertex are followed by the high bytes of the word for every vertex
+		for ( uint32_t i = 0; i < vertexCount; ++i )
+		{
+			uint16_t words[s_wordCountPerVertex];
+			memcpy( words, &i_vertices[firstVertex + i], sizeof( words ) );
+			for ( size_t j = 0; j < s_wordCountPerVertex; ++j )
+			{
+				const auto value = ZigZag( static_cast<uint16_t>( words[j] - previousWords[j] ) );
+				previousWords[j] = words[j];
+				block[( ( ( j * 2 ) + 0 ) * vertexCount ) + i] = static_cast<uint8_t>( value & 0xff );
+				block[( ( ( j * 2 ) + 1 ) * vertexCount ) + i] = static_cast<uint8_t>( value >> 8 );
+			}
+		}
+		AppendBlock( block.data(), block.size(), io_encoded );
+	}
+}
+
+void eae6320::Graphics::MeshCompression::EncodeIndices( const uint32_t* const i_indices, const uint32_t i_indexCount, std::vector<uint8_t>& io_encoded )
+{
+	EAE6320_ASSERT( ( i_indices != nullptr ) || ( i_indexCount == 0 ) );
+	uint32_t previousIndex = 0;
+	std::vector<uint8_t> block;
+	for ( uint32_t firstIndex = 0; firstIndex < i_indexCount; firstIndex += s_indexCountPerBlock )
+	{
+		const auto indexCount = std::min( s_indexCountPerBlock, i_indexCount - firstIndex );
+		block.clear();
+		for ( uint32_t i = 0; i < indexCount; ++i )
+		{
+			const auto index = i_indices[firstIndex + i];
+			AppendVarint( ZigZag( index - previousIndex ), block );
+			previousIndex = index;
+		}
+		EAE6320_ASSERT( block.size() <= s_maxBlockSize );
+		AppendBlock( block.data(), block.size(), io_encoded );
+	}
+}
+
+// Decoding
+//---------
+
+eae6320::cResult eae6320::Graphics::MeshCompression::DecodeVertices( const void* const i_encoded, const size_t i_encodedSize,
+	VertexFormats::sVertex_mesh* const o_vertices, const uint32_t i_vertexCount )
+{
+	EAE6320_ASSERT( ( o_vertices != nullptr ) || ( i_vertexCount == 0 ) );
+	auto* encoded = static_cast<const uint8_t*>( i_encoded );
+	const auto* const encodedEnd = encoded + i_encodedSize;
+	std::vector<uint8_t> scratch( s_maxBlockSize );
+	uint16_t previousWords[s_wordCountPerVertex] = {};
+	for ( uint32_t firstVertex = 0; firstVertex < i_vertexCount; firstVertex += s_vertexCountPerBlock )
+	{
+		const auto vertexCount = std::min( s_vertexCountPerBlock, i_vertexCount - firstVertex );
+		const uint8_t* block;
+		size_t blockSize;
+		if ( !ReadBlock( encoded, encodedEnd, scratch.data(), block, blockSize )
+			|| ( blockSize != ( static_cast<size_t>( vertexCount ) * sizeof( *o_vertices ) ) ) )
+		{
+			return Results::InvalidFile;
+		}
+		for ( uint32_t i = 0; i < vertexCount; ++i )
+		{
+			uint16_t words[s_wordCountPerVertex];
+			for ( size_t j = 0; j < s_wordCountPerVertex; ++j )
+			{
+				const auto value = static_cast<uint16_t>( block[( ( ( j * 2 ) + 0 ) * vertexCount ) + i]
+					| ( block[( ( ( j * 2 ) + 1 ) * vertexCount ) + i] << 8 ) );
+				words[j] = previousWords[j] = static_cast<uint16_t>( previousWords[j] + UnZigZag( value ) );
+			}
+			memcpy( &o_vertices[firstVertex + i], words, sizeof( words ) );
+		}
+	}
+	return ( encoded == encodedEnd ) ? Results::Success : Results::InvalidFile;
+}
+
+eae6320::cResult eae6320::Graphics::MeshCompression::DecodeIndices( const void* const i_encoded, const size_t i_encodedSize,
+	void* const o_indices, const uint32_t i_indexCount, const unsigned int i_indexSize, const uint32_t i_vertexCount )
+{
+	EAE6320_ASSERT( ( o_indices != nullptr ) || ( i_indexCount == 0 ) );
+	EAE6320_ASSERT( ( i_indexSize == sizeof( uint16_t ) ) || ( i_indexSize == sizeof( uint32_t ) ) );
+	auto* encoded = static_cast<const uint8_t*>( i_encoded );
+	const auto* const encodedEnd = encoded + i_encodedSize;
+	std::vector<uint8_t> scratch( s_maxBlockSize );
+	const auto maxIndex = ( i_indexSize == sizeof( uint16_t ) ) ? uint32_t( UINT16_MAX ) : UINT32_MAX;
+	uint32_t previousIndex = 0;
+	for ( uint32_t firstIndex = 0; firstIndex < i_indexCount; firstIndex += s_indexCountPerBlock )
+	{
+		const auto indexCount = std::min( s_indexCountPerBlock, i_indexCount - firstIndex );
+		const uint8_t* block;
+		size_t blockSize;
+		if ( !ReadBlock( encoded, encodedEnd, scratch.data(), block, blockSize ) )
+		{
+			return Results::InvalidFile;
+		}
+		const auto* const blockEnd = block + blockSize;
+		for ( uint32_t i = 0; i < indexCount; ++i )
+		{
+			uint32_t value;
+			if ( !ReadVarint( block, blockEnd, value ) )
+			{
+				return Results::InvalidFile;
+			}
+			const auto index = previousIndex + UnZigZag( value );
+			if ( ( index > maxIndex ) || ( index >= i_vertexCount ) )
+			{
+				return Results::InvalidFile;
+			}
+			previousIndex = index;
+			if ( i_indexSize == sizeof( uint16_t ) )
+			{
+				static_cast<uint16_t*>( o_indices )[firstIndex + i] = static_cast<uint16_t>( index );
+			}
+			else
+			{
+				static_cast<uint32_t*>( o_indices )[firstIndex + i] = index;
+			}
+		}
+		if ( block != blockEnd )
+		{
+			return Results::InvalidFile;
+		}
+	}
+	return ( encoded == encodedEnd ) ? Results::Success : Results::InvalidFile;
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	// Blocks
+	//-------
+
+	void AppendBlock( const uint8_t* const i_data, const size_t i_size, std::vector<uint8_t>& io_encoded )
+	{
+		EAE6320_ASSERT( i_size <= s_maxBlockSize );
+		std::vector<uint8_t> compressed;
+		CompressLz( i_data, i_size, compressed );
+		// A compressed block is always smaller than its data,
+		// and so a block that is the same size can only be uncompressed
+		const auto isCompressed = compressed.size() < i_size;
+		const uint32_t sizes[2] = { static_cast<uint32_t>( isCompressed ? compressed.size() : i_size ), static_cast<uint32_t>( i_size ) };
+		static_assert( sizeof( sizes ) == s_blockHeaderSize, "The block header is two sizes" );
+		const auto* const header = reinterpret_cast<const uint8_t*>( sizes );
+		io_encoded.insert( io_encoded.end(), header, header + sizeof( sizes ) );
+		if ( isCompressed )
+		{
+			io_encoded.insert( io_encoded.end(), compressed.begin(), compressed.end() );
+		}
+		else
+		{
+			io_encoded.insert( io_encoded.end(), i_data, i_data + i_size );
+		}
+	}
+
+	bool ReadBlock( const uint8_t*& io_encoded, const uint8_t* const i_encodedEnd, uint8_t* const io_scratch,
+		const uint8_t*& o_data, size_t& o_size )
+	{
+		if ( static_cast<size_t>( i_encodedEnd - io_encoded ) < s_blockHeaderSize )
+		{
+			return false;
+		}
+		uint32_t sizes[2];
+		memcpy( sizes, io_encoded, sizeof( sizes ) );
+		io_encoded += sizeof( sizes );
+		const size_t encodedSize = sizes[0], decodedSize = sizes[1];
+		if ( ( decodedSize > s_maxBlockSize ) || ( encodedSize > decodedSize )
+			|| ( encodedSize > static_cast<size_t>( i_encodedEnd - io_encoded ) ) )
+		{
+			return false;
+		}
+		if ( encodedSize == decodedSize )
+		{
+			// Uncompressed blocks are read from where they are
+			o_data = io_encoded;
+		}
+		else
+		{
+			if ( !DecompressLz( io_encoded, encodedSize, io_scratch, decodedSize ) )
+			{
+				return false;
+			}
+			o_data = io_scratch;
+		}
+		o_size = decodedSize;
+		io_encoded += encodedSize;
+		return true;
+	}
+
+	// LZ
+	//---
+
+	void AppendLength( size_t i_length, std::vector<uint8_t>& io_compressed )
+	{
+		while ( i_length >= 255 )
+		{
+			io_compressed.push_back( 255 );
+			i_length -= 255;
+		}
+		io_compressed.push_back( static_cast<uint8_t>( i_length ) );
+	}
+
+	void AppendSequence( const uint8_t* const i_literals, const size_t i_literalCount, const size_t i_matchOffset, const size_t i_matchLength,
+		std::vector<uint8_t>& io_compressed )
+	{
+		const auto isLast = ( i_matchLength == 0 );
+		const auto matchLengthCode = isLast ? 0 : ( i_matchLength - s_minMatchLength );
+		io_compressed.push_back( static_cast<uint8_t>( ( std::min<size_t>( i_literalCount, 15 ) << 4 ) | std::min<size_t>( matchLengthCode, 15 ) ) );
+		if ( i_literalCount >= 15 )
+		{
+			AppendLength( i_literalCount - 15, io_compressed );
+		}
+		io_compressed.insert( io_compressed.end(), i_literals, i_literals + i_literalCount );
+		if ( !isLast )
+		{
+			io_compressed.push_back( static_cast<uint8_t>( i_matchOffset & 0xff ) );
+			io_compressed.push_back( static_cast<uint8_t>( i_matchOffset >> 8 ) );
+			if ( matchLengthCode >= 15 )
+			{
+				AppendLength( matchLengthCode - 15, io_compressed );
+			}
+		}
+	}
+
+	void CompressLz( const uint8_t* const i_data, const size_t i_size, std::vector<uint8_t>& io_compressed )
+	{
+		// Each 4 byte sequence is hashed to remember the last place that it was seen
+		// (only the most recent place is remembered, which is greedy but fast)
+		constexpr unsigned int hashBitCount = 14;
+		std::vector<int32_t> lastPositions( size_t( 1 ) << hashBitCount, -1 );
+		size_t literalStart = 0;
+		size_t position = 0;
+		while ( ( position + s_minMatchLength ) <= i_size )
+		{
+			uint32_t sequence;
+			memcpy( &sequence, i_data + position, sizeof( sequence ) );
+			const auto hash = ( sequence * 2654435761u ) >> ( 32 - hashBitCount );
+			const auto candidate = lastPositions[hash];
+			lastPositions[hash] = static_cast<int32_t>( position );
+			if ( ( candidate >= 0 ) && ( ( position - static_cast<size_t>( candidate ) ) <= UINT16_MAX )
+				&& ( memcmp( i_data + candidate, i_data + position, s_minMatchLength ) == 0 ) )
+			{
+				auto matchLength = s_minMatchLength;
+				while ( ( ( position + matchLength ) < i_size ) && ( i_data[candidate + matchLength] == i_data[position + matchLength] ) )
+				{
+					++matchLength;
+				}
+				AppendSequence( i_data + literalStart, position - literalStart, position - static_cast<size_t>( candidate ), matchLength, io_compressed );
+				position += matchLength;
+				literalStart = position;
+			}
+			else
+			{
+				++position;
+			}
+		}
+		AppendSequence( i_data + literalStart, i_size - literalStart, 0, 0, io_compressed );
+	}
+
+	bool ReadLength( const uint8_t*& io_compressed, const uint8_t* const i_end, size_t& io_length )
+	{
+		uint8_t byte;
+		do
+		{
+			if ( io_compressed >= i_end )
+			{
+				return false;
+			}
+			byte = *io_compressed++;
+			io_length += byte;
+		} while ( byte == 255 );
+		return true;
+	}
+
+	bool DecompressLz( const uint8_t* const i_compressed, const size_t i_compressedSize, uint8_t* const o_data, const size_t i_size )
+	{
+		const auto* input = i_compressed;
+		const auto* const inputEnd = i_compressed + i_compressedSize;
+		auto* output = o_data;
+		const auto* const outputEnd = o_data + i_size;
+		while ( input < inputEnd )
+		{
+			const auto token = *input++;
+			// Literals
+			size_t literalCount = token >> 4;
+			if ( ( literalCount == 15 ) && !ReadLength( input, inputEnd, literalCount ) )
+			{
+				return false;
+			}
+			if ( ( literalCount > static_cast<size_t>( inputEnd - input ) ) || ( literalCount > static_cast<size_t>( outputEnd - output ) ) )
+			{
+				return false;
+			}
+			memcpy( output, input, literalCount );
+			input += literalCount;
+			output += literalCount;
+			if ( input == inputEnd )
+			{
+				break;
+			}
+			// Match
+			if ( ( inputEnd - input ) < 2 )
+			{
+				return false;
+			}
+			const size_t offset = input[0] | ( input[1] << 8 );
+			input += 2;
+			size_t matchLength = token & 0xf;
+			if ( ( matchLength == 15 ) && !ReadLength( input, inputEnd, matchLength ) )
+			{
+				return false;
+			}
+			matchLength += s_minMatchLength;
+			if ( ( offset == 0 ) || ( offset > static_cast<size_t>( output - o_data ) ) || ( matchLength > static_cast<size_t>( outputEnd - output ) ) )
+			{
+				return false;
+			}
+			const auto* match = output - offset;
+			if ( offset >= matchLength )
+			{
+				memcpy( output, match, matchLength );
+				output += matchLength;
+			}
+			else
+			{
+				// An overlapping match repeats the bytes that it is copying
+				for ( size_t i = 0; i < matchLength; ++i )
+				{
+					*output++ = *match++;
+				}
+			}
+		}
+		return output == outputEnd;
+	}
+
+	// Integers
+	//---------
+
+	uint16_t ZigZag( const uint16_t i_difference )
+	{
+		const auto difference = static_cast<int16_t>( i_difference );
+		// (the unsigned value is shifted because left-shifting a negative number is undefined)
+		return static_cast<uint16_t>( static_cast<uint16_t>( i_difference << 1 ) ^ static_cast<uint16_t>( difference >> 15 ) );
+	}
+
+	uint16_t UnZigZag( const uint16_t i_value )
+	{
+		return static_cast<uint16_t>( ( i_value >> 1 ) ^ static_cast<uint16_t>( -static_cast<int>( i_value & 1 ) ) );
+	}
+
+	uint32_t ZigZag( const uint32_t i_difference )
+	{
+		const auto difference = static_cast<int32_t>( i_difference );
+		return ( static_cast<uint32_t>( difference ) << 1 ) ^ static_cast<uint32_t>( difference >> 31 );
+	}
+
+	uint32_t UnZigZag( const uint32_t i_value )
+	{
+		return ( i_value >> 1 ) ^ ( 0u - ( i_value & 1 ) );
+	}
+
+	void AppendVarint( uint32_t i_value, std::vector<uint8_t>& io_data )
+	{
+		while ( i_value >= 0x80 )
+		{
+			io_data.push_back( static_cast<uint8_t>( i_value | 0x80 ) );
+			i_value >>= 7;
+		}
+		io_data.push_back( static_cast<uint8_t>( i_value ) );
+	}
+
+	bool ReadVarint( const uint8_t*& io_data, const uint8_t* const i_end, uint32_t& o_value )
+	{
+		o_value = 0;
+		for ( unsigned int shift = 0; shift < ( s_maxVarintSize * 7 ); shift += 7 )
+		{
+			if ( io_data >= i_end )
+			{
+				return false;
+			}
+			const auto byte = *io_data++;
+			o_value |= static_cast<uint32_t>( byte & 0x7f ) << shift;
+			if ( ( byte & 0x80 ) == 0 )
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
@@ -0,0 +1,63 @@
+/*
+	These functions compress the geometry of a mesh file
+	(MeshBuilder encodes it and cMesh decodes it; see MeshFormats::eEncoding)
+
+	Each section is a series of blocks that are small enough to decode in cache:
+		* Vertices are stored as the difference from the previous vertex, one 16 bit element at a time,
+			and the low and high bytes of each element are grouped together
+			(vertices that are next to each other in the file are usually close together in the mesh,
+			and so most of the high bytes are zero)
+		* Indices are stored as the difference from the previous index in a variable number of bytes
+			(after the vertices have been reordered for fetching most differences fit in a single byte)
+		* Each block is then compressed with a small LZ compressor
+			(a block that doesn't get smaller is stored as it is)
+
+	Decoding is a single pass over the file's data:
+	each block is decompressed into a small scratch buffer
+	and then the vertices or indices are written straight to where the graphics API will read them from.
+*/
+
+#ifndef EAE6320_GRAPHICS_MESHCOMPRESSION_H
+#define EAE6320_GRAPHICS_MESHCOMPRESSION_H
+
+// Includes
+//=========
+
+#include "VertexFormats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace MeshCompression
+		{
+			// Encoding
+			//---------
+
+			// The encoded data is appended to io_encoded
+			void EncodeVertices( const VertexFormats::sVertex_mesh* const i_vertices, const uint32_t i_vertexCount, std::vector<uint8_t>& io_encoded );
+			void EncodeIndices( const uint32_t* const i_indices, const uint32_t i_indexCount, std::vector<uint8_t>& io_encoded );
+
+			// Decoding
+			//---------
+
+			// These fail (instead of reading or writing out of bounds) if the encoded data is corrupt
+			cResult DecodeVertices( const void* const i_encoded, const size_t i_encodedSize,
+				VertexFormats::sVertex_mesh* const o_vertices, const uint32_t i_vertexCount );
+			// The indices are written as uint16_t or uint32_t depending on i_indexSize
+			// (every index must refer to one of the i_vertexCount vertices)
+			cResult DecodeIndices( const void* const i_encoded, const size_t i_encodedSize,
+				void* const o_indices, const uint32_t i_indexCount, const unsigned int i_indexSize, const uint32_t i_vertexCount );
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_MESHCOMPRESSION_H
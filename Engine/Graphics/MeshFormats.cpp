@@ -0,0 +1,109 @@
+// Includes
+//=========
+
+#include "MeshFormats.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <sstream>
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Graphics::MeshFormats::GetSections( const void* const i_data, const size_t i_size, sSections& o_sections,
+	std::string* const o_errorMessage )
+{
+	o_sections = sSections();
+
+	const auto address = reinterpret_cast<uintptr_t>( i_data );
+	if ( ( i_data == nullptr ) || ( ( address % alignof( sHeader ) ) != 0 ) )
+	{
+		EAE6320_ASSERTF( ( address % alignof( sHeader ) ) == 0, "Mesh data must be aligned to %u bytes", static_cast<unsigned int>( alignof( sHeader ) ) );
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = ( i_data == nullptr ) ? "The mesh file is empty" : "The mesh data isn't aligned";
+		}
+		return Results::InvalidFile;
+	}
+	if ( i_size < sizeof( sHeader ) )
+	{
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The mesh file is " << i_size << " bytes, which is too small for a header";
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::InvalidFile;
+	}
+	const auto& header = *static_cast<const sHeader*>( i_data );
+	if ( ( header.identifier != fileIdentifier ) || ( header.version != fileVersion ) )
+	{
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The file isn't a version " << fileVersion << " mesh file (it must be rebuilt)";
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::InvalidFile;
+	}
+	if ( ( header.indexSize != sizeof( uint16_t ) ) && ( header.indexSize != sizeof( uint32_t ) ) )
+	{
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The mesh file's indices are " << header.indexSize << " bytes (they must be 2 or 4)";
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::InvalidFile;
+	}
+	if ( ( header.encoding != eEncoding::Raw ) && ( header.encoding != eEncoding::Compressed ) )
+	{
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The mesh file's encoding (" << static_cast<unsigned int>( header.encoding ) << ") isn't valid";
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::InvalidFile;
+	}
+	// The sizes are calculated with 64 bits so that a corrupt file can't make them wrap around
+	const auto vertexDataSize = uint64_t( header.vertexCount ) * sizeof( VertexFormats::sVertex_mesh );
+	const auto indexDataSize = uint64_t( header.indexCount ) * header.indexSize;
+	if ( ( header.encoding == eEncoding::Raw )
+		&& ( ( header.vertexSectionSize != vertexDataSize ) || ( header.indexSectionSize != indexDataSize ) ) )
+	{
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The mesh file's sections (" << header.vertexSectionSize << " and " << header.indexSectionSize
+				<< " bytes) aren't the size of " << header.vertexCount << " vertices and " << header.indexCount << " indices";
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::InvalidFile;
+	}
+	const auto vertexEnd = uint64_t( header.vertexOffset ) + header.vertexSectionSize;
+	const auto indexEnd = uint64_t( header.indexOffset ) + header.indexSectionSize;
+	if ( ( header.vertexOffset < sizeof( sHeader ) ) || ( ( header.vertexOffset % sectionAlignment ) != 0 )
+		|| ( header.indexOffset < vertexEnd ) || ( ( header.indexOffset % sectionAlignment ) != 0 )
+		|| ( indexEnd > i_size ) )
+	{
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The mesh file's sections (" << header.vertexSectionSize << " bytes at " << header.vertexOffset
+				<< " and " << header.indexSectionSize << " bytes at " << header.indexOffset << ") don't fit in its " << i_size << " bytes";
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::InvalidFile;
+	}
+
+	o_sections.header = &header;
+	o_sections.vertexSection = reinterpret_cast<const void*>( address + header.vertexOffset );
+	o_sections.indexSection = reinterpret_cast<const void*>( address + header.indexOffset );
+	if ( header.encoding == eEncoding::Raw )
+	{
+		o_sections.vertexData = static_cast<const VertexFormats::sVertex_mesh*>( o_sections.vertexSection );
+		o_sections.indexData = o_sections.indexSection;
+	}
+
+	return Results::Success;
+}
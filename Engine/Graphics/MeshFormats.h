@@ -0,0 +1,125 @@
+/*
+	This file defines the layout of the binary mesh files
+	that MeshBuilder writes and cMesh reads
+
+	A binary mesh file is:
+		* sHeader
+		* VertexFormats::sVertex_mesh[vertexCount] (at vertexOffset)
+		* uint16_t[indexCount] or uint32_t[indexCount] (at indexOffset; see sHeader::indexSize)
+	or, if the file is compressed (see eEncoding), the two sections are encoded by MeshCompression
+	and must be decoded before the geometry can be used.
+
+	Every section starts at an offset that is a multiple of sectionAlignment.
+	When the file is mapped into memory (see Platform::MapFile()) the start of the file is page-aligned,
+	and so the header and the sections can be used directly from the mapped pages
+	(the vertex and index data are given to the graphics API without being copied first).
+*/
+
+#ifndef EAE6320_GRAPHICS_MESHFORMATS_H
+#define EAE6320_GRAPHICS_MESHFORMATS_H
+
+// Includes
+//=========
+
+#include "VertexFormats.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <string>
+
+// Format Definitions
+//===================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace MeshFormats
+		{
+			// The bounds are in the mesh's local space
+			// and are calculated when the mesh is built so that they don't have to be calculated at run time
+			struct sBounds
+			{
+				// The sphere contains every vertex
+				// (it is what frustum culling tests because a sphere is the cheapest shape to test)
+				float sphereCenter[3] = {};
+				float sphereRadius = 0.0f;
+				// Axis-aligned bounding box
+				// (the vertex positions are stored as fractions of it; see VertexFormats::sVertex_mesh)
+				float aabbMin[3] = {};
+				float aabbMax[3] = {};
+			};
+			static_assert( sizeof( sBounds ) == ( 10 * sizeof( float ) ), "The bounds are read and written directly" );
+
+			// "MESH" when the file is viewed as text
+			constexpr uint32_t fileIdentifier = 0x4853454d;
+			// This changes whenever the layout does so that old files fail to load instead of being misread
+			constexpr uint16_t fileVersion = 4;
+			constexpr uint32_t sectionAlignment = 16;
+
+			// Every mesh uses the narrowest indices that can refer to all of its vertices
+			// (16-bit indices use half of the memory and bandwidth,
+			// but they can only refer to 65,536 vertices)
+			constexpr uint16_t SelectIndexSize( const uint32_t i_vertexCount )
+			{
+				return ( i_vertexCount <= ( uint32_t( UINT16_MAX ) + 1 ) ) ? uint16_t( sizeof( uint16_t ) ) : uint16_t( sizeof( uint32_t ) );
+			}
+
+			// How the vertex and index sections are stored
+			enum class eEncoding : uint16_t
+			{
+				// The sections can be given to the graphics API as they are
+				Raw,
+				// The sections are smaller on disk but must be decoded when they are loaded (see MeshCompression.h)
+				Compressed,
+			};
+
+			struct sHeader
+			{
+				uint32_t identifier = fileIdentifier;
+				uint16_t version = fileVersion;
+				// The size of each index in bytes (2 or 4)
+				uint16_t indexSize = sizeof( uint16_t );
+				uint32_t vertexCount = 0;
+				uint32_t indexCount = 0;
+				// The offsets are from the start of the file
+				uint32_t vertexOffset = 0;
+				uint32_t indexOffset = 0;
+				// The sizes of the sections in the file
+				uint32_t vertexSectionSize = 0;
+				uint32_t indexSectionSize = 0;
+				eEncoding encoding = eEncoding::Raw;
+				uint16_t unused = 0;
+				sBounds bounds;
+			};
+			static_assert( sizeof( sHeader ) == 76, "The header is read and written directly" );
+
+			constexpr uint32_t AlignSectionOffset( const uint32_t i_offset )
+			{
+				return ( i_offset + ( sectionAlignment - 1 ) ) & ~( sectionAlignment - 1 );
+			}
+
+			// Pointers to the parts of a mesh file that is in memory
+			// (they point into the file's data; nothing is copied)
+			struct sSections
+			{
+				const sHeader* header = nullptr;
+				// These are only set if the sections are raw
+				const VertexFormats::sVertex_mesh* vertexData = nullptr;
+				// The indices are uint16_t or uint32_t depending on header->indexSize
+				const void* indexData = nullptr;
+				// These are set whatever the encoding is
+				// (their sizes are header->vertexSectionSize and header->indexSectionSize)
+				const void* vertexSection = nullptr;
+				const void* indexSection = nullptr;
+			};
+			// Checks that the data is a complete mesh file and finds its sections
+			// (i_data must be aligned for sHeader, which both mapped files and allocated memory are)
+			cResult GetSections( const void* const i_data, const size_t i_size, sSections& o_sections,
+				std::string* const o_errorMessage = nullptr );
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_MESHFORMATS_H
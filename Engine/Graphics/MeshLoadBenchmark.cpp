@@ -0,0 +1,277 @@
+// Includes
+//=========
+
+#include "MeshLoadBenchmark.h"
+
+#include "MeshCompression.h"
+#include "MeshFormats.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Platform/Platform.h>
+#include <Engine/Time/Time.h>
+#include <new>
+#include <vector>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// The geometry is copied to where the graphics API would have copied it
+	void Upload( const eae6320::Graphics::MeshFormats::sSections& i_sections,
+		const eae6320::Graphics::VertexFormats::sVertex_mesh* const i_vertexData, const void* const i_indexData,
+		std::vector<uint8_t>& io_destination );
+	// Compressed geometry is decoded to wherever it is needed
+	eae6320::cResult Decode( const eae6320::Graphics::MeshFormats::sSections& i_sections,
+		eae6320::Graphics::VertexFormats::sVertex_mesh* const o_vertexData, void* const o_indexData );
+	// The geometry is uploaded from the sections if it is raw or decoded into the destination if it is compressed
+	eae6320::cResult UploadSections( const eae6320::Graphics::MeshFormats::sSections& i_sections, std::vector<uint8_t>& io_destination,
+		uint64_t& io_decodingTickCount );
+
+	eae6320::cResult LoadCopied( const std::string& i_path, std::vector<uint8_t>& io_destination, uint64_t& io_allocatedByteCount );
+	eae6320::cResult LoadMapped( const std::string& i_path, std::vector<uint8_t>& io_destination, uint64_t& io_decodingTickCount );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Graphics::MeshLoadBenchmark::Run( const std::string& i_directory, sResults& o_results, const unsigned int i_passCount )
+{
+	EAE6320_ASSERT( i_passCount > 0 );
+	auto result = Results::Success;
+
+	o_results = sResults();
+	o_results.passCount = i_passCount;
+
+	// Find the mesh files
+	std::vector<std::string> paths;
+	{
+		std::string errorMessage;
+		if ( !( result = Platform::GetFilesInDirectory( i_directory, paths, true, &errorMessage ) ) )
+		{
+			Logging::OutputError( "The mesh load benchmark couldn't find the files in \"%s\": %s", i_directory.c_str(), errorMessage.c_str() );
+			return result;
+		}
+		constexpr char extension[] = ".mesh";
+		constexpr auto extensionLength = sizeof( extension ) - 1;
+		paths.erase( std::remove_if( paths.begin(), paths.end(), [&extension, extensionLength]( const std::string& i_path )
+			{
+				return ( i_path.size() < extensionLength ) || ( i_path.compare( i_path.size() - extensionLength, extensionLength, extension ) != 0 );
+			} ), paths.end() );
+		if ( paths.empty() )
+		{
+			result = Results::FileDoesntExist;
+			Logging::OutputError( "The mesh load benchmark didn't find any mesh files in \"%s\"", i_directory.c_str() );
+			return result;
+		}
+		o_results.meshCount = static_cast<unsigned int>( paths.size() );
+	}
+	// Every file is loaded once without being timed
+	// so that both ways read the files from the file cache
+	// (this also checks that every file is valid and finds how big the destination must be)
+	std::vector<uint8_t> destination;
+	for ( const auto& path : paths )
+	{
+		Platform::sMappedFile file;
+		MeshFormats::sSections sections;
+		std::string errorMessage;
+		if ( !( result = Platform::MapFile( path.c_str(), file, &errorMessage ) )
+			|| !( result = MeshFormats::GetSections( file.data, file.size, sections, &errorMessage ) ) )
+		{
+			Logging::OutputError( "The mesh load benchmark couldn't load \"%s\": %s", path.c_str(), errorMessage.c_str() );
+			return result;
+		}
+		o_results.fileByteCount += file.size;
+		const auto geometryByteCount = ( sizeof( VertexFormats::sVertex_mesh ) * sections.header->vertexCount )
+			+ ( static_cast<size_t>( sections.header->indexSize ) * sections.header->indexCount );
+		if ( sections.header->encoding == MeshFormats::eEncoding::Compressed )
+		{
+			++o_results.compressedMeshCount;
+			o_results.compressedByteCount += uint64_t( sections.header->vertexSectionSize ) + sections.header->indexSectionSize;
+			o_results.decompressedByteCount += geometryByteCount;
+		}
+		destination.resize( std::max( destination.size(), geometryByteCount ) );
+		uint64_t decodingTickCount = 0;
+		if ( !( result = UploadSections( sections, destination, decodingTickCount ) ) )
+		{
+			Logging::OutputError( "The mesh load benchmark couldn't decode \"%s\"", path.c_str() );
+			return result;
+		}
+	}
+
+	// Copied
+	{
+		uint64_t allocatedByteCount = 0;
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		for ( unsigned int pass = 0; pass < i_passCount; ++pass )
+		{
+			for ( const auto& path : paths )
+			{
+				if ( !( result = LoadCopied( path, destination, allocatedByteCount ) ) )
+				{
+					Logging::OutputError( "The mesh load benchmark couldn't load and copy \"%s\"", path.c_str() );
+					return result;
+				}
+			}
+		}
+		o_results.secondsPerPass_copied = Time::ConvertTicksToSeconds( Time::GetCurrentSystemTimeTickCount() - tickCount_start ) / i_passCount;
+		o_results.allocatedBytesPerPass_copied = allocatedByteCount / i_passCount;
+	}
+	// Mapped
+	{
+		uint64_t decodingTickCount = 0;
+		const auto tickCount_start = Time::GetCurrentSystemTimeTickCount();
+		for ( unsigned int pass = 0; pass < i_passCount; ++pass )
+		{
+			for ( const auto& path : paths )
+			{
+				if ( !( result = LoadMapped( path, destination, decodingTickCount ) ) )
+				{
+					Logging::OutputError( "The mesh load benchmark couldn't map \"%s\"", path.c_str() );
+					return result;
+				}
+			}
+		}
+		o_results.secondsPerPass_mapped = Time::ConvertTicksToSeconds( Time::GetCurrentSystemTimeTickCount() - tickCount_start ) / i_passCount;
+		o_results.secondsPerPass_decoding = Time::ConvertTicksToSeconds( decodingTickCount ) / i_passCount;
+		o_results.allocatedBytesPerPass_mapped = 0;
+	}
+
+	return result;
+}
+
+void eae6320::Graphics::MeshLoadBenchmark::RunAndLog( const std::string& i_directory )
+{
+	sResults results;
+	if ( Run( i_directory, results ) )
+	{
+		Logging::OutputMessage( "Loading %u meshes (%.2f MB) from \"%s\": %.3f ms per pass copied (%.2f MB allocated),"
+			" %.3f ms per pass mapped (%.2f MB allocated)",
+			results.meshCount, static_cast<double>( results.fileByteCount ) / ( 1024.0 * 1024.0 ), i_directory.c_str(),
+			results.secondsPerPass_copied * 1000.0, static_cast<double>( results.allocatedBytesPerPass_copied ) / ( 1024.0 * 1024.0 ),
+			results.secondsPerPass_mapped * 1000.0, static_cast<double>( results.allocatedBytesPerPass_mapped ) / ( 1024.0 * 1024.0 ) );
+		if ( ( results.compressedMeshCount > 0 ) && ( results.secondsPerPass_decoding > 0.0 ) )
+		{
+			Logging::OutputMessage( "%u of the meshes are compressed (%.2f MB that decode to %.2f MB): Decoding at %.1f MB/s",
+				results.compressedMeshCount, static_cast<double>( results.compressedByteCount ) / ( 1024.0 * 1024.0 ),
+				static_cast<double>( results.decompressedByteCount ) / ( 1024.0 * 1024.0 ),
+				( static_cast<double>( results.decompressedByteCount ) / ( 1024.0 * 1024.0 ) ) / results.secondsPerPass_decoding );
+		}
+	}
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	void Upload( const eae6320::Graphics::MeshFormats::sSections& i_sections,
+		const eae6320::Graphics::VertexFormats::sVertex_mesh* const i_vertexData, const void* const i_indexData,
+		std::vector<uint8_t>& io_destination )
+	{
+		const auto vertexDataSize = sizeof( i_vertexData[0] ) * i_sections.header->vertexCount;
+		const auto indexDataSize = static_cast<size_t>( i_sections.header->indexSize ) * i_sections.header->indexCount;
+		EAE6320_ASSERT( ( vertexDataSize + indexDataSize ) <= io_destination.size() );
+		memcpy( io_destination.data(), i_vertexData, vertexDataSize );
+		memcpy( io_destination.data() + vertexDataSize, i_indexData, indexDataSize );
+	}
+
+	eae6320::cResult Decode( const eae6320::Graphics::MeshFormats::sSections& i_sections,
+		eae6320::Graphics::VertexFormats::sVertex_mesh* const o_vertexData, void* const o_indexData )
+	{
+		auto result = eae6320::Results::Success;
+		const auto& header = *i_sections.header;
+		if ( !( result = eae6320::Graphics::MeshCompression::DecodeVertices( i_sections.vertexSection, header.vertexSectionSize,
+			o_vertexData, header.vertexCount ) ) )
+		{
+			return result;
+		}
+		return eae6320::Graphics::MeshCompression::DecodeIndices( i_sections.indexSection, header.indexSectionSize,
+			o_indexData, header.indexCount, header.indexSize, header.vertexCount );
+	}
+
+	eae6320::cResult UploadSections( const eae6320::Graphics::MeshFormats::sSections& i_sections, std::vector<uint8_t>& io_destination,
+		uint64_t& io_decodingTickCount )
+	{
+		if ( i_sections.header->encoding == eae6320::Graphics::MeshFormats::eEncoding::Raw )
+		{
+			Upload( i_sections, i_sections.vertexData, i_sections.indexData, io_destination );
+			return eae6320::Results::Success;
+		}
+		const auto vertexDataSize = sizeof( eae6320::Graphics::VertexFormats::sVertex_mesh ) * i_sections.header->vertexCount;
+		const auto indexDataSize = static_cast<size_t>( i_sections.header->indexSize ) * i_sections.header->indexCount;
+		EAE6320_ASSERT( ( vertexDataSize + indexDataSize ) <= io_destination.size() );
+		const auto tickCount_start = eae6320::Time::GetCurrentSystemTimeTickCount();
+		// The destination is a byte vector, and so the vertices are decoded into it where they are aligned
+		const auto result = Decode( i_sections, reinterpret_cast<eae6320::Graphics::VertexFormats::sVertex_mesh*>( io_destination.data() ),
+			io_destination.data() + vertexDataSize );
+		io_decodingTickCount += eae6320::Time::GetCurrentSystemTimeTickCount() - tickCount_start;
+		return result;
+	}
+
+	eae6320::cResult LoadCopied( const std::string& i_path, std::vector<uint8_t>& io_destination, uint64_t& io_allocatedByteCount )
+	{
+		auto result = eae6320::Results::Success;
+
+		eae6320::Platform::sDataFromFile file;
+		if ( !( result = eae6320::Platform::LoadBinaryFile( i_path.c_str(), file ) ) )
+		{
+			return result;
+		}
+		eae6320::Graphics::MeshFormats::sSections sections;
+		if ( !( result = eae6320::Graphics::MeshFormats::GetSections( file.data, file.size, sections ) ) )
+		{
+			return result;
+		}
+		const auto vertexCount = sections.header->vertexCount;
+		const auto indexDataSize = static_cast<size_t>( sections.header->indexSize ) * sections.header->indexCount;
+		auto* const vertexData = new ( std::nothrow ) eae6320::Graphics::VertexFormats::sVertex_mesh[vertexCount];
+		auto* const indexData = new ( std::nothrow ) uint8_t[indexDataSize];
+		if ( vertexData && indexData )
+		{
+			if ( sections.header->encoding == eae6320::Graphics::MeshFormats::eEncoding::Compressed )
+			{
+				result = Decode( sections, vertexData, indexData );
+			}
+			else
+			{
+				memcpy( vertexData, sections.vertexData, sizeof( vertexData[0] ) * vertexCount );
+				memcpy( indexData, sections.indexData, indexDataSize );
+			}
+			if ( result )
+			{
+				Upload( sections, vertexData, indexData, io_destination );
+			}
+			io_allocatedByteCount += file.size + ( sizeof( vertexData[0] ) * vertexCount ) + indexDataSize;
+		}
+		else
+		{
+			result = eae6320::Results::OutOfMemory;
+		}
+		delete[] vertexData;
+		delete[] indexData;
+
+		return result;
+	}
+
+	eae6320::cResult LoadMapped( const std::string& i_path, std::vector<uint8_t>& io_destination, uint64_t& io_decodingTickCount )
+	{
+		auto result = eae6320::Results::Success;
+
+		eae6320::Platform::sMappedFile file;
+		if ( !( result = eae6320::Platform::MapFile( i_path.c_str(), file ) ) )
+		{
+			return result;
+		}
+		eae6320::Graphics::MeshFormats::sSections sections;
+		if ( !( result = eae6320::Graphics::MeshFormats::GetSections( file.data, file.size, sections ) ) )
+		{
+			return result;
+		}
+
+		return UploadSections( sections, io_destination, io_decodingTickCount );
+	}
+}
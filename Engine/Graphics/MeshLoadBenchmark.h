@@ -0,0 +1,69 @@
+/*
+	This benchmark measures how long it takes to get the geometry of every mesh file in a directory
+	to the point where it can be uploaded to the GPU
+
+	It is run two ways:
+		* Copied
+			(the file is read into allocated memory
+			and then the vertices and indices are copied into their own arrays,
+			which is how meshes used to be loaded)
+		* Mapped
+			(the file is mapped into memory and the sections are used where they are;
+			see cMesh::LoadMeshFromBinaryFile())
+	Both ways finish by copying the geometry into a single destination buffer
+	that stands in for the memory the graphics API copies it into,
+	and so the benchmark doesn't need a graphics device.
+	Compressed meshes (see MeshCompression.h) are decoded instead of being copied:
+	the copied way decodes into the arrays and the mapped way decodes straight into the destination,
+	and the time that the mapped way spends decoding is also reported as a decoding rate.
+	The files are read once before either way is timed,
+	and so it measures loading from the file cache rather than from the disk.
+*/
+
+#ifndef EAE6320_GRAPHICS_MESHLOADBENCHMARK_H
+#define EAE6320_GRAPHICS_MESHLOADBENCHMARK_H
+
+// Includes
+//=========
+
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <string>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace MeshLoadBenchmark
+		{
+			struct sResults
+			{
+				unsigned int meshCount = 0;
+				unsigned int compressedMeshCount = 0;
+				unsigned int passCount = 0;
+				uint64_t fileByteCount = 0;
+				// The compressed meshes' sections and the geometry that they decode to
+				uint64_t compressedByteCount = 0;
+				uint64_t decompressedByteCount = 0;
+				// The average time that the mapped way spent decoding every compressed mesh once
+				double secondsPerPass_decoding = 0.0;
+				// The average time to load every mesh once
+				double secondsPerPass_copied = 0.0;
+				double secondsPerPass_mapped = 0.0;
+				// How many bytes each way allocated from the heap per pass
+				uint64_t allocatedBytesPerPass_copied = 0;
+				uint64_t allocatedBytesPerPass_mapped = 0;
+			};
+
+			// Every file in the directory (and its subdirectories) whose extension is ".mesh" is loaded i_passCount times each way
+			cResult Run( const std::string& i_directory, sResults& o_results, const unsigned int i_passCount = 8 );
+			// Runs and logs the results
+			void RunAndLog( const std::string& i_directory );
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_MESHLOADBENCHMARK_H
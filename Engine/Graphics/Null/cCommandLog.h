@@ -0,0 +1,162 @@
+/*
+	The null graphics platform doesn't talk to a GPU.
+	Instead, every command that would have been sent to one is recorded in a command log
+	which can then be inspected (e.g. by a headless test or benchmark).
+	It is built by the Null|x64 configuration for headless runs on Windows
+	(machines without a GPU, like build servers);
+	the rest of the engine is still Windows-only, and so it doesn't make the engine run on other operating systems.
+
+	Commands that render a frame are recorded in order;
+	the commands of the most recently swapped frame can be copied out
+	while the render thread records the next one.
+	Commands that create objects can happen on any thread,
+	and so they are only included in the running totals
+	(this keeps the recorded frames deterministic).
+*/
+
+#ifndef EAE6320_GRAPHICS_NULL_CCOMMANDLOG_H
+#define EAE6320_GRAPHICS_NULL_CCOMMANDLOG_H
+
+// Includes
+//=========
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Concurrency/cMutex.h>
+#include <vector>
+
+// Command Types
+//==============
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		enum class eCommandType : uint8_t
+		{
+			// Object creation
+			//	(byteCount is how much memory was allocated)
+			CreateShader,
+			CreateEffect,
+			CreateConstantBuffer,
+			CreateMesh,
+
+			// Rendering
+			ClearBuffer,
+			//	(value is the render state bits)
+			BindRenderState,
+			BindEffect,
+			//	(value is the ConstantBufferTypes ID, byteCount is the offset of the range if the constant buffer is a ring)
+			BindConstantBuffer,
+			//	(value is the ConstantBufferTypes ID, byteCount is how many bytes were copied)
+			UpdateConstantBuffer,
+			BindMesh,
+			//	(value is the index count, byteCount is the size of the indices that were read)
+			Draw,
+			SwapBuffer,
+
+			Count
+		};
+
+		struct sCommand
+		{
+			eCommandType type = eCommandType::Count;
+			// The ID of the object that the command used
+			// (IDs are assigned when objects are created and are never 0)
+			uint32_t objectId = 0;
+			// The meaning of this depends on the command type (see eCommandType)
+			uint32_t value = 0;
+			// A draw that was expanded from an instanced draw records which instance it was
+			// (the null platform doesn't have instancing,
+			// and so an instanced draw is turned into one draw per instance)
+			uint32_t instanceIndex = 0;
+			uint64_t byteCount = 0;
+		};
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cCommandLog
+		{
+			// Interface
+			//==========
+
+		public:
+
+			struct sTotals
+			{
+				uint64_t commandCounts[static_cast<size_t>( eCommandType::Count )] = {};
+				uint64_t byteCounts[static_cast<size_t>( eCommandType::Count )] = {};
+				uint64_t frameCount = 0;
+			};
+
+			// Record
+			//-------
+
+			void Record( const eCommandType i_type, const uint32_t i_objectId,
+				const uint32_t i_value = 0, const uint64_t i_byteCount = 0, const uint32_t i_instanceIndex = 0 );
+			// The commands recorded since the last call become the last frame's commands
+			void EndFrame();
+
+			// Every object that a command can refer to gets an ID from this
+			uint32_t GenerateObjectId();
+
+			// Access
+			//-------
+
+			// Copies the commands of the last frame that was swapped
+			// (the vector's memory is reused if it is already big enough)
+			void GetCommands_lastFrame( std::vector<sCommand>& o_commands ) const;
+			sTotals GetTotals() const;
+			// The totals of only the rendering commands of the last frame that was swapped
+			// (e.g. byteCounts[UpdateConstantBuffer] is how many bytes of constant data the frame uploaded)
+			sTotals GetTotals_lastFrame() const;
+
+			// Initialize / Clean Up
+			//----------------------
+
+			// Forgets every recorded command and total
+			// (object IDs keep increasing so that they stay unique)
+			void Reset();
+
+			cCommandLog() = default;
+
+			// Data
+			//=====
+
+		private:
+
+			std::vector<sCommand> m_commands_currentFrame;
+			std::vector<sCommand> m_commands_lastFrame;
+			sTotals m_totals;
+			sTotals m_totals_currentFrame;
+			sTotals m_totals_lastFrame;
+			mutable Concurrency::cMutex m_mutex;
+			std::atomic<uint32_t> m_nextObjectId{ 1 };
+
+			// Implementation
+			//===============
+
+		private:
+
+			static bool IsRenderingCommand( const eCommandType i_type );
+
+			// Initialize / Clean Up
+			//----------------------
+
+			cCommandLog( const cCommandLog& ) = delete;
+			cCommandLog( cCommandLog&& ) = delete;
+			cCommandLog& operator =( const cCommandLog& ) = delete;
+			cCommandLog& operator =( cCommandLog&& ) = delete;
+		};
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_NULL_CCOMMANDLOG_H
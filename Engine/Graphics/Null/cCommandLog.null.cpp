@@ -0,0 +1,104 @@
+// Includes
+//=========
+
+#include "cCommandLog.h"
+
+#include <Engine/Asserts/Asserts.h>
+
+// Interface
+//==========
+
+// Record
+//-------
+
+void eae6320::Graphics::cCommandLog::Record( const eCommandType i_type, const uint32_t i_objectId,
+	const uint32_t i_value, const uint64_t i_byteCount, const uint32_t i_instanceIndex )
+{
+	EAE6320_ASSERT( i_type < eCommandType::Count );
+
+	Concurrency::cMutex::cScopeLock scopeLock( m_mutex );
+	const auto typeIndex = static_cast<size_t>( i_type );
+	++m_totals.commandCounts[typeIndex];
+	m_totals.byteCounts[typeIndex] += i_byteCount;
+	if ( IsRenderingCommand( i_type ) )
+	{
+		sCommand command;
+		command.type = i_type;
+		command.objectId = i_objectId;
+		command.value = i_value;
+		command.instanceIndex = i_instanceIndex;
+		command.byteCount = i_byteCount;
+		m_commands_currentFrame.push_back( command );
+		++m_totals_currentFrame.commandCounts[typeIndex];
+		m_totals_currentFrame.byteCounts[typeIndex] += i_byteCount;
+	}
+}
+
+void eae6320::Graphics::cCommandLog::EndFrame()
+{
+	Concurrency::cMutex::cScopeLock scopeLock( m_mutex );
+	// Swapping keeps the memory of both vectors,
+	// and so once they have grown large enough for a typical frame recording doesn't allocate
+	m_commands_lastFrame.swap( m_commands_currentFrame );
+	m_commands_currentFrame.clear();
+	++m_totals.frameCount;
+	m_totals_lastFrame = m_totals_currentFrame;
+	m_totals_lastFrame.frameCount = 1;
+	m_totals_currentFrame = sTotals();
+}
+
+uint32_t eae6320::Graphics::cCommandLog::GenerateObjectId()
+{
+	return m_nextObjectId.fetch_add( 1, std::memory_order_relaxed );
+}
+
+// Access
+//-------
+
+void eae6320::Graphics::cCommandLog::GetCommands_lastFrame( std::vector<sCommand>& o_commands ) const
+{
+	Concurrency::cMutex::cScopeLock scopeLock( m_mutex );
+	o_commands.assign( m_commands_lastFrame.begin(), m_commands_lastFrame.end() );
+}
+
+eae6320::Graphics::cCommandLog::sTotals eae6320::Graphics::cCommandLog::GetTotals() const
+{
+	Concurrency::cMutex::cScopeLock scopeLock( m_mutex );
+	return m_totals;
+}
+
+eae6320::Graphics::cCommandLog::sTotals eae6320::Graphics::cCommandLog::GetTotals_lastFrame() const
+{
+	Concurrency::cMutex::cScopeLock scopeLock( m_mutex );
+	return m_totals_lastFrame;
+}
+
+// Initialize / Clean Up
+//----------------------
+
+void eae6320::Graphics::cCommandLog::Reset()
+{
+	Concurrency::cMutex::cScopeLock scopeLock( m_mutex );
+	m_commands_currentFrame.clear();
+	m_commands_lastFrame.clear();
+	m_totals = sTotals();
+	m_totals_currentFrame = sTotals();
+	m_totals_lastFrame = sTotals();
+}
+
+// Implementation
+//===============
+
+bool eae6320::Graphics::cCommandLog::IsRenderingCommand( const eCommandType i_type )
+{
+	switch ( i_type )
+	{
+	case eCommandType::CreateShader:
+	case eCommandType::CreateEffect:
+	case eCommandType::CreateConstantBuffer:
+	case eCommandType::CreateMesh:
+		return false;
+	default:
+		return true;
+	}
+}
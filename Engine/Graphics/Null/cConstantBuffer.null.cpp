@@ -0,0 +1,139 @@
+// Includes
+//=========
+
+#include "../cConstantBuffer.h"
+#include "../sContext.h"
+
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <new>
+
+// Interface
+//==========
+
+// Render
+//-------
+
+void eae6320::Graphics::cConstantBuffer::Bind( const uint_fast8_t i_shaderTypesToBindTo ) const
+{
+	EAE6320_ASSERT( m_bufferId != 0 );
+	EAE6320_ASSERTF( !m_isRing, "A constant buffer ring must be bound with BindRingRange()" );
+
+	auto& context = sContext::g_context;
+	context.boundConstantBuffers[static_cast<size_t>( m_type )] = this;
+	context.commandLog.Record( eCommandType::BindConstantBuffer, m_bufferId, static_cast<uint32_t>( m_type ) );
+}
+
+void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data, const size_t i_size )
+{
+	EAE6320_ASSERT( m_data != nullptr );
+	EAE6320_ASSERT( i_size <= m_size );
+	EAE6320_ASSERTF( !m_isRing, "A constant buffer ring must be updated with BeginRingUpload() and EndRingUpload()" );
+
+	memcpy( m_data, i_data, i_size );
+	sContext::g_context.commandLog.Record( eCommandType::UpdateConstantBuffer, m_bufferId, static_cast<uint32_t>( m_type ), i_size );
+}
+
+void eae6320::Graphics::cConstantBuffer::BindRingRange( const unsigned int i_rangeIndex, const uint_fast8_t )
+{
+	EAE6320_ASSERT( ( m_bufferId != 0 ) && m_isRing );
+	EAE6320_ASSERT( i_rangeIndex < m_ringRangeCount_lastUpload );
+
+	auto& context = sContext::g_context;
+	m_ringRangeOffset_bound = m_ringUploadOffset + ( i_rangeIndex * m_ringRangeStride );
+	context.boundConstantBuffers[static_cast<size_t>( m_type )] = this;
+	// The byte count is where the bound range starts
+	context.commandLog.Record( eCommandType::BindConstantBuffer, m_bufferId, static_cast<uint32_t>( m_type ), m_ringRangeOffset_bound );
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::CleanUp()
+{
+	auto& context = sContext::g_context;
+	if ( ( m_type < ConstantBufferTypes::Count ) && ( context.boundConstantBuffers[static_cast<size_t>( m_type )] == this ) )
+	{
+		context.boundConstantBuffers[static_cast<size_t>( m_type )] = nullptr;
+	}
+	delete [] m_data;
+	m_data = nullptr;
+	m_ringRangeOffset_bound = 0;
+	CleanUpRing();
+	m_bufferId = 0;
+
+	return Results::Success;
+}
+
+// Implementation
+//===============
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::Initialize_platformSpecific( const void* const i_initialData )
+{
+	// Allocate the CPU memory that stands in for the GPU memory
+	{
+		m_data = new ( std::nothrow ) uint8_t[m_size];
+		if ( !m_data )
+		{
+			EAE6320_ASSERTF( false, "Couldn't allocate memory for the constant buffer" );
+			Logging::OutputError( "Failed to allocate %u bytes for a constant buffer of type %u",
+				static_cast<unsigned int>( m_size ), m_type );
+			return Results::OutOfMemory;
+		}
+		if ( i_initialData )
+		{
+			memcpy( m_data, i_initialData, m_size );
+		}
+		else
+		{
+			memset( m_data, 0, m_size );
+		}
+	}
+	auto& commandLog = sContext::g_context.commandLog;
+	m_bufferId = commandLog.GenerateObjectId();
+	commandLog.Record( eCommandType::CreateConstantBuffer, m_bufferId, static_cast<uint32_t>( m_type ), m_size );
+
+	return Results::Success;
+}
+
+size_t eae6320::Graphics::cConstantBuffer::GetRingRangeAlignment_platformSpecific() const
+{
+	// This is the largest alignment that Direct3D or OpenGL can require,
+	// and so the recorded byte counts are what a real GPU could need
+	return 256;
+}
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::ResizeRing_platformSpecific( const unsigned int i_rangeCapacity )
+{
+	// There is no GPU that could still be reading the memory,
+	// and so (like Direct3D's discard) the buffer only needs room for a single upload
+	const auto newSize = static_cast<size_t>( i_rangeCapacity ) * m_ringRangeStride;
+	auto* const newData = new ( std::nothrow ) uint8_t[newSize];
+	if ( !newData )
+	{
+		EAE6320_ASSERTF( false, "Couldn't allocate memory for the constant buffer ring" );
+		Logging::OutputError( "Failed to allocate %u bytes for a constant buffer ring of type %u",
+			static_cast<unsigned int>( newSize ), m_type );
+		return Results::OutOfMemory;
+	}
+	memset( newData, 0, newSize );
+	delete [] m_data;
+	m_data = newData;
+	m_ringRangeOffset_bound = 0;
+	sContext::g_context.commandLog.Record( eCommandType::CreateConstantBuffer, m_bufferId, static_cast<uint32_t>( m_type ), newSize );
+
+	return Results::Success;
+}
+
+void eae6320::Graphics::cConstantBuffer::UploadRing_platformSpecific( const size_t i_byteCount )
+{
+	EAE6320_ASSERT( m_data != nullptr );
+
+	memcpy( m_data, m_ringData_cpu, i_byteCount );
+	m_ringUploadOffset = 0;
+	sContext::g_context.commandLog.Record( eCommandType::UpdateConstantBuffer, m_bufferId, static_cast<uint32_t>( m_type ), i_byteCount );
+}
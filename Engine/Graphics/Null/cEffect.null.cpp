@@ -0,0 +1,56 @@
+// Includes
+//=========
+
+#include "../cEffect.h"
+#include "../sContext.h"
+
+#include <Engine/Asserts/Asserts.h>
+
+void eae6320::Graphics::cEffect::Bind()
+{
+	EAE6320_ASSERT(s_programId != 0);
+	sContext::g_context.commandLog.Record(eCommandType::BindEffect, s_programId);
+	// Render state
+	{
+		s_renderState.Bind();
+	}
+}
+
+eae6320::cResult eae6320::Graphics::cEffect::Initialize(cShader* i_vertexShader, cShader* i_fragmentShader)
+{
+	auto result = eae6320::Results::Success;
+
+	if (!(result = InitializeData(i_vertexShader, i_fragmentShader)))
+	{
+		return result;
+	}
+
+	// The "program" is only an ID that is used by the command log
+	EAE6320_ASSERT(s_programId == 0);
+	EAE6320_ASSERT((s_vertexShader != nullptr) && (s_vertexShader->m_shaderId != 0));
+	EAE6320_ASSERT((s_fragmentShader != nullptr) && (s_fragmentShader->m_shaderId != 0));
+	auto& commandLog = sContext::g_context.commandLog;
+	s_programId = commandLog.GenerateObjectId();
+	commandLog.Record(eCommandType::CreateEffect, s_programId);
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cEffect::CleanUp()
+{
+	auto result = eae6320::Results::Success;
+
+	s_programId = 0;
+	if (s_vertexShader)
+	{
+		s_vertexShader->DecrementReferenceCount();
+		s_vertexShader = nullptr;
+	}
+	if (s_fragmentShader)
+	{
+		s_fragmentShader->DecrementReferenceCount();
+		s_fragmentShader = nullptr;
+	}
+
+	return result;
+}
@@ -0,0 +1,69 @@
+// Includes
+//=========
+
+#include "../cMesh.h"
+#include "../ConstantBufferFormats.h"
+#include "../sContext.h"
+#include "../VertexFormats.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+void eae6320::Graphics::cMesh::Bind() const
+{
+	EAE6320_ASSERT(m_objectId != 0);
+	sContext::g_context.commandLog.Record(eCommandType::BindMesh, m_objectId);
+}
+
+void eae6320::Graphics::cMesh::Draw() const
+{
+	// Drawing reads every index (the vertices that are read depend on the indices)
+	sContext::g_context.commandLog.Record(eCommandType::Draw, m_objectId,
+		static_cast<uint32_t>(m_indexCount), uint64_t(m_indexSize) * m_indexCount);
+}
+
+void eae6320::Graphics::cMesh::DrawInstanced(const unsigned int i_instanceCount) const
+{
+	// The null platform doesn't have instancing,
+	// and so an instanced draw is turned into one draw per instance
+	// (each one reads its transform from the instances constant buffer)
+	auto& context = sContext::g_context;
+	const auto* const constantBuffer_instances = context.boundConstantBuffers[static_cast<size_t>(ConstantBufferTypes::Instances)];
+	EAE6320_ASSERTF(constantBuffer_instances != nullptr, "Instanced draws need the instances constant buffer to be bound");
+	EAE6320_ASSERT(i_instanceCount <= ConstantBufferFormats::maxInstanceCountPerDrawCall);
+	if (!constantBuffer_instances)
+	{
+		return;
+	}
+
+	for (unsigned int i = 0; i < i_instanceCount; ++i)
+	{
+		context.commandLog.Record(eCommandType::Draw, m_objectId,
+			static_cast<uint32_t>(m_indexCount), uint64_t(m_indexSize) * m_indexCount, i);
+	}
+}
+
+eae6320::cResult eae6320::Graphics::cMesh::Initialize(const VertexFormats::sVertex_mesh* const vertexData, const void* const indexData, const unsigned int vertexCount, const unsigned int indexCount,
+	const unsigned int indexSize)
+{
+	EAE6320_ASSERT(m_objectId == 0);
+	EAE6320_ASSERT((vertexData != nullptr) && (indexData != nullptr));
+
+	// The vertex and index data aren't kept,
+	// but their size is recorded as if they had been uploaded
+	// (the index order doesn't need to change because the null platform doesn't cull triangles)
+	const auto bufferSize = (sizeof(vertexData[0]) * static_cast<uint64_t>(vertexCount))
+		+ (uint64_t(indexSize) * indexCount);
+	auto& commandLog = sContext::g_context.commandLog;
+	m_objectId = commandLog.GenerateObjectId();
+	commandLog.Record(eCommandType::CreateMesh, m_objectId, static_cast<uint32_t>(indexCount), bufferSize);
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::cMesh::CleanUp()
+{
+	m_objectId = 0;
+
+	return Results::Success;
+}
@@ -0,0 +1,39 @@
+// Includes
+//=========
+
+#include "../cRenderState.h"
+#include "../sContext.h"
+
+#include <Engine/Asserts/Asserts.h>
+
+// Interface
+//==========
+
+// Render
+//-------
+
+void eae6320::Graphics::cRenderState::Bind() const
+{
+	EAE6320_ASSERT( m_bits != g_invalidRenderStateBits );
+	// The render state doesn't have its own object, and so the bits identify it
+	sContext::g_context.commandLog.Record( eCommandType::BindRenderState, 0, m_bits );
+}
+
+// Implementation
+//===============
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cRenderState::Initialize( const uint8_t i_renderStateBits )
+{
+	m_bits = i_renderStateBits;
+
+	// The null platform only records the bits at binding time
+	return Results::Success;
+}
+
+eae6320::Graphics::cRenderState::~cRenderState()
+{
+
+}
@@ -0,0 +1,38 @@
+// Includes
+//=========
+
+#include "../cRenderTarget.h"
+#include "../Graphics.h"
+#include "../sContext.h"
+
+#include <Engine/Asserts/Asserts.h>
+
+// Render
+//-------
+
+void eae6320::Graphics::cRenderTarget::ClearBuffer(float* i_clearColor)
+{
+	EAE6320_ASSERT(i_clearColor != nullptr);
+	// The color and depth buffers would both be cleared
+	sContext::g_context.commandLog.Record(eCommandType::ClearBuffer, 0);
+}
+
+void eae6320::Graphics::cRenderTarget::SwapBuffer()
+{
+	auto& commandLog = sContext::g_context.commandLog;
+	commandLog.Record(eCommandType::SwapBuffer, 0);
+	// Everything recorded since the last swap is one complete frame
+	commandLog.EndFrame();
+}
+
+// Initialize / Clean Up
+//--------------------------
+eae6320::cResult eae6320::Graphics::cRenderTarget::Initialize(const sInitializationParameters& i_initializationParameters)
+{
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::cRenderTarget::CleanUp()
+{
+	return Results::Success;
+}
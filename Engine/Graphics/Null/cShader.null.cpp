@@ -0,0 +1,35 @@
+// Includes
+//=========
+
+#include "../cShader.h"
+#include "../sContext.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Platform/Platform.h>
+
+// Implementation
+//===============
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cShader::Initialize( const std::string& i_path, const void* const i_compiledShader, const size_t i_compiledShaderSize )
+{
+	EAE6320_ASSERT( ( m_type == eae6320::Graphics::eShaderType::Vertex ) || ( m_type == eae6320::Graphics::eShaderType::Fragment ) );
+	EAE6320_ASSERT( m_shaderId == 0 );
+
+	// The compiled shader isn't used,
+	// but its size is recorded as if it had been uploaded
+	auto& commandLog = sContext::g_context.commandLog;
+	m_shaderId = commandLog.GenerateObjectId();
+	commandLog.Record( eCommandType::CreateShader, m_shaderId, static_cast<uint32_t>( m_type ), i_compiledShaderSize );
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::cShader::CleanUp()
+{
+	m_shaderId = 0;
+
+	return Results::Success;
+}
@@ -0,0 +1,44 @@
+// Includes
+//=========
+
+#include "../sContext.h"
+
+#include <Engine/Asserts/Asserts.h>
+
+// Interface
+//==========
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::sContext::Initialize( const sInitializationParameters& i_initializationParameters )
+{
+#if defined( EAE6320_PLATFORM_WINDOWS )
+	// The window is remembered (like on the other platforms)
+	// but nothing is ever drawn to it
+	windowBeingRenderedTo = i_initializationParameters.mainWindow;
+#endif
+
+	// Every run starts with an empty command log
+	commandLog.Reset();
+	for ( auto& boundConstantBuffer : boundConstantBuffers )
+	{
+		boundConstantBuffer = nullptr;
+	}
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::sContext::CleanUp()
+{
+	for ( auto& boundConstantBuffer : boundConstantBuffers )
+	{
+		boundConstantBuffer = nullptr;
+	}
+
+#if defined( EAE6320_PLATFORM_WINDOWS )
+	windowBeingRenderedTo = NULL;
+#endif
+
+	return Results::Success;
+}
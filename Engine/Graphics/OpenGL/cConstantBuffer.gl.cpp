@@ -16,6 +16,7 @@
 void eae6320::Graphics::cConstantBuffer::Bind( const uint_fast8_t ) const
 {
 	EAE6320_ASSERT( m_bufferId != 0 );
+	EAE6320_ASSERTF( !m_isRing, "A constant buffer ring must be bound with BindRingRange()" );
 
 	// OpenGL doesn't have a way to only bind the constant buffer to specific shader types,
 	// and so the input parameter isn't used
@@ -23,9 +24,11 @@ void eae6320::Graphics::cConstantBuffer::Bind( const uint_fast8_t ) const
 	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
 }
 
-void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
+void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data, const size_t i_size )
 {
 	EAE6320_ASSERT( m_bufferId != 0 );
+	EAE6320_ASSERT( i_size <= m_size );
+	EAE6320_ASSERTF( !m_isRing, "A constant buffer ring must be updated with BeginRingUpload() and EndRingUpload()" );
 
 	// Make the uniform buffer active
 	{
@@ -35,11 +38,23 @@ void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
 	// Copy the updated memory to the GPU
 	{
 		GLintptr updateAtTheBeginning = 0;
-		glBufferSubData( GL_UNIFORM_BUFFER, updateAtTheBeginning, static_cast<GLsizeiptr>( m_size ), i_data );
+		glBufferSubData( GL_UNIFORM_BUFFER, updateAtTheBeginning, static_cast<GLsizeiptr>( i_size ), i_data );
 		EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
 	}
 }
 
+void eae6320::Graphics::cConstantBuffer::BindRingRange( const unsigned int i_rangeIndex, const uint_fast8_t )
+{
+	EAE6320_ASSERT( ( m_bufferId != 0 ) && m_isRing );
+	EAE6320_ASSERT( i_rangeIndex < m_ringRangeCount_lastUpload );
+
+	// OpenGL doesn't have a way to only bind the constant buffer to specific shader types,
+	// and so the shader types aren't used
+	const auto offset = static_cast<GLintptr>( m_ringUploadOffset + ( i_rangeIndex * m_ringRangeStride ) );
+	glBindBufferRange( GL_UNIFORM_BUFFER, static_cast<GLuint>( m_type ), m_bufferId, offset, static_cast<GLsizeiptr>( m_size ) );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+}
+
 // Initialize / Clean Up
 //----------------------
 
@@ -61,6 +76,7 @@ eae6320::cResult eae6320::Graphics::cConstantBuffer::CleanUp()
 		}
 		m_bufferId = 0;
 	}
+	CleanUpRing();
 
 	return result;
 }
@@ -120,3 +136,50 @@ eae6320::cResult eae6320::Graphics::cConstantBuffer::Initialize_platformSpecific
 
 	return result;
 }
+
+size_t eae6320::Graphics::cConstantBuffer::GetRingRangeAlignment_platformSpecific() const
+{
+	GLint alignment = 0;
+	glGetIntegerv( GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	// The specification says that the alignment is at most 256,
+	// and so that is used if the query fails
+	return ( alignment > 0 ) ? static_cast<size_t>( alignment ) : 256;
+}
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::ResizeRing_platformSpecific( const unsigned int i_rangeCapacity )
+{
+	EAE6320_ASSERT( m_bufferId != 0 );
+
+	// glBufferSubData() into memory that the GPU might still be reading from would make the CPU wait,
+	// and so the buffer has a segment for every frame that might still be in flight
+	// and every upload goes to the next one
+	const auto segmentSize = static_cast<size_t>( i_rangeCapacity ) * m_ringRangeStride;
+	glBindBuffer( GL_UNIFORM_BUFFER, m_bufferId );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	constexpr GLenum usage = GL_DYNAMIC_DRAW;	// The buffer will be modified frequently and used to draw
+	glBufferData( GL_UNIFORM_BUFFER, static_cast<GLsizeiptr>( segmentSize * EAE6320_GRAPHICS_CONSTANTBUFFERRINGSEGMENTCOUNT ), nullptr, usage );
+	const auto errorCode = glGetError();
+	if ( errorCode != GL_NO_ERROR )
+	{
+		EAE6320_ASSERTF( false, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+		Logging::OutputError( "OpenGL failed to allocate %u ranges for the uniform buffer ring %u: %s",
+			i_rangeCapacity, m_bufferId, reinterpret_cast<const char*>( gluErrorString( errorCode ) ) );
+		return Results::Failure;
+	}
+	m_ringSegmentIndex = 0;
+
+	return Results::Success;
+}
+
+void eae6320::Graphics::cConstantBuffer::UploadRing_platformSpecific( const size_t i_byteCount )
+{
+	EAE6320_ASSERT( m_bufferId != 0 );
+
+	m_ringSegmentIndex = ( m_ringSegmentIndex + 1 ) % EAE6320_GRAPHICS_CONSTANTBUFFERRINGSEGMENTCOUNT;
+	m_ringUploadOffset = static_cast<size_t>( m_ringSegmentIndex ) * m_ringRangeCapacity * m_ringRangeStride;
+	glBindBuffer( GL_UNIFORM_BUFFER, m_bufferId );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+	glBufferSubData( GL_UNIFORM_BUFFER, static_cast<GLintptr>( m_ringUploadOffset ), static_cast<GLsizeiptr>( i_byteCount ), m_ringData_cpu );
+	EAE6320_ASSERT( glGetError() == GL_NO_ERROR );
+}
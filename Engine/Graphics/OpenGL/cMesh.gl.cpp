@@ -5,11 +5,21 @@
 #include "../sContext.h"
 #include "../VertexFormats.h"
 
+#include <cstddef>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Asserts/Asserts.h>
 
+// Helper Declarations
+//====================
 
-void eae6320::Graphics::cMesh::DrawGeometry()
+namespace
+{
+	// Describes one element of the vertex format to the bound vertex array and enables it
+	eae6320::cResult SetVertexAttribute(const GLuint i_location, const GLint i_elementCount, const GLenum i_type, const GLboolean i_isNormalized,
+		const size_t i_offset, const char* const i_semanticName);
+}
+
+void eae6320::Graphics::cMesh::Bind() const
 {
 	// Bind a specific vertex buffer to the device as a data source
 	{
@@ -17,6 +27,10 @@ void eae6320::Graphics::cMesh::DrawGeometry()
 		glBindVertexArray(s_vertexArrayId);
 		EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
 	}
+}
+
+void eae6320::Graphics::cMesh::Draw() const
+{
 	// Render triangles from the currently-bound vertex buffer
 	//{
 	//	// The mode defines how to interpret multiple vertices as a single "primitive";
@@ -41,11 +55,23 @@ void eae6320::Graphics::cMesh::DrawGeometry()
 
 	// It's possible to start rendering primitives in the middle of the stream
 	const GLvoid* const offset = 0;
-	glDrawElements(mode, static_cast<GLsizei>(m_indexCount), GL_UNSIGNED_SHORT, offset);
+	const GLenum indexType = (m_indexSize == sizeof(uint32_t)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+	glDrawElements(mode, static_cast<GLsizei>(m_indexCount), indexType, offset);
 	EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
 }
 
-eae6320::cResult eae6320::Graphics::cMesh::Initialize(VertexFormats::sVertex_mesh* vertexData, uint16_t* indexData, const int vertexCount, const int indexCount)
+void eae6320::Graphics::cMesh::DrawInstanced(const unsigned int i_instanceCount) const
+{
+	constexpr GLenum mode = GL_TRIANGLES;
+	const GLvoid* const offset = 0;
+	const GLenum indexType = (m_indexSize == sizeof(uint32_t)) ? GL_UNSIGNED_INT : GL_UNSIGNED_SHORT;
+	// Each instance can find its data using gl_InstanceID
+	glDrawElementsInstanced(mode, static_cast<GLsizei>(m_indexCount), indexType, offset, static_cast<GLsizei>(i_instanceCount));
+	EAE6320_ASSERT(glGetError() == GL_NO_ERROR);
+}
+
+eae6320::cResult eae6320::Graphics::cMesh::Initialize(const VertexFormats::sVertex_mesh* const vertexData, const void* const indexData, const unsigned int vertexCount, const unsigned int indexCount,
+	const unsigned int indexSize)
 {
 	auto result = eae6320::Results::Success;
 
@@ -136,7 +162,7 @@ eae6320::cResult eae6320::Graphics::cMesh::Initialize(VertexFormats::sVertex_mes
 	{
 		const auto bufferSize = sizeof(vertexData[0]) * vertexCount;
 		EAE6320_ASSERT(bufferSize <= static_cast<unsigned int>(std::numeric_limits<GLsizeiptr>::max()));
-		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bufferSize), reinterpret_cast<GLvoid*>(vertexData),
+		glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(bufferSize), static_cast<const GLvoid*>(vertexData),
 			// In our class we won't ever read from the buffer
 			GL_STATIC_DRAW);
 		const auto errorCode = glGetError();
@@ -152,14 +178,10 @@ eae6320::cResult eae6320::Graphics::cMesh::Initialize(VertexFormats::sVertex_mes
 
 	// Assign the data to the buffer
 	{
-		//convert winding order
-		for (int i = 1; i < indexCount; i += 3)
-		{
-			std::swap(indexData[i], indexData[i+1]);
-		}
-		unsigned int bufferSize = sizeof(indexData[0]) * indexCount;
+		// The winding order was converted when the mesh was built (see cMeshBuilder.cpp)
+		const auto bufferSize = static_cast<size_t>(indexSize) * indexCount;
 		EAE6320_ASSERT(bufferSize <= static_cast<unsigned int>(std::numeric_limits<GLsizeiptr>::max()));
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(bufferSize), reinterpret_cast<GLvoid*>(indexData),
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(bufferSize), indexData,
 			// In our class we won't ever read from the buffer
 			GL_STATIC_DRAW);
 		const auto errorCode = glGetError();
@@ -175,41 +197,35 @@ eae6320::cResult eae6320::Graphics::cMesh::Initialize(VertexFormats::sVertex_mes
 
 	// Initialize vertex format
 	{
-		// The "stride" defines how large a single vertex is in the stream of data
-		// (or, said another way, how far apart each position element is)
-		constexpr auto stride = static_cast<GLsizei>(sizeof(eae6320::Graphics::VertexFormats::sVertex_mesh));
-
 		// Position (0)
-		// 3 floats == 12 bytes
+		// 4 uint16_ts == 8 bytes
 		// Offset = 0
+		// (the normalized integers are converted to floats between 0 and 1,
+		// and the draw call's transform converts those to the mesh's local space)
+		if (!(result = SetVertexAttribute(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, offsetof(eae6320::Graphics::VertexFormats::sVertex_mesh, x), "POSITION")))
 		{
-			constexpr GLuint vertexElementLocation = 0;
-			constexpr GLint elementCount = 3;
-			constexpr GLboolean notNormalized = GL_FALSE;	// The given floats should be used as-is
-			glVertexAttribPointer(vertexElementLocation, elementCount, GL_FLOAT, notNormalized, stride,
-				reinterpret_cast<GLvoid*>(offsetof(eae6320::Graphics::VertexFormats::sVertex_mesh, x)));
-			const auto errorCode = glGetError();
-			if (errorCode == GL_NO_ERROR)
-			{
-				glEnableVertexAttribArray(vertexElementLocation);
-				const GLenum errorCode = glGetError();
-				if (errorCode != GL_NO_ERROR)
-				{
-					result = eae6320::Results::Failure;
-					EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
-					eae6320::Logging::OutputError("OpenGL failed to enable the POSITION vertex attribute at location %u: %s",
-						vertexElementLocation, reinterpret_cast<const char*>(gluErrorString(errorCode)));
-					return result;
-				}
-			}
-			else
-			{
-				result = eae6320::Results::Failure;
-				EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
-				eae6320::Logging::OutputError("OpenGL failed to set the POSITION vertex attribute at location %u: %s",
-					vertexElementLocation, reinterpret_cast<const char*>(gluErrorString(errorCode)));
-				return result;
-			}
+			return result;
+		}
+		// Normal (1)
+		// 2 int16_ts == 4 bytes
+		// Offset = 8
+		if (!(result = SetVertexAttribute(1, 2, GL_SHORT, GL_TRUE, offsetof(eae6320::Graphics::VertexFormats::sVertex_mesh, nx), "NORMAL")))
+		{
+			return result;
+		}
+		// Texture coordinates (2)
+		// 2 half floats == 4 bytes
+		// Offset = 12
+		if (!(result = SetVertexAttribute(2, 2, GL_HALF_FLOAT, GL_FALSE, offsetof(eae6320::Graphics::VertexFormats::sVertex_mesh, u), "TEXCOORD")))
+		{
+			return result;
+		}
+		// Color (3)
+		// 4 uint8_ts == 4 bytes
+		// Offset = 16
+		if (!(result = SetVertexAttribute(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, offsetof(eae6320::Graphics::VertexFormats::sVertex_mesh, r), "COLOR")))
+		{
+			return result;
 		}
 	}
 
@@ -289,4 +305,42 @@ eae6320::cResult eae6320::Graphics::cMesh::CleanUp()
 	}
 
 	return result;
-}
\ No newline at end of file
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	eae6320::cResult SetVertexAttribute(const GLuint i_location, const GLint i_elementCount, const GLenum i_type, const GLboolean i_isNormalized,
+		const size_t i_offset, const char* const i_semanticName)
+	{
+		// The "stride" defines how large a single vertex is in the stream of data
+		// (or, said another way, how far apart each element is)
+		constexpr auto stride = static_cast<GLsizei>(sizeof(eae6320::Graphics::VertexFormats::sVertex_mesh));
+
+		glVertexAttribPointer(i_location, i_elementCount, i_type, i_isNormalized, stride, reinterpret_cast<GLvoid*>(i_offset));
+		const auto errorCode = glGetError();
+		if (errorCode == GL_NO_ERROR)
+		{
+			glEnableVertexAttribArray(i_location);
+			const GLenum errorCode = glGetError();
+			if (errorCode != GL_NO_ERROR)
+			{
+				EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+				eae6320::Logging::OutputError("OpenGL failed to enable the %s vertex attribute at location %u: %s",
+					i_semanticName, i_location, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+				return eae6320::Results::Failure;
+			}
+		}
+		else
+		{
+			EAE6320_ASSERTF(false, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+			eae6320::Logging::OutputError("OpenGL failed to set the %s vertex attribute at location %u: %s",
+				i_semanticName, i_location, reinterpret_cast<const char*>(gluErrorString(errorCode)));
+			return eae6320::Results::Failure;
+		}
+
+		return eae6320::Results::Success;
+	}
+}
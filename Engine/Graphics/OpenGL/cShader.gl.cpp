@@ -16,7 +16,7 @@
 // Initialize / Clean Up
 //----------------------
 
-eae6320::cResult eae6320::Graphics::cShader::Initialize( const std::string& i_path, const Platform::sDataFromFile& i_loadedShader )
+eae6320::cResult eae6320::Graphics::cShader::Initialize( const std::string& i_path, const void* const i_compiledShader, const size_t i_compiledShaderSize )
 {
 	auto result = Results::Success;
 
@@ -83,8 +83,9 @@ eae6320::cResult eae6320::Graphics::cShader::Initialize( const std::string& i_pa
 	// Set the source code into the shader
 	{
 		constexpr GLsizei shaderSourceCount = 1;
-		const auto length = static_cast<GLint>( i_loadedShader.size );
-		glShaderSource( shaderId, shaderSourceCount, reinterpret_cast<GLchar* const*>( &i_loadedShader.data ), &length );
+		const auto* const source = static_cast<const GLchar*>( i_compiledShader );
+		const auto length = static_cast<GLint>( i_compiledShaderSize );
+		glShaderSource( shaderId, shaderSourceCount, &source, &length );
 		const auto errorCode = glGetError();
 		if ( errorCode != GL_NO_ERROR )
 		{
@@ -0,0 +1,117 @@
+// Includes
+//=========
+
+#include "ShaderFormats.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <sstream>
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Graphics::ShaderFormats::GetVariantProgram( const void* const i_data, const size_t i_size, const uint32_t i_variantKey,
+	const void*& o_program, size_t& o_programSize, std::string* const o_errorMessage )
+{
+	o_program = nullptr;
+	o_programSize = 0;
+
+	const auto address = reinterpret_cast<uintptr_t>( i_data );
+	if ( ( i_data == nullptr ) || ( ( address % alignof( sHeader ) ) != 0 ) )
+	{
+		EAE6320_ASSERTF( ( address % alignof( sHeader ) ) == 0, "Shader data must be aligned to %u bytes", static_cast<unsigned int>( alignof( sHeader ) ) );
+		if ( o_errorMessage )
+		{
+			*o_errorMessage = ( i_data == nullptr ) ? "The shader file is empty" : "The shader data isn't aligned";
+		}
+		return Results::InvalidFile;
+	}
+	if ( i_size < sizeof( sHeader ) )
+	{
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The shader file is " << i_size << " bytes, which is too small for a header";
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::InvalidFile;
+	}
+	const auto& header = *static_cast<const sHeader*>( i_data );
+	if ( ( header.identifier != fileIdentifier ) || ( header.version != fileVersion ) )
+	{
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The file isn't a version " << fileVersion << " shader file (it must be rebuilt)";
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::InvalidFile;
+	}
+	if ( header.keywordCount > maxKeywordCount )
+	{
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The shader file has " << header.keywordCount << " keywords (the most there can be is " << maxKeywordCount << ")";
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::InvalidFile;
+	}
+	const auto variantCount = GetVariantCount( header.keywordCount );
+	if ( i_variantKey >= variantCount )
+	{
+		// This isn't a problem with the file,
+		// but with the code that is asking for a keyword that the shader doesn't declare
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The shader doesn't have a variant with the key " << i_variantKey
+				<< " (it declares " << header.keywordCount << " keywords)";
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::Failure;
+	}
+	// The sizes are calculated with 64 bits so that a corrupt file can't make them wrap around
+	const auto programsOffset = uint64_t( sizeof( sHeader ) ) + ( uint64_t( variantCount ) * sizeof( uint32_t ) );
+	const auto tablesEnd = programsOffset + ( uint64_t( header.programCount ) * sizeof( sProgram ) );
+	if ( tablesEnd > i_size )
+	{
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The shader file's tables (" << variantCount << " variants and " << header.programCount
+				<< " programs) don't fit in its " << i_size << " bytes";
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::InvalidFile;
+	}
+	const auto programIndex = reinterpret_cast<const uint32_t*>( address + sizeof( sHeader ) )[i_variantKey];
+	if ( programIndex >= header.programCount )
+	{
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The shader file's variant " << i_variantKey << " uses program " << programIndex
+				<< " but there are only " << header.programCount;
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::InvalidFile;
+	}
+	const auto& program = reinterpret_cast<const sProgram*>( address + programsOffset )[programIndex];
+	if ( ( program.offset < tablesEnd ) || ( ( program.offset % programAlignment ) != 0 )
+		|| ( ( uint64_t( program.offset ) + program.size ) > i_size ) )
+	{
+		if ( o_errorMessage )
+		{
+			std::ostringstream errorMessage;
+			errorMessage << "The shader file's program " << programIndex << " (" << program.size << " bytes at " << program.offset
+				<< ") doesn't fit in its " << i_size << " bytes";
+			*o_errorMessage = errorMessage.str();
+		}
+		return Results::InvalidFile;
+	}
+
+	o_program = reinterpret_cast<const void*>( address + program.offset );
+	o_programSize = program.size;
+
+	return Results::Success;
+}
@@ -0,0 +1,86 @@
+/*
+	This file defines the layout of the binary shader files
+	that ShaderBuilder writes and cShader reads
+
+	A shader source file can declare keywords (see cShaderBuilder.h),
+	and every combination of them is a different variant of the shader.
+	A variant is identified by a key with one bit for each keyword that is #defined
+	(the first keyword that the shader declares is bit 0, the second is bit 1, etc.).
+	Variants that are the same after preprocessing share a single compiled program,
+	and so a binary shader file is:
+		* sHeader
+		* uint32_t[GetVariantCount( keywordCount )] (the index of the program that each variant uses)
+		* sProgram[programCount]
+		* The compiled programs (each at an offset that is a multiple of programAlignment)
+	A compiled program is what is given to the platform's graphics API
+	(Direct3D byte code or GLSL source code).
+
+	Every variant is in the same file,
+	and so once the file has been loaded any of its variants can be created without reading it again.
+*/
+
+#ifndef EAE6320_GRAPHICS_SHADERFORMATS_H
+#define EAE6320_GRAPHICS_SHADERFORMATS_H
+
+// Includes
+//=========
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <string>
+
+// Format Definitions
+//===================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace ShaderFormats
+		{
+			// "SHDR" when the file is viewed as text
+			constexpr uint32_t fileIdentifier = 0x52444853;
+			// This changes whenever the layout does so that old files fail to load instead of being misread
+			constexpr uint16_t fileVersion = 1;
+			// Every keyword doubles the number of variants that must be built
+			// (a shader with the maximum number has 256)
+			constexpr uint16_t maxKeywordCount = 8;
+			constexpr uint32_t programAlignment = 16;
+
+			struct sHeader
+			{
+				uint32_t identifier = fileIdentifier;
+				uint16_t version = fileVersion;
+				uint16_t keywordCount = 0;
+				uint32_t programCount = 0;
+			};
+			static_assert( sizeof( sHeader ) == 12, "The header is read and written directly" );
+
+			struct sProgram
+			{
+				// The offset is from the start of the file
+				uint32_t offset = 0;
+				uint32_t size = 0;
+			};
+			static_assert( sizeof( sProgram ) == 8, "The programs are read and written directly" );
+
+			constexpr uint32_t GetVariantCount( const uint16_t i_keywordCount )
+			{
+				return uint32_t( 1 ) << i_keywordCount;
+			}
+
+			constexpr uint32_t AlignProgramOffset( const uint32_t i_offset )
+			{
+				return ( i_offset + ( programAlignment - 1 ) ) & ~( programAlignment - 1 );
+			}
+
+			// Checks that the data is a shader file with the variant and finds the variant's compiled program
+			// (the program points into the file's data; nothing is copied)
+			cResult GetVariantProgram( const void* const i_data, const size_t i_size, const uint32_t i_variantKey,
+				const void*& o_program, size_t& o_programSize, std::string* const o_errorMessage = nullptr );
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_SHADERFORMATS_H
@@ -0,0 +1,51 @@
+/*
+	These functions write (and read) the frames that the software platform renders
+
+	PPM is the simplest possible format and is easy to compare in a test;
+	PNG can be viewed anywhere.
+	Pixels are tightly packed RGBA8 rows from top to bottom
+	(i.e. what cRasterizer::GetPresentedFrame() returns).
+*/
+
+#ifndef EAE6320_GRAPHICS_SOFTWARE_IMAGEFILES_H
+#define EAE6320_GRAPHICS_SOFTWARE_IMAGEFILES_H
+
+// Includes
+//=========
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace ImageFiles
+		{
+			// A binary PPM (P6) only has RGB, and so alpha is discarded
+			cResult SavePpm( const char* const i_path, const uint32_t* const i_pixels, const unsigned int i_width, const unsigned int i_height );
+			// The PNG is RGBA and isn't compressed
+			// (the image data is stored in uncompressed deflate blocks, which every PNG reader supports)
+			cResult SavePng( const char* const i_path, const uint32_t* const i_pixels, const unsigned int i_width, const unsigned int i_height );
+			// The format is chosen from the extension (".ppm" or ".png")
+			cResult Save( const char* const i_path, const uint32_t* const i_pixels, const unsigned int i_width, const unsigned int i_height );
+
+			// Reads a binary PPM (P6) with a maximum value of 255
+			// (e.g. a golden image to compare a rendered frame against); alpha is set to 255
+			cResult LoadPpm( const char* const i_path, std::vector<uint32_t>& o_pixels, unsigned int& o_width, unsigned int& o_height );
+
+			// Returns how many pixels have a color channel that differs by more than the tolerance
+			// (alpha is ignored, because a PPM doesn't have it).
+			// Both images must have the same number of pixels
+			uint64_t CountDifferentPixels( const uint32_t* const i_pixels_a, const uint32_t* const i_pixels_b, const size_t i_pixelCount,
+				const uint8_t i_tolerance = 0 );
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_SOFTWARE_IMAGEFILES_H
@@ -0,0 +1,251 @@
+// Includes
+//=========
+
+#include "ImageFiles.h"
+
+#include <algorithm>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <fstream>
+#include <string>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	uint32_t CalculateCrc32( const uint8_t* const i_data, const size_t i_size, const uint32_t i_crc = 0 );
+	void AppendBigEndian( std::vector<uint8_t>& io_bytes, const uint32_t i_value );
+	void AppendPngChunk( std::vector<uint8_t>& io_file, const char* const i_type, const std::vector<uint8_t>& i_data );
+	eae6320::cResult WriteFile( const char* const i_path, const uint8_t* const i_data, const size_t i_size );
+	bool DoesPathEndWith( const char* const i_path, const char* const i_extension );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Graphics::ImageFiles::SavePpm( const char* const i_path,
+	const uint32_t* const i_pixels, const unsigned int i_width, const unsigned int i_height )
+{
+	EAE6320_ASSERT( i_pixels != nullptr );
+
+	const auto header = "P6\n" + std::to_string( i_width ) + " " + std::to_string( i_height ) + "\n255\n";
+	const auto pixelCount = static_cast<size_t>( i_width ) * i_height;
+	std::vector<uint8_t> file;
+	file.reserve( header.size() + ( pixelCount * 3 ) );
+	file.insert( file.end(), header.begin(), header.end() );
+	for ( size_t i = 0; i < pixelCount; ++i )
+	{
+		const auto pixel = i_pixels[i];
+		file.push_back( static_cast<uint8_t>( pixel ) );
+		file.push_back( static_cast<uint8_t>( pixel >> 8 ) );
+		file.push_back( static_cast<uint8_t>( pixel >> 16 ) );
+	}
+	return WriteFile( i_path, file.data(), file.size() );
+}
+
+eae6320::cResult eae6320::Graphics::ImageFiles::SavePng( const char* const i_path,
+	const uint32_t* const i_pixels, const unsigned int i_width, const unsigned int i_height )
+{
+	EAE6320_ASSERT( i_pixels != nullptr );
+
+	std::vector<uint8_t> file = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+	// Header
+	{
+		std::vector<uint8_t> header;
+		AppendBigEndian( header, i_width );
+		AppendBigEndian( header, i_height );
+		// 8 bits per channel, RGBA, the only compression/filter methods, not interlaced
+		header.insert( header.end(), { 8, 6, 0, 0, 0 } );
+		AppendPngChunk( file, "IHDR", header );
+	}
+	// Image data
+	{
+		// Every row starts with a filter type byte (0 means the row isn't filtered)
+		const auto rowSize = 1 + ( static_cast<size_t>( i_width ) * 4 );
+		std::vector<uint8_t> rows( rowSize * i_height );
+		for ( unsigned int y = 0; y < i_height; ++y )
+		{
+			auto* const row = rows.data() + ( rowSize * y );
+			row[0] = 0;
+			// The pixels are already RGBA in memory order
+			memcpy( row + 1, i_pixels + ( static_cast<size_t>( i_width ) * y ), rowSize - 1 );
+		}
+		// The rows are stored in a zlib stream of uncompressed deflate blocks
+		std::vector<uint8_t> zlibStream = { 0x78, 0x01 };
+		constexpr size_t maxBlockSize = 0xffff;
+		size_t offset = 0;
+		do
+		{
+			const auto blockSize = std::min( rows.size() - offset, maxBlockSize );
+			const auto isFinalBlock = ( offset + blockSize ) == rows.size();
+			zlibStream.push_back( isFinalBlock ? 1 : 0 );
+			zlibStream.push_back( static_cast<uint8_t>( blockSize ) );
+			zlibStream.push_back( static_cast<uint8_t>( blockSize >> 8 ) );
+			zlibStream.push_back( static_cast<uint8_t>( ~blockSize ) );
+			zlibStream.push_back( static_cast<uint8_t>( ~blockSize >> 8 ) );
+			zlibStream.insert( zlibStream.end(), rows.begin() + offset, rows.begin() + offset + blockSize );
+			offset += blockSize;
+		} while ( offset < rows.size() );
+		// Adler-32 checksum of the uncompressed data
+		{
+			uint32_t a = 1, b = 0;
+			for ( const auto byte : rows )
+			{
+				a = ( a + byte ) % 65521;
+				b = ( b + a ) % 65521;
+			}
+			AppendBigEndian( zlibStream, ( b << 16 ) | a );
+		}
+		AppendPngChunk( file, "IDAT", zlibStream );
+	}
+	AppendPngChunk( file, "IEND", {} );
+
+	return WriteFile( i_path, file.data(), file.size() );
+}
+
+eae6320::cResult eae6320::Graphics::ImageFiles::Save( const char* const i_path,
+	const uint32_t* const i_pixels, const unsigned int i_width, const unsigned int i_height )
+{
+	if ( DoesPathEndWith( i_path, ".png" ) )
+	{
+		return SavePng( i_path, i_pixels, i_width, i_height );
+	}
+	else if ( DoesPathEndWith( i_path, ".ppm" ) )
+	{
+		return SavePpm( i_path, i_pixels, i_width, i_height );
+	}
+	else
+	{
+		EAE6320_ASSERTF( false, "Images can only be saved as .png or .ppm" );
+		Logging::OutputError( "Couldn't save the image \"%s\" because the extension isn't .png or .ppm", i_path );
+		return Results::InvalidFile;
+	}
+}
+
+eae6320::cResult eae6320::Graphics::ImageFiles::LoadPpm( const char* const i_path,
+	std::vector<uint32_t>& o_pixels, unsigned int& o_width, unsigned int& o_height )
+{
+	std::ifstream file( i_path, std::ios::binary );
+	if ( !file )
+	{
+		Logging::OutputError( "The image \"%s\" couldn't be opened", i_path );
+		return Results::FileDoesntExist;
+	}
+	std::string magicNumber;
+	unsigned int maxValue = 0;
+	file >> magicNumber >> o_width >> o_height >> maxValue;
+	// A single whitespace character separates the header from the pixels
+	file.get();
+	if ( !file || ( magicNumber != "P6" ) || ( maxValue != 255 ) )
+	{
+		Logging::OutputError( "The image \"%s\" isn't a binary PPM with 8 bits per channel", i_path );
+		return Results::InvalidFile;
+	}
+	const auto pixelCount = static_cast<size_t>( o_width ) * o_height;
+	std::vector<uint8_t> rgb( pixelCount * 3 );
+	if ( !file.read( reinterpret_cast<char*>( rgb.data() ), static_cast<std::streamsize>( rgb.size() ) ) )
+	{
+		Logging::OutputError( "The image \"%s\" is smaller than its header says", i_path );
+		return Results::InvalidFile;
+	}
+	o_pixels.resize( pixelCount );
+	for ( size_t i = 0; i < pixelCount; ++i )
+	{
+		o_pixels[i] = rgb[i * 3] | ( rgb[( i * 3 ) + 1] << 8 ) | ( rgb[( i * 3 ) + 2] << 16 ) | 0xff000000u;
+	}
+	return Results::Success;
+}
+
+uint64_t eae6320::Graphics::ImageFiles::CountDifferentPixels( const uint32_t* const i_pixels_a, const uint32_t* const i_pixels_b,
+	const size_t i_pixelCount, const uint8_t i_tolerance )
+{
+	uint64_t differentPixelCount = 0;
+	for ( size_t i = 0; i < i_pixelCount; ++i )
+	{
+		for ( unsigned int shift = 0; shift < 24; shift += 8 )
+		{
+			const auto a = static_cast<int>( ( i_pixels_a[i] >> shift ) & 0xff );
+			const auto b = static_cast<int>( ( i_pixels_b[i] >> shift ) & 0xff );
+			if ( ( ( a > b ) ? ( a - b ) : ( b - a ) ) > i_tolerance )
+			{
+				++differentPixelCount;
+				break;
+			}
+		}
+	}
+	return differentPixelCount;
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	uint32_t CalculateCrc32( const uint8_t* const i_data, const size_t i_size, const uint32_t i_crc )
+	{
+		auto crc = ~i_crc;
+		for ( size_t i = 0; i < i_size; ++i )
+		{
+			crc ^= i_data[i];
+			for ( unsigned int bit = 0; bit < 8; ++bit )
+			{
+				crc = ( crc >> 1 ) ^ ( 0xedb88320u & ( 0u - ( crc & 1u ) ) );
+			}
+		}
+		return ~crc;
+	}
+
+	void AppendBigEndian( std::vector<uint8_t>& io_bytes, const uint32_t i_value )
+	{
+		io_bytes.push_back( static_cast<uint8_t>( i_value >> 24 ) );
+		io_bytes.push_back( static_cast<uint8_t>( i_value >> 16 ) );
+		io_bytes.push_back( static_cast<uint8_t>( i_value >> 8 ) );
+		io_bytes.push_back( static_cast<uint8_t>( i_value ) );
+	}
+
+	void AppendPngChunk( std::vector<uint8_t>& io_file, const char* const i_type, const std::vector<uint8_t>& i_data )
+	{
+		AppendBigEndian( io_file, static_cast<uint32_t>( i_data.size() ) );
+		const auto typeOffset = io_file.size();
+		io_file.insert( io_file.end(), i_type, i_type + 4 );
+		io_file.insert( io_file.end(), i_data.begin(), i_data.end() );
+		// The CRC includes the type but not the length
+		AppendBigEndian( io_file, CalculateCrc32( io_file.data() + typeOffset, io_file.size() - typeOffset ) );
+	}
+
+	eae6320::cResult WriteFile( const char* const i_path, const uint8_t* const i_data, const size_t i_size )
+	{
+		std::ofstream file( i_path, std::ios::binary | std::ios::trunc );
+		if ( !file.write( reinterpret_cast<const char*>( i_data ), static_cast<std::streamsize>( i_size ) ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't write the image" );
+			eae6320::Logging::OutputError( "The image \"%s\" couldn't be written", i_path );
+			return eae6320::Results::Failure;
+		}
+		return eae6320::Results::Success;
+	}
+
+	bool DoesPathEndWith( const char* const i_path, const char* const i_extension )
+	{
+		const auto pathLength = strlen( i_path ), extensionLength = strlen( i_extension );
+		if ( pathLength < extensionLength )
+		{
+			return false;
+		}
+		for ( size_t i = 0; i < extensionLength; ++i )
+		{
+			auto character = i_path[pathLength - extensionLength + i];
+			if ( ( character >= 'A' ) && ( character <= 'Z' ) )
+			{
+				character = static_cast<char>( character - 'A' + 'a' );
+			}
+			if ( character != i_extension[i] )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
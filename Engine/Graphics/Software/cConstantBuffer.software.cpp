@@ -0,0 +1,126 @@
+// Includes
+//=========
+
+#include "../cConstantBuffer.h"
+#include "../sContext.h"
+
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <new>
+
+// Interface
+//==========
+
+// Render
+//-------
+
+void eae6320::Graphics::cConstantBuffer::Bind( const uint_fast8_t i_shaderTypesToBindTo ) const
+{
+	EAE6320_ASSERT( m_data != nullptr );
+	EAE6320_ASSERTF( !m_isRing, "A constant buffer ring must be bound with BindRingRange()" );
+
+	// Draws read the constant data directly from whichever buffer is bound
+	sContext::g_context.boundConstantBuffers[static_cast<size_t>( m_type )] = this;
+}
+
+void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data, const size_t i_size )
+{
+	EAE6320_ASSERT( m_data != nullptr );
+	EAE6320_ASSERT( i_size <= m_size );
+	EAE6320_ASSERTF( !m_isRing, "A constant buffer ring must be updated with BeginRingUpload() and EndRingUpload()" );
+
+	memcpy( m_data, i_data, i_size );
+}
+
+void eae6320::Graphics::cConstantBuffer::BindRingRange( const unsigned int i_rangeIndex, const uint_fast8_t )
+{
+	EAE6320_ASSERT( ( m_data != nullptr ) && m_isRing );
+	EAE6320_ASSERT( i_rangeIndex < m_ringRangeCount_lastUpload );
+
+	// Draws read the bound range (see GetData())
+	m_ringRangeOffset_bound = m_ringUploadOffset + ( i_rangeIndex * m_ringRangeStride );
+	sContext::g_context.boundConstantBuffers[static_cast<size_t>( m_type )] = this;
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::CleanUp()
+{
+	auto& context = sContext::g_context;
+	if ( ( m_type < ConstantBufferTypes::Count ) && ( context.boundConstantBuffers[static_cast<size_t>( m_type )] == this ) )
+	{
+		context.boundConstantBuffers[static_cast<size_t>( m_type )] = nullptr;
+	}
+	delete [] m_data;
+	m_data = nullptr;
+	m_ringRangeOffset_bound = 0;
+	CleanUpRing();
+
+	return Results::Success;
+}
+
+// Implementation
+//===============
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::Initialize_platformSpecific( const void* const i_initialData )
+{
+	// The constant data stays in CPU memory
+	m_data = new ( std::nothrow ) uint8_t[m_size];
+	if ( !m_data )
+	{
+		EAE6320_ASSERTF( false, "Couldn't allocate memory for the constant buffer" );
+		Logging::OutputError( "Failed to allocate %u bytes for a constant buffer of type %u",
+			static_cast<unsigned int>( m_size ), m_type );
+		return Results::OutOfMemory;
+	}
+	if ( i_initialData )
+	{
+		memcpy( m_data, i_initialData, m_size );
+	}
+	else
+	{
+		memset( m_data, 0, m_size );
+	}
+
+	return Results::Success;
+}
+
+size_t eae6320::Graphics::cConstantBuffer::GetRingRangeAlignment_platformSpecific() const
+{
+	// Ranges only need the alignment of a shader constant (four floats)
+	return 16;
+}
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::ResizeRing_platformSpecific( const unsigned int i_rangeCapacity )
+{
+	// Draws read the constant data as soon as they are made,
+	// and so the buffer only needs room for a single upload
+	const auto newSize = static_cast<size_t>( i_rangeCapacity ) * m_ringRangeStride;
+	auto* const newData = new ( std::nothrow ) uint8_t[newSize];
+	if ( !newData )
+	{
+		EAE6320_ASSERTF( false, "Couldn't allocate memory for the constant buffer ring" );
+		Logging::OutputError( "Failed to allocate %u bytes for a constant buffer ring of type %u",
+			static_cast<unsigned int>( newSize ), m_type );
+		return Results::OutOfMemory;
+	}
+	memset( newData, 0, newSize );
+	delete [] m_data;
+	m_data = newData;
+	m_ringRangeOffset_bound = 0;
+
+	return Results::Success;
+}
+
+void eae6320::Graphics::cConstantBuffer::UploadRing_platformSpecific( const size_t i_byteCount )
+{
+	EAE6320_ASSERT( m_data != nullptr );
+
+	memcpy( m_data, m_ringData_cpu, i_byteCount );
+	m_ringUploadOffset = 0;
+}
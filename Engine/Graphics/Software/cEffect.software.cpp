@@ -0,0 +1,42 @@
+// Includes
+//=========
+
+#include "../cEffect.h"
+#include "../sContext.h"
+
+#include <Engine/Asserts/Asserts.h>
+
+void eae6320::Graphics::cEffect::Bind()
+{
+	EAE6320_ASSERT((s_vertexShader != nullptr) && (s_fragmentShader != nullptr));
+	// The shaders aren't run;
+	// every effect uses the standard vertex shader (which cMesh implements in C++)
+	// and the standard fragment shader, which outputs the material's color
+	// (this is the color that is used if there is no material constant buffer)
+	sContext::g_context.fragmentColor = cRasterizer::PackColor(1.0f, 1.0f, 1.0f, 1.0f);
+	// Render state
+	{
+		s_renderState.Bind();
+	}
+}
+
+eae6320::cResult eae6320::Graphics::cEffect::Initialize(cShader* i_vertexShader, cShader* i_fragmentShader)
+{
+	return InitializeData(i_vertexShader, i_fragmentShader);
+}
+
+eae6320::cResult eae6320::Graphics::cEffect::CleanUp()
+{
+	if (s_vertexShader)
+	{
+		s_vertexShader->DecrementReferenceCount();
+		s_vertexShader = nullptr;
+	}
+	if (s_fragmentShader)
+	{
+		s_fragmentShader->DecrementReferenceCount();
+		s_fragmentShader = nullptr;
+	}
+
+	return Results::Success;
+}
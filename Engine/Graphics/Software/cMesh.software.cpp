@@ -0,0 +1,190 @@
+// Includes
+//=========
+
+#include "../cMesh.h"
+#include "../ConstantBufferFormats.h"
+#include "../sContext.h"
+#include "../VertexFormats.h"
+
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <new>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// This is Shaders/Vertex/standard.shader (and its INSTANCED variant) in C++
+	void RunVertexShader( const eae6320::Math::cMatrix_transformation& i_transform_localToWorld,
+		const eae6320::Graphics::VertexFormats::sVertex_mesh* const i_vertices, const unsigned int i_vertexCount,
+		eae6320::Graphics::sVertex_projected* const o_vertices );
+	// This is Shaders/Fragment/standard.shader in C++
+	uint32_t RunFragmentShader();
+	// The indices are uint16_t or uint32_t depending on i_indexSize
+	void DrawIndexed( const unsigned int i_vertexCount, const uint8_t* const i_indices, const unsigned int i_indexCount, const unsigned int i_indexSize,
+		const uint32_t i_color );
+}
+
+void eae6320::Graphics::cMesh::Bind() const
+{
+	// There is nothing to bind;
+	// the rasterizer reads the geometry directly when the mesh is drawn
+	EAE6320_ASSERT((m_vertexData != nullptr) && (m_indexData != nullptr));
+}
+
+void eae6320::Graphics::cMesh::Draw() const
+{
+	auto& context = sContext::g_context;
+	const auto* const constantBuffer_drawCall = context.boundConstantBuffers[static_cast<size_t>(ConstantBufferTypes::DrawCall)];
+	EAE6320_ASSERTF(constantBuffer_drawCall != nullptr, "Draws need the draw call constant buffer to be bound");
+	if (!constantBuffer_drawCall)
+	{
+		return;
+	}
+
+	const auto* const constantData_drawCall = static_cast<const ConstantBufferFormats::sDrawCall*>(constantBuffer_drawCall->GetData());
+	const auto fragmentColor = RunFragmentShader();
+	context.projectedVertices.resize(static_cast<size_t>(m_vertexCount));
+	RunVertexShader(constantData_drawCall->g_transform_localToWorld, m_vertexData, m_vertexCount, context.projectedVertices.data());
+	DrawIndexed(m_vertexCount, m_indexData, m_indexCount, m_indexSize, fragmentColor);
+}
+
+void eae6320::Graphics::cMesh::DrawInstanced(const unsigned int i_instanceCount) const
+{
+	// Every instance is run through the vertex shader with its own transform
+	// and then drawn like a single draw call
+	// (the triangles are binned together, and so this still costs one pass over the tiles)
+	auto& context = sContext::g_context;
+	const auto* const constantBuffer_instances = context.boundConstantBuffers[static_cast<size_t>(ConstantBufferTypes::Instances)];
+	EAE6320_ASSERTF(constantBuffer_instances != nullptr, "Instanced draws need the instances constant buffer to be bound");
+	EAE6320_ASSERT(i_instanceCount <= ConstantBufferFormats::maxInstanceCountPerDrawCall);
+	if (!constantBuffer_instances)
+	{
+		return;
+	}
+
+	const auto* const instances = static_cast<const ConstantBufferFormats::sInstances*>(constantBuffer_instances->GetData());
+	const auto fragmentColor = RunFragmentShader();
+	context.projectedVertices.resize(static_cast<size_t>(m_vertexCount));
+	for (unsigned int i = 0; i < i_instanceCount; ++i)
+	{
+		RunVertexShader(instances->g_transforms_localToWorld[i], m_vertexData, m_vertexCount, context.projectedVertices.data());
+		DrawIndexed(m_vertexCount, m_indexData, m_indexCount, m_indexSize, fragmentColor);
+	}
+}
+
+eae6320::cResult eae6320::Graphics::cMesh::Initialize(const VertexFormats::sVertex_mesh* const vertexData, const void* const indexData, const unsigned int vertexCount, const unsigned int indexCount,
+	const unsigned int indexSize)
+{
+	EAE6320_ASSERT((m_vertexData == nullptr) && (m_indexData == nullptr));
+	EAE6320_ASSERT((vertexData != nullptr) && (indexData != nullptr));
+
+	// The data is in the mesh file, which is unmapped after the mesh has been initialized,
+	// and so the mesh keeps its own copy
+	// (this is the software platform's equivalent of uploading it to GPU memory)
+	// (the index order doesn't need to change because the rasterizer uses the Direct3D winding order)
+	m_vertexData = new (std::nothrow) VertexFormats::sVertex_mesh[vertexCount];
+	// (the indices keep their size so that small meshes still use half of the memory)
+	const auto indexDataSize = static_cast<size_t>(indexSize) * indexCount;
+	m_indexData = new (std::nothrow) uint8_t[indexDataSize];
+	if (!m_vertexData || !m_indexData)
+	{
+		EAE6320_ASSERTF(false, "Couldn't allocate memory for the mesh's geometry");
+		Logging::OutputError("Failed to allocate memory for a mesh with %u vertices and %u indices", vertexCount, indexCount);
+		return Results::OutOfMemory;
+	}
+	memcpy(m_vertexData, vertexData, sizeof(vertexData[0]) * static_cast<size_t>(vertexCount));
+	memcpy(m_indexData, indexData, indexDataSize);
+	m_vertexCount = vertexCount;
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::cMesh::CleanUp()
+{
+	delete[] m_vertexData;
+	m_vertexData = nullptr;
+	delete[] m_indexData;
+	m_indexData = nullptr;
+	m_vertexCount = 0;
+
+	return Results::Success;
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	void RunVertexShader( const eae6320::Math::cMatrix_transformation& i_transform_localToWorld,
+		const eae6320::Graphics::VertexFormats::sVertex_mesh* const i_vertices, const unsigned int i_vertexCount,
+		eae6320::Graphics::sVertex_projected* const o_vertices )
+	{
+		// The frame constant buffer is bound once at the start of every frame
+		const auto* const constantBuffer_frame =
+			eae6320::Graphics::sContext::g_context.boundConstantBuffers[static_cast<size_t>( eae6320::Graphics::ConstantBufferTypes::Frame )];
+		EAE6320_ASSERTF( constantBuffer_frame != nullptr, "Draws need the frame constant buffer to be bound" );
+		const auto* const constantData_frame = static_cast<const eae6320::Graphics::ConstantBufferFormats::sFrame*>( constantBuffer_frame->GetData() );
+
+		// The shader transforms every vertex from local to world to camera to projected space.
+		// The three transforms are the same for every vertex of a draw,
+		// and so they are concatenated once instead of being applied one at a time
+		const auto transform_localToProjected = constantData_frame->g_transform_cameraToProjected
+			* ( constantData_frame->g_transform_worldToCamera * i_transform_localToWorld );
+		// The matrix is stored as columns (see cMatrix_transformation.h)
+		float m[16];
+		static_assert( sizeof( m ) == sizeof( transform_localToProjected ), "A transform must be 16 floats" );
+		memcpy( m, &transform_localToProjected, sizeof( m ) );
+		// The positions are normalized integers (see VertexFormats::sVertex_mesh)
+		// that the GPU would convert to floats between 0 and 1 when it fetches them;
+		// the division is folded into the first three columns instead of being done for every vertex
+		// (the transform already converts from 0-1 to local space)
+		for ( int i = 0; i < 12; ++i )
+		{
+			m[i] *= 1.0f / eae6320::Graphics::VertexFormats::positionQuantizationMax;
+		}
+		for ( unsigned int i = 0; i < i_vertexCount; ++i )
+		{
+			const auto& vertex = i_vertices[i];
+			const auto x = static_cast<float>( vertex.x ), y = static_cast<float>( vertex.y ), z = static_cast<float>( vertex.z );
+			auto& vertex_projected = o_vertices[i];
+			vertex_projected.x = ( m[0] * x ) + ( m[4] * y ) + ( m[8] * z ) + m[12];
+			vertex_projected.y = ( m[1] * x ) + ( m[5] * y ) + ( m[9] * z ) + m[13];
+			vertex_projected.z = ( m[2] * x ) + ( m[6] * y ) + ( m[10] * z ) + m[14];
+			vertex_projected.w = ( m[3] * x ) + ( m[7] * y ) + ( m[11] * z ) + m[15];
+		}
+	}
+
+	uint32_t RunFragmentShader()
+	{
+		// The color comes from the material
+		// (if there isn't a material constant buffer then the effect's color is used)
+		const auto& context = eae6320::Graphics::sContext::g_context;
+		const auto* const constantBuffer_material = context.boundConstantBuffers[static_cast<size_t>( eae6320::Graphics::ConstantBufferTypes::Material )];
+		if ( !constantBuffer_material )
+		{
+			return context.fragmentColor;
+		}
+		const auto& color = static_cast<const eae6320::Graphics::ConstantBufferFormats::sMaterial*>( constantBuffer_material->GetData() )->g_color;
+		return eae6320::Graphics::cRasterizer::PackColor( color[0], color[1], color[2], color[3] );
+	}
+
+	void DrawIndexed( const unsigned int i_vertexCount, const uint8_t* const i_indices, const unsigned int i_indexCount, const unsigned int i_indexSize,
+		const uint32_t i_color )
+	{
+		auto& context = eae6320::Graphics::sContext::g_context;
+		if ( i_indexSize == sizeof( uint32_t ) )
+		{
+			context.rasterizer.DrawIndexed( context.projectedVertices.data(), i_vertexCount,
+				reinterpret_cast<const uint32_t*>( i_indices ), i_indexCount, context.renderStateBits, i_color );
+		}
+		else
+		{
+			EAE6320_ASSERT( i_indexSize == sizeof( uint16_t ) );
+			context.rasterizer.DrawIndexed( context.projectedVertices.data(), i_vertexCount,
+				reinterpret_cast<const uint16_t*>( i_indices ), i_indexCount, context.renderStateBits, i_color );
+		}
+	}
+}
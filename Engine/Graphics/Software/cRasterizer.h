@@ -0,0 +1,224 @@
+/*
+	The software platform renders with the CPU instead of a GPU
+
+	Triangles are transformed and set up on the render thread as they are drawn
+	and then binned into every screen tile that they might touch.
+	When the frame is presented the tiles are rasterized in parallel by a pool of worker threads:
+	every tile is owned by a single thread for the whole frame,
+	and its triangles are rasterized in the order that they were drawn,
+	and so depth testing and blending give the same results as a GPU would
+	(and the same results every time, regardless of how many threads there are).
+
+	The rasterizer only depends on the standard library
+	so that it can be used anywhere that there is a C++ compiler
+	(e.g. for golden-image tests or benchmarks on machines without a GPU).
+*/
+
+#ifndef EAE6320_GRAPHICS_SOFTWARE_CRASTERIZER_H
+#define EAE6320_GRAPHICS_SOFTWARE_CRASTERIZER_H
+
+// Includes
+//=========
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Vertex Format
+//==============
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		// This is what a vertex shader outputs
+		// (i.e. o_vertexPosition_projected in Direct3D or gl_Position in OpenGL)
+		struct sVertex_projected
+		{
+			float x, y, z, w;
+		};
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cRasterizer
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Tiles are square, and the width must be a multiple of the SIMD width
+			static constexpr unsigned int tileSize = 64;
+
+			struct sStatistics
+			{
+				// Triangles that were drawn (before culling and clipping)
+				uint32_t triangleCount_submitted = 0;
+				// Triangles that were culled because they were back-facing, outside of the view, or too small to cover a pixel
+				uint32_t triangleCount_culled = 0;
+				// Triangles that were set up and binned (clipping can turn one submitted triangle into several)
+				uint32_t triangleCount_binned = 0;
+				// Every time a triangle is binned into a tile counts once
+				uint32_t tileTriangleCount = 0;
+				// Pixels that passed the depth test and were written
+				uint64_t pixelCount_written = 0;
+				// How long rasterizing the binned tiles took
+				double rasterizationSeconds = 0.0;
+			};
+
+			// Render
+			//-------
+
+			// This is called after the color and depth buffers have been cleared;
+			// clearing is deferred until the tiles are rasterized
+			void Clear( const float* const i_clearColor );
+			// Draws triangles in projected space using the specified render state bits
+			// (see RenderStates::eRenderState).
+			// Every triangle is i_indices[3n], i_indices[3n+1], i_indices[3n+2],
+			// and triangles are front-facing if they are clockwise on screen
+			// (this matches the Direct3D convention that the mesh files are authored for).
+			// The vertices and indices are only read during the call
+			void DrawIndexed( const sVertex_projected* const i_vertices, const unsigned int i_vertexCount,
+				const uint16_t* const i_indices, const unsigned int i_indexCount,
+				const uint8_t i_renderStateBits, const uint32_t i_color );
+			void DrawIndexed( const sVertex_projected* const i_vertices, const unsigned int i_vertexCount,
+				const uint32_t* const i_indices, const unsigned int i_indexCount,
+				const uint8_t i_renderStateBits, const uint32_t i_color );
+			// Rasterizes everything that has been drawn since the last call
+			// and makes it the presented frame
+			void Present();
+
+			// Access
+			//-------
+
+			unsigned int GetWidth() const { return m_width; }
+			unsigned int GetHeight() const { return m_height; }
+			unsigned int GetThreadCount() const { return static_cast<unsigned int>( m_workerThreads.size() ) + 1; }
+			// Copies the most recently presented frame
+			// (pixels are tightly packed RGBA8 rows from top to bottom;
+			// the vector's memory is reused if it is already big enough).
+			// This can be called from any thread
+			void GetPresentedFrame( std::vector<uint32_t>& o_pixels ) const;
+			// The statistics of the most recently presented frame
+			sStatistics GetStatistics_lastFrame() const;
+
+			// Colors are stored as RGBA8 in memory order (i.e. red is the first byte)
+			static uint32_t PackColor( const float i_red, const float i_green, const float i_blue, const float i_alpha );
+
+			// Initialize / Clean Up
+			//----------------------
+
+			// If the thread count is 0 then one thread is used for every hardware thread
+			cResult Initialize( const unsigned int i_width, const unsigned int i_height, const unsigned int i_threadCount = 0 );
+			cResult CleanUp();
+
+			cRasterizer() = default;
+			~cRasterizer();
+
+			// Data
+			//=====
+
+		private:
+
+			// A triangle that has been set up for rasterizing:
+			// every value is a plane equation in pixel coordinates (value = a*x + b*y + c)
+			struct sTriangle
+			{
+				// Edge functions (a pixel is covered when all three are inside)
+				float edge_a[3], edge_b[3], edge_c[3];
+				// Pixels that are exactly on an edge are only covered if it is a top or left edge
+				// (this is the same rule that GPUs use, so that pixels on shared edges are only drawn once)
+				bool isEdgeInclusive[3];
+				// Depth in the [0,1] range of Direct3D
+				float depth_a, depth_b, depth_c;
+				// Bounding rectangle in pixels (inclusive)
+				int32_t minX, minY, maxX, maxY;
+				uint32_t color;
+				uint8_t renderStateBits;
+			};
+
+			unsigned int m_width = 0, m_height = 0;
+			// The buffers are padded to a whole number of tiles
+			// so that rasterizing never needs to check for the edge of the screen
+			unsigned int m_tileCountX = 0, m_tileCountY = 0;
+			unsigned int m_stride = 0;
+			std::vector<uint32_t> m_colorBuffer;
+			std::vector<float> m_depthBuffer;
+
+			// Frame data
+			//	(the memory is kept from frame to frame,
+			//	and so once it has grown large enough for a typical frame drawing doesn't allocate)
+			std::vector<sTriangle> m_triangles;
+			// Every tile has a list of the triangles that might touch it, in the order that they were drawn
+			std::vector<std::vector<uint32_t>> m_tileBins;
+			uint32_t m_clearColor = 0;
+			bool m_shouldClear = false;
+			sStatistics m_statistics;
+
+			// The presented frame can be read by any thread
+			std::vector<uint32_t> m_presentedFrame;
+			sStatistics m_statistics_presentedFrame;
+			mutable std::mutex m_mutex_presentedFrame;
+
+			// Worker pool
+			//	(the render thread rasterizes tiles too, and so there is one fewer worker than threads)
+			std::vector<std::thread> m_workerThreads;
+			std::mutex m_mutex_workers;
+			std::condition_variable m_condition_workStarted;
+			std::condition_variable m_condition_workFinished;
+			// This increases every time there is a new batch of tiles to rasterize
+			uint64_t m_workGeneration = 0;
+			unsigned int m_workingWorkerCount = 0;
+			bool m_shouldWorkersExit = false;
+			std::atomic<unsigned int> m_nextTileIndex{ 0 };
+			std::atomic<uint64_t> m_pixelCount_written{ 0 };
+
+			// Implementation
+			//===============
+
+		private:
+
+			// Render
+			//-------
+
+			// Both sizes of indices are drawn the same way
+			template <typename tIndex>
+			void DrawIndexedTriangles( const sVertex_projected* const i_vertices, const unsigned int i_vertexCount,
+				const tIndex* const i_indices, const unsigned int i_indexCount,
+				const uint8_t i_renderStateBits, const uint32_t i_color );
+			void SetUpAndBinTriangle( const sVertex_projected& i_vertex0, const sVertex_projected& i_vertex1, const sVertex_projected& i_vertex2,
+				const uint8_t i_renderStateBits, const uint32_t i_color );
+			void RasterizeBinnedTiles();
+			void RasterizeTiles();
+			uint64_t RasterizeTile( const unsigned int i_tileIndex );
+			uint64_t RasterizeTriangleInTile( const sTriangle& i_triangle,
+				const int32_t i_tileMinX, const int32_t i_tileMinY, const int32_t i_tileMaxX, const int32_t i_tileMaxY );
+
+			// Worker pool
+			//------------
+
+			void WorkerThreadFunction();
+
+			// Initialize / Clean Up
+			//----------------------
+
+			cRasterizer( const cRasterizer& ) = delete;
+			cRasterizer( cRasterizer&& ) = delete;
+			cRasterizer& operator =( const cRasterizer& ) = delete;
+			cRasterizer& operator =( cRasterizer&& ) = delete;
+		};
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_SOFTWARE_CRASTERIZER_H
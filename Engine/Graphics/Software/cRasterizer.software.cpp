@@ -0,0 +1,680 @@
+// Includes
+//=========
+
+#include "cRasterizer.h"
+
+#include "../cRenderState.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <Engine/Asserts/Asserts.h>
+
+// The edge functions and depth test are evaluated for four pixels at a time.
+// Every x64 CPU has SSE2; other CPUs evaluate the four pixels one at a time
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+	#define EAE6320_GRAPHICS_SOFTWARE_ISSSE2AVAILABLE
+	#include <emmintrin.h>
+#endif
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	constexpr unsigned int s_simdWidth = 4;
+	static_assert( ( eae6320::Graphics::cRasterizer::tileSize % s_simdWidth ) == 0, "A tile row must be a whole number of SIMD blocks" );
+
+	// Vertex positions are snapped to 1/16 of a pixel
+	// (like a GPU does) so that edges that are shared by two triangles are evaluated identically
+	constexpr float s_subpixelPrecision = 16.0f;
+
+	// A projected vertex is inside the view when -w <= x <= w, -w <= y <= w, and 0 <= z <= w
+	// (the [0,1] depth range matches Direct3D)
+	constexpr unsigned int s_clipPlaneCount = 6;
+	constexpr unsigned int s_maxClippedVertexCount = 3 + s_clipPlaneCount;
+	float CalculateDistanceToClipPlane( const eae6320::Graphics::sVertex_projected& i_vertex, const unsigned int i_planeIndex );
+	uint8_t CalculateOutCode( const eae6320::Graphics::sVertex_projected& i_vertex );
+	// Returns the number of vertices in the output polygon
+	unsigned int ClipPolygon( const eae6320::Graphics::sVertex_projected* const i_vertices, const unsigned int i_vertexCount,
+		const unsigned int i_planeIndex, eae6320::Graphics::sVertex_projected* const o_vertices );
+
+	uint32_t BlendColor_alphaTransparency( const uint32_t i_source, const uint32_t i_destination );
+}
+
+// Interface
+//==========
+
+// Render
+//-------
+
+void eae6320::Graphics::cRasterizer::Clear( const float* const i_clearColor )
+{
+	EAE6320_ASSERT( i_clearColor != nullptr );
+
+	// Anything drawn before the clear has to be rasterized first
+	// (this shouldn't happen in a typical frame, where clearing is the first thing that is done)
+	if ( !m_triangles.empty() )
+	{
+		RasterizeBinnedTiles();
+	}
+	m_clearColor = PackColor( i_clearColor[0], i_clearColor[1], i_clearColor[2], i_clearColor[3] );
+	m_shouldClear = true;
+}
+
+void eae6320::Graphics::cRasterizer::DrawIndexed( const sVertex_projected* const i_vertices, const unsigned int i_vertexCount,
+	const uint16_t* const i_indices, const unsigned int i_indexCount,
+	const uint8_t i_renderStateBits, const uint32_t i_color )
+{
+	DrawIndexedTriangles( i_vertices, i_vertexCount, i_indices, i_indexCount, i_renderStateBits, i_color );
+}
+
+void eae6320::Graphics::cRasterizer::DrawIndexed( const sVertex_projected* const i_vertices, const unsigned int i_vertexCount,
+	const uint32_t* const i_indices, const unsigned int i_indexCount,
+	const uint8_t i_renderStateBits, const uint32_t i_color )
+{
+	DrawIndexedTriangles( i_vertices, i_vertexCount, i_indices, i_indexCount, i_renderStateBits, i_color );
+}
+
+void eae6320::Graphics::cRasterizer::Present()
+{
+	const auto startTime = std::chrono::steady_clock::now();
+	RasterizeBinnedTiles();
+	m_statistics.rasterizationSeconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - startTime ).count();
+
+	// Copy the visible part of the color buffer
+	{
+		std::lock_guard<std::mutex> lock( m_mutex_presentedFrame );
+		m_presentedFrame.resize( static_cast<size_t>( m_width ) * m_height );
+		for ( unsigned int y = 0; y < m_height; ++y )
+		{
+			std::copy_n( m_colorBuffer.data() + ( static_cast<size_t>( y ) * m_stride ), m_width,
+				m_presentedFrame.data() + ( static_cast<size_t>( y ) * m_width ) );
+		}
+		m_statistics_presentedFrame = m_statistics;
+	}
+	m_statistics = sStatistics();
+}
+
+// Access
+//-------
+
+void eae6320::Graphics::cRasterizer::GetPresentedFrame( std::vector<uint32_t>& o_pixels ) const
+{
+	std::lock_guard<std::mutex> lock( m_mutex_presentedFrame );
+	o_pixels.assign( m_presentedFrame.begin(), m_presentedFrame.end() );
+}
+
+eae6320::Graphics::cRasterizer::sStatistics eae6320::Graphics::cRasterizer::GetStatistics_lastFrame() const
+{
+	std::lock_guard<std::mutex> lock( m_mutex_presentedFrame );
+	return m_statistics_presentedFrame;
+}
+
+uint32_t eae6320::Graphics::cRasterizer::PackColor( const float i_red, const float i_green, const float i_blue, const float i_alpha )
+{
+	const auto ConvertToByte = []( const float i_value ) -> uint32_t
+	{
+		return static_cast<uint32_t>( ( std::min( std::max( i_value, 0.0f ), 1.0f ) * 255.0f ) + 0.5f );
+	};
+	// This assumes a little-endian CPU (which every platform that the engine runs on is)
+	return ConvertToByte( i_red ) | ( ConvertToByte( i_green ) << 8 ) | ( ConvertToByte( i_blue ) << 16 ) | ( ConvertToByte( i_alpha ) << 24 );
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cRasterizer::Initialize( const unsigned int i_width, const unsigned int i_height, const unsigned int i_threadCount )
+{
+	EAE6320_ASSERT( m_workerThreads.empty() );
+	if ( ( i_width == 0 ) || ( i_height == 0 ) )
+	{
+		EAE6320_ASSERTF( false, "The software rasterizer needs a resolution" );
+		return Results::InvalidFile;
+	}
+
+	m_width = i_width;
+	m_height = i_height;
+	m_tileCountX = ( i_width + tileSize - 1 ) / tileSize;
+	m_tileCountY = ( i_height + tileSize - 1 ) / tileSize;
+	m_stride = m_tileCountX * tileSize;
+	const auto paddedPixelCount = static_cast<size_t>( m_stride ) * ( m_tileCountY * tileSize );
+	m_colorBuffer.assign( paddedPixelCount, 0 );
+	m_depthBuffer.assign( paddedPixelCount, 1.0f );
+	m_tileBins.resize( static_cast<size_t>( m_tileCountX ) * m_tileCountY );
+	m_presentedFrame.assign( static_cast<size_t>( m_width ) * m_height, 0 );
+
+	// Start the worker threads
+	{
+		auto threadCount = i_threadCount;
+		if ( threadCount == 0 )
+		{
+			threadCount = std::max( std::thread::hardware_concurrency(), 1u );
+		}
+		m_shouldWorkersExit = false;
+		m_workerThreads.reserve( threadCount - 1 );
+		for ( unsigned int i = 1; i < threadCount; ++i )
+		{
+			m_workerThreads.emplace_back( &cRasterizer::WorkerThreadFunction, this );
+		}
+	}
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::cRasterizer::CleanUp()
+{
+	{
+		std::lock_guard<std::mutex> lock( m_mutex_workers );
+		m_shouldWorkersExit = true;
+	}
+	m_condition_workStarted.notify_all();
+	for ( auto& workerThread : m_workerThreads )
+	{
+		workerThread.join();
+	}
+	m_workerThreads.clear();
+
+	m_triangles.clear();
+	m_tileBins.clear();
+	m_colorBuffer.clear();
+	m_depthBuffer.clear();
+	m_shouldClear = false;
+
+	return Results::Success;
+}
+
+eae6320::Graphics::cRasterizer::~cRasterizer()
+{
+	const auto result = CleanUp();
+	EAE6320_ASSERT( result );
+}
+
+// Implementation
+//===============
+
+// Render
+//-------
+
+template <typename tIndex>
+void eae6320::Graphics::cRasterizer::DrawIndexedTriangles( const sVertex_projected* const i_vertices, const unsigned int i_vertexCount,
+	const tIndex* const i_indices, const unsigned int i_indexCount,
+	const uint8_t i_renderStateBits, const uint32_t i_color )
+{
+	EAE6320_ASSERT( ( i_indexCount % 3 ) == 0 );
+	EAE6320_ASSERT( ( i_vertices != nullptr ) || ( i_vertexCount == 0 ) );
+
+	for ( unsigned int i = 0; ( i + 2 ) < i_indexCount; i += 3 )
+	{
+		++m_statistics.triangleCount_submitted;
+		const auto index0 = i_indices[i], index1 = i_indices[i + 1], index2 = i_indices[i + 2];
+		EAE6320_ASSERT( ( index0 < i_vertexCount ) && ( index1 < i_vertexCount ) && ( index2 < i_vertexCount ) );
+		if ( ( index0 >= i_vertexCount ) || ( index1 >= i_vertexCount ) || ( index2 >= i_vertexCount ) )
+		{
+			++m_statistics.triangleCount_culled;
+			continue;
+		}
+		const auto& vertex0 = i_vertices[index0];
+		const auto& vertex1 = i_vertices[index1];
+		const auto& vertex2 = i_vertices[index2];
+
+		const auto outCode0 = CalculateOutCode( vertex0 ), outCode1 = CalculateOutCode( vertex1 ), outCode2 = CalculateOutCode( vertex2 );
+		if ( ( outCode0 & outCode1 & outCode2 ) != 0 )
+		{
+			// Every vertex is outside of the same plane
+			++m_statistics.triangleCount_culled;
+		}
+		else if ( ( outCode0 | outCode1 | outCode2 ) == 0 )
+		{
+			// Every vertex is inside of every plane
+			SetUpAndBinTriangle( vertex0, vertex1, vertex2, i_renderStateBits, i_color );
+		}
+		else
+		{
+			// Clip the triangle against every plane that it crosses
+			// and then draw the resulting convex polygon as a fan of triangles
+			sVertex_projected polygons[2][s_maxClippedVertexCount] = { { vertex0, vertex1, vertex2 } };
+			unsigned int vertexCount = 3;
+			unsigned int inputIndex = 0;
+			const auto outCode_any = outCode0 | outCode1 | outCode2;
+			for ( unsigned int planeIndex = 0; ( planeIndex < s_clipPlaneCount ) && ( vertexCount >= 3 ); ++planeIndex )
+			{
+				if ( ( outCode_any & ( 1u << planeIndex ) ) != 0 )
+				{
+					vertexCount = ClipPolygon( polygons[inputIndex], vertexCount, planeIndex, polygons[1 - inputIndex] );
+					inputIndex = 1 - inputIndex;
+				}
+			}
+			if ( vertexCount < 3 )
+			{
+				++m_statistics.triangleCount_culled;
+			}
+			for ( unsigned int j = 2; j < vertexCount; ++j )
+			{
+				SetUpAndBinTriangle( polygons[inputIndex][0], polygons[inputIndex][j - 1], polygons[inputIndex][j],
+					i_renderStateBits, i_color );
+			}
+		}
+	}
+}
+
+void eae6320::Graphics::cRasterizer::SetUpAndBinTriangle( const sVertex_projected& i_vertex0, const sVertex_projected& i_vertex1, const sVertex_projected& i_vertex2,
+	const uint8_t i_renderStateBits, const uint32_t i_color )
+{
+	// Convert from projected space to pixels
+	// (y is flipped because pixel rows go from top to bottom)
+	float x[3], y[3], z[3];
+	{
+		const sVertex_projected* const vertices[3] = { &i_vertex0, &i_vertex1, &i_vertex2 };
+		for ( unsigned int i = 0; i < 3; ++i )
+		{
+			const auto oneOverW = 1.0f / vertices[i]->w;
+			x[i] = std::round( ( ( vertices[i]->x * oneOverW ) * 0.5f + 0.5f ) * static_cast<float>( m_width ) * s_subpixelPrecision ) / s_subpixelPrecision;
+			y[i] = std::round( ( 0.5f - ( vertices[i]->y * oneOverW ) * 0.5f ) * static_cast<float>( m_height ) * s_subpixelPrecision ) / s_subpixelPrecision;
+			z[i] = vertices[i]->z * oneOverW;
+		}
+	}
+
+	// Front-facing triangles are clockwise on screen, which has a positive area when y goes down
+	auto area = ( ( x[1] - x[0] ) * ( y[2] - y[0] ) ) - ( ( y[1] - y[0] ) * ( x[2] - x[0] ) );
+	if ( area == 0.0f )
+	{
+		++m_statistics.triangleCount_culled;
+		return;
+	}
+	if ( area < 0.0f )
+	{
+		if ( !RenderStates::ShouldBothTriangleSidesBeDrawn( i_renderStateBits ) )
+		{
+			++m_statistics.triangleCount_culled;
+			return;
+		}
+		// Back-facing triangles are rasterized the same way as front-facing ones
+		std::swap( x[1], x[2] );
+		std::swap( y[1], y[2] );
+		std::swap( z[1], z[2] );
+		area = -area;
+	}
+
+	sTriangle triangle;
+	// Bounding rectangle of the pixel centers that could be covered
+	{
+		const auto minX = std::min( { x[0], x[1], x[2] } ), maxX = std::max( { x[0], x[1], x[2] } );
+		const auto minY = std::min( { y[0], y[1], y[2] } ), maxY = std::max( { y[0], y[1], y[2] } );
+		triangle.minX = std::max( static_cast<int32_t>( std::ceil( minX - 0.5f ) ), 0 );
+		triangle.minY = std::max( static_cast<int32_t>( std::ceil( minY - 0.5f ) ), 0 );
+		triangle.maxX = std::min( static_cast<int32_t>( std::floor( maxX - 0.5f ) ), static_cast<int32_t>( m_width ) - 1 );
+		triangle.maxY = std::min( static_cast<int32_t>( std::floor( maxY - 0.5f ) ), static_cast<int32_t>( m_height ) - 1 );
+		if ( ( triangle.minX > triangle.maxX ) || ( triangle.minY > triangle.maxY ) )
+		{
+			// The triangle doesn't cover any pixel centers
+			++m_statistics.triangleCount_culled;
+			return;
+		}
+	}
+	// Edge functions
+	//	(edge i goes from vertex i to vertex i+1, and is positive on the side of the remaining vertex)
+	for ( unsigned int i = 0; i < 3; ++i )
+	{
+		const auto j = ( i + 1 ) % 3;
+		const auto a = y[i] - y[j];
+		const auto b = x[j] - x[i];
+		triangle.edge_a[i] = a;
+		triangle.edge_b[i] = b;
+		triangle.edge_c[i] = -( ( a * x[i] ) + ( b * y[i] ) );
+		// A left edge's inside is to the right, and a top edge's inside is below
+		triangle.isEdgeInclusive[i] = ( a > 0.0f ) || ( ( a == 0.0f ) && ( b > 0.0f ) );
+	}
+	// Depth is interpolated linearly in screen space
+	//	(the weight of vertex 1 is the edge opposite of it (2) divided by the area,
+	//	and the weight of vertex 2 is the edge opposite of it (0) divided by the area)
+	{
+		const auto oneOverArea = 1.0f / area;
+		const auto depthDelta1 = ( z[1] - z[0] ) * oneOverArea;
+		const auto depthDelta2 = ( z[2] - z[0] ) * oneOverArea;
+		triangle.depth_a = ( depthDelta1 * triangle.edge_a[2] ) + ( depthDelta2 * triangle.edge_a[0] );
+		triangle.depth_b = ( depthDelta1 * triangle.edge_b[2] ) + ( depthDelta2 * triangle.edge_b[0] );
+		triangle.depth_c = z[0] + ( depthDelta1 * triangle.edge_c[2] ) + ( depthDelta2 * triangle.edge_c[0] );
+	}
+	triangle.color = i_color;
+	triangle.renderStateBits = i_renderStateBits;
+
+	// Bin the triangle into every tile that it touches
+	const auto triangleIndex = static_cast<uint32_t>( m_triangles.size() );
+	m_triangles.push_back( triangle );
+	++m_statistics.triangleCount_binned;
+	const auto tileMinX = static_cast<unsigned int>( triangle.minX ) / tileSize, tileMaxX = static_cast<unsigned int>( triangle.maxX ) / tileSize;
+	const auto tileMinY = static_cast<unsigned int>( triangle.minY ) / tileSize, tileMaxY = static_cast<unsigned int>( triangle.maxY ) / tileSize;
+	for ( auto tileY = tileMinY; tileY <= tileMaxY; ++tileY )
+	{
+		for ( auto tileX = tileMinX; tileX <= tileMaxX; ++tileX )
+		{
+			// A tile can be skipped when any edge is outside at the tile's corner that is the most inside
+			// (a large triangle's bounding rectangle often includes tiles that the triangle doesn't touch)
+			const auto tileLeft = static_cast<float>( tileX * tileSize ) + 0.5f, tileRight = tileLeft + static_cast<float>( tileSize - 1 );
+			const auto tileTop = static_cast<float>( tileY * tileSize ) + 0.5f, tileBottom = tileTop + static_cast<float>( tileSize - 1 );
+			auto isTileOutside = false;
+			for ( unsigned int i = 0; i < 3; ++i )
+			{
+				const auto cornerX = ( triangle.edge_a[i] > 0.0f ) ? tileRight : tileLeft;
+				const auto cornerY = ( triangle.edge_b[i] > 0.0f ) ? tileBottom : tileTop;
+				if ( ( ( triangle.edge_a[i] * cornerX ) + ( triangle.edge_b[i] * cornerY ) + triangle.edge_c[i] ) < 0.0f )
+				{
+					isTileOutside = true;
+					break;
+				}
+			}
+			if ( !isTileOutside )
+			{
+				m_tileBins[( static_cast<size_t>( tileY ) * m_tileCountX ) + tileX].push_back( triangleIndex );
+				++m_statistics.tileTriangleCount;
+			}
+		}
+	}
+}
+
+void eae6320::Graphics::cRasterizer::RasterizeBinnedTiles()
+{
+	if ( m_triangles.empty() && !m_shouldClear )
+	{
+		return;
+	}
+
+	m_nextTileIndex.store( 0, std::memory_order_relaxed );
+	m_pixelCount_written.store( 0, std::memory_order_relaxed );
+	// Wake up the workers
+	//	(the mutex makes everything that was binned visible to them)
+	{
+		std::lock_guard<std::mutex> lock( m_mutex_workers );
+		++m_workGeneration;
+		m_workingWorkerCount = static_cast<unsigned int>( m_workerThreads.size() );
+	}
+	m_condition_workStarted.notify_all();
+	// The render thread rasterizes tiles too instead of only waiting
+	RasterizeTiles();
+	{
+		std::unique_lock<std::mutex> lock( m_mutex_workers );
+		m_condition_workFinished.wait( lock, [this] { return m_workingWorkerCount == 0; } );
+	}
+	m_statistics.pixelCount_written += m_pixelCount_written.load( std::memory_order_relaxed );
+
+	// The memory is kept for the next batch
+	m_triangles.clear();
+	for ( auto& tileBin : m_tileBins )
+	{
+		tileBin.clear();
+	}
+	m_shouldClear = false;
+}
+
+void eae6320::Graphics::cRasterizer::RasterizeTiles()
+{
+	const auto tileCount = static_cast<unsigned int>( m_tileBins.size() );
+	uint64_t pixelCount_written = 0;
+	for ( auto tileIndex = m_nextTileIndex.fetch_add( 1, std::memory_order_relaxed ); tileIndex < tileCount;
+		tileIndex = m_nextTileIndex.fetch_add( 1, std::memory_order_relaxed ) )
+	{
+		pixelCount_written += RasterizeTile( tileIndex );
+	}
+	m_pixelCount_written.fetch_add( pixelCount_written, std::memory_order_relaxed );
+}
+
+uint64_t eae6320::Graphics::cRasterizer::RasterizeTile( const unsigned int i_tileIndex )
+{
+	const auto& tileBin = m_tileBins[i_tileIndex];
+	const auto tileMinX = static_cast<int32_t>( ( i_tileIndex % m_tileCountX ) * tileSize );
+	const auto tileMinY = static_cast<int32_t>( ( i_tileIndex / m_tileCountX ) * tileSize );
+	if ( m_shouldClear )
+	{
+		for ( unsigned int y = 0; y < tileSize; ++y )
+		{
+			const auto offset = ( static_cast<size_t>( tileMinY + y ) * m_stride ) + tileMinX;
+			std::fill_n( m_colorBuffer.data() + offset, tileSize, m_clearColor );
+			std::fill_n( m_depthBuffer.data() + offset, tileSize, 1.0f );
+		}
+	}
+	uint64_t pixelCount_written = 0;
+	for ( const auto triangleIndex : tileBin )
+	{
+		pixelCount_written += RasterizeTriangleInTile( m_triangles[triangleIndex],
+			tileMinX, tileMinY, tileMinX + static_cast<int32_t>( tileSize ) - 1, tileMinY + static_cast<int32_t>( tileSize ) - 1 );
+	}
+	return pixelCount_written;
+}
+
+uint64_t eae6320::Graphics::cRasterizer::RasterizeTriangleInTile( const sTriangle& i_triangle,
+	const int32_t i_tileMinX, const int32_t i_tileMinY, const int32_t i_tileMaxX, const int32_t i_tileMaxY )
+{
+	const auto minX = std::max( i_triangle.minX, i_tileMinX ), maxX = std::min( i_triangle.maxX, i_tileMaxX );
+	const auto minY = std::max( i_triangle.minY, i_tileMinY ), maxY = std::min( i_triangle.maxY, i_tileMaxY );
+	// Every block of pixels starts at a multiple of the SIMD width
+	// (tiles start at a multiple of it, and so a block never crosses into another tile)
+	const auto blockMinX = minX - ( ( minX - i_tileMinX ) % static_cast<int32_t>( s_simdWidth ) );
+	const auto isDepthTestingEnabled = RenderStates::IsDepthTestingEnabled( i_triangle.renderStateBits );
+	const auto isDepthWritingEnabled = RenderStates::IsDepthWritingEnabled( i_triangle.renderStateBits );
+	const auto isAlphaTransparencyEnabled = RenderStates::IsAlphaTransparencyEnabled( i_triangle.renderStateBits );
+	uint64_t pixelCount_written = 0;
+
+#if defined( EAE6320_GRAPHICS_SOFTWARE_ISSSE2AVAILABLE )
+	const auto laneOffsets = _mm_set_ps( 3.5f, 2.5f, 1.5f, 0.5f );
+	const auto zero = _mm_setzero_ps();
+	const auto minPixelCenterX = _mm_set1_ps( static_cast<float>( minX ) + 0.5f );
+	const auto maxPixelCenterX = _mm_set1_ps( static_cast<float>( maxX ) + 0.5f );
+	const auto color = _mm_set1_epi32( static_cast<int>( i_triangle.color ) );
+	__m128 edge_a[3];
+	for ( unsigned int i = 0; i < 3; ++i )
+	{
+		edge_a[i] = _mm_set1_ps( i_triangle.edge_a[i] );
+	}
+	const auto depth_a = _mm_set1_ps( i_triangle.depth_a );
+	for ( auto y = minY; y <= maxY; ++y )
+	{
+		const auto pixelCenterY = static_cast<float>( y ) + 0.5f;
+		// The parts of the plane equations that only depend on y are the same for the whole row
+		__m128 edge_row[3];
+		for ( unsigned int i = 0; i < 3; ++i )
+		{
+			edge_row[i] = _mm_set1_ps( ( i_triangle.edge_b[i] * pixelCenterY ) + i_triangle.edge_c[i] );
+		}
+		const auto depth_row = _mm_set1_ps( ( i_triangle.depth_b * pixelCenterY ) + i_triangle.depth_c );
+		auto* const colorRow = m_colorBuffer.data() + ( static_cast<size_t>( y ) * m_stride );
+		auto* const depthRow = m_depthBuffer.data() + ( static_cast<size_t>( y ) * m_stride );
+		for ( auto x = blockMinX; x <= maxX; x += static_cast<int32_t>( s_simdWidth ) )
+		{
+			const auto pixelCenterX = _mm_add_ps( _mm_set1_ps( static_cast<float>( x ) ), laneOffsets );
+			auto mask = _mm_and_ps( _mm_cmpge_ps( pixelCenterX, minPixelCenterX ), _mm_cmple_ps( pixelCenterX, maxPixelCenterX ) );
+			for ( unsigned int i = 0; i < 3; ++i )
+			{
+				const auto edge = _mm_add_ps( _mm_mul_ps( edge_a[i], pixelCenterX ), edge_row[i] );
+				mask = _mm_and_ps( mask, i_triangle.isEdgeInclusive[i] ? _mm_cmpge_ps( edge, zero ) : _mm_cmpgt_ps( edge, zero ) );
+			}
+			if ( _mm_movemask_ps( mask ) == 0 )
+			{
+				continue;
+			}
+			const auto depth = _mm_add_ps( _mm_mul_ps( depth_a, pixelCenterX ), depth_row );
+			const auto depth_previous = _mm_loadu_ps( depthRow + x );
+			if ( isDepthTestingEnabled )
+			{
+				mask = _mm_and_ps( mask, _mm_cmplt_ps( depth, depth_previous ) );
+			}
+			const auto laneMask = _mm_movemask_ps( mask );
+			if ( laneMask == 0 )
+			{
+				continue;
+			}
+			if ( isDepthWritingEnabled )
+			{
+				_mm_storeu_ps( depthRow + x, _mm_or_ps( _mm_and_ps( mask, depth ), _mm_andnot_ps( mask, depth_previous ) ) );
+			}
+			if ( isAlphaTransparencyEnabled )
+			{
+				for ( unsigned int lane = 0; lane < s_simdWidth; ++lane )
+				{
+					if ( ( laneMask & ( 1 << lane ) ) != 0 )
+					{
+						colorRow[x + lane] = BlendColor_alphaTransparency( i_triangle.color, colorRow[x + lane] );
+					}
+				}
+			}
+			else
+			{
+				auto* const colors = reinterpret_cast<__m128i*>( colorRow + x );
+				const auto mask_integer = _mm_castps_si128( mask );
+				_mm_storeu_si128( colors, _mm_or_si128( _mm_and_si128( mask_integer, color ), _mm_andnot_si128( mask_integer, _mm_loadu_si128( colors ) ) ) );
+			}
+			pixelCount_written += ( laneMask & 1 ) + ( ( laneMask >> 1 ) & 1 ) + ( ( laneMask >> 2 ) & 1 ) + ( ( laneMask >> 3 ) & 1 );
+		}
+	}
+#else
+	for ( auto y = minY; y <= maxY; ++y )
+	{
+		const auto pixelCenterY = static_cast<float>( y ) + 0.5f;
+		float edge_row[3];
+		for ( unsigned int i = 0; i < 3; ++i )
+		{
+			edge_row[i] = ( i_triangle.edge_b[i] * pixelCenterY ) + i_triangle.edge_c[i];
+		}
+		const auto depth_row = ( i_triangle.depth_b * pixelCenterY ) + i_triangle.depth_c;
+		auto* const colorRow = m_colorBuffer.data() + ( static_cast<size_t>( y ) * m_stride );
+		auto* const depthRow = m_depthBuffer.data() + ( static_cast<size_t>( y ) * m_stride );
+		for ( auto x = minX; x <= maxX; ++x )
+		{
+			const auto pixelCenterX = static_cast<float>( x ) + 0.5f;
+			auto isCovered = true;
+			for ( unsigned int i = 0; isCovered && ( i < 3 ); ++i )
+			{
+				const auto edge = ( i_triangle.edge_a[i] * pixelCenterX ) + edge_row[i];
+				isCovered = i_triangle.isEdgeInclusive[i] ? ( edge >= 0.0f ) : ( edge > 0.0f );
+			}
+			if ( !isCovered )
+			{
+				continue;
+			}
+			const auto depth = ( i_triangle.depth_a * pixelCenterX ) + depth_row;
+			if ( isDepthTestingEnabled && !( depth < depthRow[x] ) )
+			{
+				continue;
+			}
+			if ( isDepthWritingEnabled )
+			{
+				depthRow[x] = depth;
+			}
+			colorRow[x] = isAlphaTransparencyEnabled ? BlendColor_alphaTransparency( i_triangle.color, colorRow[x] ) : i_triangle.color;
+			++pixelCount_written;
+		}
+	}
+	static_cast<void>( blockMinX );
+#endif
+
+	return pixelCount_written;
+}
+
+// Worker pool
+//------------
+
+void eae6320::Graphics::cRasterizer::WorkerThreadFunction()
+{
+	uint64_t lastWorkGeneration = 0;
+	for ( ;; )
+	{
+		{
+			std::unique_lock<std::mutex> lock( m_mutex_workers );
+			m_condition_workStarted.wait( lock, [this, lastWorkGeneration] { return m_shouldWorkersExit || ( m_workGeneration != lastWorkGeneration ); } );
+			if ( m_shouldWorkersExit )
+			{
+				return;
+			}
+			lastWorkGeneration = m_workGeneration;
+		}
+		RasterizeTiles();
+		{
+			std::lock_guard<std::mutex> lock( m_mutex_workers );
+			EAE6320_ASSERT( m_workingWorkerCount > 0 );
+			if ( --m_workingWorkerCount == 0 )
+			{
+				m_condition_workFinished.notify_one();
+			}
+		}
+	}
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	float CalculateDistanceToClipPlane( const eae6320::Graphics::sVertex_projected& i_vertex, const unsigned int i_planeIndex )
+	{
+		switch ( i_planeIndex )
+		{
+		case 0: return i_vertex.w + i_vertex.x;
+		case 1: return i_vertex.w - i_vertex.x;
+		case 2: return i_vertex.w + i_vertex.y;
+		case 3: return i_vertex.w - i_vertex.y;
+		case 4: return i_vertex.z;
+		default: return i_vertex.w - i_vertex.z;
+		}
+	}
+
+	uint8_t CalculateOutCode( const eae6320::Graphics::sVertex_projected& i_vertex )
+	{
+		uint8_t outCode = 0;
+		for ( unsigned int i = 0; i < s_clipPlaneCount; ++i )
+		{
+			if ( CalculateDistanceToClipPlane( i_vertex, i ) < 0.0f )
+			{
+				outCode |= static_cast<uint8_t>( 1u << i );
+			}
+		}
+		return outCode;
+	}
+
+	unsigned int ClipPolygon( const eae6320::Graphics::sVertex_projected* const i_vertices, const unsigned int i_vertexCount,
+		const unsigned int i_planeIndex, eae6320::Graphics::sVertex_projected* const o_vertices )
+	{
+		unsigned int outputVertexCount = 0;
+		for ( unsigned int i = 0; i < i_vertexCount; ++i )
+		{
+			const auto& vertex_current = i_vertices[i];
+			const auto& vertex_next = i_vertices[( i + 1 ) % i_vertexCount];
+			const auto distance_current = CalculateDistanceToClipPlane( vertex_current, i_planeIndex );
+			const auto distance_next = CalculateDistanceToClipPlane( vertex_next, i_planeIndex );
+			if ( distance_current >= 0.0f )
+			{
+				o_vertices[outputVertexCount++] = vertex_current;
+			}
+			if ( ( distance_current >= 0.0f ) != ( distance_next >= 0.0f ) )
+			{
+				// Add the point where the edge crosses the plane
+				const auto t = distance_current / ( distance_current - distance_next );
+				auto& vertex_intersection = o_vertices[outputVertexCount++];
+				vertex_intersection.x = vertex_current.x + ( ( vertex_next.x - vertex_current.x ) * t );
+				vertex_intersection.y = vertex_current.y + ( ( vertex_next.y - vertex_current.y ) * t );
+				vertex_intersection.z = vertex_current.z + ( ( vertex_next.z - vertex_current.z ) * t );
+				vertex_intersection.w = vertex_current.w + ( ( vertex_next.w - vertex_current.w ) * t );
+			}
+		}
+		EAE6320_ASSERT( outputVertexCount <= s_maxClippedVertexCount );
+		return outputVertexCount;
+	}
+
+	uint32_t BlendColor_alphaTransparency( const uint32_t i_source, const uint32_t i_destination )
+	{
+		// This matches the blend state that the other platforms use:
+		//	color = ( source * sourceAlpha ) + ( destination * ( 1 - sourceAlpha ) )
+		//	alpha = sourceAlpha + ( destinationAlpha * ( 1 - sourceAlpha ) )
+		const auto sourceAlpha = ( i_source >> 24 ) & 0xff;
+		const auto oneMinusSourceAlpha = 255 - sourceAlpha;
+		uint32_t result = 0;
+		for ( unsigned int shift = 0; shift < 24; shift += 8 )
+		{
+			const auto source = ( i_source >> shift ) & 0xff;
+			const auto destination = ( i_destination >> shift ) & 0xff;
+			result |= ( ( ( source * sourceAlpha ) + ( destination * oneMinusSourceAlpha ) + 127 ) / 255 ) << shift;
+		}
+		const auto destinationAlpha = ( i_destination >> 24 ) & 0xff;
+		result |= ( sourceAlpha + ( ( ( destinationAlpha * oneMinusSourceAlpha ) + 127 ) / 255 ) ) << 24;
+		return result;
+	}
+}
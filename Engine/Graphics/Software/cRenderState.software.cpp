@@ -0,0 +1,39 @@
+// Includes
+//=========
+
+#include "../cRenderState.h"
+#include "../sContext.h"
+
+#include <Engine/Asserts/Asserts.h>
+
+// Interface
+//==========
+
+// Render
+//-------
+
+void eae6320::Graphics::cRenderState::Bind() const
+{
+	EAE6320_ASSERT( m_bits != g_invalidRenderStateBits );
+	// Every triangle that is drawn remembers the bits that were bound when it was drawn
+	sContext::g_context.renderStateBits = m_bits;
+}
+
+// Implementation
+//===============
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cRenderState::Initialize( const uint8_t i_renderStateBits )
+{
+	m_bits = i_renderStateBits;
+
+	// The rasterizer reads the bits directly
+	return Results::Success;
+}
+
+eae6320::Graphics::cRenderState::~cRenderState()
+{
+
+}
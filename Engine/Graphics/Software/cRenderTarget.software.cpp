@@ -0,0 +1,39 @@
+// Includes
+//=========
+
+#include "../cRenderTarget.h"
+#include "../Graphics.h"
+#include "../sContext.h"
+
+#include <Engine/Asserts/Asserts.h>
+
+// Render
+//-------
+
+void eae6320::Graphics::cRenderTarget::ClearBuffer(float* i_clearColor)
+{
+	EAE6320_ASSERT(i_clearColor != nullptr);
+	// The color and depth buffers are both cleared
+	// (this is done by the worker threads when the frame is rasterized)
+	sContext::g_context.rasterizer.Clear(i_clearColor);
+}
+
+void eae6320::Graphics::cRenderTarget::SwapBuffer()
+{
+	// Everything that was drawn since the last swap is rasterized and becomes the presented frame
+	sContext::g_context.rasterizer.Present();
+}
+
+// Initialize / Clean Up
+//--------------------------
+eae6320::cResult eae6320::Graphics::cRenderTarget::Initialize(const sInitializationParameters& i_initializationParameters)
+{
+	// The color and depth buffers belong to the rasterizer
+	// (which is initialized with the context)
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::cRenderTarget::CleanUp()
+{
+	return Results::Success;
+}
@@ -0,0 +1,28 @@
+// Includes
+//=========
+
+#include "../cShader.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Platform/Platform.h>
+
+// Implementation
+//===============
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::cShader::Initialize( const std::string& i_path, const void* const i_compiledShader, const size_t i_compiledShaderSize )
+{
+	EAE6320_ASSERT( ( m_type == eae6320::Graphics::eShaderType::Vertex ) || ( m_type == eae6320::Graphics::eShaderType::Fragment ) );
+
+	// The compiled shader isn't used;
+	// the software platform implements the standard shaders in C++
+	// (see cMesh.software.cpp and cEffect.software.cpp)
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::cShader::CleanUp()
+{
+	return Results::Success;
+}
@@ -0,0 +1,71 @@
+// Includes
+//=========
+
+#include "../sContext.h"
+
+#include "ImageFiles.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+
+// Interface
+//==========
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Graphics::sContext::Initialize( const sInitializationParameters& i_initializationParameters )
+{
+	auto result = Results::Success;
+
+#if defined( EAE6320_PLATFORM_WINDOWS )
+	// The window is remembered (like on the other platforms)
+	// but the frames are only kept in memory
+	windowBeingRenderedTo = i_initializationParameters.mainWindow;
+#endif
+
+	if ( !( result = rasterizer.Initialize( i_initializationParameters.resolutionWidth, i_initializationParameters.resolutionHeight,
+		EAE6320_GRAPHICS_SOFTWARERASTERIZERTHREADCOUNT ) ) )
+	{
+		EAE6320_ASSERTF( false, "Can't initialize the software rasterizer" );
+		Logging::OutputError( "The software rasterizer couldn't be initialized with a resolution of %ux%u",
+			i_initializationParameters.resolutionWidth, i_initializationParameters.resolutionHeight );
+		return result;
+	}
+	Logging::OutputMessage( "The software rasterizer renders %ux%u with %u threads",
+		rasterizer.GetWidth(), rasterizer.GetHeight(), rasterizer.GetThreadCount() );
+	for ( auto& boundConstantBuffer : boundConstantBuffers )
+	{
+		boundConstantBuffer = nullptr;
+	}
+	renderStateBits = 0;
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::sContext::CleanUp()
+{
+	const auto result = rasterizer.CleanUp();
+	for ( auto& boundConstantBuffer : boundConstantBuffers )
+	{
+		boundConstantBuffer = nullptr;
+	}
+	projectedVertices.clear();
+	projectedVertices.shrink_to_fit();
+
+#if defined( EAE6320_PLATFORM_WINDOWS )
+	windowBeingRenderedTo = NULL;
+#endif
+
+	return result;
+}
+
+// Render
+//-------
+
+eae6320::cResult eae6320::Graphics::sContext::SavePresentedFrame( const char* const i_path ) const
+{
+	std::vector<uint32_t> pixels;
+	rasterizer.GetPresentedFrame( pixels );
+	return ImageFiles::Save( i_path, pixels.data(), rasterizer.GetWidth(), rasterizer.GetHeight() );
+}
@@ -0,0 +1,168 @@
+// Includes
+//=========
+
+#include "SubmissionBenchmark.h"
+
+#include <atomic>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/ReferenceCountedAssets.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/Time/Time.h>
+#include <thread>
+#include <vector>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// This stands in for an effect or a mesh:
+	// it is reference counted the same way,
+	// and every one is on its own cache line (like separately allocated assets are)
+	class alignas( 64 ) cStandInAsset
+	{
+	public:
+
+		EAE6320_ASSETS_DECLAREREFERENCECOUNTINGFUNCTIONS();
+
+		cStandInAsset() = default;
+
+	private:
+
+		~cStandInAsset() = default;
+
+		EAE6320_ASSETS_DECLAREREFERENCECOUNT();
+	};
+
+	struct sDrawCall
+	{
+		cStandInAsset* effect = nullptr;
+		cStandInAsset* mesh = nullptr;
+		// The rest of a submitted draw call is its transform
+		float transform_localToWorld[16];
+	};
+
+	// Returns the total ticks that the frames took
+	uint64_t SimulateSubmission( const unsigned int i_drawCallCount, const unsigned int i_frameCount,
+		const std::vector<cStandInAsset*>& i_effects, const std::vector<cStandInAsset*>& i_meshes, const bool i_shouldReferenceCount );
+}
+
+// Interface
+//==========
+
+eae6320::Graphics::SubmissionBenchmark::sResults eae6320::Graphics::SubmissionBenchmark::Run(
+	const unsigned int i_drawCallCount, const unsigned int i_frameCount, const unsigned int i_assetCount )
+{
+	EAE6320_ASSERT( ( i_frameCount > 0 ) && ( i_assetCount > 0 ) );
+
+	std::vector<cStandInAsset*> effects( i_assetCount ), meshes( i_assetCount );
+	for ( unsigned int i = 0; i < i_assetCount; ++i )
+	{
+		effects[i] = new cStandInAsset;
+		meshes[i] = new cStandInAsset;
+	}
+
+	sResults results;
+	results.drawCallCount = i_drawCallCount;
+	results.frameCount = i_frameCount;
+	// Each way is run once without being timed first
+	// so that neither one pays for touching the memory the first time
+	SimulateSubmission( i_drawCallCount, 1, effects, meshes, true );
+	results.secondsPerFrame_referenceCounted =
+		Time::ConvertTicksToSeconds( SimulateSubmission( i_drawCallCount, i_frameCount, effects, meshes, true ) ) / i_frameCount;
+	SimulateSubmission( i_drawCallCount, 1, effects, meshes, false );
+	results.secondsPerFrame_frameLifetime =
+		Time::ConvertTicksToSeconds( SimulateSubmission( i_drawCallCount, i_frameCount, effects, meshes, false ) ) / i_frameCount;
+	// Every draw call increments and decrements both its effect and its mesh
+	results.interlockedOperationsPerFrame_referenceCounted = uint64_t( i_drawCallCount ) * 4;
+	results.interlockedOperationsPerFrame_frameLifetime = 0;
+
+	for ( unsigned int i = 0; i < i_assetCount; ++i )
+	{
+		effects[i]->DecrementReferenceCount();
+		meshes[i]->DecrementReferenceCount();
+	}
+
+	return results;
+}
+
+void eae6320::Graphics::SubmissionBenchmark::RunAndLogStandardSizes()
+{
+	constexpr unsigned int drawCallCounts[] = { 10000, 100000 };
+	for ( const auto drawCallCount : drawCallCounts )
+	{
+		const auto results = Run( drawCallCount );
+		Logging::OutputMessage( "Submitting %u draw calls: %.3f ms per frame with per-draw reference counting (%llu interlocked operations),"
+			" %.3f ms per frame with frame-lifetime ownership (%llu interlocked operations)",
+			results.drawCallCount,
+			results.secondsPerFrame_referenceCounted * 1000.0, static_cast<unsigned long long>( results.interlockedOperationsPerFrame_referenceCounted ),
+			results.secondsPerFrame_frameLifetime * 1000.0, static_cast<unsigned long long>( results.interlockedOperationsPerFrame_frameLifetime ) );
+	}
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	uint64_t SimulateSubmission( const unsigned int i_drawCallCount, const unsigned int i_frameCount,
+		const std::vector<cStandInAsset*>& i_effects, const std::vector<cStandInAsset*>& i_meshes, const bool i_shouldReferenceCount )
+	{
+		// There are two copies of the frame data, like the engine's submission ring with the minimum frame count
+		constexpr unsigned int frameDataCount = 2;
+		std::vector<sDrawCall> frames[frameDataCount];
+		for ( auto& frame : frames )
+		{
+			frame.resize( i_drawCallCount );
+		}
+		std::atomic<unsigned int> submittedFrameCount( 0 ), renderedFrameCount( 0 );
+		const auto assetCount = i_effects.size();
+
+		const auto tickCount_start = eae6320::Time::GetCurrentSystemTimeTickCount();
+		// The render thread "renders" each frame by cleaning it up
+		std::thread renderThread( [&]
+			{
+				for ( unsigned int frameIndex = 0; frameIndex < i_frameCount; ++frameIndex )
+				{
+					while ( submittedFrameCount.load( std::memory_order_acquire ) == frameIndex )
+					{
+						std::this_thread::yield();
+					}
+					auto& frame = frames[frameIndex % frameDataCount];
+					if ( i_shouldReferenceCount )
+					{
+						for ( auto& drawCall : frame )
+						{
+							drawCall.effect->DecrementReferenceCount();
+							drawCall.mesh->DecrementReferenceCount();
+						}
+					}
+					renderedFrameCount.store( frameIndex + 1, std::memory_order_release );
+				}
+			} );
+		// The application loop thread submits every frame
+		for ( unsigned int frameIndex = 0; frameIndex < i_frameCount; ++frameIndex )
+		{
+			while ( ( frameIndex - renderedFrameCount.load( std::memory_order_acquire ) ) >= frameDataCount )
+			{
+				std::this_thread::yield();
+			}
+			auto& frame = frames[frameIndex % frameDataCount];
+			for ( unsigned int i = 0; i < i_drawCallCount; ++i )
+			{
+				auto& drawCall = frame[i];
+				drawCall.effect = i_effects[i % assetCount];
+				drawCall.mesh = i_meshes[i % assetCount];
+				if ( i_shouldReferenceCount )
+				{
+					drawCall.effect->IncrementReferenceCount();
+					drawCall.mesh->IncrementReferenceCount();
+				}
+				drawCall.transform_localToWorld[12] = static_cast<float>( i );
+			}
+			submittedFrameCount.store( frameIndex + 1, std::memory_order_release );
+		}
+		renderThread.join();
+		return eae6320::Time::GetCurrentSystemTimeTickCount() - tickCount_start;
+	}
+}
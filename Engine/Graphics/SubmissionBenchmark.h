@@ -0,0 +1,55 @@
+/*
+	This microbenchmark measures what reference counting every submitted draw call costs
+
+	Submission is simulated the way the engine does it:
+	the application loop thread fills a frame's draw calls
+	while a render thread cleans up the previous frame,
+	and the two threads are kept at most one frame apart.
+	It is run twice:
+		* With per-draw reference counting
+			(every draw call increments its effect's and mesh's reference counts when it is submitted
+			and the render thread decrements them when the frame has been rendered)
+		* With frame-lifetime ownership
+			(draw calls only copy plain pointers; see Graphics::ReleaseAfterInFlightFramesHaveBeenRendered())
+	The assets are stand-ins that use the same reference counting as real effects and meshes,
+	and so the benchmark doesn't need a graphics device.
+*/
+
+#ifndef EAE6320_GRAPHICS_SUBMISSIONBENCHMARK_H
+#define EAE6320_GRAPHICS_SUBMISSIONBENCHMARK_H
+
+// Includes
+//=========
+
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		namespace SubmissionBenchmark
+		{
+			struct sResults
+			{
+				unsigned int drawCallCount = 0;
+				unsigned int frameCount = 0;
+				// The average time for both threads to finish a frame
+				double secondsPerFrame_referenceCounted = 0.0;
+				double secondsPerFrame_frameLifetime = 0.0;
+				// How many interlocked operations each way did per frame
+				uint64_t interlockedOperationsPerFrame_referenceCounted = 0;
+				uint64_t interlockedOperationsPerFrame_frameLifetime = 0;
+			};
+
+			// The draw calls cycle through i_assetCount different effects and meshes
+			sResults Run( const unsigned int i_drawCallCount, const unsigned int i_frameCount = 32, const unsigned int i_assetCount = 64 );
+			// Runs with 10,000 and 100,000 draw calls and logs the results
+			void RunAndLogStandardSizes();
+		}
+	}
+}
+
+#endif	// EAE6320_GRAPHICS_SUBMISSIONBENCHMARK_H
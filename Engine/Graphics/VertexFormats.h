@@ -34,13 +34,43 @@ namespace eae6320
 			// In a real game it would be more common to have several different formats
 			// (with simpler/smaller formats for simpler shading
 			// and more complex and bigger formats for more complicated shading).
+			// Every element is quantized to the smallest size that still looks right
+			// (the vertices are less than half of the size that they would be with floats,
+			// and so less memory and bandwidth is used to store and fetch them)
 			struct sVertex_mesh
 			{
 				// POSITION
-				// 3 floats == 12 bytes
+				// 4 uint16_ts == 8 bytes
 				// Offset = 0
-				float x, y, z;
+				// The position is a normalized fraction of the mesh's bounding box (see MeshFormats::sBounds):
+				//	position_local = aabbMin + ( ( x / 65535 ) * ( aabbMax - aabbMin ) )
+				// The draw call's local-to-world transform is changed so that it does this at the same time (see cMesh::FoldPositionDequantization()),
+				// and so shaders treat the position like any other.
+				// w is padding (there is no 3 element 16 bit format) and is always zero
+				uint16_t x, y, z, w;
+
+				// NORMAL
+				// 2 int16_ts == 4 bytes
+				// Offset = 8
+				// The unit normal is octahedral-encoded as two normalized values
+				// (see DecodeOctahedralNormal() in shaders.inc)
+				int16_t nx, ny;
+
+				// TEXCOORD
+				// 2 half floats == 4 bytes
+				// Offset = 12
+				uint16_t u, v;
+
+				// COLOR
+				// 4 uint8_ts == 4 bytes
+				// Offset = 16
+				// The color is normalized (0 is 0.0 and 255 is 1.0)
+				uint8_t r, g, b, a;
 			};
+			static_assert( sizeof( sVertex_mesh ) == 20, "The vertex layout must match cVertexFormat and cMesh" );
+
+			// The denominator of the normalized position
+			constexpr float positionQuantizationMax = 65535.0f;
 		}
 	}
 }
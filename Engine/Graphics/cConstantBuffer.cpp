@@ -5,12 +5,107 @@
 
 #include "ConstantBufferFormats.h"
 
+#include <cstring>
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Logging/Logging.h>
+#include <Engine/Math/Functions.h>
+#include <new>
+#include <utility>
 
 // Interface
 //==========
 
+// Render
+//-------
+
+void eae6320::Graphics::cConstantBuffer::Update( const void* const i_data )
+{
+	Update( i_data, m_size );
+}
+
+// Upload Ring
+//------------
+
+void* eae6320::Graphics::cConstantBuffer::BeginRingUpload( const unsigned int i_maxRangeCount )
+{
+	EAE6320_ASSERTF( m_isRing, "Only a constant buffer that was initialized as a ring can be uploaded to this way" );
+
+	const auto requiredSize = static_cast<size_t>( i_maxRangeCount ) * m_ringRangeStride;
+	if ( requiredSize > m_ringDataSize_cpu )
+	{
+		// The memory grows geometrically so that it stops changing once it is large enough for a typical frame
+		auto newSize = ( m_ringDataSize_cpu > 0 ) ? m_ringDataSize_cpu : m_ringRangeStride;
+		while ( newSize < requiredSize )
+		{
+			newSize *= 2;
+		}
+		auto* const newData = new ( std::nothrow ) uint8_t[newSize];
+		auto* const newData_lastUpload = new ( std::nothrow ) uint8_t[newSize];
+		if ( !newData || !newData_lastUpload )
+		{
+			delete [] newData;
+			delete [] newData_lastUpload;
+			EAE6320_ASSERTF( false, "Couldn't allocate memory for %u constant buffer ranges", i_maxRangeCount );
+			Logging::OutputError( "Failed to allocate %u bytes of CPU memory for a constant buffer ring", static_cast<unsigned int>( newSize ) );
+			return nullptr;
+		}
+		// The padding between ranges is never written,
+		// and so zeroing it once means that it never makes two uploads look different
+		memset( newData, 0, newSize );
+		memset( newData_lastUpload, 0, newSize );
+		CleanUpRing();
+		m_ringData_cpu = newData;
+		m_ringData_cpu_lastUpload = newData_lastUpload;
+		m_ringDataSize_cpu = newSize;
+		// The previous upload was lost, and so the next one can't be skipped
+		m_ringRangeCount_lastUpload = 0;
+	}
+	return m_ringData_cpu;
+}
+
+eae6320::cResult eae6320::Graphics::cConstantBuffer::EndRingUpload( const unsigned int i_rangeCount, uint64_t& o_byteCount_uploaded )
+{
+	EAE6320_ASSERT( m_isRing );
+	const auto byteCount = static_cast<size_t>( i_rangeCount ) * m_ringRangeStride;
+	EAE6320_ASSERT( byteCount <= m_ringDataSize_cpu );
+	o_byteCount_uploaded = 0;
+	if ( i_rangeCount == 0 )
+	{
+		return Results::Success;
+	}
+
+	// If every range is the same as the previous upload then the GPU already has the data
+	// (this is the common case when nothing in a scene moves)
+	if ( ( i_rangeCount == m_ringRangeCount_lastUpload ) && ( memcmp( m_ringData_cpu, m_ringData_cpu_lastUpload, byteCount ) == 0 ) )
+	{
+		return Results::Success;
+	}
+	// Make sure that the GPU buffer is big enough
+	if ( i_rangeCount > m_ringRangeCapacity )
+	{
+		auto newCapacity = m_ringRangeCapacity * 2;
+		if ( newCapacity < i_rangeCount )
+		{
+			newCapacity = i_rangeCount;
+		}
+		const auto result = ResizeRing_platformSpecific( newCapacity );
+		if ( !result )
+		{
+			EAE6320_ASSERTF( false, "Couldn't grow the constant buffer ring to %u ranges", newCapacity );
+			Logging::OutputError( "Failed to grow a constant buffer ring to %u ranges", newCapacity );
+			m_ringRangeCount_lastUpload = 0;
+			return result;
+		}
+		m_ringRangeCapacity = newCapacity;
+	}
+	UploadRing_platformSpecific( byteCount );
+	// The uploaded data becomes what the next upload is compared against
+	std::swap( m_ringData_cpu, m_ringData_cpu_lastUpload );
+	m_ringRangeCount_lastUpload = i_rangeCount;
+	o_byteCount_uploaded = byteCount;
+	return Results::Success;
+}
+
 // Initialize / Clean Up
 //----------------------
 
@@ -25,8 +120,9 @@ eae6320::cResult eae6320::Graphics::cConstantBuffer::Initialize( const void* con
 			switch ( m_type )
 			{
 				case ConstantBufferTypes::Frame: m_size = sizeof( ConstantBufferFormats::sFrame ); break;
-//				case ConstantBufferTypes::Material: m_size = sizeof( ConstantBufferFormats::sMaterial ); break;
+				case ConstantBufferTypes::Material: m_size = sizeof( ConstantBufferFormats::sMaterial ); break;
 				case ConstantBufferTypes::DrawCall: m_size = sizeof( ConstantBufferFormats::sDrawCall ); break;
+				case ConstantBufferTypes::Instances: m_size = sizeof( ConstantBufferFormats::sInstances ); break;
 
 			// This should never happen
 			default:
@@ -55,6 +151,31 @@ eae6320::cResult eae6320::Graphics::cConstantBuffer::Initialize( const void* con
 	return result;
 }
 
+eae6320::cResult eae6320::Graphics::cConstantBuffer::InitializeRing( const unsigned int i_initialRangeCapacity )
+{
+	auto result = Results::Success;
+
+	m_isRing = true;
+	if ( !( result = Initialize() ) )
+	{
+		return result;
+	}
+	// Every range starts at an offset that the platform can bind
+	m_ringRangeStride = Math::RoundUpToMultiple( m_size, GetRingRangeAlignment_platformSpecific() );
+	{
+		const auto rangeCapacity = ( i_initialRangeCapacity > 0 ) ? i_initialRangeCapacity : 1;
+		if ( !( result = ResizeRing_platformSpecific( rangeCapacity ) ) )
+		{
+			EAE6320_ASSERTF( false, "Couldn't create the GPU memory for a constant buffer ring" );
+			Logging::OutputError( "A constant buffer of type %u couldn't be initialized as a ring with %u ranges", m_type, rangeCapacity );
+			return result;
+		}
+		m_ringRangeCapacity = rangeCapacity;
+	}
+
+	return result;
+}
+
 eae6320::Graphics::cConstantBuffer::cConstantBuffer( const ConstantBufferTypes i_type )
 	:
 	m_type( i_type )
@@ -67,3 +188,19 @@ eae6320::Graphics::cConstantBuffer::~cConstantBuffer()
 	const auto result = CleanUp();
 	EAE6320_ASSERT( result );
 }
+
+// Implementation
+//===============
+
+// Initialize / Clean Up
+//----------------------
+
+void eae6320::Graphics::cConstantBuffer::CleanUpRing()
+{
+	delete [] m_ringData_cpu;
+	m_ringData_cpu = nullptr;
+	delete [] m_ringData_cpu_lastUpload;
+	m_ringData_cpu_lastUpload = nullptr;
+	m_ringDataSize_cpu = 0;
+	m_ringRangeCount_lastUpload = 0;
+}
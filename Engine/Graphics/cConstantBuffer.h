@@ -24,6 +24,7 @@
 
 #include "Configuration.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <Engine/Results/Results.h>
 
@@ -45,7 +46,7 @@ namespace eae6320
 {
 	namespace Graphics
 	{
-		// In our class we will define three different types of constant buffers
+		// In our class we will define four different types of constant buffers
 		// (see ConstantBufferFormats.h for the data layout of each type)
 		enum class ConstantBufferTypes : uint8_t
 		{
@@ -67,6 +68,11 @@ namespace eae6320
 			//		* These are values that are associated with a specific draw call
 			//		* The constant buffer must be updated and bound for every draw call that is made
 			DrawCall = 2,
+			//	* Instances:
+			//		* These are the values for every instance of an instanced draw call
+			//		* The constant buffer must be updated before every instanced draw call,
+			//			but only the instances that are actually drawn need to be copied
+			Instances = 3,
 
 			Count,
 			Invalid = Count
@@ -102,11 +108,56 @@ namespace eae6320
 			// The specified data must be the appropriate Graphics::ConstantBufferFormats struct corresponding to this constant buffer's type!
 			// This function only needs to be called when the constant data that the GPU is using needs to change.
 			void Update( const void* const i_data );
+			// Only the first i_size bytes are copied
+			// (this is useful for a constant buffer that holds an array that is only partially used)
+			void Update( const void* const i_data, const size_t i_size );
+
+			// Upload Ring
+			//------------
+
+			// A constant buffer can be initialized as an upload ring instead
+			// (this is meant for ConstantBufferTypes::DrawCall, whose data is different for every draw call):
+			//	* The data for every draw call in a frame is written to CPU memory
+			//		and then copied to the GPU with a single upload into one large buffer
+			//	* Each draw call binds the range of the buffer that has its data
+			//		(with glBindBufferRange() in OpenGL or VSSetConstantBuffers1() in Direct3D)
+			//	* If the data is identical to the previous upload (e.g. because nothing moved)
+			//		then nothing is copied and the ranges that are already on the GPU are bound again
+			// Ranges are GetRingRangeStride() bytes apart (the platform's required offset alignment).
+			// Update() and Bind() can't be used with a ring
+
+			// Returns CPU memory that the data for up to i_maxRangeCount ranges can be written to
+			// (or NULL if memory couldn't be allocated).
+			// The memory is only valid until EndRingUpload() is called
+			void* BeginRingUpload( const unsigned int i_maxRangeCount );
+			// Copies the first i_rangeCount ranges to the GPU
+			// (o_byteCount_uploaded is how many bytes were copied, which is 0 if the upload was skipped)
+			cResult EndRingUpload( const unsigned int i_rangeCount, uint64_t& o_byteCount_uploaded );
+			// Binds one of the ranges that were uploaded by the last EndRingUpload()
+			void BindRingRange( const unsigned int i_rangeIndex, const uint_fast8_t i_shaderTypesToBindTo );
+			size_t GetRingRangeStride() const { return m_ringRangeStride; }
+
+#if defined( EAE6320_PLATFORM_NULL ) || defined( EAE6320_PLATFORM_SOFTWARE )
+			// Access
+			//-------
+
+			// The null and software platforms keep the constant data in CPU memory
+			// (so that it can be inspected and so that draws can read it).
+			// If the constant buffer is a ring then this is the range that is bound
+			const void* GetData() const { return m_data + m_ringRangeOffset_bound; }
+			size_t GetSize() const { return m_size; }
+			ConstantBufferTypes GetType() const { return m_type; }
+	#if defined( EAE6320_PLATFORM_NULL )
+			uint32_t GetObjectId() const { return m_bufferId; }
+	#endif
+#endif
 
 			// Initialize / Clean Up
 			//----------------------
 
 			cResult Initialize( const void* const i_initialData = nullptr );
+			// The ring grows if a frame needs more ranges than its capacity
+			cResult InitializeRing( const unsigned int i_initialRangeCapacity );
 			cResult CleanUp();
 
 			cConstantBuffer( const ConstantBufferTypes i_type );
@@ -125,6 +176,32 @@ namespace eae6320
 			ID3D11Buffer* m_buffer = nullptr;
 #elif defined( EAE6320_PLATFORM_GL )
 			GLuint m_bufferId = 0;
+#elif defined( EAE6320_PLATFORM_NULL )
+			uint32_t m_bufferId = 0;
+			uint8_t* m_data = nullptr;
+#elif defined( EAE6320_PLATFORM_SOFTWARE )
+			uint8_t* m_data = nullptr;
+#endif
+
+			// Upload ring data
+			//	(none of this is used unless the constant buffer was initialized as a ring)
+			// The ranges are written to CPU memory first;
+			// the previous upload is kept so that an identical upload can be detected
+			uint8_t* m_ringData_cpu = nullptr;
+			uint8_t* m_ringData_cpu_lastUpload = nullptr;
+			size_t m_ringDataSize_cpu = 0;
+			size_t m_ringRangeStride = 0;
+			// This is how many ranges the GPU buffer has room for in a single upload
+			unsigned int m_ringRangeCapacity = 0;
+			// The most recent upload starts at this byte offset in the GPU buffer
+			// (OpenGL cycles through several segments so that it never writes to memory that a previous frame might be reading)
+			size_t m_ringUploadOffset = 0;
+			unsigned int m_ringSegmentIndex = 0;
+			// An upload is skipped if it has the same ranges as the previous one
+			unsigned int m_ringRangeCount_lastUpload = 0;
+			bool m_isRing = false;
+#if defined( EAE6320_PLATFORM_NULL ) || defined( EAE6320_PLATFORM_SOFTWARE )
+			size_t m_ringRangeOffset_bound = 0;
 #endif
 			
 			// The constant buffer type defines the size of the constant data
@@ -140,6 +217,16 @@ namespace eae6320
 			//----------------------
 
 			cResult Initialize_platformSpecific( const void* const i_initialData );
+			// Frees the CPU memory of the upload ring
+			// (every platform's CleanUp() calls this)
+			void CleanUpRing();
+			// Returns the alignment that bound ranges must start at
+			size_t GetRingRangeAlignment_platformSpecific() const;
+			// (Re)creates the GPU memory so that an upload can have i_rangeCapacity ranges
+			cResult ResizeRing_platformSpecific( const unsigned int i_rangeCapacity );
+			// Copies the first i_byteCount bytes of the CPU ring data to the GPU
+			// and sets m_ringUploadOffset to where they were copied
+			void UploadRing_platformSpecific( const size_t i_byteCount );
 
 			cConstantBuffer( const cConstantBuffer& ) = delete;
 			cConstantBuffer( cConstantBuffer&& ) = delete;
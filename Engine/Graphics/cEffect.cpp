@@ -7,6 +7,7 @@
 #include <Engine/Concurrency/cMutex.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/ScopeGuard/cScopeGuard.h>
+#include <atomic>
 #include <new>
 #include <vector>
 
@@ -47,6 +48,9 @@ namespace
 		cEffectTracker& operator =(const cEffectTracker&) = delete;
 		cEffectTracker& operator =(cEffectTracker&&) = delete;
 	} s_effectTracker;
+
+	// Every effect gets a different sort ID (until the counter wraps around)
+	std::atomic<uint16_t> s_nextSortId( 0 );
 }
 
 eae6320::cResult eae6320::Graphics::cEffect::Load(cEffect*& o_effect, cShader* i_vertexShader, cShader* i_fragmentShader)
@@ -94,10 +98,17 @@ eae6320::cResult eae6320::Graphics::cEffect::Load(cEffect*& o_effect, cShader* i
 	return result;
 }
 
+uint8_t eae6320::Graphics::cEffect::GetRenderStateBits() const
+{
+	return s_renderState.GetRenderStateBits();
+}
+
 // Initialize / Clean Up
 //----------------------
 
 eae6320::Graphics::cEffect::cEffect()
+	:
+	m_sortId(s_nextSortId++)
 {
 	s_effectTracker.AddEffect(this);
 }
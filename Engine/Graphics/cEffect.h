@@ -25,6 +25,10 @@ namespace eae6320
 
 			void Bind();
 
+			uint8_t GetRenderStateBits() const;
+			// This ID is only used to group draw calls that use the same effect when sorting
+			uint16_t GetSortId() const { return m_sortId; }
+
 			EAE6320_ASSETS_DECLAREREFERENCECOUNT();
 		private:
 			cEffect();
@@ -37,8 +41,11 @@ namespace eae6320
 			eae6320::Graphics::cShader* s_vertexShader = nullptr;
 			eae6320::Graphics::cShader* s_fragmentShader = nullptr;
 			eae6320::Graphics::cRenderState s_renderState;
+			uint16_t m_sortId = 0;
 #if defined( EAE6320_PLATFORM_GL )
 			GLuint s_programId = 0;
+#elif defined( EAE6320_PLATFORM_NULL )
+			uint32_t s_programId = 0;
 #endif
 		};
 	}
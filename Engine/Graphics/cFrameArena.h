@@ -0,0 +1,95 @@
+/*
+	A frame arena is a block of memory that is reused every frame
+
+	Elements are reserved from the arena while a frame is being submitted
+	and are all released at once (by resetting the arena) after the frame has been rendered.
+	The memory itself is kept when the arena is reset,
+	and so once an arena has grown large enough for a typical frame
+	no more heap allocations are made.
+*/
+
+#ifndef EAE6320_GRAPHICS_CFRAMEARENA_H
+#define EAE6320_GRAPHICS_CFRAMEARENA_H
+
+// Includes
+//=========
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+			template <typename tElement>
+		class cFrameArena
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Access
+			//-------
+
+			// Reserves i_count contiguous elements (initialized to default values)
+			// and returns a pointer to the first one, or NULL if memory couldn't be allocated.
+			// If the arena must grow then elements that were already reserved are moved,
+			// and so a pointer returned earlier in the same frame is no longer valid
+			tElement* Allocate( const size_t i_count );
+
+			tElement* GetElements() const { return m_elements; }
+			size_t GetCount() const { return m_count; }
+			size_t GetCapacity() const { return m_capacity; }
+			// This is how many times the arena has had to allocate memory from the heap
+			// (it should stop changing once the arena has grown large enough)
+			uint64_t GetHeapAllocationCount() const { return m_heapAllocationCount.load( std::memory_order_relaxed ); }
+
+			// Releases every reserved element but keeps the memory for the next frame
+			void Reset() { m_count = 0; }
+			// Releases the i_count most recently reserved elements
+			// (this is how a reservation is undone when a later one in the same submission fails)
+			void ReleaseLast( const size_t i_count );
+
+			// Initialize / Clean Up
+			//----------------------
+
+			cResult Initialize( const size_t i_initialCapacity );
+			void CleanUp();
+
+			cFrameArena() = default;
+			~cFrameArena();
+
+			cFrameArena( const cFrameArena& ) = delete;
+			cFrameArena( cFrameArena&& ) = delete;
+			cFrameArena& operator =( const cFrameArena& ) = delete;
+			cFrameArena& operator =( cFrameArena&& ) = delete;
+
+			// Data
+			//=====
+
+		private:
+
+			tElement* m_elements = nullptr;
+			size_t m_count = 0;
+			size_t m_capacity = 0;
+			std::atomic<uint64_t> m_heapAllocationCount{ 0 };
+
+			// Implementation
+			//===============
+
+		private:
+
+			cResult Grow( const size_t i_requiredCapacity );
+		};
+	}
+}
+
+#include "cFrameArena.inl"
+
+#endif	// EAE6320_GRAPHICS_CFRAMEARENA_H
@@ -0,0 +1,108 @@
+#ifndef EAE6320_GRAPHICS_CFRAMEARENA_INL
+#define EAE6320_GRAPHICS_CFRAMEARENA_INL
+
+// Includes
+//=========
+
+#include "cFrameArena.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <new>
+
+// Interface
+//==========
+
+// Access
+//-------
+
+	template <typename tElement>
+tElement* eae6320::Graphics::cFrameArena<tElement>::Allocate( const size_t i_count )
+{
+	const auto requiredCapacity = m_count + i_count;
+	if ( requiredCapacity > m_capacity )
+	{
+		if ( !Grow( requiredCapacity ) )
+		{
+			return nullptr;
+		}
+	}
+	auto* const elements = m_elements + m_count;
+	for ( size_t i = 0; i < i_count; ++i )
+	{
+		elements[i] = tElement();
+	}
+	m_count = requiredCapacity;
+	return elements;
+}
+
+	template <typename tElement>
+void eae6320::Graphics::cFrameArena<tElement>::ReleaseLast( const size_t i_count )
+{
+	EAE6320_ASSERTF( i_count <= m_count, "Releasing %u elements from a frame arena that only has %u reserved",
+		static_cast<unsigned int>( i_count ), static_cast<unsigned int>( m_count ) );
+	m_count -= ( i_count <= m_count ) ? i_count : m_count;
+}
+
+// Initialize / Clean Up
+//----------------------
+
+	template <typename tElement>
+eae6320::cResult eae6320::Graphics::cFrameArena<tElement>::Initialize( const size_t i_initialCapacity )
+{
+	if ( i_initialCapacity > m_capacity )
+	{
+		return Grow( i_initialCapacity );
+	}
+	return Results::Success;
+}
+
+	template <typename tElement>
+void eae6320::Graphics::cFrameArena<tElement>::CleanUp()
+{
+	EAE6320_ASSERTF( m_count == 0, "A frame arena is being cleaned up while it still has %u reserved elements",
+		static_cast<unsigned int>( m_count ) );
+	delete [] m_elements;
+	m_elements = nullptr;
+	m_count = 0;
+	m_capacity = 0;
+}
+
+	template <typename tElement>
+eae6320::Graphics::cFrameArena<tElement>::~cFrameArena()
+{
+	delete [] m_elements;
+}
+
+// Implementation
+//===============
+
+	template <typename tElement>
+eae6320::cResult eae6320::Graphics::cFrameArena<tElement>::Grow( const size_t i_requiredCapacity )
+{
+	// The capacity is doubled so that a frame that keeps growing
+	// only causes a logarithmic number of allocations
+	auto newCapacity = ( m_capacity > 0 ) ? ( m_capacity * 2 ) : 64;
+	while ( newCapacity < i_requiredCapacity )
+	{
+		newCapacity *= 2;
+	}
+	auto* const newElements = new ( std::nothrow ) tElement[newCapacity];
+	if ( !newElements )
+	{
+		EAE6320_ASSERTF( false, "Couldn't allocate memory for %u frame arena elements", static_cast<unsigned int>( newCapacity ) );
+		Logging::OutputError( "Failed to allocate memory for %u frame arena elements", static_cast<unsigned int>( newCapacity ) );
+		return Results::OutOfMemory;
+	}
+	m_heapAllocationCount.fetch_add( 1, std::memory_order_relaxed );
+	for ( size_t i = 0; i < m_count; ++i )
+	{
+		newElements[i] = m_elements[i];
+	}
+	delete [] m_elements;
+	m_elements = newElements;
+	m_capacity = newCapacity;
+	return Results::Success;
+}
+
+#endif	// EAE6320_GRAPHICS_CFRAMEARENA_INL
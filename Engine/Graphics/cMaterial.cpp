@@ -0,0 +1,110 @@
+// Includes
+//=========
+
+#include "cMaterial.h"
+
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Logging/Logging.h>
+#include <Engine/ScopeGuard/cScopeGuard.h>
+#include <atomic>
+#include <new>
+
+namespace
+{
+	// Every material gets a different sort ID (until the counter wraps around);
+	// 0 is reserved for draw calls without a material
+	std::atomic<uint16_t> s_nextSortId( 1 );
+}
+
+eae6320::cResult eae6320::Graphics::cMaterial::Load(cMaterial*& o_material, cEffect* const i_effect, const ConstantBufferFormats::sMaterial& i_constantData)
+{
+	auto result = Results::Success;
+
+	cMaterial* newMaterial = nullptr;
+	cScopeGuard scopeGuard([&o_material, &result, &newMaterial]
+		{
+			if (result)
+			{
+				EAE6320_ASSERT(newMaterial != nullptr);
+				o_material = newMaterial;
+			}
+			else
+			{
+				if (newMaterial)
+				{
+					newMaterial->DecrementReferenceCount();
+					newMaterial = nullptr;
+				}
+				o_material = nullptr;
+			}
+		});
+
+	// Allocate a new material
+	{
+		newMaterial = new (std::nothrow) cMaterial();
+		if (!newMaterial)
+		{
+			result = Results::OutOfMemory;
+			EAE6320_ASSERTF(false, "Couldn't allocate memory for the material");
+			Logging::OutputError("Failed to allocate memory for the material");
+			return result;
+		}
+	}
+
+	if (!(result = newMaterial->Initialize(i_effect, i_constantData)))
+	{
+		EAE6320_ASSERTF(false, "Initialization of new material failed");
+		return result;
+	}
+
+	return result;
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::Graphics::cMaterial::cMaterial()
+{
+	auto sortId = s_nextSortId++;
+	if (sortId == 0)
+	{
+		sortId = s_nextSortId++;
+	}
+	m_sortId = sortId;
+}
+
+eae6320::Graphics::cMaterial::~cMaterial()
+{
+	EAE6320_ASSERT(m_referenceCount == 0);
+	const auto result = CleanUp();
+	EAE6320_ASSERT(result);
+}
+
+eae6320::cResult eae6320::Graphics::cMaterial::Initialize(cEffect* const i_effect, const ConstantBufferFormats::sMaterial& i_constantData)
+{
+	if (i_effect == nullptr)
+	{
+		EAE6320_ASSERTF(false, "A material needs an effect");
+		Logging::OutputError("A material can't be created without an effect");
+		return Results::Failure;
+	}
+	m_effect = i_effect;
+	m_effect->IncrementReferenceCount();
+	m_constantData = i_constantData;
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Graphics::cMaterial::CleanUp()
+{
+	// A material is only deleted once no frame in flight can reference it
+	// (see Graphics::ReleaseAfterInFlightFramesHaveBeenRendered()),
+	// and so its effect can be released immediately
+	if (m_effect)
+	{
+		m_effect->DecrementReferenceCount();
+		m_effect = nullptr;
+	}
+
+	return Results::Success;
+}
@@ -0,0 +1,53 @@
+/*
+	A material is an effect together with the authored values that its shaders read
+	(see ConstantBufferFormats::sMaterial)
+
+	Many objects can be drawn with the same material:
+	draw calls are sorted so that draw calls with the same material are next to each other
+	and the material constant buffer is only updated when the material changes.
+*/
+
+#pragma once
+
+#include "cEffect.h"
+#include "ConstantBufferFormats.h"
+
+#include <Engine/Assets/ReferenceCountedAssets.h>
+#include <Engine/Results/Results.h>
+
+namespace eae6320
+{
+	namespace Graphics
+	{
+		class cMaterial
+		{
+		public:
+			EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS(cMaterial);
+
+			EAE6320_ASSETS_DECLAREREFERENCECOUNTINGFUNCTIONS();
+
+			// The material holds a reference to the effect
+			static cResult Load(cMaterial*& o_material, cEffect* const i_effect, const ConstantBufferFormats::sMaterial& i_constantData);
+
+			// The effect's reference count isn't changed
+			cEffect* GetEffect() const { return m_effect; }
+			const ConstantBufferFormats::sMaterial& GetConstantData() const { return m_constantData; }
+
+			// This ID is only used to group draw calls that use the same material when sorting
+			// (0 is never used, and means that a draw call has no material)
+			uint16_t GetSortId() const { return m_sortId; }
+
+			EAE6320_ASSETS_DECLAREREFERENCECOUNT();
+		private:
+			cMaterial();
+			~cMaterial();
+
+			cResult Initialize(cEffect* const i_effect, const ConstantBufferFormats::sMaterial& i_constantData);
+			cResult CleanUp();
+
+			cEffect* m_effect = nullptr;
+			ConstantBufferFormats::sMaterial m_constantData;
+			uint16_t m_sortId = 0;
+		};
+	}
+}
@@ -3,16 +3,19 @@
 
 #include "cMesh.h"
 
+#include "MeshCompression.h"
+
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/cPackFile.h>
 #include <Engine/Concurrency/cMutex.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/ScopeGuard/cScopeGuard.h>
-#include <External/Lua/Includes.h>
 #include <Engine/Platform/Platform.h>
 #include <Engine/Time/Time.h>
+#include <atomic>
+#include <cstring>
 #include <new>
 #include <vector>
-#include <fstream>
 
 namespace
 {
@@ -51,6 +54,9 @@ namespace
 		cMeshTracker& operator =(const cMeshTracker&) = delete;
 		cMeshTracker& operator =(cMeshTracker&&) = delete;
 	} s_meshTracker;
+
+	// Every mesh gets a different sort ID (until the counter wraps around)
+	std::atomic<uint16_t> s_nextSortId( 0 );
 }
 
 
@@ -58,6 +64,69 @@ eae6320::cResult eae6320::Graphics::cMesh::Load(cMesh*& o_mesh, const std::strin
 {
 	auto result = Results::Success;
 
+	// The loaded data is only needed until the mesh has been created
+	// (the file is unmapped when this function returns)
+	sLoadedData loadedData;
+	if (!(result = LoadData(i_path, loadedData)))
+	{
+		o_mesh = nullptr;
+		return result;
+	}
+	return CreateFromLoadedData(i_path, loadedData, o_mesh);
+}
+
+eae6320::cResult eae6320::Graphics::cMesh::LoadData(const std::string& i_path, sLoadedData& o_loadedData)
+{
+	auto result = Results::Success;
+
+	// Map the mesh file
+	// (the vertex and index data are uploaded directly from the mapped file or the mounted asset pack)
+	auto& sections = o_loadedData.sections;
+	if (!(result = LoadMeshFromBinaryFile(i_path, o_loadedData.file, sections)))
+	{
+		return result;
+	}
+	const auto vertexCount = sections.header->vertexCount;
+	const auto indexCount = sections.header->indexCount;
+	const auto indexSize = sections.header->indexSize;
+
+	// Compressed geometry is decoded in a single pass from the mapped file
+	// into the memory that is then uploaded
+	// (raw geometry is uploaded from the mapped file without being copied)
+	o_loadedData.vertexData = sections.vertexData;
+	o_loadedData.indexData = sections.indexData;
+	if (sections.header->encoding == MeshFormats::eEncoding::Compressed)
+	{
+		auto& decodedVertexData = o_loadedData.decodedVertexData;
+		auto& decodedIndexData = o_loadedData.decodedIndexData;
+		decodedVertexData.resize(vertexCount);
+		decodedIndexData.resize(static_cast<size_t>(indexCount) * indexSize);
+		if (!(result = MeshCompression::DecodeVertices(sections.vertexSection, sections.header->vertexSectionSize, decodedVertexData.data(), vertexCount))
+			|| !(result = MeshCompression::DecodeIndices(sections.indexSection, sections.header->indexSectionSize, decodedIndexData.data(), indexCount, indexSize, vertexCount)))
+		{
+			EAE6320_ASSERTF(false, "The mesh's compressed geometry couldn't be decoded");
+			Logging::OutputError("The mesh file \"%s\" is invalid: Its compressed geometry couldn't be decoded", i_path.c_str());
+			return result;
+		}
+		o_loadedData.vertexData = decodedVertexData.data();
+		o_loadedData.indexData = decodedIndexData.data();
+	}
+	else
+	{
+		// Raw geometry isn't read until it is uploaded,
+		// and so the reads from disk are started now
+		// (so that the render thread is less likely to have to wait for them when it uploads the geometry)
+		Platform::PrefetchMappedData(sections.vertexSection, sections.header->vertexSectionSize);
+		Platform::PrefetchMappedData(sections.indexSection, sections.header->indexSectionSize);
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Graphics::cMesh::CreateFromLoadedData(const std::string& i_path, sLoadedData& i_loadedData, cMesh*& o_mesh)
+{
+	auto result = Results::Success;
+
 	cMesh* newMesh = nullptr;
 	cScopeGuard scopeGuard([&o_mesh, &result, &newMesh]
 		{
@@ -84,39 +153,64 @@ eae6320::cResult eae6320::Graphics::cMesh::Load(cMesh*& o_mesh, const std::strin
 		{
 			result = Results::OutOfMemory;
 			EAE6320_ASSERTF(false, "Couldn't allocate memory for the mesh");
-			Logging::OutputError("Failed to allocate memory for the mesh");
+			Logging::OutputError("Failed to allocate memory for the mesh \"%s\"", i_path.c_str());
 			return result;
 		}
 	}
 
-	//Load mesh data from lua file
-	VertexFormats::sVertex_mesh* vertexData = nullptr;
-	uint16_t* indexData = nullptr;
-	uint16_t vertexCount = 0;
-	uint16_t indexCount = 0;
-	if (!(result = LoadMeshFromBinaryFile(i_path, vertexData, indexData, vertexCount, indexCount)))
-	{
-		EAE6320_ASSERTF(false, "Load mesh data failed");
-		return result;
-	}
+	const auto& header = *i_loadedData.sections.header;
+	const auto vertexCount = header.vertexCount;
+	const auto indexCount = header.indexCount;
+	const auto indexSize = header.indexSize;
+	newMesh->m_bounds = header.bounds;
 
 	// Initialize the platform-specific graphics API mesh object
-	if (!(result = newMesh->Initialize(vertexData, indexData, static_cast<int>(vertexCount), static_cast<int>(indexCount))))
+	if (!(result = newMesh->Initialize(i_loadedData.vertexData, i_loadedData.indexData, vertexCount, indexCount, indexSize)))
 	{
 		EAE6320_ASSERTF(false, "Initialization of new mesh failed");
 		return result;
 	}
-	delete[] vertexData;
-	delete[] indexData;
-	vertexData = nullptr;
-	indexData = nullptr;
 
 	// set indexCount
 	newMesh->m_indexCount = indexCount;
+	newMesh->m_indexSize = static_cast<uint8_t>(indexSize);
+	newMesh->m_geometryByteCount = (sizeof(VertexFormats::sVertex_mesh) * static_cast<size_t>(vertexCount)) + (static_cast<size_t>(indexSize) * indexCount);
 
 	return result;
 }
 
+eae6320::Math::cMatrix_transformation eae6320::Graphics::cMesh::FoldPositionDequantization(const Math::cMatrix_transformation& i_transform_localToWorld) const
+{
+	// position_local = aabbMin + (quantized * extent),
+	// and so aabbMin is transformed and added to the translation
+	// and then the first three columns are scaled by the extent
+	// (the matrix is stored as columns; see cMatrix_transformation.h)
+	float m[16];
+	static_assert(sizeof(m) == sizeof(i_transform_localToWorld), "A transform must be 16 floats");
+	memcpy(m, &i_transform_localToWorld, sizeof(m));
+	for (int row = 0; row < 4; ++row)
+	{
+		m[12 + row] += (m[0 + row] * m_bounds.aabbMin[0]) + (m[4 + row] * m_bounds.aabbMin[1]) + (m[8 + row] * m_bounds.aabbMin[2]);
+	}
+	for (int column = 0; column < 3; ++column)
+	{
+		const auto extent = m_bounds.aabbMax[column] - m_bounds.aabbMin[column];
+		for (int row = 0; row < 4; ++row)
+		{
+			m[(column * 4) + row] *= extent;
+		}
+	}
+	Math::cMatrix_transformation transform_quantizedToWorld;
+	memcpy(&transform_quantizedToWorld, m, sizeof(m));
+	return transform_quantizedToWorld;
+}
+
+void eae6320::Graphics::cMesh::DrawGeometry() const
+{
+	Bind();
+	Draw();
+}
+
 // Implementation
 //===============
 
@@ -124,6 +218,8 @@ eae6320::cResult eae6320::Graphics::cMesh::Load(cMesh*& o_mesh, const std::strin
 //----------------------
 
 eae6320::Graphics::cMesh::cMesh()
+	:
+	m_sortId(s_nextSortId++)
 {
 	s_meshTracker.AddMesh(this);
 }
@@ -136,29 +232,31 @@ eae6320::Graphics::cMesh::~cMesh()
 	EAE6320_ASSERT(result);
 }
 
-eae6320::cResult eae6320::Graphics::cMesh::LoadMeshFromBinaryFile(const std::string& i_path, VertexFormats::sVertex_mesh*& i_vertexData, uint16_t*& i_indexData, uint16_t& i_vertexCount, uint16_t& i_indexCount)
+eae6320::cResult eae6320::Graphics::cMesh::LoadMeshFromBinaryFile(const std::string& i_path, Platform::sMappedFile& o_file, MeshFormats::sSections& o_sections)
 {
 	auto result = eae6320::Results::Success;
 
-	eae6320::Platform::sDataFromFile dataFromFile;
-	eae6320::Platform::LoadBinaryFile(i_path.c_str(), dataFromFile);
-
-	auto currentOffset = reinterpret_cast<uintptr_t>(dataFromFile.data);
-	const auto finalOffset = currentOffset + dataFromFile.size;
-	memcpy(&i_vertexCount, reinterpret_cast<void*>(currentOffset), sizeof(i_vertexCount));
-	currentOffset += sizeof(i_vertexCount);
-	memcpy(&i_indexCount, reinterpret_cast<void*>(currentOffset), sizeof(i_indexCount));
-	currentOffset += sizeof(i_indexCount);
-
-	size_t targetSize = sizeof(i_vertexCount) + sizeof(i_indexCount) + sizeof(VertexFormats::sVertex_mesh) * i_vertexCount + sizeof(uint16_t) * i_indexCount;
-	EAE6320_ASSERTF(dataFromFile.size == targetSize, "dataFromFile size is not correct.");
-
-	i_vertexData = new VertexFormats::sVertex_mesh[i_vertexCount];
-	memcpy(i_vertexData, reinterpret_cast<void*>(currentOffset), sizeof(VertexFormats::sVertex_mesh) * i_vertexCount);
-	i_indexData = new uint16_t[i_indexCount];
-	currentOffset += sizeof(VertexFormats::sVertex_mesh) * i_vertexCount;
-	memcpy(i_indexData, reinterpret_cast<void*>(currentOffset), sizeof(uint16_t) * i_indexCount);
-	currentOffset += sizeof(uint16_t) * i_indexCount;
+	// If the mesh is in the mounted asset pack it is used from there
+	// (the pack is already mapped and the mesh is aligned in it the same way that it would be in its own file)
+	Assets::cPackFile::sView meshData;
+	std::string errorMessage;
+	if (!Assets::cPackFile::FindInMountedPack(i_path.c_str(), meshData))
+	{
+		if (!(result = Platform::MapFile(i_path.c_str(), o_file, &errorMessage)))
+		{
+			EAE6320_ASSERTF(false, errorMessage.c_str());
+			Logging::OutputError("Failed to map the mesh file \"%s\": %s", i_path.c_str(), errorMessage.c_str());
+			return result;
+		}
+		meshData.data = o_file.data;
+		meshData.size = o_file.size;
+	}
+	if (!(result = MeshFormats::GetSections(meshData.data, meshData.size, o_sections, &errorMessage)))
+	{
+		EAE6320_ASSERTF(false, errorMessage.c_str());
+		Logging::OutputError("The mesh file \"%s\" is invalid: %s", i_path.c_str(), errorMessage.c_str());
+		return result;
+	}
 
 	return result;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "MeshFormats.h"
 #include "VertexFormats.h"
 #if defined( EAE6320_PLATFORM_D3D )
 #include "Direct3D/Includes.h"
@@ -9,7 +10,11 @@
 #endif
 
 #include <Engine/Assets/ReferenceCountedAssets.h>
+#include <Engine/Math/cMatrix_transformation.h>
+#include <Engine/Platform/Platform.h>
+#include <Engine/Results/Results.h>
 #include <string>
+#include <vector>
 
 namespace eae6320
 {
@@ -23,19 +28,66 @@ namespace eae6320
 			EAE6320_ASSETS_DECLAREREFERENCECOUNTINGFUNCTIONS();
 
 			static cResult Load(cMesh*& o_mesh, const std::string& i_path);
+
+			// Loading is split in two so that it can be done asynchronously (see Assets::cManager::LoadAsync()):
+			// the file is read and decoded on any thread
+			// and then the mesh is created from the loaded data on the render thread
+			struct sLoadedData
+			{
+				// The file stays mapped until the mesh is created
+				// so that raw geometry can be uploaded straight from it
+				Platform::sMappedFile file;
+				MeshFormats::sSections sections;
+				// Compressed geometry is decoded into these
+				std::vector<VertexFormats::sVertex_mesh> decodedVertexData;
+				std::vector<uint8_t> decodedIndexData;
+				// The geometry to upload (either in the file or in the decoded data)
+				const VertexFormats::sVertex_mesh* vertexData = nullptr;
+				const void* indexData = nullptr;
+			};
+			static cResult LoadData(const std::string& i_path, sLoadedData& o_loadedData);
+			static cResult CreateFromLoadedData(const std::string& i_path, sLoadedData& i_loadedData, cMesh*& o_mesh);
 			
-			void	DrawGeometry();
+			// Binding and drawing are separate so that the renderer can skip binding
+			// when successive draw calls use the same mesh
+			void	Bind() const;
+			void	Draw() const;
+			void	DrawGeometry() const;
+			// Draws the bound mesh i_instanceCount times
+			// (the instance data must already be in the Instances constant buffer)
+			void	DrawInstanced(const unsigned int i_instanceCount) const;
+
+			// This ID is only used to group draw calls that use the same mesh when sorting
+			uint16_t GetSortId() const { return m_sortId; }
+			// The bounds are in the mesh's local space (see MeshFormats.h)
+			const MeshFormats::sBounds& GetBounds() const { return m_bounds; }
+			// The memory that the mesh's geometry uses (see Assets::cManager::SetResidencyBudget())
+			size_t GetResidentByteCount() const { return m_geometryByteCount; }
+			// The vertex positions are stored as fractions of the bounding box (see VertexFormats::sVertex_mesh).
+			// This returns a transform that converts those fractions to local space and then transforms them to world space
+			// (the renderer uses it in place of the draw call's local-to-world transform)
+			Math::cMatrix_transformation FoldPositionDequantization(const Math::cMatrix_transformation& i_transform_localToWorld) const;
 
 			EAE6320_ASSETS_DECLAREREFERENCECOUNT();
 		private:
 			cMesh();
 			~cMesh();
-			static cResult LoadMeshFromBinaryFile(const std::string& i_path, VertexFormats::sVertex_mesh* &i_vertexData, uint16_t* &i_indexData, uint16_t& i_vertexCount, uint16_t& i_indexCount);
-			cResult Initialize(VertexFormats::sVertex_mesh* vertexData, uint16_t* indexData, const int vertexCount, const int indexCount);
+			// The file stays mapped while the mesh is initialized
+			// so that the geometry can be read straight from it
+			// (if the mesh is in the mounted asset pack then the file isn't mapped and the sections are in the pack instead)
+			static cResult LoadMeshFromBinaryFile(const std::string& i_path, Platform::sMappedFile& o_file, MeshFormats::sSections& o_sections);
+			// The indices are uint16_t or uint32_t depending on indexSize (see MeshFormats::sHeader)
+			cResult Initialize(const VertexFormats::sVertex_mesh* const vertexData, const void* const indexData, const unsigned int vertexCount, const unsigned int indexCount,
+				const unsigned int indexSize);
 			cResult CleanUp();
 
 			// indexCountToRender
-			int m_indexCount = 0;
+			unsigned int m_indexCount = 0;
+			// The size of each index in bytes (2 or 4)
+			uint8_t m_indexSize = sizeof(uint16_t);
+			uint16_t m_sortId = 0;
+			size_t m_geometryByteCount = 0;
+			MeshFormats::sBounds m_bounds;
 
 #if defined( EAE6320_PLATFORM_D3D )
 			eae6320::Graphics::cVertexFormat* s_vertexFormat = nullptr;
@@ -52,6 +104,15 @@ namespace eae6320
 
 			// A index buffer holds the index for each vertex
 			GLuint s_indexBufferId = 0;
+#elif defined( EAE6320_PLATFORM_NULL )
+			// There is no GPU memory; this identifies the mesh in the command log
+			uint32_t m_objectId = 0;
+#elif defined( EAE6320_PLATFORM_SOFTWARE )
+			// The rasterizer reads the geometry from CPU memory every time the mesh is drawn
+			VertexFormats::sVertex_mesh* m_vertexData = nullptr;
+			// The indices are stored with the size that they had in the mesh file
+			uint8_t* m_indexData = nullptr;
+			unsigned int m_vertexCount = 0;
 #endif
 		};
 	}
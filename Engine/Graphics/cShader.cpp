@@ -3,11 +3,15 @@
 
 #include "cShader.h"
 
+#include "ShaderFormats.h"
+
 #include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/cPackFile.h>
 #include <Engine/Concurrency/cMutex.h>
 #include <Engine/Logging/Logging.h>
 #include <Engine/Platform/Platform.h>
 #include <Engine/ScopeGuard/cScopeGuard.h>
+#include <map>
 #include <new>
 #include <vector>
 
@@ -51,6 +55,52 @@ namespace
 		cShaderTracker& operator =( const cShaderTracker& ) = delete;
 		cShaderTracker& operator =( cShaderTracker&& ) = delete;
 	} s_shaderTracker;
+
+	// Every variant of a shader is in the same file,
+	// and so a file is kept while any shader that was created from it exists
+	// (creating another variant then only has to find its program)
+	class cShaderFiles
+	{
+		// Interface
+		//----------
+
+	public:
+
+		// Access
+		// (the file is loaded, or found in the mounted asset pack, when nothing else is using it)
+		eae6320::cResult Acquire( const std::string& i_path, eae6320::Assets::cPackFile::sView& o_file );
+		void Release( const std::string& i_path );
+		// Initialize / Clean Up
+		cShaderFiles() = default;
+		~cShaderFiles();
+
+		// Data
+		//-----
+
+	private:
+
+		struct sFile
+		{
+			// This is only used if the file isn't in the mounted asset pack
+			eae6320::Platform::sDataFromFile dataFromFile;
+			eae6320::Assets::cPackFile::sView view;
+			unsigned int shaderCount = 0;
+		};
+		// The path is the key
+		std::map<std::string, sFile> m_files;
+		eae6320::Concurrency::cMutex m_mutex;
+
+		// Implementation
+		//---------------
+
+	private:
+
+		// Initialize / Clean Up
+		cShaderFiles( const cShaderFiles& ) = delete;
+		cShaderFiles( cShaderFiles&& ) = delete;
+		cShaderFiles& operator =( const cShaderFiles& ) = delete;
+		cShaderFiles& operator =( cShaderFiles&& ) = delete;
+	} s_shaderFiles;
 }
 
 // Interface
@@ -59,13 +109,13 @@ namespace
 // Initialize / Clean Up
 //----------------------
 
-eae6320::cResult eae6320::Graphics::cShader::Load( const std::string& i_path, cShader*& o_shader, const eShaderType i_type )
+eae6320::cResult eae6320::Graphics::cShader::Load( const std::string& i_path, cShader*& o_shader, const eShaderType i_type,
+	const uint32_t i_variantKey )
 {
 	auto result = Results::Success;
 
-	Platform::sDataFromFile dataFromFile;
 	cShader* newShader = nullptr;
-	cScopeGuard scopeGuard( [&o_shader, &result, &dataFromFile, &newShader]
+	cScopeGuard scopeGuard( [&o_shader, &result, &newShader]
 		{
 			if ( result )
 			{
@@ -97,16 +147,6 @@ eae6320::cResult eae6320::Graphics::cShader::Load( const std::string& i_path, cS
 			return result;
 		}
 	}
-	// Load the binary data
-	{
-		std::string errorMessage;
-		if ( !( result = Platform::LoadBinaryFile( i_path.c_str(), dataFromFile, &errorMessage ) ) )
-		{
-			EAE6320_ASSERTF( false, errorMessage.c_str() );
-			Logging::OutputError( "Failed to load shader from file %s: %s", i_path.c_str(), errorMessage.c_str() );
-			return result;
-		}
-	}
 	// Allocate a new shader
 	{
 		newShader = new (std::nothrow) cShader( i_type );
@@ -118,8 +158,29 @@ eae6320::cResult eae6320::Graphics::cShader::Load( const std::string& i_path, cS
 			return result;
 		}
 	}
+	// Get the binary data
+	// (if another variant from the same file is loaded the file has already been loaded,
+	// and if the shader is in the mounted asset pack it is used from there without opening its file)
+	Assets::cPackFile::sView file;
+	if ( !( result = s_shaderFiles.Acquire( i_path, file ) ) )
+	{
+		return result;
+	}
+	newShader->m_path = i_path;
+	// Find the variant's program
+	const void* compiledShader;
+	size_t compiledShaderSize;
+	{
+		std::string errorMessage;
+		if ( !( result = ShaderFormats::GetVariantProgram( file.data, file.size, i_variantKey, compiledShader, compiledShaderSize, &errorMessage ) ) )
+		{
+			EAE6320_ASSERTF( false, errorMessage.c_str() );
+			Logging::OutputError( "The shader %s can't be loaded: %s", i_path.c_str(), errorMessage.c_str() );
+			return result;
+		}
+	}
 	// Initialize the platform-specific graphics API shader object
-	if ( !( result = newShader->Initialize( i_path, dataFromFile ) ) )
+	if ( !( result = newShader->Initialize( i_path, compiledShader, compiledShaderSize ) ) )
 	{
 		EAE6320_ASSERTF( false, "Initialization of new shader failed" );
 		return result;
@@ -147,6 +208,10 @@ eae6320::Graphics::cShader::~cShader()
 	s_shaderTracker.RemoveShader( this );
 	const auto result = CleanUp();
 	EAE6320_ASSERT( result );
+	if ( !m_path.empty() )
+	{
+		s_shaderFiles.Release( m_path );
+	}
 }
 
 // Helper Class Definition
@@ -202,4 +267,60 @@ namespace
 			*invalidAddress = 123;	// Intentional crash! You have a bug that must be fixed!
 		}
 	}
+
+	// Access
+
+	eae6320::cResult cShaderFiles::Acquire( const std::string& i_path, eae6320::Assets::cPackFile::sView& o_file )
+	{
+		eae6320::Concurrency::cMutex::cScopeLock scopeLock( m_mutex );
+		auto& file = m_files[i_path];
+		if ( file.shaderCount == 0 )
+		{
+			if ( !eae6320::Assets::cPackFile::FindInMountedPack( i_path.c_str(), file.view ) )
+			{
+				std::string errorMessage;
+				const auto result = eae6320::Platform::LoadBinaryFile( i_path.c_str(), file.dataFromFile, &errorMessage );
+				if ( !result )
+				{
+					m_files.erase( i_path );
+					EAE6320_ASSERTF( false, errorMessage.c_str() );
+					eae6320::Logging::OutputError( "Failed to load shader from file %s: %s", i_path.c_str(), errorMessage.c_str() );
+					return result;
+				}
+				file.view.data = file.dataFromFile.data;
+				file.view.size = file.dataFromFile.size;
+			}
+		}
+		++file.shaderCount;
+		o_file = file.view;
+		return eae6320::Results::Success;
+	}
+
+	void cShaderFiles::Release( const std::string& i_path )
+	{
+		eae6320::Concurrency::cMutex::cScopeLock scopeLock( m_mutex );
+		const auto iterator = m_files.find( i_path );
+		if ( iterator != m_files.end() )
+		{
+			EAE6320_ASSERT( iterator->second.shaderCount > 0 );
+			if ( --iterator->second.shaderCount == 0 )
+			{
+				m_files.erase( iterator );
+			}
+		}
+		else
+		{
+			EAE6320_ASSERTF( false, "The shader file %s wasn't acquired", i_path.c_str() );
+		}
+	}
+
+	// Initialize / Clean Up
+
+	cShaderFiles::~cShaderFiles()
+	{
+		// Every shader releases its file when it is destroyed,
+		// and so if a file hasn't been released the shader tracker will already have reported it
+		eae6320::Concurrency::cMutex::cScopeLock scopeLock( m_mutex );
+		m_files.clear();
+	}
 }
@@ -15,6 +15,7 @@
 
 #include <Engine/Assets/ReferenceCountedAssets.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <Engine/Results/Results.h>
 #include <string>
@@ -48,16 +49,6 @@ namespace eae6320
 	}
 }
 
-// Forward Declarations
-//=====================
-
-namespace eae6320
-{
-	namespace Platform
-	{
-		struct sDataFromFile;
-	}
-}
 
 #ifdef EAE6320_PLATFORM_D3D
 	struct ID3D11VertexShader;
@@ -81,7 +72,10 @@ namespace eae6320
 			// Initialization / Clean Up
 			//--------------------------
 
-			static cResult Load( const std::string& i_path, cShader*& o_shader, const eShaderType i_type );
+			// The variant key has a bit set for each of the shader's keywords that should be #defined (see ShaderFormats.h).
+			// Every variant is in the same file,
+			// and while any variant from a file is loaded the others can be loaded without reading the file again.
+			static cResult Load( const std::string& i_path, cShader*& o_shader, const eShaderType i_type, const uint32_t i_variantKey = 0 );
 
 			EAE6320_ASSETS_DECLAREDELETEDREFERENCECOUNTEDFUNCTIONS( cShader );
 
@@ -108,10 +102,18 @@ namespace eae6320
 			} m_shaderObject;
 #elif defined( EAE6320_PLATFORM_GL )
 			GLuint m_shaderId = 0;
+#elif defined( EAE6320_PLATFORM_NULL )
+			uint32_t m_shaderId = 0;
 #endif
 			EAE6320_ASSETS_DECLAREREFERENCECOUNT();
 			const eShaderType m_type = eShaderType::Unknown;
 
+		private:
+
+			// This is empty until the shader's file has been acquired
+			// (the file is released when the shader is destroyed)
+			std::string m_path;
+
 			// Implementation
 			//===============
 
@@ -120,7 +122,9 @@ namespace eae6320
 			// Initialization / Clean Up
 			//--------------------------
 
-			cResult Initialize( const std::string& i_path, const Platform::sDataFromFile& i_loadedShader );
+			// The compiled shader is one program from a loaded file or from a view of the mounted asset pack,
+			// and it is only valid while this is called
+			cResult Initialize( const std::string& i_path, const void* const i_compiledShader, const size_t i_compiledShaderSize );
 			cResult CleanUp();
 
 			cShader( const eShaderType i_type );
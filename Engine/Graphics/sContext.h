@@ -28,12 +28,23 @@
 	#endif
 #endif
 
+#if defined( EAE6320_PLATFORM_NULL )
+	#include "cConstantBuffer.h"
+	#include "Null/cCommandLog.h"
+#elif defined( EAE6320_PLATFORM_SOFTWARE )
+	#include "cConstantBuffer.h"
+	#include "Software/cRasterizer.h"
+
+	#include <vector>
+#endif
+
 // Forward Declarations
 //=====================
 
 #if defined( EAE6320_PLATFORM_D3D )
 	struct ID3D11Device;
 	struct ID3D11DeviceContext;
+	struct ID3D11DeviceContext1;
 	struct IDXGISwapChain;
 #endif
 
@@ -59,6 +70,9 @@ namespace eae6320
 			// A device's immediate context can only be used by the main/render thread
 			// (it is not thread safe)
 			ID3D11DeviceContext* direct3dImmediateContext = nullptr;
+			// The Direct3D 11.1 interface of the same context
+			// (it can bind part of a constant buffer, which constant buffer rings need)
+			ID3D11DeviceContext1* direct3dImmediateContext1 = nullptr;
 			// A swap chain is like an array (a "chain") of textures
 			// that are rendered to in sequence,
 			// with a single one being currently displayed
@@ -68,6 +82,24 @@ namespace eae6320
 			// (i.e. they are Windows concepts and wouldn't be used on other platforms that use OpenGL)
 			HDC deviceContext = NULL;
 			HGLRC openGlRenderingContext = NULL;
+#elif defined( EAE6320_PLATFORM_NULL )
+			// There is no device;
+			// every command that would have been sent to one is recorded here instead
+			cCommandLog commandLog;
+			// Instanced draws are expanded into one draw per instance,
+			// and so the null platform needs to know which constant buffers the draws would have read from
+			const cConstantBuffer* boundConstantBuffers[static_cast<size_t>( ConstantBufferTypes::Count )] = {};
+#elif defined( EAE6320_PLATFORM_SOFTWARE )
+			// There is no device;
+			// the CPU transforms and rasterizes every draw
+			cRasterizer rasterizer;
+			// A draw reads from whatever was bound most recently (like a GPU would)
+			const cConstantBuffer* boundConstantBuffers[static_cast<size_t>( ConstantBufferTypes::Count )] = {};
+			uint8_t renderStateBits = 0;
+			uint32_t fragmentColor = 0;
+			// The vertices that the vertex shader outputs are written here
+			// (the memory is reused for every draw)
+			std::vector<sVertex_projected> projectedVertices;
 #endif
 
 			// Interface
@@ -84,6 +116,15 @@ namespace eae6320
 			cResult Initialize( const sInitializationParameters& i_initializationParameters );
 			cResult CleanUp();
 
+#if defined( EAE6320_PLATFORM_SOFTWARE )
+			// Render
+			//-------
+
+			// Saves the most recently presented frame as a .png or .ppm
+			// (this can be called from any thread)
+			cResult SavePresentedFrame( const char* const i_path ) const;
+#endif
+
 			~sContext();
 
 			// Implementation
@@ -44,7 +44,8 @@ eae6320::Math::cMatrix_transformation eae6320::Math::cMatrix_transformation::Cre
 {
 	const auto yScale = 1.0f / std::tan( i_verticalFieldOfView_inRadians * 0.5f );
 	const auto xScale = yScale / i_aspectRatio;
-#if defined( EAE6320_PLATFORM_D3D )
+	// The null and software platforms use the same [0,1] depth range as Direct3D
+#if defined( EAE6320_PLATFORM_D3D ) || defined( EAE6320_PLATFORM_NULL ) || defined( EAE6320_PLATFORM_SOFTWARE )
 	const auto zDistanceScale = i_z_farPlane / ( i_z_nearPlane - i_z_farPlane );
 	return cMatrix_transformation(
 		xScale, 0.0f, 0.0f, 0.0f,
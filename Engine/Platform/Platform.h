@@ -75,18 +75,73 @@ namespace eae6320
 			}
 		};
 
+		// This is used to read files without copying them:
+		// the file's contents are mapped directly into memory,
+		// and the operating system only reads the pages from disk when they are accessed.
+		// The data is read-only and is valid until the file is unmapped
+		// (the start of the data is aligned for any type that the file contains)
+		struct sMappedFile
+		{
+			const void* data = nullptr;
+			size_t size = 0;
+
+			sMappedFile() = default;
+
+			void Unmap() noexcept;
+
+			~sMappedFile()
+			{
+				Unmap();
+			}
+
+			sMappedFile( const sMappedFile& ) = delete;
+			sMappedFile( sMappedFile&& io_movedFrom ) noexcept
+				:
+				data( io_movedFrom.data ), size( io_movedFrom.size )
+			{
+				io_movedFrom.data = nullptr;
+				io_movedFrom.size = 0;
+			}
+			sMappedFile& operator =( const sMappedFile& ) = delete;
+			sMappedFile& operator =( sMappedFile&& io_movedFrom ) noexcept
+			{
+				if ( &io_movedFrom != this )
+				{
+					Unmap();
+					data = io_movedFrom.data;
+					io_movedFrom.data = nullptr;
+					size = io_movedFrom.size;
+					io_movedFrom.size = 0;
+				}
+				return *this;
+			}
+		};
+
 		cResult CopyFile( const char* const i_path_source, const char* const i_path_target,
 			const bool i_shouldFunctionFailIfTargetAlreadyExists = false, const bool i_shouldTargetFileTimeBeModified = false,
 			std::string* o_errorMessage = nullptr );
 		cResult CreateDirectoryIfItDoesntExist( const std::string& i_filePath, std::string* const o_errorMessage = nullptr );
 		bool DoesFileExist( const char* const i_path, std::string* const o_errorMessage = nullptr );
-		cResult ExecuteCommand( const char* const i_command, int* const o_exitCode = nullptr, std::string* const o_errorMessage = nullptr );
+		// If an output string is provided then the command's standard output and standard error are captured into it
+		// instead of being written to the console
+		// (this can be called from several threads at the same time)
+		cResult ExecuteCommand( const char* const i_command, int* const o_exitCode = nullptr, std::string* const o_errorMessage = nullptr,
+			std::string* const o_output = nullptr );
 		cResult GetFilesInDirectory( const std::string& i_path, std::vector<std::string>& o_paths,
 			const bool i_shouldSubdirectoriesBeSearchedRecursively = true, std::string* const o_errorMessage = nullptr );
 		cResult GetEnvironmentVariable( const char* const i_key, std::string& o_value, std::string* const o_errorMessage = nullptr );
 		cResult GetLastWriteTime( const char* const i_path, uint64_t& o_lastWriteTime, std::string* const o_errorMessage = nullptr );
+		// This is the path of the executable file that the current process was started from
+		cResult GetPathOfThisProgram( std::string& o_path, std::string* const o_errorMessage = nullptr );
 		cResult InvalidateLastWriteTime( const char* const i_path, std::string* const o_errorMessage = nullptr );
 		cResult LoadBinaryFile( const char* const i_path, sDataFromFile& o_data, std::string* const o_errorMessage = nullptr );
+		// Unlike LoadBinaryFile() no memory is allocated and nothing is copied
+		// (an empty file succeeds with no data)
+		cResult MapFile( const char* const i_path, sMappedFile& o_file, std::string* const o_errorMessage = nullptr );
+		// Mapped data is only read from disk when it is first accessed,
+		// and so a thread that is about to hand mapped data to another thread can call this
+		// to start reading it without waiting (and without blocking the thread that will access it)
+		void PrefetchMappedData( const void* const i_data, const size_t i_size );
 		// This function writes an entire file in a single operation in the most efficient way possible.
 		// If you need to write out more than one smaller chunk to a file, however,
 		// you should use one of the standard library functions that does buffering.
@@ -27,10 +27,11 @@ bool eae6320::Platform::DoesFileExist( const char* const i_path, std::string* co
 	return Windows::DoesFileExist( i_path, o_errorMessage );
 }
 
-eae6320::cResult eae6320::Platform::ExecuteCommand( const char* const i_command, int* const o_exitCode, std::string* const o_errorMessage )
+eae6320::cResult eae6320::Platform::ExecuteCommand( const char* const i_command, int* const o_exitCode, std::string* const o_errorMessage,
+	std::string* const o_output )
 {
 	DWORD exitCode_unsigned;
-	const auto result = Windows::ExecuteCommand( i_command, &exitCode_unsigned, o_errorMessage );
+	const auto result = Windows::ExecuteCommand( i_command, &exitCode_unsigned, o_errorMessage, o_output );
 	if ( o_exitCode )
 	{
 		int32_t exitCode_signed = static_cast<int32_t>( exitCode_unsigned );
@@ -55,6 +56,11 @@ eae6320::cResult eae6320::Platform::GetLastWriteTime( const char* const i_path,
 	return Windows::GetLastWriteTime( i_path, o_lastWriteTime, o_errorMessage );
 }
 
+eae6320::cResult eae6320::Platform::GetPathOfThisProgram( std::string& o_path, std::string* const o_errorMessage )
+{
+	return Windows::GetPathOfThisProgram( o_path, o_errorMessage );
+}
+
 eae6320::cResult eae6320::Platform::InvalidateLastWriteTime( const char* const i_path, std::string* const o_errorMessage )
 {
 	return Windows::InvalidateLastWriteTime( i_path, o_errorMessage );
@@ -72,6 +78,38 @@ eae6320::cResult eae6320::Platform::LoadBinaryFile( const char* const i_path, sD
 	return result;
 }
 
+eae6320::cResult eae6320::Platform::MapFile( const char* const i_path, sMappedFile& o_file, std::string* const o_errorMessage )
+{
+	// If the output already has a file mapped it is unmapped
+	// (otherwise the view would be leaked when it is overwritten)
+	o_file.Unmap();
+	Windows::sMappedFile mappedFile;
+	const auto result = Windows::MapFile( i_path, mappedFile, o_errorMessage );
+	{
+		o_file.data = mappedFile.data;
+		o_file.size = mappedFile.size;
+	}
+
+	return result;
+}
+
+void eae6320::Platform::sMappedFile::Unmap() noexcept
+{
+	Windows::sMappedFile mappedFile;
+	{
+		mappedFile.data = data;
+		mappedFile.size = size;
+	}
+	mappedFile.Unmap();
+	data = nullptr;
+	size = 0;
+}
+
+void eae6320::Platform::PrefetchMappedData( const void* const i_data, const size_t i_size )
+{
+	Windows::PrefetchMappedData( i_data, i_size );
+}
+
 eae6320::cResult eae6320::Platform::WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage )
 {
 	return Windows::WriteBinaryFile( i_path, i_data, i_size, o_errorMessage );
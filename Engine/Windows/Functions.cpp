@@ -9,18 +9,29 @@
 #include <Engine/ScopeGuard/cScopeGuard.h>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <regex>
 #include <ShlObj.h>
 #include <Shlwapi.h>
 #include <sstream>
 
+// Static Data
+//============
+
+namespace
+{
+	// Processes that capture their output are created one at a time
+	// (see ExecuteCommand())
+	std::mutex s_mutex_createProcessWithOutput;
+}
+
 // Helper Declarations
 //====================
 
 namespace
 {
 	void OutputMessageForVisualStudio( const char* const i_severity, const char* const i_errorMessage, const char* const i_optionalFilePath,
-		const unsigned int* const i_optionalLineNumber, const unsigned int* const i_optionalColumnNumber );
+		const unsigned int* const i_optionalLineNumber, const unsigned int* const i_optionalColumnNumber, std::ostream* const io_optionalStream );
 }
 
 // Interface
@@ -340,14 +351,15 @@ bool eae6320::Windows::DoesFileExist( const char* const i_path, std::string* con
 	}
 }
 
-eae6320::cResult eae6320::Windows::ExecuteCommand( const char* const i_command, DWORD* const o_exitCode, std::string* const o_errorMessage )
+eae6320::cResult eae6320::Windows::ExecuteCommand( const char* const i_command, DWORD* const o_exitCode, std::string* const o_errorMessage,
+	std::string* const o_output )
 {
 	constexpr char* const noPath = nullptr;
-	return ExecuteCommand( noPath, i_command, o_exitCode, o_errorMessage );
+	return ExecuteCommand( noPath, i_command, o_exitCode, o_errorMessage, o_output );
 }
 
 eae6320::cResult eae6320::Windows::ExecuteCommand( const char* const i_path, const char* const i_optionalArguments,
-	DWORD* const o_exitCode, std::string* const o_errorMessage )
+	DWORD* const o_exitCode, std::string* const o_errorMessage, std::string* const o_output )
 {
 	// Get a non-const char* command line
 	std::string path;
@@ -445,22 +457,99 @@ eae6320::cResult eae6320::Windows::ExecuteCommand( const char* const i_path, con
 		}
 	}
 	
+	// If the output is being captured then the process writes it to a pipe instead of to the console
+	HANDLE outputPipe_read = NULL;
+	HANDLE outputPipe_write = NULL;
+	const cScopeGuard scopeGuard_outputPipe( [&outputPipe_read, &outputPipe_write]()
+		{
+			if ( outputPipe_read )
+			{
+				CloseHandle( outputPipe_read );
+			}
+			if ( outputPipe_write )
+			{
+				CloseHandle( outputPipe_write );
+			}
+		} );
+	if ( o_output )
+	{
+		o_output->clear();
+		constexpr SECURITY_ATTRIBUTES* const dontInheritPipe = nullptr;
+		constexpr DWORD useDefaultBufferSize = 0;
+		if ( CreatePipe( &outputPipe_read, &outputPipe_write, dontInheritPipe, useDefaultBufferSize ) == FALSE )
+		{
+			const auto errorCode = GetLastError();
+			EAE6320_ASSERTF( false, "Couldn't create a pipe for a process's output: %s", GetFormattedSystemMessage( errorCode ).c_str() );
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to create a pipe for the output of the process \"" << path << "\": " << GetFormattedSystemMessage( errorCode );
+				*o_errorMessage = errorMessage.str();
+			}
+			return Results::Failure;
+		}
+	}
+
 	// Start a new process
 	auto result = Results::Success;
 	constexpr SECURITY_ATTRIBUTES* useDefaultAttributes = nullptr;
-	constexpr BOOL dontInheritHandles = FALSE;
 	constexpr DWORD createDefaultProcess = 0;
 	constexpr void* const useCallingProcessEnvironment = nullptr;
 	constexpr wchar_t* const useCallingProcessCurrentDirectory = nullptr;
 	STARTUPINFOW startupInfo{};
 	{
 		startupInfo.cb = sizeof( startupInfo );
+		if ( o_output )
+		{
+			// Both standard output and standard error go to the pipe
+			// (the process doesn't get any input)
+			startupInfo.dwFlags = STARTF_USESTDHANDLES;
+			startupInfo.hStdInput = NULL;
+			startupInfo.hStdOutput = outputPipe_write;
+			startupInfo.hStdError = outputPipe_write;
+		}
 	}
 	PROCESS_INFORMATION processInformation{};
-	if ( CreateProcessW( NULL, arguments, useDefaultAttributes, useDefaultAttributes,
-		dontInheritHandles, createDefaultProcess, useCallingProcessEnvironment, useCallingProcessCurrentDirectory,
-		&startupInfo, &processInformation ) != FALSE )
+	BOOL wasProcessCreated;
+	if ( !o_output )
+	{
+		constexpr BOOL dontInheritHandles = FALSE;
+		wasProcessCreated = CreateProcessW( NULL, arguments, useDefaultAttributes, useDefaultAttributes,
+			dontInheritHandles, createDefaultProcess, useCallingProcessEnvironment, useCallingProcessCurrentDirectory,
+			&startupInfo, &processInformation );
+	}
+	else
 	{
+		// The process must inherit the pipe's write handle,
+		// but if commands are being executed on several threads at the same time
+		// then a different process could also inherit it and keep the pipe open after this process exits.
+		// To prevent that the handle is only inheritable while this process is being created.
+		std::lock_guard<std::mutex> lock( s_mutex_createProcessWithOutput );
+		SetHandleInformation( outputPipe_write, HANDLE_FLAG_INHERIT, HANDLE_FLAG_INHERIT );
+		constexpr BOOL inheritHandles = TRUE;
+		wasProcessCreated = CreateProcessW( NULL, arguments, useDefaultAttributes, useDefaultAttributes,
+			inheritHandles, createDefaultProcess, useCallingProcessEnvironment, useCallingProcessCurrentDirectory,
+			&startupInfo, &processInformation );
+		SetHandleInformation( outputPipe_write, HANDLE_FLAG_INHERIT, 0 );
+	}
+	if ( wasProcessCreated != FALSE )
+	{
+		// Read the output until the process closes its end of the pipe
+		if ( o_output )
+		{
+			// This process's copy of the write handle must be closed first
+			// or reading would never reach the end
+			CloseHandle( outputPipe_write );
+			outputPipe_write = NULL;
+			constexpr DWORD bufferSize = 4096;
+			char buffer[bufferSize];
+			DWORD readByteCount;
+			constexpr OVERLAPPED* const noOverlapped = nullptr;
+			while ( ( ReadFile( outputPipe_read, buffer, bufferSize, &readByteCount, noOverlapped ) != FALSE ) && ( readByteCount > 0 ) )
+			{
+				o_output->append( buffer, readByteCount );
+			}
+		}
 		// Wait for the process to finish
 		if ( WaitForSingleObject( processInformation.hProcess, INFINITE ) != WAIT_FAILED )
 		{
@@ -823,6 +912,34 @@ eae6320::cResult eae6320::Windows::GetLastWriteTime( const char* const i_path, u
 	return Results::Success;
 }
 
+eae6320::cResult eae6320::Windows::GetPathOfThisProgram( std::string& o_path, std::string* const o_errorMessage )
+{
+	// GetModuleFileName() truncates the path if the buffer is too small instead of failing,
+	// and so the buffer is made bigger until the whole path fits
+	std::wstring buffer( MAX_PATH, L'\0' );
+	while ( true )
+	{
+		const auto characterCount = GetModuleFileNameW( NULL, &buffer[0], static_cast<DWORD>( buffer.size() ) );
+		if ( characterCount == 0 )
+		{
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to get the path of this program: " << GetLastSystemError();
+				*o_errorMessage = errorMessage.str();
+			}
+			return Results::Failure;
+		}
+		else if ( characterCount < buffer.size() )
+		{
+			buffer.resize( characterCount );
+			o_path = ConvertUtf16ToUtf8( buffer.c_str() );
+			return Results::Success;
+		}
+		buffer.resize( buffer.size() * 2 );
+	}
+}
+
 eae6320::cResult eae6320::Windows::InvalidateLastWriteTime( const char* const i_path, std::string* const o_errorMessage )
 {
 	HANDLE fileHandle = INVALID_HANDLE_VALUE;
@@ -1033,16 +1150,189 @@ eae6320::cResult eae6320::Windows::LoadBinaryFile( const char* const i_path, sDa
 	return result;
 }
 
+eae6320::cResult eae6320::Windows::MapFile( const char* const i_path, sMappedFile& o_file, std::string* const o_errorMessage )
+{
+	auto result = Results::Success;
+
+	HANDLE fileHandle = INVALID_HANDLE_VALUE;
+	HANDLE fileMappingHandle = NULL;
+
+	// The view keeps its own reference to the file mapping object (which keeps its own reference to the file),
+	// and so both handles can be closed as soon as the view has been mapped
+	const cScopeGuard scopeGuard( [i_path, &o_file, o_errorMessage, &result, &fileHandle, &fileMappingHandle]()
+		{
+			if ( !result )
+			{
+				o_file.Unmap();
+				o_file.size = 0;
+			}
+			if ( fileMappingHandle != NULL )
+			{
+				if ( CloseHandle( fileMappingHandle ) == FALSE )
+				{
+					const auto errorCode = GetLastError();
+					if ( o_errorMessage )
+					{
+						std::ostringstream errorMessage;
+						errorMessage << "\n" "Windows failed to close the file mapping handle from \"" << i_path << "\": "
+							<< GetFormattedSystemMessage( errorCode );
+						*o_errorMessage += errorMessage.str();
+					}
+				}
+				fileMappingHandle = NULL;
+			}
+			if ( fileHandle != INVALID_HANDLE_VALUE )
+			{
+				if ( CloseHandle( fileHandle ) == FALSE )
+				{
+					const auto errorCode = GetLastError();
+					if ( o_errorMessage )
+					{
+						std::ostringstream errorMessage;
+						errorMessage << "\n" "Windows failed to close the file handle from \"" << i_path << "\": "
+							<< GetFormattedSystemMessage( errorCode );
+						*o_errorMessage += errorMessage.str();
+					}
+				}
+				fileHandle = INVALID_HANDLE_VALUE;
+			}
+		} );
+
+	// Initialize the output struct so that if there's an error during this function any existing garbage data isn't misinterpreted
+	{
+		EAE6320_ASSERT( o_file.data == nullptr );
+		o_file.data = nullptr;
+		o_file.size = 0;
+	}
+
+	// Open the file
+	{
+		constexpr DWORD desiredAccess = FILE_GENERIC_READ;
+		constexpr DWORD otherProgramsCanStillReadTheFile = FILE_SHARE_READ;
+		constexpr SECURITY_ATTRIBUTES* const useDefaultSecurity = nullptr;
+		constexpr DWORD onlySucceedIfFileExists = OPEN_EXISTING;
+		constexpr DWORD attributes = FILE_ATTRIBUTE_NORMAL;
+		constexpr HANDLE dontUseTemplateFile = NULL;
+		fileHandle = CreateFileW( ConvertUtf8ToUtf16( i_path ).c_str(), desiredAccess, otherProgramsCanStillReadTheFile,
+			useDefaultSecurity, onlySucceedIfFileExists, attributes, dontUseTemplateFile );
+		if ( fileHandle == INVALID_HANDLE_VALUE )
+		{
+			const auto errorCode = GetLastError();
+			switch ( errorCode )
+			{
+			case ERROR_FILE_NOT_FOUND:
+			case ERROR_PATH_NOT_FOUND:
+				result = Results::FileDoesntExist;
+				break;
+			default:
+				result = Results::Failure;
+			}
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to open the file \"" << i_path << "\" for mapping: " << GetFormattedSystemMessage( errorCode );
+				*o_errorMessage = errorMessage.str();
+			}
+			return result;
+		}
+	}
+	// Get the file's size
+	{
+		LARGE_INTEGER fileSize_integer;
+		if ( GetFileSizeEx( fileHandle, &fileSize_integer ) != FALSE )
+		{
+			EAE6320_ASSERT( fileSize_integer.QuadPart <= SIZE_MAX );
+			o_file.size = static_cast<size_t>( fileSize_integer.QuadPart );
+		}
+		else
+		{
+			const auto errorCode = GetLastError();
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to get the size of the file \"" << i_path << "\": " << GetFormattedSystemMessage( errorCode );
+				*o_errorMessage = errorMessage.str();
+			}
+			result = Results::Failure;
+			return result;
+		}
+	}
+	// An empty file can't be mapped,
+	// but there is nothing to read from it anyway
+	if ( o_file.size == 0 )
+	{
+		return result;
+	}
+	// Create a read-only file mapping object for the entire file
+	{
+		constexpr SECURITY_ATTRIBUTES* const useDefaultSecurity = nullptr;
+		constexpr DWORD mapEntireFile_high = 0, mapEntireFile_low = 0;
+		constexpr wchar_t* const noName = nullptr;
+		fileMappingHandle = CreateFileMappingW( fileHandle, useDefaultSecurity, PAGE_READONLY,
+			mapEntireFile_high, mapEntireFile_low, noName );
+		if ( fileMappingHandle == NULL )
+		{
+			const auto errorCode = GetLastError();
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to create a file mapping for \"" << i_path << "\": " << GetFormattedSystemMessage( errorCode );
+				*o_errorMessage = errorMessage.str();
+			}
+			result = Results::Failure;
+			return result;
+		}
+	}
+	// Map a view of the entire file
+	// (a view always starts on an allocation granularity boundary,
+	// and so the data is aligned for any type that the file contains)
+	{
+		constexpr DWORD offset_high = 0, offset_low = 0;
+		constexpr SIZE_T mapToEndOfFile = 0;
+		o_file.data = MapViewOfFile( fileMappingHandle, FILE_MAP_READ, offset_high, offset_low, mapToEndOfFile );
+		if ( !o_file.data )
+		{
+			const auto errorCode = GetLastError();
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "Windows failed to map a view of \"" << i_path << "\": " << GetFormattedSystemMessage( errorCode );
+				*o_errorMessage = errorMessage.str();
+			}
+			result = Results::Failure;
+			return result;
+		}
+	}
+
+	return result;
+}
+
 void eae6320::Windows::OutputErrorMessageForVisualStudio( const char* const i_errorMessage, const char* const i_optionalFilePath,
-	const unsigned int* const i_optionalLineNumber, const unsigned int* const i_optionalColumnNumber )
+	const unsigned int* const i_optionalLineNumber, const unsigned int* const i_optionalColumnNumber, std::ostream* const io_optionalStream )
 {
-	OutputMessageForVisualStudio( "error", i_errorMessage, i_optionalFilePath, i_optionalLineNumber, i_optionalColumnNumber );
+	OutputMessageForVisualStudio( "error", i_errorMessage, i_optionalFilePath, i_optionalLineNumber, i_optionalColumnNumber, io_optionalStream );
 }
 
 void eae6320::Windows::OutputWarningMessageForVisualStudio( const char* const i_errorMessage, const char* const i_optionalFilePath,
-	const unsigned int* const i_optionalLineNumber, const unsigned int* const i_optionalColumnNumber )
+	const unsigned int* const i_optionalLineNumber, const unsigned int* const i_optionalColumnNumber, std::ostream* const io_optionalStream )
 {
-	OutputMessageForVisualStudio( "warning", i_errorMessage, i_optionalFilePath, i_optionalLineNumber, i_optionalColumnNumber );
+	OutputMessageForVisualStudio( "warning", i_errorMessage, i_optionalFilePath, i_optionalLineNumber, i_optionalColumnNumber, io_optionalStream );
+}
+
+void eae6320::Windows::PrefetchMappedData( const void* const i_data, const size_t i_size )
+{
+	if ( i_data && ( i_size > 0 ) )
+	{
+		WIN32_MEMORY_RANGE_ENTRY range;
+		{
+			range.VirtualAddress = const_cast<void*>( i_data );
+			range.NumberOfBytes = i_size;
+		}
+		constexpr ULONG_PTR rangeCount = 1;
+		constexpr ULONG noFlags = 0;
+		// If this fails the pages are read when they are first accessed instead
+		PrefetchVirtualMemory( GetCurrentProcess(), rangeCount, &range, noFlags );
+	}
 }
 
 eae6320::cResult eae6320::Windows::WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage )
@@ -1136,23 +1426,24 @@ eae6320::cResult eae6320::Windows::WriteBinaryFile( const char* const i_path, co
 namespace
 {
 	void OutputMessageForVisualStudio( const char* const i_severity, const char* const i_errorMessage, const char* const i_optionalFilePath,
-		const unsigned int* const i_optionalLineNumber, const unsigned int* const i_optionalColumnNumber )
+		const unsigned int* const i_optionalLineNumber, const unsigned int* const i_optionalColumnNumber, std::ostream* const io_optionalStream )
 	{
+		auto& stream = io_optionalStream ? *io_optionalStream : std::cerr;
 		if ( i_optionalFilePath )
 		{
-			std::cerr << i_optionalFilePath;
+			stream << i_optionalFilePath;
 			if ( i_optionalLineNumber )
 			{
-				std::cerr << "(" << *i_optionalLineNumber;
+				stream << "(" << *i_optionalLineNumber;
 				if ( i_optionalColumnNumber )
 				{
-					std::cerr << ", " << *i_optionalColumnNumber;
+					stream << ", " << *i_optionalColumnNumber;
 				}
-				std::cerr << ")";
+				stream << ")";
 			}
-			std::cerr << " : ";
+			stream << " : ";
 		}
-		std::cerr << i_severity << " : " << i_errorMessage
+		stream << i_severity << " : " << i_errorMessage
 			// Using std::endl flushes the buffer so that the error shows up immediately
 			<< std::endl;
 	}
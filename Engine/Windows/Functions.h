@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <Engine/Results/Results.h>
+#include <iosfwd>
 #include <string>
 #include <vector>
 
@@ -40,6 +41,25 @@ namespace eae6320
 			}
 		};
 
+		// This is used to read files without copying them:
+		// the file's contents are mapped into the process's address space
+		// and Windows reads the pages from the file cache when they are first accessed
+		// (Note that the view is _not_ automatically unmapped by the destructor)
+		struct sMappedFile
+		{
+			const void* data = nullptr;
+			size_t size = 0;
+
+			void Unmap()
+			{
+				if ( data )
+				{
+					UnmapViewOfFile( data );
+					data = nullptr;
+				}
+			}
+		};
+
 		std::wstring ConvertUtf8ToUtf16( const char* const i_string_utf8 );
 		std::string ConvertUtf16ToUtf8( const wchar_t* const i_string_utf16 );
 		cResult CopyFile( const char* const i_path_source, const char* const i_path_target,
@@ -47,21 +67,34 @@ namespace eae6320
 			std::string* o_errorMessage = nullptr );
 		cResult CreateDirectoryIfItDoesntExist( const std::string& i_filePath, std::string* const o_errorMessage = nullptr );
 		bool DoesFileExist( const char* const i_path, std::string* const o_errorMessage = nullptr );
-		cResult ExecuteCommand( const char* const i_command, DWORD* const o_exitCode = nullptr, std::string* const o_errorMessage = nullptr );
+		// If an output string is provided then the process's standard output and standard error are captured into it
+		// instead of being written to the console
+		cResult ExecuteCommand( const char* const i_command, DWORD* const o_exitCode = nullptr, std::string* const o_errorMessage = nullptr,
+			std::string* const o_output = nullptr );
 		cResult ExecuteCommand( const char* const i_path, const char* const i_optionalArguments = nullptr,
-			DWORD* const o_exitCode = nullptr, std::string* const o_errorMessage = nullptr );
+			DWORD* const o_exitCode = nullptr, std::string* const o_errorMessage = nullptr, std::string* const o_output = nullptr );
 		cResult GetFilesInDirectory( const std::string& i_path, std::vector<std::string>& o_paths,
 			const bool i_shouldSubdirectoriesBeSearchedRecursively = true, std::string* const o_errorMessage = nullptr );
 		cResult GetEnvironmentVariable( const char* const i_key, std::string& o_value, std::string* const o_errorMessage = nullptr );
 		std::string GetFormattedSystemMessage( const DWORD i_code );
 		std::string GetLastSystemError( DWORD* const o_optionalErrorCode = nullptr );
 		cResult GetLastWriteTime( const char* const i_path, uint64_t& o_lastWriteTime, std::string* const o_errorMessage = nullptr );
+		// This is the path of the executable file that the current process was started from
+		cResult GetPathOfThisProgram( std::string& o_path, std::string* const o_errorMessage = nullptr );
 		cResult InvalidateLastWriteTime( const char* const i_path, std::string* const o_errorMessage = nullptr );
 		cResult LoadBinaryFile( const char* const i_path, sDataFromFile& o_data, std::string* const o_errorMessage = nullptr );
+		// The file can't be written to while it is mapped
+		cResult MapFile( const char* const i_path, sMappedFile& o_file, std::string* const o_errorMessage = nullptr );
+		// If no stream is provided the message is written to std::cerr
 		void OutputErrorMessageForVisualStudio( const char* const i_errorMessage, const char* const i_optionalFilePath = nullptr,
-			const unsigned int* const i_optionalLineNumber = nullptr, const unsigned int* const i_optionalColumnNumber = nullptr );
+			const unsigned int* const i_optionalLineNumber = nullptr, const unsigned int* const i_optionalColumnNumber = nullptr,
+			std::ostream* const io_optionalStream = nullptr );
 		void OutputWarningMessageForVisualStudio( const char* const i_errorMessage, const char* const i_optionalFilePath = nullptr,
-			const unsigned int* const i_optionalLineNumber = nullptr, const unsigned int* const i_optionalColumnNumber = nullptr );
+			const unsigned int* const i_optionalLineNumber = nullptr, const unsigned int* const i_optionalColumnNumber = nullptr,
+			std::ostream* const io_optionalStream = nullptr );
+		// This asks Windows to start reading the pages of a mapped range from the file without waiting for them
+		// (it is only a hint, and so there is nothing to report if it fails)
+		void PrefetchMappedData( const void* const i_data, const size_t i_size );
 		cResult WriteBinaryFile( const char* const i_path, const void* const i_data, const size_t i_size, std::string* const o_errorMessage = nullptr );
 	}
 }
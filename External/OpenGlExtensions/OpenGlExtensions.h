@@ -30,6 +30,7 @@ extern PFNGLACTIVETEXTUREPROC glActiveTexture;
 extern PFNGLATTACHSHADERPROC glAttachShader;
 extern PFNGLBINDBUFFERPROC glBindBuffer;
 extern PFNGLBINDBUFFERBASEPROC glBindBufferBase;
+extern PFNGLBINDBUFFERRANGEPROC glBindBufferRange;
 extern PFNGLBINDSAMPLERPROC glBindSampler;
 extern PFNGLBINDVERTEXARRAYPROC glBindVertexArray;
 extern PFNGLBLENDEQUATIONPROC glBlendEquation;
@@ -44,6 +45,7 @@ extern PFNGLDELETEPROGRAMPROC glDeleteProgram;
 extern PFNGLDELETESAMPLERSPROC glDeleteSamplers;
 extern PFNGLDELETESHADERPROC glDeleteShader;
 extern PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays;
+extern PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced;
 extern PFNGLENABLEVERTEXATTRIBARRAYARBPROC glEnableVertexAttribArray;
 extern PFNGLGENBUFFERSPROC glGenBuffers;
 extern PFNGLGENSAMPLERSPROC glGenSamplers;
@@ -27,6 +27,7 @@ PFNGLACTIVETEXTUREPROC glActiveTexture = nullptr;
 PFNGLATTACHSHADERPROC glAttachShader = nullptr;
 PFNGLBINDBUFFERPROC glBindBuffer = nullptr;
 PFNGLBINDBUFFERBASEPROC glBindBufferBase = nullptr;
+PFNGLBINDBUFFERRANGEPROC glBindBufferRange = nullptr;
 PFNGLBINDSAMPLERPROC glBindSampler = nullptr;
 PFNGLBINDVERTEXARRAYPROC glBindVertexArray = nullptr;
 PFNGLBLENDEQUATIONPROC glBlendEquation = nullptr;
@@ -41,6 +42,7 @@ PFNGLDELETEPROGRAMPROC glDeleteProgram = nullptr;
 PFNGLDELETESAMPLERSPROC glDeleteSamplers = nullptr;
 PFNGLDELETESHADERPROC glDeleteShader = nullptr;
 PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays = nullptr;
+PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced = nullptr;
 PFNGLENABLEVERTEXATTRIBARRAYARBPROC glEnableVertexAttribArray = nullptr;
 PFNGLGENBUFFERSPROC glGenBuffers = nullptr;
 PFNGLGENSAMPLERSPROC glGenSamplers = nullptr;
@@ -116,6 +118,7 @@ eae6320::cResult eae6320::OpenGlExtensions::Load( std::string* const o_errorMess
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glAttachShader, PFNGLATTACHSHADERPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBindBuffer, PFNGLBINDBUFFERPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBindBufferBase, PFNGLBINDBUFFERBASEPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBindBufferRange, PFNGLBINDBUFFERRANGEPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBindSampler, PFNGLBINDSAMPLERPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBindVertexArray, PFNGLBINDVERTEXARRAYPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glBlendEquation, PFNGLBLENDEQUATIONPROC );
@@ -129,6 +132,7 @@ eae6320::cResult eae6320::OpenGlExtensions::Load( std::string* const o_errorMess
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteProgram, PFNGLDELETEPROGRAMPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteVertexArrays, PFNGLDELETEVERTEXARRAYSPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteSamplers, PFNGLDELETESAMPLERSPROC );
+		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDrawElementsInstanced, PFNGLDRAWELEMENTSINSTANCEDPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glDeleteShader, PFNGLDELETESHADERPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glEnableVertexAttribArray, PFNGLENABLEVERTEXATTRIBARRAYARBPROC );
 		EAE6320_OPENGLEXTENSIONS_LOADFUNCTION( glGenBuffers, PFNGLGENBUFFERSPROC );
@@ -135,14 +135,39 @@ void eae6320::cMyGame::SubmitDataToBeRendered(const float i_elapsedSecondCount_s
 	float clearColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
 	Graphics::SubmitClearColor(clearColor);
 
-	constexpr int renderDataCount = 9;
-	Graphics::sEffectDrawCallAndMesh* renderData = new Graphics::sEffectDrawCallAndMesh[renderDataCount];
-	for (int i = 0; i < 9; i++) renderData[i] = m_renderableObjects[i]->GetRenderData(i_elapsedSecondCount_sinceLastSimulationUpdate);
-
-	Graphics::SubmitEffectsDrawCallsAndMeshes(renderData, renderDataCount);
-
 	m_camera_0->PredictForRender(i_elapsedSecondCount_sinceLastSimulationUpdate);
 	Graphics::SubmitCamera(m_camera_0->GetTransformWorldToCamera(), m_camera_0->GetTransformCameraToProjected());
+	// Only objects that the camera can see are submitted
+	const auto frustum = m_camera_0->GetFrustum();
+
+	// Objects that share an effect and a mesh are submitted together as instances
+	constexpr unsigned int renderDataCount = 9;
+	{
+		Graphics::cEffect* batchEffects[renderDataCount];
+		Graphics::cMesh* batchMeshes[renderDataCount];
+		Graphics::ConstantBufferFormats::sDrawCall batchInstances[renderDataCount][renderDataCount];
+		unsigned int batchInstanceCounts[renderDataCount] = {};
+		unsigned int batchCount = 0;
+		for (unsigned int i = 0; i < renderDataCount; i++)
+		{
+			auto* const effect = m_renderableObjects[i]->GetEffect();
+			auto* const mesh = m_renderableObjects[i]->GetMesh();
+			unsigned int batchIndex = 0;
+			while ((batchIndex < batchCount) && ((batchEffects[batchIndex] != effect) || (batchMeshes[batchIndex] != mesh))) batchIndex++;
+			if (batchIndex == batchCount)
+			{
+				batchEffects[batchCount] = effect;
+				batchMeshes[batchCount] = mesh;
+				batchCount++;
+			}
+			batchInstances[batchIndex][batchInstanceCounts[batchIndex]++].g_transform_localToWorld =
+				m_renderableObjects[i]->PredictFutureTransform(i_elapsedSecondCount_sinceLastSimulationUpdate);
+		}
+		for (unsigned int i = 0; i < batchCount; i++)
+		{
+			Graphics::SubmitVisibleInstancedDrawCalls(batchEffects[i], batchMeshes[i], batchInstances[i], batchInstanceCounts[i], frustum);
+		}
+	}
 }
 
 void eae6320::cMyGame::UpdateSimulationBasedOnInput()
@@ -214,12 +239,15 @@ void eae6320::cMyGame::InitializeGameObjects()
 		gameObjectRigidBodyState.velocity = Math::sVector(0.0f, 0.0f, 0.0f);
 		gameObjectRigidBodyState.acceleration = Math::sVector(0.0f, 0.0f, 0.0f);
 	}
+	// The moles are drawn with instanced draw calls
+	// (INSTANCED is the first keyword that the standard vertex shader declares)
+	constexpr uint32_t vertexShaderVariant_instanced = 1 << 0;
 	eae6320::Graphics::cEffect* activeEffect;
 	{
 		eae6320::Graphics::cShader* vertexShader;
 		eae6320::Graphics::cShader* fragmentShader;
 		if (!eae6320::Graphics::cShader::Load("data/Shaders/Vertex/standard.shader",
-			vertexShader, eae6320::Graphics::eShaderType::Vertex))
+			vertexShader, eae6320::Graphics::eShaderType::Vertex, vertexShaderVariant_instanced))
 		{
 			EAE6320_ASSERTF(false, "Can't initialize shading data without vertex shader");
 		}
@@ -235,7 +263,7 @@ void eae6320::cMyGame::InitializeGameObjects()
 		eae6320::Graphics::cShader* vertexShader;
 		eae6320::Graphics::cShader* fragmentShader;
 		if (!eae6320::Graphics::cShader::Load("data/Shaders/Vertex/standard.shader",
-			vertexShader, eae6320::Graphics::eShaderType::Vertex))
+			vertexShader, eae6320::Graphics::eShaderType::Vertex, vertexShaderVariant_instanced))
 		{
 			EAE6320_ASSERTF(false, "Can't initialize shading data without vertex shader");
 		}
@@ -251,7 +279,7 @@ void eae6320::cMyGame::InitializeGameObjects()
 		eae6320::Graphics::cShader* vertexShader;
 		eae6320::Graphics::cShader* fragmentShader;
 		if (!eae6320::Graphics::cShader::Load("data/Shaders/Vertex/standard.shader",
-			vertexShader, eae6320::Graphics::eShaderType::Vertex))
+			vertexShader, eae6320::Graphics::eShaderType::Vertex, vertexShaderVariant_instanced))
 		{
 			EAE6320_ASSERTF(false, "Can't initialize shading data without vertex shader");
 		}
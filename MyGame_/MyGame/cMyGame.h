@@ -54,6 +54,10 @@ namespace eae6320
 				"Direct3D"
 #elif defined( EAE6320_PLATFORM_GL )
 				"OpenGL"
+#elif defined( EAE6320_PLATFORM_NULL )
+				"Null"
+#elif defined( EAE6320_PLATFORM_SOFTWARE )
+				"Software"
 #endif
 #ifdef _DEBUG
 				" -- Debug"
@@ -6,8 +6,14 @@
 //=========
 
 #include <cstdlib>
+#include <Engine/Assets/PackFormat.h>
+#include <Engine/Platform/Platform.h>
 #include <Engine/Results/Results.h>
+#include <string>
+#include <Tools/AssetBuildLibrary/BuilderRegistry.h>
 #include <Tools/AssetBuildLibrary/Functions.h>
+#include <Tools/MeshBuilder/cMeshBuilder.h>
+#include <Tools/ShaderBuilder/cShaderBuilder.h>
 
 // Entry Point
 //============
@@ -16,18 +22,109 @@ int main( int i_argumentCount, char** i_arguments )
 {
 	auto result = eae6320::Results::Success;
 
+	// The builders that are linked with this program build their assets in this process
+	// instead of being executed as separate programs
+	{
+		using namespace eae6320::Assets;
+		if ( !( result = BuilderRegistry::Register( "MeshBuilder.exe", BuilderRegistry::CreateBuilder<cMeshBuilder> ) ) )
+		{
+			return EXIT_FAILURE;
+		}
+#if defined( EAE6320_PLATFORM_GL )
+		// The OpenGL shader builder verifies shaders with its own OpenGL context
+		// (and stores which vendor made the GPU globally),
+		// and so it can only build one shader at a time
+		// (the preprocessor library that every shader builder uses has global state too,
+		// but the builder only lets one shader use it at a time)
+		constexpr auto canShaderBuilderBuildConcurrently = false;
+#else
+		constexpr auto canShaderBuilderBuildConcurrently = true;
+#endif
+		if ( !( result = BuilderRegistry::Register( "ShaderBuilder.exe", BuilderRegistry::CreateBuilder<cShaderBuilder>,
+			canShaderBuilderBuildConcurrently ) ) )
+		{
+			return EXIT_FAILURE;
+		}
+	}
+
 	// The command line should have a path to the list of assets to build
-	if ( i_argumentCount == 2 )
+	// (optionally preceded by "-j N" to limit how many assets are built at the same time
+	// and by "-isolate" to execute every builder as a separate program)
+	const char* path_assetsToBuild = nullptr;
+	unsigned int jobCount = 0;
+	auto shouldBuildersRunInSeparateProcesses = false;
+	for ( int i = 1; i < i_argumentCount; ++i )
+	{
+		const std::string argument( i_arguments[i] );
+		if ( argument == "-isolate" )
+		{
+			shouldBuildersRunInSeparateProcesses = true;
+		}
+		else if ( ( argument.size() >= 2 ) && ( argument[0] == '-' ) && ( argument[1] == 'j' ) )
+		{
+			// The job count can either be part of the same argument ("-j8") or the next one ("-j 8")
+			const char* jobCountArgument = nullptr;
+			if ( argument.size() > 2 )
+			{
+				jobCountArgument = i_arguments[i] + 2;
+			}
+			else if ( ( i + 1 ) < i_argumentCount )
+			{
+				jobCountArgument = i_arguments[++i];
+			}
+			char* end = nullptr;
+			const auto parsedJobCount = jobCountArgument ? std::strtoul( jobCountArgument, &end, 10 ) : 0;
+			if ( !jobCountArgument || ( end == jobCountArgument ) || ( *end != '\0' ) || ( parsedJobCount == 0 ) )
+			{
+				result = eae6320::Results::Failure;
+				eae6320::Assets::OutputErrorMessageWithFileInfo( __FILE__, __LINE__,
+					"The -j option must be followed by the number of assets to build at the same time (which must be at least 1)" );
+				break;
+			}
+			jobCount = static_cast<unsigned int>( parsedJobCount );
+		}
+		else if ( !path_assetsToBuild )
+		{
+			path_assetsToBuild = i_arguments[i];
+		}
+		else
+		{
+			result = eae6320::Results::Failure;
+			eae6320::Assets::OutputErrorMessageWithFileInfo( __FILE__, __LINE__,
+				"AssetBuild.exe must be run with a single path to the list of assets to build (\"%s\" is an extra argument)", i_arguments[i] );
+			break;
+		}
+	}
+	if ( !result )
+	{
+		// An error has already been output
+	}
+	else if ( path_assetsToBuild )
 	{
-		const auto* const path_assetsToBuild = i_arguments[1];
-		result = eae6320::Assets::BuildAssets( path_assetsToBuild );
+		if ( result = eae6320::Assets::BuildAssets( path_assetsToBuild, jobCount, shouldBuildersRunInSeparateProcesses ) )
+		{
+			// Once every asset is built they are packed into a single file
+			// so that the game can load them without opening each one
+			std::string path_gameInstallDirectory;
+			std::string errorMessage;
+			if ( result = eae6320::Platform::GetEnvironmentVariable( "GameInstallDir", path_gameInstallDirectory, &errorMessage ) )
+			{
+				const auto path_pack = path_gameInstallDirectory + "/" + eae6320::Assets::PackFormat::defaultPath;
+				result = eae6320::Assets::BuildAssetPack( path_gameInstallDirectory.c_str(), path_pack.c_str() );
+			}
+			else
+			{
+				eae6320::Assets::OutputErrorMessageWithFileInfo( __FILE__, __LINE__, errorMessage.c_str() );
+			}
+		}
 	}
 	else
 	{
 		result = eae6320::Results::Failure;
 		eae6320::Assets::OutputErrorMessageWithFileInfo( __FILE__, __LINE__,
-			"AssetBuild.exe must be run with a single command line argument which is the path to the list of assets to build"
-			" (the invalid argument count being passed to main is %u)", i_argumentCount );
+			"AssetBuild.exe must be run with a command line argument which is the path to the list of assets to build"
+			" (optionally preceded by -j N to build at most N assets at the same time"
+			" and by -isolate to run every builder as a separate program)" );
 	}
 
 	return result ? EXIT_SUCCESS : EXIT_FAILURE;
@@ -58,25 +58,20 @@ do
 	end
 end
 
--- The last time that this file was modified
-local lastWriteTime_this
+-- The path of this file
+-- (every built asset depends on it)
+local path_this
 do
-	local path_this
+	local sourceOfThisFunction
 	do
-		local sourceOfThisFunction
-		do
-			local stackLevel = 1
-			sourceOfThisFunction = debug.getinfo( stackLevel, "S" ).source
-		end
-		-- If the source is a file (which it should be as long as this script isn't being run in a weird way)
-		-- there will be a leading @
-		path_this = sourceOfThisFunction:match( "^@(.*)" )
+		local stackLevel = 1
+		sourceOfThisFunction = debug.getinfo( stackLevel, "S" ).source
 	end
-	if path_this then
-		lastWriteTime_this = GetLastWriteTime( path_this )
-	else
+	-- If the source is a file (which it should be as long as this script isn't being run in a weird way)
+	-- there will be a leading @
+	path_this = sourceOfThisFunction:match( "^@(.*)" )
+	if not path_this then
 		OutputWarningMessage( "The path for the Asset Build Functions script is unavailable" )
-		lastWriteTime_this = 0
 	end
 end
 
@@ -152,6 +147,9 @@ end
 
 -- In order to be built an asset must be "registered"
 local registeredAssetsToBuild = {}
+-- While an asset's references are being registered this is the asset that references them
+-- (and so any asset that is registered depends on it)
+local referencingAssetInfo
 --
 local function RegisterAssetToBeBuilt( i_sourceAssetRelativePath, i_assetType, i_optionalCommandLineArguments )
 	-- Get the asset type info
@@ -185,14 +183,25 @@ local function RegisterAssetToBeBuilt( i_sourceAssetRelativePath, i_assetType, i
 		-- Create a unique version of the path
 		local uniquePath = CreateUniquePath( tostring( i_sourceAssetRelativePath ) )
 		registrationInfo = registeredAssetsToBuild[uniquePath]
+		-- If another asset references this one then that asset must be built after this one
+		if referencingAssetInfo then
+			local dependencies = referencingAssetInfo.dependencies
+			if not dependencies[uniquePath] then
+				dependencies[uniquePath] = true
+				dependencies[#dependencies + 1] = uniquePath
+			end
+		end
 		if not registrationInfo then
 			-- If this source asset hasn't been registered yet then register it now
-			registrationInfo = { path = uniquePath, assetTypeInfo = assetTypeInfo, arguments = arguments }
-			-- (This table is simultaneously used as a dictionary and an array)
+			registrationInfo = { path = uniquePath, assetTypeInfo = assetTypeInfo, arguments = arguments, dependencies = {} }
+			-- (This table and the dependencies table are simultaneously used as a dictionary and an array)
 			registeredAssetsToBuild[uniquePath] = registrationInfo
 			registeredAssetsToBuild[#registeredAssetsToBuild + 1] = registrationInfo
 			-- And also register any assets that are referenced by this asset
+			local previousReferencingAssetInfo = referencingAssetInfo
+			referencingAssetInfo = registrationInfo
 			assetTypeInfo.RegisterReferencedAssets( uniquePath )
+			referencingAssetInfo = previousReferencingAssetInfo
 		else
 			-- If this source asset has already been registered then the information must be identical
 			if assetTypeInfo ~= registrationInfo.assetTypeInfo then
@@ -239,11 +248,15 @@ function cbAssetTypeInfo.RegisterReferencedAssets( i_sourceRelativePath )
 end
 
 -- You may need to override the following function for some new asset types, but not for many
-function cbAssetTypeInfo.ShouldTargetBeBuilt( i_lastWriteTime_builtAsset )
-	-- By default this returns false,
+function cbAssetTypeInfo.GetIncludedPaths( i_path_source )
+	-- Some source assets include other files
+	-- (e.g. shaders #include shaders.inc)
+	-- which must be built again if any of those files change.
+	-- This function returns the absolute paths of any files that are included by the given source asset.
+	-- By default this returns an empty table,
 	-- because there are no special dependencies for this asset type
 	-- that need to be taken into account
-	return false
+	return {}
 end
 
 -- Shader Asset Type
@@ -263,11 +276,38 @@ NewAssetTypeInfo( "shaders",
 		GetBuilderRelativePath = function()
 			return "ShaderBuilder.exe"
 		end,
-		ShouldTargetBeBuilt = function( i_lastWriteTime_builtAsset )
-			-- If the shaders.inc file has changed since the last time this shader was built
+		GetIncludedPaths = function( i_path_source )
+			-- If any file that is #included (directly or indirectly) has changed since the last time this shader was built
+			-- (e.g. shaders.inc)
 			-- then it should be built again
-			local lastWriteTime_includeFile = GetLastWriteTime( EngineSourceContentDir .. "Shaders/shaders.inc" )
-			return lastWriteTime_includeFile > i_lastWriteTime_builtAsset
+			local includedPaths = {}
+			local function AddIncludedPaths( i_path )
+				local file = io.open( i_path, "r" )
+				if not file then
+					-- The shader builder will report an error if the file can't be included
+					return
+				end
+				local directory = i_path:match( "(.-)[^/\\]+$" )
+				for line in file:lines() do
+					local relativePath = line:match( "^%s*#%s*include%s*[<\"]([^>\"]+)[>\"]" )
+					if relativePath then
+						-- The path can either be relative to the file or to the source content directories
+						local path_include = directory .. relativePath
+						if not DoesFileExist( path_include ) then
+							path_include = FindSourceContentAbsolutePathFromRelativePath( relativePath )
+						end
+						if path_include and not includedPaths[path_include] then
+							-- (This table is simultaneously used as a dictionary and an array)
+							includedPaths[path_include] = true
+							includedPaths[#includedPaths + 1] = path_include
+							AddIncludedPaths( path_include )
+						end
+					end
+				end
+				file:close()
+			end
+			AddIncludedPaths( i_path_source )
+			return includedPaths
 		end
 	}
 )
@@ -295,9 +335,21 @@ NewAssetTypeInfo( "meshes",
 -- Local Function Definitions
 --===========================
 
+-- This doesn't build the asset immediately:
+-- If the asset needs to be built then a job is submitted that will build it when ExecuteBuildJobs() is called
+-- (after the jobs for any assets that it depends on)
 local function BuildAsset( i_assetInfo )
 	local assetTypeInfo = i_assetInfo.assetTypeInfo
 
+	-- If an asset that this one depends on can't be built then neither can this one
+	for i, dependencyPath in ipairs( i_assetInfo.dependencies ) do
+		local dependencyInfo = registeredAssetsToBuild[dependencyPath]
+		if dependencyInfo.couldntBeBuilt then
+			OutputErrorMessage( "The asset can't be built because \"" .. dependencyPath .. "\" (which it depends on) can't be built", i_assetInfo.path )
+			return false
+		end
+	end
+
 	-- Get the absolute path to the source
 	-- (The "source" is the authored asset)
 	local path_source
@@ -337,38 +389,39 @@ local function BuildAsset( i_assetInfo )
 		end
 	end
 	-- Decide if the target needs to be built
-	local shouldTargetBeBuilt
+	-- from the contents of everything that is used to build it
+	local shouldTargetBeBuilt, buildCacheKey
 	do
-		-- The simplest reason a target should be built is if it doesn't exist
-		local doesTargetExist = DoesFileExist( path_target )
-		if doesTargetExist then
-			-- Even if the target exists it may be out-of-date.
-			-- If the source has been modified more recently than the target
-			-- then the target should be re-built.
-			local lastWriteTime_source = GetLastWriteTime( path_source )
-			local lastWriteTime_target = GetLastWriteTime( path_target )
-			shouldTargetBeBuilt = lastWriteTime_source > lastWriteTime_target
-			if not shouldTargetBeBuilt then
-				-- Even if the target is newer than the source
-				-- the builder EXE may have been updated
-				-- which could result in a different target being made
-				-- (e.g. if you fix a bug in the builder code)
-				local lastWriteTime_builder = GetLastWriteTime( path_builder )
-				shouldTargetBeBuilt = lastWriteTime_builder > lastWriteTime_target
-				if not shouldTargetBeBuilt then
-					-- Even if the builder EXE hasn't changed this script file (AssetBuildFunctions.lua) may have been updated
-					-- which could result in a different target being made
-					-- (e.g. if you change an AssetTypeInfo function)
-					shouldTargetBeBuilt = lastWriteTime_this > lastWriteTime_target
-					if not shouldTargetBeBuilt then
-						-- Even if there is no reason that a general asset shouldn't be built
-						-- the specific asset type may have specialized dependencies
-						shouldTargetBeBuilt = assetTypeInfo.ShouldTargetBeBuilt( lastWriteTime_target )
-					end
-				end
-			end
+		-- The key changes if any of these files change
+		-- (e.g. if you fix a bug in the builder code or change an AssetTypeInfo function)
+		local paths = { path_source }
+		for i, path_include in ipairs( assetTypeInfo.GetIncludedPaths( path_source ) ) do
+			paths[#paths + 1] = path_include
+		end
+		-- (if AssetBuildExe has the builder built in then it is AssetBuildExe's code that builds the asset
+		-- rather than the builder program's)
+		local path_program, returnValue = GetProgramThatRunsBuilder( path_builder )
+		if not path_program then
+			OutputErrorMessage( "The program that runs the builder \"" .. path_builder .. "\" couldn't be found: " .. tostring( returnValue ),
+				path_source )
+			return false
+		end
+		local isBuilderInThisProcess = returnValue
+		paths[#paths + 1] = path_program
+		if path_this then
+			paths[#paths + 1] = path_this
+		end
+		-- or if the builder would be run differently
+		local buildDescription = assetTypeInfo.type .. "\n" .. table.concat( i_assetInfo.arguments, " " )
+			.. "\n" .. ( isBuilderInThisProcess and "in-process" or "separate process" )
+		local errorMessage
+		buildCacheKey, errorMessage = CalculateBuildCacheKey( paths, buildDescription )
+		if buildCacheKey then
+			-- If the target was already built with the same key it doesn't need to be built again
+			shouldTargetBeBuilt = not UseCachedTarget( path_target, buildCacheKey )
 		else
-			shouldTargetBeBuilt = true;
+			OutputWarningMessage( "The build cache can't be used for this asset: " .. tostring( errorMessage ), path_source )
+			shouldTargetBeBuilt = true
 		end
 	end
 
@@ -386,49 +439,68 @@ local function BuildAsset( i_assetInfo )
 			if #i_assetInfo.arguments > 0 then
 				arguments = arguments .. " " .. table.concat( i_assetInfo.arguments, " " )
 			end
-			-- Execute the command
 			local commandLine = command .. " " .. arguments
-			-- The following line can be uncommented to see what command line is being executed
-			-- (this can be used, for example, to figure out what command arguments to provide Visual Studio
-			-- in order to debug a Builder)
-			print( commandLine )
-			local result, exitCode = ExecuteCommand( commandLine )
-			if result then
-				if exitCode == 0 then
-					-- Display a message for each asset
-					print( "Built " .. path_source )
-					-- Return success, and the exit code for informational purposes
-					return true, exitCode
-				else
-					-- The builder should already output a descriptive error message if there was an error
-					-- (remember that you write the builder code,
-					-- and so if the build process failed it means that _your_ code has returned an error code)
-					-- but it can be helpful to still return an additional vague error message here
-					-- in case there is a bug in the specific builder that doesn't output an error message.
-					OutputErrorMessage( "The command " .. commandLine .. " failed with exit code " .. tostring( exitCode ), path_source )
+			-- The job won't be started until the jobs of any assets that this one depends on have succeeded
+			-- (an asset that didn't need to be built doesn't have a job)
+			local dependencyJobs = {}
+			for i, dependencyPath in ipairs( i_assetInfo.dependencies ) do
+				local dependencyJob = registeredAssetsToBuild[dependencyPath].buildJob
+				if dependencyJob then
+					dependencyJobs[#dependencyJobs + 1] = dependencyJob
 				end
-			else
-				-- If the command wasn't executed then the second return value is an error message
-				OutputErrorMessage( "The command " .. commandLine .. " couldn't be executed: " .. tostring( exitCode ), path_source )
 			end
-
-			-- There's a chance that the builder already created the target file even though the build failed,
-			-- in which case it currently exists with a new time stamp
-			-- and the next time a build is run no attempt to build it again would be made even though the build failed.
-			if DoesFileExist( path_target ) then
-				-- Setting the time stamp to an invalid date in far in the past
-				-- allows you to look at the generated file if you wish
-				-- but still ensures that the build process will attempt to build it again
-				InvalidateLastWriteTime( path_target )
+			-- The command line is output when the job's results are
+			-- (this can be used, for example, to figure out what command arguments to provide Visual Studio
+			-- in order to debug a Builder),
+			-- and if the builder fails the job makes sure that the target will be built again the next time.
+			-- If AssetBuildExe has the builder built in then it is called directly with the same arguments
+			-- instead of executing the command line.
+			local buildJob, errorMessage = SubmitBuildJob( commandLine, path_source, path_target, dependencyJobs, buildCacheKey,
+				path_builder, i_assetInfo.arguments )
+			if buildJob then
+				i_assetInfo.buildJob = buildJob
+				return true
+			else
+				OutputErrorMessage( "The command " .. commandLine .. " couldn't be submitted: " .. tostring( errorMessage ), path_source )
+				return false
 			end
-
-			return false
 		end
 	else
 		return true
 	end
 end
 
+-- This returns the registered assets ordered so that every asset comes after the assets it depends on
+-- (otherwise the order they were registered in is kept)
+local function SortRegisteredAssetsByDependencies()
+	local sortedAssetInfos = {}
+	local wereThereErrors = false
+	-- An asset that is being visited is false and an asset that has been visited is true
+	local visitedAssetInfos = {}
+	local function Visit( i_assetInfo )
+		visitedAssetInfos[i_assetInfo] = false
+		for i, dependencyPath in ipairs( i_assetInfo.dependencies ) do
+			local dependencyInfo = registeredAssetsToBuild[dependencyPath]
+			local visitState = visitedAssetInfos[dependencyInfo]
+			if visitState == nil then
+				Visit( dependencyInfo )
+			elseif visitState == false then
+				-- The dependency is ignored so that the assets can still be built
+				wereThereErrors = true
+				OutputErrorMessage( "The asset depends on \"" .. dependencyPath .. "\" which also depends on it", i_assetInfo.path )
+			end
+		end
+		visitedAssetInfos[i_assetInfo] = true
+		sortedAssetInfos[#sortedAssetInfos + 1] = i_assetInfo
+	end
+	for i, assetInfo in ipairs( registeredAssetsToBuild ) do
+		if visitedAssetInfos[assetInfo] == nil then
+			Visit( assetInfo )
+		end
+	end
+	return sortedAssetInfos, wereThereErrors
+end
+
 -- External Interface
 --===================
 
@@ -450,7 +522,14 @@ function BuildAssets( i_path_assetsToBuild )
 	-- Register every asset that needs to be built
 	registeredAssetsToBuild = {}	-- Clear the table
 	-- Iterate through every type of asset in the file
-	for assetType, assetsToBuild_specificType in pairs( assetsToBuild ) do
+	-- (in alphabetical order so that the assets are always built and reported in the same order)
+	local assetTypes = {}
+	for assetType in pairs( assetsToBuild ) do
+		assetTypes[#assetTypes + 1] = assetType
+	end
+	table.sort( assetTypes, function( i_lhs, i_rhs ) return tostring( i_lhs ) < tostring( i_rhs ) end )
+	for i, assetType in ipairs( assetTypes ) do
+		local assetsToBuild_specificType = assetsToBuild[assetType]
 		-- In order for an asset of this type to be built
 		-- an asset type info must have been defined
 		local assetTypeInfo = assetTypeInfos[assetType]
@@ -474,8 +553,22 @@ function BuildAssets( i_path_assetsToBuild )
 	end
 
 	-- Build every asset that was registered
-	for i, assetInfo in ipairs( registeredAssetsToBuild ) do
-		if not BuildAsset( assetInfo ) then
+	do
+		-- A job is submitted for every asset that needs to be built
+		-- (an asset's dependencies are submitted before it)
+		local sortedAssetInfos, wereThereSortingErrors = SortRegisteredAssetsByDependencies()
+		if wereThereSortingErrors then
+			wereThereErrors = true
+		end
+		for i, assetInfo in ipairs( sortedAssetInfos ) do
+			if not BuildAsset( assetInfo ) then
+				assetInfo.couldntBeBuilt = true
+				wereThereErrors = true
+			end
+		end
+		-- The jobs are executed in parallel
+		-- (the results are output in the order that the jobs were submitted)
+		if not ExecuteBuildJobs() then
 			wereThereErrors = true
 		end
 	end
@@ -0,0 +1,128 @@
+// Includes
+//=========
+
+#include "Functions.h"
+
+#include <algorithm>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Assets/PackFormat.h>
+#include <Engine/Platform/Platform.h>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	struct sAssetToPack
+	{
+		std::string path;
+		uint64_t pathHash = 0;
+		eae6320::Platform::sDataFromFile data;
+	};
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Assets::BuildAssetPack( const char* const i_path_gameInstallDirectory, const char* const i_path_pack )
+{
+	auto result = Results::Success;
+
+	// Every built asset is in the game's data directory,
+	// and its path in the pack is the path that the game uses to load it
+	// (i.e. relative to the game's installation directory)
+	auto path_installDirectory = PackFormat::NormalizePath( i_path_gameInstallDirectory );
+	if ( path_installDirectory.empty() || ( path_installDirectory.back() != '/' ) )
+	{
+		path_installDirectory += '/';
+	}
+	std::vector<sAssetToPack> assets;
+	{
+		std::vector<std::string> paths;
+		std::string errorMessage;
+		if ( !( result = Platform::GetFilesInDirectory( std::string( i_path_gameInstallDirectory ) + "/data/", paths, true, &errorMessage ) ) )
+		{
+			OutputErrorMessage( "The built assets couldn't be found to pack: %s", errorMessage.c_str() );
+			return result;
+		}
+		assets.resize( paths.size() );
+		for ( size_t i = 0; i < paths.size(); ++i )
+		{
+			auto& asset = assets[i];
+			const auto path_normalized = PackFormat::NormalizePath( paths[i].c_str() );
+			EAE6320_ASSERT( path_normalized.compare( 0, path_installDirectory.length(), path_installDirectory ) == 0 );
+			asset.path = path_normalized.substr( path_installDirectory.length() );
+			asset.pathHash = PackFormat::CalculatePathHash( asset.path.c_str(), asset.path.length() );
+			if ( !( result = Platform::LoadBinaryFile( paths[i].c_str(), asset.data, &errorMessage ) ) )
+			{
+				OutputErrorMessageWithFileInfo( paths[i].c_str(), "The built asset couldn't be loaded to pack: %s", errorMessage.c_str() );
+				return result;
+			}
+		}
+	}
+	// The entries are sorted so that the game can find an asset with a binary search
+	std::sort( assets.begin(), assets.end(), []( const sAssetToPack& i_lhs, const sAssetToPack& i_rhs )
+		{
+			return ( i_lhs.pathHash != i_rhs.pathHash ) ? ( i_lhs.pathHash < i_rhs.pathHash ) : ( i_lhs.path < i_rhs.path );
+		} );
+
+	// Lay out the pack
+	PackFormat::sHeader header;
+	std::vector<PackFormat::sEntry> entries( assets.size() );
+	std::string paths;
+	{
+		header.entryCount = static_cast<uint32_t>( assets.size() );
+		header.pathsOffset = sizeof( header ) + ( sizeof( entries[0] ) * entries.size() );
+		for ( size_t i = 0; i < assets.size(); ++i )
+		{
+			const auto& asset = assets[i];
+			auto& entry = entries[i];
+			entry.pathHash = asset.pathHash;
+			entry.pathOffset = static_cast<uint32_t>( paths.length() );
+			EAE6320_ASSERT( asset.path.length() <= UINT16_MAX );
+			entry.pathLength = static_cast<uint16_t>( asset.path.length() );
+			paths += asset.path;
+		}
+		header.pathsSize = static_cast<uint32_t>( paths.length() );
+		auto payloadOffset = header.pathsOffset + header.pathsSize;
+		for ( size_t i = 0; i < assets.size(); ++i )
+		{
+			auto& entry = entries[i];
+			entry.payloadOffset = PackFormat::AlignPayloadOffset( payloadOffset );
+			entry.payloadSize = entry.assetSize = assets[i].data.size;
+			entry.compression = PackFormat::eCompression::None;
+			payloadOffset = entry.payloadOffset + entry.payloadSize;
+		}
+	}
+
+	// Write the pack
+	uint64_t packSize = 0;
+	{
+		std::ofstream pack( i_path_pack, std::ios::out | std::ios::binary );
+		pack.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+		pack.write( reinterpret_cast<const char*>( entries.data() ), sizeof( entries[0] ) * entries.size() );
+		pack.write( paths.data(), paths.length() );
+		packSize = header.pathsOffset + header.pathsSize;
+		const std::vector<char> padding( static_cast<size_t>( PackFormat::payloadAlignment ), 0 );
+		for ( size_t i = 0; i < assets.size(); ++i )
+		{
+			const auto& entry = entries[i];
+			pack.write( padding.data(), static_cast<std::streamsize>( entry.payloadOffset - packSize ) );
+			pack.write( static_cast<const char*>( assets[i].data.data ), static_cast<std::streamsize>( entry.payloadSize ) );
+			packSize = entry.payloadOffset + entry.payloadSize;
+		}
+		pack.close();
+		if ( !pack )
+		{
+			// (a partially written pack fails to mount because its entries don't fit in it)
+			OutputErrorMessageWithFileInfo( i_path_pack, "The asset pack couldn't be written" );
+			return Results::Failure;
+		}
+	}
+	std::cout << "Packed " << assets.size() << " assets (" << packSize << " bytes) into " << i_path_pack << std::endl;
+
+	return result;
+}
@@ -0,0 +1,127 @@
+// Includes
+//=========
+
+#include "BuilderRegistry.h"
+
+#include "Functions.h"
+#include "iBuilder.h"
+
+#include <algorithm>
+#include <cctype>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/ScopeGuard/cScopeGuard.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+// Helper Class Declaration
+//=========================
+
+struct eae6320::Assets::BuilderRegistry::sBuilder
+{
+	fCreateBuilder createBuilder = nullptr;
+	bool canBuildConcurrently = true;
+	// This is only used if the builder can't build concurrently
+	std::mutex mutex;
+};
+
+// Static Data
+//============
+
+namespace
+{
+	// The lowercase file name is the key
+	// (a std::map is used because the builders can't move once they have been found)
+	std::map<std::string, eae6320::Assets::BuilderRegistry::sBuilder> s_builders;
+}
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	std::string GetLowercaseFileName( const char* const i_path );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Assets::BuilderRegistry::Register( const char* const i_fileName_builder, const fCreateBuilder i_createBuilder,
+	const bool i_canBuildConcurrently )
+{
+	EAE6320_ASSERT( i_createBuilder );
+
+	const auto key = GetLowercaseFileName( i_fileName_builder );
+	if ( s_builders.find( key ) == s_builders.end() )
+	{
+		auto& builder = s_builders[key];
+		builder.createBuilder = i_createBuilder;
+		builder.canBuildConcurrently = i_canBuildConcurrently;
+		return Results::Success;
+	}
+	else
+	{
+		EAE6320_ASSERTF( false, "A builder named %s has already been registered", i_fileName_builder );
+		OutputErrorMessage( "A builder named %s has already been registered", i_fileName_builder );
+		return Results::Failure;
+	}
+}
+
+eae6320::Assets::BuilderRegistry::sBuilder* eae6320::Assets::BuilderRegistry::Find( const char* const i_path_builder )
+{
+	const auto iterator = s_builders.find( GetLowercaseFileName( i_path_builder ) );
+	return ( iterator != s_builders.end() ) ? &iterator->second : nullptr;
+}
+
+eae6320::cResult eae6320::Assets::BuilderRegistry::Build( sBuilder& io_builder, const char* const i_path_source, const char* const i_path_target,
+	const std::vector<std::string>& i_optionalArguments, std::string& o_output )
+{
+	// Everything that is output on this thread while building is captured
+	std::ostringstream output;
+	CaptureOutput( &output );
+	cScopeGuard scopeGuard_output( [&output, &o_output]
+		{
+			CaptureOutput( nullptr );
+			o_output = output.str();
+		} );
+
+	std::unique_ptr<iBuilder> builder( io_builder.createBuilder() );
+	if ( !builder )
+	{
+		OutputErrorMessageWithFileInfo( i_path_source, "Failed to allocate memory for the builder" );
+		return Results::OutOfMemory;
+	}
+	if ( io_builder.canBuildConcurrently )
+	{
+		return builder->SetPathsAndBuild( i_path_source, i_path_target, i_optionalArguments );
+	}
+	else
+	{
+		std::lock_guard<std::mutex> lock( io_builder.mutex );
+		return builder->SetPathsAndBuild( i_path_source, i_path_target, i_optionalArguments );
+	}
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	std::string GetLowercaseFileName( const char* const i_path )
+	{
+		std::string fileName( i_path );
+		{
+			const auto lastSeparator = fileName.find_last_of( "/\\" );
+			if ( lastSeparator != std::string::npos )
+			{
+				fileName.erase( 0, lastSeparator + 1 );
+			}
+		}
+		std::transform( fileName.begin(), fileName.end(), fileName.begin(), []( const char i_character )
+			{
+				return static_cast<char>( std::tolower( static_cast<unsigned char>( i_character ) ) );
+			} );
+		return fileName;
+	}
+}
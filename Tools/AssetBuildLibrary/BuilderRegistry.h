@@ -0,0 +1,73 @@
+/*
+	The builder registry lets AssetBuildExe run builders in its own process
+	instead of executing a separate program for every asset
+
+	AssetBuildExe registers a factory for every builder that it is linked with
+	using the file name of the builder's program (e.g. "MeshBuilder.exe"),
+	and a build job whose builder has been registered calls the builder directly on a worker thread:
+		* Anything the builder outputs is captured (see CaptureOutput() in Functions.h)
+			and is output with the job's results
+		* A builder that uses global state (e.g. a library that isn't thread-safe)
+			can be registered so that only one of its assets is built at a time
+	Builders that haven't been registered are still executed as separate programs.
+*/
+
+#ifndef EAE6320_ASSETBUILD_BUILDERREGISTRY_H
+#define EAE6320_ASSETBUILD_BUILDERREGISTRY_H
+
+// Includes
+//=========
+
+#include <Engine/Results/Results.h>
+#include <new>
+#include <string>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		class iBuilder;
+	}
+}
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace BuilderRegistry
+		{
+			using fCreateBuilder = iBuilder* (*)();
+			// A factory for a specific builder can be made by using it as the template argument:
+			//	BuilderRegistry::Register( "MeshBuilder.exe", BuilderRegistry::CreateBuilder<cMeshBuilder> );
+			template<class tBuilder>
+			iBuilder* CreateBuilder()
+			{
+				return new ( std::nothrow ) tBuilder();
+			}
+
+			// The file name is compared with the file name of the builder paths that build jobs are submitted with
+			// (the directory isn't compared and case doesn't matter).
+			// If a builder can't build concurrently then it will only build one asset at a time
+			// (although it can still build at the same time as other builders).
+			cResult Register( const char* const i_fileName_builder, const fCreateBuilder i_createBuilder, const bool i_canBuildConcurrently = true );
+
+			// This returns null if no builder was registered with the path's file name
+			struct sBuilder;
+			sBuilder* Find( const char* const i_path_builder );
+
+			// A new builder is created for every asset
+			// and everything that it outputs is returned in the output string
+			cResult Build( sBuilder& io_builder, const char* const i_path_source, const char* const i_path_target,
+				const std::vector<std::string>& i_optionalArguments, std::string& o_output );
+		}
+	}
+}
+
+#endif	// EAE6320_ASSETBUILD_BUILDERREGISTRY_H
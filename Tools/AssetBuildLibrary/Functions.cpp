@@ -3,6 +3,10 @@
 
 #include "Functions.h"
 
+#include "BuilderRegistry.h"
+#include "cBuildCache.h"
+#include "cBuildJobGraph.h"
+
 #include <cstdarg>
 #include <cstdio>
 #include <Engine/Asserts/Asserts.h>
@@ -11,6 +15,7 @@
 #include <External/Lua/Includes.h>
 #include <iostream>
 #include <limits>
+#include <mutex>
 #include <sstream>
 #include <vector>
 
@@ -71,6 +76,19 @@ namespace
 namespace
 {
 	cLuaState s_luaState;
+
+	// AssetBuildFunctions.lua adds a job for every asset that needs to be built
+	// and then executes them all at once
+	eae6320::Assets::cBuildJobGraph s_buildJobGraph;
+	unsigned int s_buildJobThreadCount = 0;
+	bool s_shouldBuildersRunInSeparateProcesses = false;
+	// AssetBuildFunctions.lua uses the cache to decide which assets need to be built
+	eae6320::Assets::cBuildCache s_buildCache;
+	// Builders that run in this process can call functions that use the Lua state from several threads
+	std::mutex s_mutex_luaState;
+
+	// If output is being captured on a thread then this is where it goes
+	thread_local std::ostream* s_capturedOutputStream = nullptr;
 }
 
 // Helper Declarations
@@ -91,29 +109,65 @@ namespace
 	// Lua Wrapper Functions
 	//----------------------
 
+	int luaCalculateBuildCacheKey( lua_State* io_luaState );
 	int luaCopyFile( lua_State* io_luaState );
 	int luaCreateDirectoryIfItDoesntExist( lua_State* io_luaState );
 	int luaDoesFileExist( lua_State* io_luaState );
+	int luaExecuteBuildJobs( lua_State* io_luaState );
 	int luaExecuteCommand( lua_State* io_luaState );
 	int luaGetEnvironmentVariable( lua_State* io_luaState );
 	int LuaGetFilesInDirectory( lua_State* io_luaState );
 	int luaGetLastWriteTime( lua_State* io_luaState );
+	int luaGetProgramThatRunsBuilder( lua_State* io_luaState );
 	int luaInvalidateLastWriteTime( lua_State* io_luaState );
 	int luaOutputErrorMessage( lua_State* io_luaState );
 	int luaOutputWarningMessage( lua_State* io_luaState );
+	int luaSubmitBuildJob( lua_State* io_luaState );
+	int luaUseCachedTarget( lua_State* io_luaState );
 }
 
 // Interface
 //==========
 
-eae6320::cResult eae6320::Assets::BuildAssets( const char* const i_path_assetsToBuild )
+eae6320::cResult eae6320::Assets::BuildAssets( const char* const i_path_assetsToBuild, const unsigned int i_jobCount,
+	const bool i_shouldBuildersRunInSeparateProcesses )
 {
-	return s_luaState.BuildAssets( i_path_assetsToBuild );
+	s_buildJobThreadCount = i_jobCount;
+	s_shouldBuildersRunInSeparateProcesses = i_shouldBuildersRunInSeparateProcesses;
+	// The build cache is kept in the game's intermediate directory
+	// (if it can't be used then every asset is built)
+	{
+		std::string path_gameIntermediateDirectory;
+		std::string errorMessage;
+		if ( eae6320::Platform::GetEnvironmentVariable( "GameIntermediateDir", path_gameIntermediateDirectory, &errorMessage ) )
+		{
+			if ( !s_buildCache.Initialize( path_gameIntermediateDirectory + "AssetBuildCache/" ) )
+			{
+				OutputWarningMessage( "The build cache can't be used, and so every asset will be built" );
+			}
+		}
+		else
+		{
+			OutputWarningMessage( "The build cache can't be used, and so every asset will be built: %s", errorMessage.c_str() );
+		}
+	}
+	auto result = s_luaState.BuildAssets( i_path_assetsToBuild );
+	s_buildCache.OutputSummary();
+	{
+		const auto result_buildCache = s_buildCache.CleanUp();
+		if ( result )
+		{
+			result = result_buildCache;
+		}
+	}
+	return result;
 }
 
 eae6320::cResult eae6320::Assets::ConvertSourceRelativePathToBuiltRelativePath( const char* const i_sourceRelativePath, const char* const i_assetType,
 	std::string& o_builtRelativePath, std::string* o_errorMessage )
 {
+	// Builders that run in this process can call this from their worker threads
+	std::lock_guard<std::mutex> lock( s_mutex_luaState );
 	return s_luaState.ConvertSourceRelativePathToBuiltRelativePath( i_sourceRelativePath, i_assetType, o_builtRelativePath, o_errorMessage );
 }
 
@@ -260,6 +314,24 @@ void eae6320::Assets::OutputWarningMessageWithFileInfo( const char* const i_file
 	}
 }
 
+// Other Output
+//-------------
+
+std::ostream& eae6320::Assets::GetOutputStream()
+{
+	return s_capturedOutputStream ? *s_capturedOutputStream : std::cout;
+}
+
+std::ostream& eae6320::Assets::GetErrorOutputStream()
+{
+	return s_capturedOutputStream ? *s_capturedOutputStream : std::cerr;
+}
+
+void eae6320::Assets::CaptureOutput( std::ostream* const io_stream )
+{
+	s_capturedOutputStream = io_stream;
+}
+
 // Helper Class Declaration
 //=========================
 
@@ -564,16 +636,21 @@ namespace
 		luaL_openlibs( luaState );
 		// Register the custom functions
 		{
+			lua_register( luaState, "CalculateBuildCacheKey", luaCalculateBuildCacheKey );
 			lua_register( luaState, "CopyFile", luaCopyFile );
 			lua_register( luaState, "CreateDirectoryIfItDoesntExist", luaCreateDirectoryIfItDoesntExist );
 			lua_register( luaState, "DoesFileExist", luaDoesFileExist );
+			lua_register( luaState, "ExecuteBuildJobs", luaExecuteBuildJobs );
 			lua_register( luaState, "ExecuteCommand", luaExecuteCommand );
 			lua_register( luaState, "GetEnvironmentVariable", luaGetEnvironmentVariable );
 			lua_register( luaState, "GetFilesInDirectory", LuaGetFilesInDirectory );
 			lua_register( luaState, "GetLastWriteTime", luaGetLastWriteTime );
+			lua_register( luaState, "GetProgramThatRunsBuilder", luaGetProgramThatRunsBuilder );
 			lua_register( luaState, "InvalidateLastWriteTime", luaInvalidateLastWriteTime );
 			lua_register( luaState, "OutputErrorMessage", luaOutputErrorMessage );
 			lua_register( luaState, "OutputWarningMessage", luaOutputWarningMessage );
+			lua_register( luaState, "SubmitBuildJob", luaSubmitBuildJob );
+			lua_register( luaState, "UseCachedTarget", luaUseCachedTarget );
 		}
 		// Set the platform #defines
 		{
@@ -587,6 +664,12 @@ namespace
 			#elif defined( EAE6320_PLATFORM_GL )
 				lua_pushboolean( luaState, true );
 				lua_setglobal( luaState, "EAE6320_PLATFORM_GL" );
+			#elif defined( EAE6320_PLATFORM_NULL )
+				lua_pushboolean( luaState, true );
+				lua_setglobal( luaState, "EAE6320_PLATFORM_NULL" );
+			#elif defined( EAE6320_PLATFORM_SOFTWARE )
+				lua_pushboolean( luaState, true );
+				lua_setglobal( luaState, "EAE6320_PLATFORM_SOFTWARE" );
 			#endif
 		#endif
 		}
@@ -796,7 +879,8 @@ namespace
 		const unsigned int* const i_optionalLineNumber, const unsigned int* const i_optionalColumnNumber )
 	{
 #if defined( EAE6320_PLATFORM_WINDOWS )
-		eae6320::Windows::OutputErrorMessageForVisualStudio( i_errorMessage, i_optionalFilePath, i_optionalLineNumber, i_optionalColumnNumber );
+		eae6320::Windows::OutputErrorMessageForVisualStudio( i_errorMessage, i_optionalFilePath, i_optionalLineNumber, i_optionalColumnNumber,
+			s_capturedOutputStream );
 #else
 	#error "No implementation exists for outputting asset build error messages!"
 #endif
@@ -806,7 +890,8 @@ namespace
 		const unsigned int* const i_optionalLineNumber, const unsigned int* const i_optionalColumnNumber )
 	{
 #if defined( EAE6320_PLATFORM_WINDOWS )
-		eae6320::Windows::OutputWarningMessageForVisualStudio( i_warningMessage, i_optionalFilePath, i_optionalLineNumber, i_optionalColumnNumber );
+		eae6320::Windows::OutputWarningMessageForVisualStudio( i_warningMessage, i_optionalFilePath, i_optionalLineNumber, i_optionalColumnNumber,
+			s_capturedOutputStream );
 #else
 	#error "No implementation exists for outputting asset build warning messages!"
 #endif
@@ -815,6 +900,65 @@ namespace
 	// Lua Wrapper Functions
 	//----------------------
 
+	int luaCalculateBuildCacheKey( lua_State* io_luaState )
+	{
+		// Argument #1: The paths of the files that are used to build the asset
+		std::vector<std::string> i_paths;
+		if ( lua_istable( io_luaState, 1 ) )
+		{
+			const auto pathCount = luaL_len( io_luaState, 1 );
+			for ( lua_Integer i = 1; i <= pathCount; ++i )
+			{
+				lua_geti( io_luaState, 1, i );
+				if ( lua_isstring( io_luaState, -1 ) )
+				{
+					i_paths.push_back( lua_tostring( io_luaState, -1 ) );
+					lua_pop( io_luaState, 1 );
+				}
+				else
+				{
+					return luaL_error( io_luaState,
+						"Path #%d must be a string (instead of a %s)",
+						static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+				}
+			}
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #1 must be a table (instead of a %s)",
+				luaL_typename( io_luaState, 1 ) );
+		}
+		// Argument #2: Anything else that the built asset depends on (e.g. the builder's arguments)
+		const char* i_string;
+		if ( lua_isstring( io_luaState, 2 ) )
+		{
+			i_string = lua_tostring( io_luaState, 2 );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #2 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 2 ) );
+		}
+
+		std::string key;
+		std::string errorMessage;
+		if ( s_buildCache.CalculateKey( i_paths, i_string, key, &errorMessage ) )
+		{
+			lua_pushstring( io_luaState, key.c_str() );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		}
+		else
+		{
+			lua_pushnil( io_luaState );
+			lua_pushstring( io_luaState, errorMessage.c_str() );
+			constexpr int returnValueCount = 2;
+			return returnValueCount;
+		}
+	}
+
 	int luaCopyFile( lua_State* io_luaState )
 	{
 		// Argument #1: The source path
@@ -925,6 +1069,16 @@ namespace
 		}
 	}
 
+	int luaExecuteBuildJobs( lua_State* io_luaState )
+	{
+		// Every submitted job is executed,
+		// and the results are output in the order that they were submitted
+		const auto result = s_buildJobGraph.Execute( s_buildJobThreadCount, &s_buildCache );
+		lua_pushboolean( io_luaState, result ? true : false );
+		constexpr int returnValueCount = 1;
+		return returnValueCount;
+	}
+
 	int luaExecuteCommand( lua_State* io_luaState )
 	{
 		// Argument #1: The command
@@ -1073,6 +1227,51 @@ namespace
 		}
 	}
 
+	int luaGetProgramThatRunsBuilder( lua_State* io_luaState )
+	{
+		// Argument #1: The path of the builder
+		const char* i_path_builder;
+		if ( lua_isstring( io_luaState, 1 ) )
+		{
+			i_path_builder = lua_tostring( io_luaState, 1 );
+		}
+		else
+		{
+			return luaL_error( io_luaState,
+				"Argument #1 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 1 ) );
+		}
+
+		// If the builder has been registered then it is this program's code that builds the asset
+		// (the same check is made when the build job is submitted)
+		if ( !s_shouldBuildersRunInSeparateProcesses && eae6320::Assets::BuilderRegistry::Find( i_path_builder ) )
+		{
+			std::string path_thisProgram;
+			std::string errorMessage;
+			if ( eae6320::Platform::GetPathOfThisProgram( path_thisProgram, &errorMessage ) )
+			{
+				lua_pushstring( io_luaState, path_thisProgram.c_str() );
+				lua_pushboolean( io_luaState, true );
+				constexpr int returnValueCount = 2;
+				return returnValueCount;
+			}
+			else
+			{
+				lua_pushnil( io_luaState );
+				lua_pushstring( io_luaState, errorMessage.c_str() );
+				constexpr int returnValueCount = 2;
+				return returnValueCount;
+			}
+		}
+		else
+		{
+			lua_pushstring( io_luaState, i_path_builder );
+			lua_pushboolean( io_luaState, false );
+			constexpr int returnValueCount = 2;
+			return returnValueCount;
+		}
+	}
+
 	int luaInvalidateLastWriteTime( lua_State* io_luaState )
 	{
 		// Argument #1: The path
@@ -1188,4 +1387,152 @@ namespace
 		constexpr int returnValueCount = 0;
 		return returnValueCount;
 	}
+
+	int luaSubmitBuildJob( lua_State* io_luaState )
+	{
+		// Arguments #1-#3: The command line, the source path, and the target path
+		const char* i_strings[3];
+		for ( int i = 0; i < 3; ++i )
+		{
+			const auto argumentIndex = i + 1;
+			if ( lua_isstring( io_luaState, argumentIndex ) )
+			{
+				i_strings[i] = lua_tostring( io_luaState, argumentIndex );
+			}
+			else
+			{
+				return luaL_error( io_luaState,
+					"Argument #%d must be a string (instead of a %s)",
+					argumentIndex, luaL_typename( io_luaState, argumentIndex ) );
+			}
+		}
+		// Argument #4: The jobs that this job depends on
+		std::vector<size_t> i_dependencies;
+		if ( lua_istable( io_luaState, 4 ) )
+		{
+			const auto dependencyCount = luaL_len( io_luaState, 4 );
+			for ( lua_Integer i = 1; i <= dependencyCount; ++i )
+			{
+				lua_geti( io_luaState, 4, i );
+				int isInteger;
+				const auto dependency = lua_tointegerx( io_luaState, -1, &isInteger );
+				lua_pop( io_luaState, 1 );
+				if ( !isInteger || ( dependency < 0 ) )
+				{
+					return luaL_error( io_luaState,
+						"Dependency #%d must be a job returned from SubmitBuildJob()", static_cast<int>( i ) );
+				}
+				i_dependencies.push_back( static_cast<size_t>( dependency ) );
+			}
+		}
+		else if ( !lua_isnoneornil( io_luaState, 4 ) )
+		{
+			return luaL_error( io_luaState,
+				"Argument #4 must be a table (instead of a %s)",
+				luaL_typename( io_luaState, 4 ) );
+		}
+		// Argument #5: The build cache key (optional)
+		const char* i_buildCacheKey = nullptr;
+		if ( lua_isstring( io_luaState, 5 ) )
+		{
+			i_buildCacheKey = lua_tostring( io_luaState, 5 );
+		}
+		else if ( !lua_isnoneornil( io_luaState, 5 ) )
+		{
+			return luaL_error( io_luaState,
+				"Argument #5 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 5 ) );
+		}
+		// Argument #6: The builder (optional)
+		const char* i_path_builder = nullptr;
+		if ( lua_isstring( io_luaState, 6 ) )
+		{
+			i_path_builder = lua_tostring( io_luaState, 6 );
+		}
+		else if ( !lua_isnoneornil( io_luaState, 6 ) )
+		{
+			return luaL_error( io_luaState,
+				"Argument #6 must be a string (instead of a %s)",
+				luaL_typename( io_luaState, 6 ) );
+		}
+		// Argument #7: The builder's optional arguments (optional)
+		std::vector<std::string> i_optionalArguments;
+		if ( lua_istable( io_luaState, 7 ) )
+		{
+			const auto argumentCount = luaL_len( io_luaState, 7 );
+			for ( lua_Integer i = 1; i <= argumentCount; ++i )
+			{
+				lua_geti( io_luaState, 7, i );
+				if ( lua_isstring( io_luaState, -1 ) )
+				{
+					i_optionalArguments.push_back( lua_tostring( io_luaState, -1 ) );
+					lua_pop( io_luaState, 1 );
+				}
+				else
+				{
+					return luaL_error( io_luaState,
+						"Optional argument #%d must be a string (instead of a %s)",
+						static_cast<int>( i ), luaL_typename( io_luaState, -1 ) );
+				}
+			}
+		}
+		else if ( !lua_isnoneornil( io_luaState, 7 ) )
+		{
+			return luaL_error( io_luaState,
+				"Argument #7 must be a table (instead of a %s)",
+				luaL_typename( io_luaState, 7 ) );
+		}
+
+		// If the builder has been registered it is run in this process
+		// (otherwise the command line is executed)
+		eae6320::Assets::BuilderRegistry::sBuilder* builder = nullptr;
+		if ( i_path_builder && !s_shouldBuildersRunInSeparateProcesses )
+		{
+			builder = eae6320::Assets::BuilderRegistry::Find( i_path_builder );
+		}
+
+		// Add the job
+		size_t jobIndex;
+		std::string errorMessage;
+		if ( s_buildJobGraph.AddJob( i_strings[0], i_strings[1], i_strings[2], builder, i_optionalArguments, i_buildCacheKey, i_dependencies,
+			jobIndex, &errorMessage ) )
+		{
+			lua_pushinteger( io_luaState, static_cast<lua_Integer>( jobIndex ) );
+			constexpr int returnValueCount = 1;
+			return returnValueCount;
+		}
+		else
+		{
+			lua_pushnil( io_luaState );
+			lua_pushstring( io_luaState, errorMessage.c_str() );
+			constexpr int returnValueCount = 2;
+			return returnValueCount;
+		}
+	}
+
+	int luaUseCachedTarget( lua_State* io_luaState )
+	{
+		// Arguments #1-#2: The target path and the build cache key
+		const char* i_strings[2];
+		for ( int i = 0; i < 2; ++i )
+		{
+			const auto argumentIndex = i + 1;
+			if ( lua_isstring( io_luaState, argumentIndex ) )
+			{
+				i_strings[i] = lua_tostring( io_luaState, argumentIndex );
+			}
+			else
+			{
+				return luaL_error( io_luaState,
+					"Argument #%d must be a string (instead of a %s)",
+					argumentIndex, luaL_typename( io_luaState, argumentIndex ) );
+			}
+		}
+
+		// If the target is up-to-date (or could be restored from the cache) then it doesn't need to be built
+		const auto isTargetUpToDate = s_buildCache.UseCachedTarget( i_strings[0], i_strings[1] );
+		lua_pushboolean( io_luaState, isTargetUpToDate );
+		constexpr int returnValueCount = 1;
+		return returnValueCount;
+	}
 }
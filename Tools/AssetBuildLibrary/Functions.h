@@ -9,6 +9,7 @@
 //=========
 
 #include <Engine/Results/Results.h>
+#include <iosfwd>
 #include <string>
 
 // Interface
@@ -18,7 +19,16 @@ namespace eae6320
 {
 	namespace Assets
 	{
-		eae6320::cResult BuildAssets( const char* const i_path_assetsToBuild );
+		// Up to i_jobCount builders are executed at the same time
+		// (if it is zero then one is executed for every hardware thread).
+		// Builders that have been registered (see BuilderRegistry.h) are run in this process
+		// unless they should run in separate processes
+		// (which is slower, but a builder that crashes can't bring down the whole build).
+		eae6320::cResult BuildAssets( const char* const i_path_assetsToBuild, const unsigned int i_jobCount = 0,
+			const bool i_shouldBuildersRunInSeparateProcesses = false );
+		// This packs every built asset in the game's data directory into a single file that the game can mount
+		// (see Engine/Assets/PackFormat.h)
+		eae6320::cResult BuildAssetPack( const char* const i_path_gameInstallDirectory, const char* const i_path_pack );
 
 		// If an asset ("A") references another asset ("B")
 		// then that reference to B must be converted from a source path to a built path
@@ -51,6 +61,18 @@ namespace eae6320
 		void OutputWarningMessageWithFileInfo( const char* const i_filePath,
 			const unsigned int i_lineNumber, const unsigned int i_columnNumber,
 			const char* const i_warningMessage, ... );
+
+		// Other Output
+		//-------------
+
+		// Builders should write any other output to these streams instead of directly to std::cout and std::cerr
+		// (when a builder is run in the same process as AssetBuildExe its output is captured
+		// so that it can be output together with the rest of the asset's results)
+		std::ostream& GetOutputStream();
+		std::ostream& GetErrorOutputStream();
+		// All of the output from the calling thread (including errors and warnings) is written to the given stream
+		// until this is called again with nullptr
+		void CaptureOutput( std::ostream* const io_stream );
 	}
 }
 
@@ -0,0 +1,355 @@
+// Includes
+//=========
+
+#include "cBuildCache.h"
+
+#include "Functions.h"
+
+#include <cstdio>
+#include <Engine/Platform/Platform.h>
+#include <iostream>
+#include <sstream>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// The database starts with this line,
+	// and if it is different (because the format has changed) the database is ignored
+	constexpr auto* const s_databaseHeader = "eae6320 asset build cache 1";
+
+	// 64-bit FNV-1a
+	constexpr uint64_t s_hashOffsetBasis = 0xcbf29ce484222325;
+	uint64_t AddToHash( const uint64_t i_hash, const void* const i_data, const size_t i_size );
+}
+
+// Interface
+//==========
+
+// Keys
+//-----
+
+eae6320::cResult eae6320::Assets::cBuildCache::CalculateKey( const std::vector<std::string>& i_paths, const std::string& i_string,
+	std::string& o_key, std::string* const o_errorMessage )
+{
+	auto key = s_hashOffsetBasis;
+	for ( const auto& path : i_paths )
+	{
+		uint64_t fileHash;
+		{
+			const auto iterator = m_fileHashes.find( path );
+			if ( iterator != m_fileHashes.end() )
+			{
+				fileHash = iterator->second;
+			}
+			else
+			{
+				Platform::sMappedFile file;
+				auto result = Results::Success;
+				if ( !( result = Platform::MapFile( path.c_str(), file, o_errorMessage ) ) )
+				{
+					return result;
+				}
+				fileHash = AddToHash( s_hashOffsetBasis, file.data, file.size );
+				m_fileHashes.insert( std::make_pair( path, fileHash ) );
+			}
+		}
+		key = AddToHash( key, &fileHash, sizeof( fileHash ) );
+	}
+	key = AddToHash( key, i_string.data(), i_string.size() );
+
+	char buffer[16 + 1];
+	std::snprintf( buffer, sizeof( buffer ), "%016llx", static_cast<unsigned long long>( key ) );
+	o_key = buffer;
+
+	return Results::Success;
+}
+
+// Targets
+//--------
+
+bool eae6320::Assets::cBuildCache::UseCachedTarget( const char* const i_path_target, const std::string& i_key )
+{
+	if ( !m_isInitialized )
+	{
+		return false;
+	}
+
+	const auto iterator_buildSecondCount = m_buildSecondCounts.find( i_key );
+	if ( iterator_buildSecondCount == m_buildSecondCounts.end() )
+	{
+		// Nothing has ever been built with this key
+		return false;
+	}
+	// If the target was built with the same key it is up-to-date
+	// unless something else has written to it since
+	{
+		const auto iterator_target = m_targets.find( i_path_target );
+		if ( ( iterator_target != m_targets.end() ) && ( iterator_target->second.key == i_key ) && Platform::DoesFileExist( i_path_target ) )
+		{
+			uint64_t lastWriteTime;
+			if ( Platform::GetLastWriteTime( i_path_target, lastWriteTime ) && ( lastWriteTime == iterator_target->second.lastWriteTime ) )
+			{
+				++m_statistics.upToDateCount;
+				m_statistics.savedSecondCount += iterator_buildSecondCount->second;
+				return true;
+			}
+		}
+	}
+	// Otherwise the copy that was stored when it was built can be restored
+	{
+		const auto path_storedTarget = GetStoredTargetPath( i_key );
+		if ( !Platform::DoesFileExist( path_storedTarget.c_str() ) )
+		{
+			return false;
+		}
+		std::string errorMessage;
+		if ( !Platform::CreateDirectoryIfItDoesntExist( i_path_target, &errorMessage ) )
+		{
+			OutputWarningMessageWithFileInfo( i_path_target, "The target couldn't be restored from the build cache: %s", errorMessage.c_str() );
+			return false;
+		}
+		constexpr auto noErrorIfTargetAlreadyExists = false;
+		constexpr auto updateTheTargetFileTime = true;
+		uint64_t lastWriteTime;
+		if ( !Platform::CopyFile( path_storedTarget.c_str(), i_path_target, noErrorIfTargetAlreadyExists, updateTheTargetFileTime, &errorMessage )
+			|| !Platform::GetLastWriteTime( i_path_target, lastWriteTime, &errorMessage ) )
+		{
+			OutputWarningMessageWithFileInfo( i_path_target, "The target couldn't be restored from the build cache: %s", errorMessage.c_str() );
+			return false;
+		}
+		auto& target = m_targets[i_path_target];
+		target.key = i_key;
+		target.lastWriteTime = lastWriteTime;
+		++m_statistics.restoredCount;
+		m_statistics.savedSecondCount += iterator_buildSecondCount->second;
+		std::cout << "Restored " << i_path_target << " from the build cache\n";
+		std::cout.flush();
+		return true;
+	}
+}
+
+void eae6320::Assets::cBuildCache::StoreTarget( const char* const i_path_target, const std::string& i_key, const double i_buildSecondCount )
+{
+	if ( !m_isInitialized )
+	{
+		return;
+	}
+
+	++m_statistics.builtCount;
+	// The target is only remembered if a copy of it could be stored
+	// (otherwise the next build would think that it is up-to-date but couldn't restore it if it changed)
+	const auto path_storedTarget = GetStoredTargetPath( i_key );
+	std::string errorMessage;
+	constexpr auto noErrorIfTargetAlreadyExists = false;
+	constexpr auto updateTheTargetFileTime = true;
+	uint64_t lastWriteTime;
+	if ( Platform::CopyFile( i_path_target, path_storedTarget.c_str(), noErrorIfTargetAlreadyExists, updateTheTargetFileTime, &errorMessage )
+		&& Platform::GetLastWriteTime( i_path_target, lastWriteTime, &errorMessage ) )
+	{
+		auto& target = m_targets[i_path_target];
+		target.key = i_key;
+		target.lastWriteTime = lastWriteTime;
+		m_buildSecondCounts[i_key] = i_buildSecondCount;
+	}
+	else
+	{
+		m_targets.erase( i_path_target );
+		OutputWarningMessageWithFileInfo( i_path_target, "The target couldn't be stored in the build cache: %s", errorMessage.c_str() );
+	}
+}
+
+// Statistics
+//-----------
+
+eae6320::Assets::cBuildCache::sStatistics eae6320::Assets::cBuildCache::GetStatistics() const
+{
+	return m_statistics;
+}
+
+void eae6320::Assets::cBuildCache::OutputSummary() const
+{
+	if ( !m_isInitialized )
+	{
+		return;
+	}
+
+	const auto hitCount = m_statistics.upToDateCount + m_statistics.restoredCount;
+	std::ostringstream summary;
+	summary.setf( std::ios::fixed );
+	summary.precision( 1 );
+	summary << "Build cache: " << hitCount << " hit" << ( ( hitCount == 1 ) ? "" : "s" )
+		<< " (" << m_statistics.upToDateCount << " up-to-date, " << m_statistics.restoredCount << " restored), "
+		<< m_statistics.builtCount << " miss" << ( ( m_statistics.builtCount == 1 ) ? "" : "es" )
+		<< ", about " << m_statistics.savedSecondCount << " seconds of building saved";
+	std::cout << summary.str() << "\n";
+	std::cout.flush();
+}
+
+// Initialize / Clean Up
+//----------------------
+
+eae6320::cResult eae6320::Assets::cBuildCache::Initialize( const std::string& i_path_directory )
+{
+	m_path_directory = i_path_directory;
+	if ( !m_path_directory.empty() && ( m_path_directory.back() != '/' ) && ( m_path_directory.back() != '\\' ) )
+	{
+		m_path_directory += '/';
+	}
+	// (The function expects a path to a file in the directory)
+	{
+		auto result = Results::Success;
+		std::string errorMessage;
+		if ( !( result = Platform::CreateDirectoryIfItDoesntExist( m_path_directory + "database", &errorMessage ) ) )
+		{
+			OutputErrorMessageWithFileInfo( m_path_directory.c_str(), "The build cache directory couldn't be created: %s", errorMessage.c_str() );
+			return result;
+		}
+	}
+	m_targets.clear();
+	m_buildSecondCounts.clear();
+	m_fileHashes.clear();
+	m_statistics = sStatistics();
+	if ( !LoadDatabase() )
+	{
+		// Every asset will be built
+		m_targets.clear();
+		m_buildSecondCounts.clear();
+	}
+	m_isInitialized = true;
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Assets::cBuildCache::CleanUp()
+{
+	auto result = Results::Success;
+
+	if ( m_isInitialized )
+	{
+		result = SaveDatabase();
+		m_isInitialized = false;
+	}
+	m_targets.clear();
+	m_buildSecondCounts.clear();
+	m_fileHashes.clear();
+
+	return result;
+}
+
+// Implementation
+//===============
+
+std::string eae6320::Assets::cBuildCache::GetStoredTargetPath( const std::string& i_key ) const
+{
+	return m_path_directory + i_key;
+}
+
+eae6320::cResult eae6320::Assets::cBuildCache::LoadDatabase()
+{
+	const auto path_database = m_path_directory + "database";
+	if ( !Platform::DoesFileExist( path_database.c_str() ) )
+	{
+		// The cache hasn't been used yet
+		return Results::Failure;
+	}
+	Platform::sDataFromFile dataFromFile;
+	{
+		auto result = Results::Success;
+		std::string errorMessage;
+		if ( !( result = Platform::LoadBinaryFile( path_database.c_str(), dataFromFile, &errorMessage ) ) )
+		{
+			OutputWarningMessageWithFileInfo( path_database.c_str(), "The build cache database couldn't be loaded: %s", errorMessage.c_str() );
+			return result;
+		}
+	}
+
+	// Each line is either:
+	//	t <key> <last write time> <target path>
+	//	k <key> <build seconds>
+	std::istringstream database( std::string( static_cast<const char*>( dataFromFile.data ), dataFromFile.size ) );
+	std::string line;
+	if ( !std::getline( database, line ) || ( line != s_databaseHeader ) )
+	{
+		return Results::Failure;
+	}
+	while ( std::getline( database, line ) )
+	{
+		std::istringstream fields( line );
+		char type;
+		std::string key;
+		if ( !( fields >> type >> key ) )
+		{
+			return Results::Failure;
+		}
+		if ( type == 't' )
+		{
+			sTarget target;
+			target.key = key;
+			std::string path_target;
+			if ( !( fields >> target.lastWriteTime ) || !std::getline( fields >> std::ws, path_target ) || path_target.empty() )
+			{
+				return Results::Failure;
+			}
+			m_targets[path_target] = target;
+		}
+		else if ( type == 'k' )
+		{
+			double buildSecondCount;
+			if ( !( fields >> buildSecondCount ) )
+			{
+				return Results::Failure;
+			}
+			m_buildSecondCounts[key] = buildSecondCount;
+		}
+		else
+		{
+			return Results::Failure;
+		}
+	}
+
+	return Results::Success;
+}
+
+eae6320::cResult eae6320::Assets::cBuildCache::SaveDatabase() const
+{
+	std::ostringstream database;
+	database << s_databaseHeader << "\n";
+	for ( const auto& buildSecondCount : m_buildSecondCounts )
+	{
+		database << "k " << buildSecondCount.first << " " << buildSecondCount.second << "\n";
+	}
+	for ( const auto& target : m_targets )
+	{
+		database << "t " << target.second.key << " " << target.second.lastWriteTime << " " << target.first << "\n";
+	}
+	const auto path_database = m_path_directory + "database";
+	const auto data = database.str();
+	std::string errorMessage;
+	const auto result = Platform::WriteBinaryFile( path_database.c_str(), data.data(), data.size(), &errorMessage );
+	if ( !result )
+	{
+		OutputErrorMessageWithFileInfo( path_database.c_str(), "The build cache database couldn't be saved: %s", errorMessage.c_str() );
+	}
+	return result;
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	uint64_t AddToHash( const uint64_t i_hash, const void* const i_data, const size_t i_size )
+	{
+		constexpr uint64_t prime = 0x100000001b3;
+		auto hash = i_hash;
+		const auto* const bytes = static_cast<const uint8_t*>( i_data );
+		for ( size_t i = 0; i < i_size; ++i )
+		{
+			hash ^= bytes[i];
+			hash *= prime;
+		}
+		return hash;
+	}
+}
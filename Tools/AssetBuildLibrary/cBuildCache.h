@@ -0,0 +1,122 @@
+/*
+	A build cache decides whether an asset needs to be built from the contents of everything that goes into building it
+	(rather than from the times that files were last written to)
+
+	AssetBuildFunctions.lua calculates a key for every asset from:
+		* The source asset
+		* Any files that the source includes (e.g. shaders.inc)
+		* The builder
+			(or AssetBuildExe if the builder is built in to it; see BuilderRegistry.h)
+		* AssetBuildFunctions.lua itself
+		* The asset type, the builder's optional arguments,
+			and whether the builder runs in AssetBuildExe's process or as a separate program
+	and then:
+		* If the target was built with the same key (and hasn't been changed since) then it is up-to-date
+		* Otherwise, if a target was ever built with the same key then a copy of it is restored
+			(e.g. after switching branches or undoing a change)
+		* Otherwise the target is built, and a copy of it is stored in the cache
+
+	The database and the stored copies are in a single directory which is never cleaned up automatically
+	(it can be deleted at any time, which will just cause every asset to be built again).
+*/
+
+#ifndef EAE6320_ASSETBUILD_CBUILDCACHE_H
+#define EAE6320_ASSETBUILD_CBUILDCACHE_H
+
+// Includes
+//=========
+
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <map>
+#include <string>
+#include <vector>
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		class cBuildCache
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Keys
+			//-----
+
+			// The key is a content hash of every file and the string
+			// (the order of the files matters)
+			cResult CalculateKey( const std::vector<std::string>& i_paths, const std::string& i_string,
+				std::string& o_key, std::string* const o_errorMessage = nullptr );
+
+			// Targets
+			//--------
+
+			// This returns true if the target doesn't need to be built,
+			// either because it is already up-to-date or because a copy of it was restored from the cache
+			bool UseCachedTarget( const char* const i_path_target, const std::string& i_key );
+			// This is called after a target has been built successfully
+			void StoreTarget( const char* const i_path_target, const std::string& i_key, const double i_buildSecondCount );
+
+			// Statistics
+			//-----------
+
+			struct sStatistics
+			{
+				unsigned int upToDateCount = 0;
+				unsigned int restoredCount = 0;
+				unsigned int builtCount = 0;
+				// How long the up-to-date and restored targets took to build the last time they were built
+				double savedSecondCount = 0.0;
+			};
+			sStatistics GetStatistics() const;
+			void OutputSummary() const;
+
+			// Initialize / Clean Up
+			//----------------------
+
+			// If the database can't be loaded (e.g. because it doesn't exist yet) the cache starts out empty
+			cResult Initialize( const std::string& i_path_directory );
+			// The database is saved
+			cResult CleanUp();
+
+			// Data
+			//=====
+
+		private:
+
+			struct sTarget
+			{
+				std::string key;
+				uint64_t lastWriteTime = 0;
+			};
+			// The target path is the key
+			std::map<std::string, sTarget> m_targets;
+			// How long it took to build the target with each key
+			// (a copy of the target is stored in the directory with the key as its file name)
+			std::map<std::string, double> m_buildSecondCounts;
+			// The content hashes of files are remembered
+			// so that a file that is used by many assets (e.g. a builder) is only read once
+			std::map<std::string, uint64_t> m_fileHashes;
+			std::string m_path_directory;
+			sStatistics m_statistics;
+			bool m_isInitialized = false;
+
+			// Implementation
+			//===============
+
+		private:
+
+			std::string GetStoredTargetPath( const std::string& i_key ) const;
+			cResult LoadDatabase();
+			cResult SaveDatabase() const;
+		};
+	}
+}
+
+#endif	// EAE6320_ASSETBUILD_CBUILDCACHE_H
@@ -0,0 +1,302 @@
+// Includes
+//=========
+
+#include "cBuildJobGraph.h"
+
+#include "BuilderRegistry.h"
+#include "cBuildCache.h"
+#include "Functions.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Platform/Platform.h>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+
+// Interface
+//==========
+
+// Jobs
+//-----
+
+eae6320::cResult eae6320::Assets::cBuildJobGraph::AddJob( const char* const i_commandLine, const char* const i_path_source, const char* const i_path_target,
+	BuilderRegistry::sBuilder* const i_builder, const std::vector<std::string>& i_optionalArguments, const char* const i_buildCacheKey, const std::vector<size_t>& i_dependencies, size_t& o_jobIndex, std::string* const o_errorMessage )
+{
+	const auto jobIndex = m_jobs.size();
+	for ( const auto dependency : i_dependencies )
+	{
+		if ( dependency >= jobIndex )
+		{
+			if ( o_errorMessage )
+			{
+				std::ostringstream errorMessage;
+				errorMessage << "The build job for \"" << i_path_source << "\" can't depend on job #" << dependency
+					<< " because there are only " << jobIndex << " jobs";
+				*o_errorMessage = errorMessage.str();
+			}
+			return Results::Failure;
+		}
+	}
+
+	sJob job;
+	{
+		job.commandLine = i_commandLine;
+		job.path_source = i_path_source;
+		job.path_target = i_path_target;
+		job.builder = i_builder;
+		job.optionalArguments = i_optionalArguments;
+		if ( i_buildCacheKey )
+		{
+			job.buildCacheKey = i_buildCacheKey;
+		}
+	}
+	for ( const auto dependency : i_dependencies )
+	{
+		auto& dependentJobs = m_jobs[dependency].dependentJobs;
+		// (a dependency that is listed more than once is only counted once)
+		if ( std::find( dependentJobs.begin(), dependentJobs.end(), jobIndex ) == dependentJobs.end() )
+		{
+			dependentJobs.push_back( jobIndex );
+			++job.remainingDependencyCount;
+		}
+	}
+	m_jobs.push_back( std::move( job ) );
+	o_jobIndex = jobIndex;
+
+	return Results::Success;
+}
+
+// Execution
+//----------
+
+eae6320::cResult eae6320::Assets::cBuildJobGraph::Execute( const unsigned int i_threadCount, cBuildCache* const io_buildCache )
+{
+	const auto jobCount = m_jobs.size();
+	if ( jobCount == 0 )
+	{
+		return Results::Success;
+	}
+
+	// The collections below are shared between every thread
+	std::mutex mutex;
+	std::condition_variable condition_jobReady;
+	std::condition_variable condition_jobFinished;
+	// The jobs that are ready are started in the order that they were added
+	std::set<size_t> readyJobs;
+	// Jobs that haven't been started or skipped
+	auto unstartedJobCount = jobCount;
+	for ( size_t i = 0; i < jobCount; ++i )
+	{
+		auto& job = m_jobs[i];
+		if ( job.remainingDependencyCount == 0 )
+		{
+			job.state = eJobState::Ready;
+			readyJobs.insert( i );
+		}
+	}
+
+	// Start the threads
+	std::vector<std::thread> threads;
+	{
+		auto threadCount = ( i_threadCount > 0 ) ? i_threadCount : std::max( std::thread::hardware_concurrency(), 1u );
+		threadCount = static_cast<unsigned int>( std::min( static_cast<size_t>( threadCount ), jobCount ) );
+		threads.reserve( threadCount );
+		for ( unsigned int i = 0; i < threadCount; ++i )
+		{
+			threads.emplace_back( [this, &mutex, &condition_jobReady, &condition_jobFinished, &readyJobs, &unstartedJobCount]()
+				{
+					std::unique_lock<std::mutex> lock( mutex );
+					while ( true )
+					{
+						condition_jobReady.wait( lock, [&readyJobs, &unstartedJobCount]()
+							{
+								return !readyJobs.empty() || ( unstartedJobCount == 0 );
+							} );
+						if ( readyJobs.empty() )
+						{
+							// Every job has been started (or skipped)
+							return;
+						}
+						const auto jobIndex = *readyJobs.begin();
+						readyJobs.erase( readyJobs.begin() );
+						--unstartedJobCount;
+						auto& job = m_jobs[jobIndex];
+						job.state = eJobState::Executing;
+
+						// The builder is executed without the mutex locked
+						// (only this thread uses the job until its state changes)
+						lock.unlock();
+						const auto wasSuccessful = ExecuteJob( job );
+						lock.lock();
+
+						if ( wasSuccessful )
+						{
+							job.state = eJobState::Succeeded;
+							for ( const auto dependentJobIndex : job.dependentJobs )
+							{
+								auto& dependentJob = m_jobs[dependentJobIndex];
+								EAE6320_ASSERT( dependentJob.remainingDependencyCount > 0 );
+								if ( ( --dependentJob.remainingDependencyCount == 0 ) && ( dependentJob.state == eJobState::Waiting ) )
+								{
+									dependentJob.state = eJobState::Ready;
+									readyJobs.insert( dependentJobIndex );
+								}
+							}
+						}
+						else
+						{
+							job.state = eJobState::Failed;
+							// Every job that depends on this one (directly or indirectly) is skipped
+							std::vector<size_t> jobsToSkip( job.dependentJobs );
+							while ( !jobsToSkip.empty() )
+							{
+								const auto jobToSkipIndex = jobsToSkip.back();
+								jobsToSkip.pop_back();
+								auto& jobToSkip = m_jobs[jobToSkipIndex];
+								// (a job that depends on more than one failed job is only skipped once)
+								if ( jobToSkip.state == eJobState::Waiting )
+								{
+									jobToSkip.state = eJobState::Skipped;
+									jobToSkip.failedDependency = jobIndex;
+									--unstartedJobCount;
+									jobsToSkip.insert( jobsToSkip.end(), jobToSkip.dependentJobs.begin(), jobToSkip.dependentJobs.end() );
+								}
+							}
+						}
+						condition_jobReady.notify_all();
+						condition_jobFinished.notify_all();
+					}
+				} );
+		}
+	}
+
+	// The results are output in the order that the jobs were added
+	// as soon as each job (and every job before it) has finished
+	auto result = Results::Success;
+	for ( size_t i = 0; i < jobCount; ++i )
+	{
+		const auto& job = m_jobs[i];
+		{
+			std::unique_lock<std::mutex> lock( mutex );
+			condition_jobFinished.wait( lock, [&job]()
+				{
+					return IsFinished( job.state );
+				} );
+		}
+		// A finished job is never changed again,
+		// and so it can be read without the mutex locked
+		if ( OutputJobResult( job ) )
+		{
+			// (the cache is only used by this thread)
+			if ( io_buildCache && !job.buildCacheKey.empty() )
+			{
+				io_buildCache->StoreTarget( job.path_target.c_str(), job.buildCacheKey, job.buildSecondCount );
+			}
+		}
+		else
+		{
+			result = Results::Failure;
+		}
+	}
+
+	for ( auto& thread : threads )
+	{
+		thread.join();
+	}
+	m_jobs.clear();
+
+	return result;
+}
+
+// Implementation
+//===============
+
+bool eae6320::Assets::cBuildJobGraph::ExecuteJob( sJob& io_job )
+{
+	const auto time_start = std::chrono::steady_clock::now();
+	if ( io_job.builder )
+	{
+		// The builder is called directly instead of executing the command line,
+		// and its result is treated the same as if it were the exit code
+		io_job.wasCommandExecuted = true;
+		io_job.exitCode = BuilderRegistry::Build( *io_job.builder, io_job.path_source.c_str(), io_job.path_target.c_str(),
+			io_job.optionalArguments, io_job.output ) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	else
+	{
+		io_job.wasCommandExecuted = Platform::ExecuteCommand( io_job.commandLine.c_str(), &io_job.exitCode, &io_job.errorMessage, &io_job.output );
+	}
+	io_job.buildSecondCount = std::chrono::duration<double>( std::chrono::steady_clock::now() - time_start ).count();
+	if ( io_job.wasCommandExecuted && ( io_job.exitCode == 0 ) )
+	{
+		return true;
+	}
+	else
+	{
+		// There's a chance that the builder already created the target file even though the build failed,
+		// in which case it currently exists with a new time stamp
+		// and the next time a build is run no attempt to build it again would be made even though the build failed.
+		if ( Platform::DoesFileExist( io_job.path_target.c_str() ) )
+		{
+			// Setting the time stamp to an invalid date in far in the past
+			// allows you to look at the generated file if you wish
+			// but still ensures that the build process will attempt to build it again
+			Platform::InvalidateLastWriteTime( io_job.path_target.c_str() );
+		}
+		return false;
+	}
+}
+
+bool eae6320::Assets::cBuildJobGraph::IsFinished( const eJobState i_state )
+{
+	return ( i_state == eJobState::Succeeded ) || ( i_state == eJobState::Failed ) || ( i_state == eJobState::Skipped );
+}
+
+bool eae6320::Assets::cBuildJobGraph::OutputJobResult( const sJob& i_job ) const
+{
+	const auto* const path_source = i_job.path_source.c_str();
+	if ( i_job.state == eJobState::Skipped )
+	{
+		OutputErrorMessageWithFileInfo( path_source, "The asset wasn't built because \"%s\" (which it depends on) failed to build",
+			m_jobs[i_job.failedDependency].path_source.c_str() );
+		return false;
+	}
+
+	// The command line is output before the builder's output (the same as if it had been executed serially)
+	std::cout << i_job.commandLine << "\n";
+	if ( !i_job.output.empty() )
+	{
+		std::cout << i_job.output;
+		if ( i_job.output.back() != '\n' )
+		{
+			std::cout << "\n";
+		}
+	}
+	std::cout.flush();
+	if ( i_job.state == eJobState::Succeeded )
+	{
+		// Display a message for each asset
+		std::cout << "Built " << path_source << "\n";
+		std::cout.flush();
+		return true;
+	}
+	else if ( i_job.wasCommandExecuted )
+	{
+		// The builder should already output a descriptive error message if there was an error,
+		// but it can be helpful to still output an additional vague error message here
+		// in case there is a bug in the specific builder that doesn't output an error message.
+		OutputErrorMessageWithFileInfo( path_source, "The command %s failed with exit code %i", i_job.commandLine.c_str(), i_job.exitCode );
+		return false;
+	}
+	else
+	{
+		OutputErrorMessageWithFileInfo( path_source, "The command %s couldn't be executed: %s", i_job.commandLine.c_str(), i_job.errorMessage.c_str() );
+		return false;
+	}
+}
@@ -0,0 +1,135 @@
+/*
+	A build job graph executes the builders for every asset that needs to be built
+
+	AssetBuildFunctions.lua decides which assets need to be built
+	and adds a job for each one (with the jobs that it depends on),
+	and then the graph executes the jobs on a pool of threads:
+		* A job isn't started until every job that it depends on has succeeded
+			(and if one of them fails then the job is never started)
+		* Jobs that are ready are started in the order that they were added
+		* A job whose builder has been registered (see BuilderRegistry.h) builds in this process on the job's thread,
+			and other jobs execute their builder's command line as a separate process
+		* The output of each builder is captured,
+			and the results are output in the order that the jobs were added
+			(and so the output is the same no matter how many threads are used)
+		* A job with a build cache key stores its target in the build cache when it succeeds
+*/
+
+#ifndef EAE6320_ASSETBUILD_CBUILDJOBGRAPH_H
+#define EAE6320_ASSETBUILD_CBUILDJOBGRAPH_H
+
+// Includes
+//=========
+
+#include <cstddef>
+#include <Engine/Results/Results.h>
+#include <string>
+#include <vector>
+
+// Forward Declarations
+//=====================
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		class cBuildCache;
+
+		namespace BuilderRegistry
+		{
+			struct sBuilder;
+		}
+	}
+}
+
+// Class Declaration
+//==================
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		class cBuildJobGraph
+		{
+			// Interface
+			//==========
+
+		public:
+
+			// Jobs
+			//-----
+
+			// A job can only depend on jobs that have already been added
+			// (which means that the graph can't have cycles).
+			// The build cache key is optional.
+			// If a builder is provided then it is used to build the asset (with the optional arguments)
+			// instead of executing the command line
+			// (the command line is still output with the job's results so that the builder can be debugged).
+			cResult AddJob( const char* const i_commandLine, const char* const i_path_source, const char* const i_path_target,
+				BuilderRegistry::sBuilder* const i_builder, const std::vector<std::string>& i_optionalArguments,
+				const char* const i_buildCacheKey, const std::vector<size_t>& i_dependencies, size_t& o_jobIndex,
+				std::string* const o_errorMessage = nullptr );
+			size_t GetJobCount() const { return m_jobs.size(); }
+
+			// Execution
+			//----------
+
+			// This executes every job that has been added and then removes them.
+			// If the thread count is zero then one thread is used for every hardware thread.
+			// The result is a failure if any job failed (or wasn't executed because a job it depended on failed).
+			// If a build cache is provided then the targets of jobs with keys are stored in it.
+			cResult Execute( const unsigned int i_threadCount = 0, cBuildCache* const io_buildCache = nullptr );
+
+			// Data
+			//=====
+
+		private:
+
+			enum class eJobState
+			{
+				// Waiting for the jobs that it depends on
+				Waiting,
+				Ready,
+				Executing,
+				Succeeded,
+				Failed,
+				// A job that it depends on failed
+				Skipped,
+			};
+			struct sJob
+			{
+				std::string commandLine;
+				std::string path_source;
+				std::string path_target;
+				BuilderRegistry::sBuilder* builder = nullptr;
+				std::vector<std::string> optionalArguments;
+				std::string buildCacheKey;
+				std::vector<size_t> dependentJobs;
+				size_t remainingDependencyCount = 0;
+				eJobState state = eJobState::Waiting;
+				// The results
+				std::string output;
+				std::string errorMessage;
+				int exitCode = 0;
+				double buildSecondCount = 0.0;
+				bool wasCommandExecuted = false;
+				// If the job was skipped this is the job that failed
+				size_t failedDependency = 0;
+			};
+			std::vector<sJob> m_jobs;
+
+			// Implementation
+			//===============
+
+		private:
+
+			// This is called without the mutex locked, and returns false if the job failed
+			static bool ExecuteJob( sJob& io_job );
+			static bool IsFinished( const eJobState i_state );
+			// This returns false if the job failed (or was skipped)
+			bool OutputJobResult( const sJob& i_job ) const;
+		};
+	}
+}
+
+#endif	// EAE6320_ASSETBUILD_CBUILDJOBGRAPH_H
@@ -22,15 +22,12 @@ eae6320::cResult eae6320::Assets::iBuilder::ParseCommandArgumentsAndBuild( char*
 	if ( actualArgumentCount >= requiredArgumentCount )
 	{
 		EAE6320_ASSERT( i_arguments != nullptr );
-		m_path_source = i_arguments[commandCount + 0];
-		m_path_target = i_arguments[commandCount + 1];
-
 		std::vector<std::string> optionalArguments;
 		for ( auto i = ( commandCount + requiredArgumentCount ); i < i_argumentCount; ++i )
 		{
 			optionalArguments.push_back( i_arguments[i] );
 		}
-		return Build( optionalArguments );
+		return SetPathsAndBuild( i_arguments[commandCount + 0], i_arguments[commandCount + 1], optionalArguments );
 	}
 	else
 	{
@@ -55,3 +52,12 @@ eae6320::cResult eae6320::Assets::iBuilder::ParseCommandArgumentsAndBuild( char*
 		return Results::Failure;
 	}
 }
+
+eae6320::cResult eae6320::Assets::iBuilder::SetPathsAndBuild( const char* const i_path_source, const char* const i_path_target,
+	const std::vector<std::string>& i_optionalArguments )
+{
+	EAE6320_ASSERT( i_path_source && i_path_target );
+	m_path_source = i_path_source;
+	m_path_target = i_path_target;
+	return Build( i_optionalArguments );
+}
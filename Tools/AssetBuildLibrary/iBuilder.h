@@ -44,6 +44,11 @@ namespace eae6320
 			// The following function will be called from the templated Build<> function above
 			// with the command line arguments directly from the main() entry point:
 			cResult ParseCommandArgumentsAndBuild( char* const* i_arguments, const unsigned int i_argumentCount );
+			// The following function will be called instead when the builder is run in the same process as AssetBuildExe
+			// (see BuilderRegistry.h).
+			// The paths must stay valid until it returns.
+			cResult SetPathsAndBuild( const char* const i_path_source, const char* const i_path_target,
+				const std::vector<std::string>& i_optionalArguments );
 
 			// Initialization / Clean Up
 			//--------------------------
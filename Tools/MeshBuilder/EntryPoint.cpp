@@ -6,11 +6,24 @@
 //=========
 
 #include "cMeshBuilder.h"
+#include "MeshParsingBenchmark.h"
+
+#include <cstdlib>
+#include <cstring>
 
 // Entry Point
 //============
 
 int main(int i_argumentCount, char** i_arguments)
 {
+	// "-benchmark <directory> [vertex count]" compares the ways of loading mesh source files instead of building one
+	// (see MeshParsingBenchmark.h)
+	if ((i_argumentCount >= 3) && (std::strcmp(i_arguments[1], "-benchmark") == 0))
+	{
+		const auto result = (i_argumentCount >= 4)
+			? eae6320::Assets::MeshParsingBenchmark::RunAndOutput(i_arguments[2], static_cast<uint32_t>(std::strtoul(i_arguments[3], nullptr, 10)))
+			: eae6320::Assets::MeshParsingBenchmark::RunAndOutputStandardSizes(i_arguments[2]);
+		return result ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
 	return eae6320::Assets::Build<eae6320::Assets::cMeshBuilder>(i_arguments, i_argumentCount);
 }
\ No newline at end of file
@@ -0,0 +1,353 @@
+// Includes
+//=========
+
+#include "MeshOptimization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <Engine/Asserts/Asserts.h>
+#include <vector>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	constexpr uint32_t s_noVertex = ~uint32_t( 0 );
+
+	// The triangles that use each vertex,
+	// stored so that vertex v's triangles are triangles[offsets[v]] to triangles[offsets[v + 1] - 1]
+	struct sAdjacency
+	{
+		std::vector<uint32_t> offsets;
+		std::vector<uint32_t> triangles;
+	};
+	void BuildAdjacency( const uint32_t* const i_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount, sAdjacency& o_adjacency );
+
+	// Reorders the triangles and returns where each cluster starts
+	// (a new cluster starts whenever Tipsify can't continue from a vertex that is still in the cache)
+	std::vector<uint32_t> Tipsify( uint32_t* const io_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount,
+		const unsigned int i_cacheSize );
+	// Sorts the clusters so that the ones that face away from the middle of the mesh are first
+	void SortClustersForOverdraw( uint32_t* const io_indices, const uint32_t i_indexCount, const std::vector<uint32_t>& i_clusterStarts,
+		const eae6320::Assets::sSourceVertex* const i_vertices );
+}
+
+// Interface
+//==========
+
+eae6320::Assets::MeshOptimization::sVertexCacheStatistics eae6320::Assets::MeshOptimization::AnalyzeVertexCache(
+	const uint32_t* const i_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount )
+{
+	sVertexCacheStatistics statistics;
+	const auto triangleCount = i_indexCount / 3;
+	if ( triangleCount == 0 )
+	{
+		return statistics;
+	}
+
+	// Each vertex remembers when it was last put in the cache,
+	// and it is still in the cache if fewer than vertexCacheSize vertices have been put in since then
+	std::vector<uint32_t> timeAddedToCache( i_vertexCount, 0 );
+	std::vector<bool> isUsed( i_vertexCount, false );
+	uint32_t time = vertexCacheSize + 1;
+	uint32_t missCount = 0, usedVertexCount = 0;
+	for ( uint32_t i = 0; i < ( triangleCount * 3 ); ++i )
+	{
+		const auto vertex = i_indices[i];
+		EAE6320_ASSERT( vertex < i_vertexCount );
+		if ( ( time - timeAddedToCache[vertex] ) > vertexCacheSize )
+		{
+			timeAddedToCache[vertex] = time++;
+			++missCount;
+		}
+		if ( !isUsed[vertex] )
+		{
+			isUsed[vertex] = true;
+			++usedVertexCount;
+		}
+	}
+	statistics.acmr = static_cast<float>( missCount ) / static_cast<float>( triangleCount );
+	statistics.atvr = static_cast<float>( missCount ) / static_cast<float>( usedVertexCount );
+	return statistics;
+}
+
+void eae6320::Assets::MeshOptimization::OptimizeTriangleOrder( uint32_t* const io_indices, const uint32_t i_indexCount,
+	const sSourceVertex* const i_vertices, const uint32_t i_vertexCount )
+{
+	EAE6320_ASSERT( ( i_indexCount % 3 ) == 0 );
+	if ( i_indexCount < 6 )
+	{
+		return;
+	}
+	const auto clusterStarts = Tipsify( io_indices, i_indexCount, i_vertexCount, vertexCacheSize );
+	SortClustersForOverdraw( io_indices, i_indexCount, clusterStarts, i_vertices );
+}
+
+uint32_t eae6320::Assets::MeshOptimization::OptimizeVertexFetch( sSourceVertex* const io_vertices, const uint32_t i_vertexCount,
+	uint32_t* const io_indices, const uint32_t i_indexCount )
+{
+	std::vector<uint32_t> newIndices( i_vertexCount, s_noVertex );
+	std::vector<sSourceVertex> newVertices;
+	newVertices.reserve( i_vertexCount );
+	for ( uint32_t i = 0; i < i_indexCount; ++i )
+	{
+		auto& newIndex = newIndices[io_indices[i]];
+		if ( newIndex == s_noVertex )
+		{
+			newIndex = static_cast<uint32_t>( newVertices.size() );
+			newVertices.push_back( io_vertices[io_indices[i]] );
+		}
+		io_indices[i] = newIndex;
+	}
+	std::copy( newVertices.begin(), newVertices.end(), io_vertices );
+	return static_cast<uint32_t>( newVertices.size() );
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	void BuildAdjacency( const uint32_t* const i_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount, sAdjacency& o_adjacency )
+	{
+		o_adjacency.offsets.assign( size_t( i_vertexCount ) + 1, 0 );
+		for ( uint32_t i = 0; i < i_indexCount; ++i )
+		{
+			++o_adjacency.offsets[i_indices[i] + 1];
+		}
+		for ( uint32_t v = 0; v < i_vertexCount; ++v )
+		{
+			o_adjacency.offsets[v + 1] += o_adjacency.offsets[v];
+		}
+		o_adjacency.triangles.resize( i_indexCount );
+		std::vector<uint32_t> nextSlots( o_adjacency.offsets.begin(), o_adjacency.offsets.end() - 1 );
+		for ( uint32_t i = 0; i < i_indexCount; ++i )
+		{
+			o_adjacency.triangles[nextSlots[i_indices[i]]++] = i / 3;
+		}
+	}
+
+	std::vector<uint32_t> Tipsify( uint32_t* const io_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount,
+		const unsigned int i_cacheSize )
+	{
+		const auto triangleCount = i_indexCount / 3;
+		sAdjacency adjacency;
+		BuildAdjacency( io_indices, i_indexCount, i_vertexCount, adjacency );
+
+		// How many triangles that haven't been emitted yet use each vertex
+		std::vector<uint32_t> liveTriangleCounts( i_vertexCount );
+		for ( uint32_t v = 0; v < i_vertexCount; ++v )
+		{
+			liveTriangleCounts[v] = adjacency.offsets[v + 1] - adjacency.offsets[v];
+		}
+		std::vector<uint32_t> timeAddedToCache( i_vertexCount, 0 );
+		std::vector<bool> isEmitted( triangleCount, false );
+		// Recently used vertices that Tipsify can go back to when it reaches a dead end
+		std::vector<uint32_t> deadEndStack;
+		std::vector<uint32_t> candidates;
+		std::vector<uint32_t> output;
+		output.reserve( i_indexCount );
+		std::vector<uint32_t> clusterStarts;
+
+		uint32_t time = i_cacheSize + 1;
+		uint32_t cursor = 0;
+		uint32_t fanningVertex = 0;
+		while ( fanningVertex != s_noVertex )
+		{
+			// Emit every triangle around the fanning vertex that hasn't already been emitted
+			candidates.clear();
+			for ( auto a = adjacency.offsets[fanningVertex]; a < adjacency.offsets[fanningVertex + 1]; ++a )
+			{
+				const auto triangle = adjacency.triangles[a];
+				if ( isEmitted[triangle] )
+				{
+					continue;
+				}
+				for ( uint32_t j = 0; j < 3; ++j )
+				{
+					const auto vertex = io_indices[( triangle * 3 ) + j];
+					output.push_back( vertex );
+					deadEndStack.push_back( vertex );
+					candidates.push_back( vertex );
+					--liveTriangleCounts[vertex];
+					if ( ( time - timeAddedToCache[vertex] ) > i_cacheSize )
+					{
+						timeAddedToCache[vertex] = time++;
+					}
+				}
+				isEmitted[triangle] = true;
+			}
+			// The next fanning vertex is the candidate that will still be in the cache after its remaining triangles are emitted
+			// and that has been in the cache the longest
+			// (so that it is used before it is evicted)
+			uint32_t nextVertex = s_noVertex;
+			uint32_t highestPriority = 0;
+			for ( const auto vertex : candidates )
+			{
+				if ( liveTriangleCounts[vertex] > 0 )
+				{
+					uint32_t priority = 0;
+					if ( ( ( time - timeAddedToCache[vertex] ) + ( 2 * liveTriangleCounts[vertex] ) ) <= i_cacheSize )
+					{
+						priority = time - timeAddedToCache[vertex];
+					}
+					if ( ( nextVertex == s_noVertex ) || ( priority > highestPriority ) )
+					{
+						highestPriority = priority;
+						nextVertex = vertex;
+					}
+				}
+			}
+			// If none of the candidates have any triangles left this is a dead end:
+			// Tipsify goes back to a recently used vertex that does,
+			// or else the next vertex in the mesh that does
+			if ( nextVertex == s_noVertex )
+			{
+				while ( !deadEndStack.empty() && ( nextVertex == s_noVertex ) )
+				{
+					const auto vertex = deadEndStack.back();
+					deadEndStack.pop_back();
+					if ( liveTriangleCounts[vertex] > 0 )
+					{
+						nextVertex = vertex;
+					}
+				}
+				if ( nextVertex == s_noVertex )
+				{
+					while ( ( cursor < i_vertexCount ) && ( liveTriangleCounts[cursor] == 0 ) )
+					{
+						++cursor;
+					}
+					if ( cursor < i_vertexCount )
+					{
+						nextVertex = cursor;
+					}
+				}
+				// The vertices that were in the cache probably aren't anymore,
+				// and so this is a good place for a cluster to end
+				if ( nextVertex != s_noVertex )
+				{
+					clusterStarts.push_back( static_cast<uint32_t>( output.size() / 3 ) );
+				}
+			}
+			fanningVertex = nextVertex;
+		}
+		EAE6320_ASSERT( output.size() == ( size_t( triangleCount ) * 3 ) );
+		std::copy( output.begin(), output.end(), io_indices );
+
+		if ( clusterStarts.empty() || ( clusterStarts.front() != 0 ) )
+		{
+			clusterStarts.insert( clusterStarts.begin(), 0 );
+		}
+		return clusterStarts;
+	}
+
+	void SortClustersForOverdraw( uint32_t* const io_indices, const uint32_t i_indexCount, const std::vector<uint32_t>& i_clusterStarts,
+		const eae6320::Assets::sSourceVertex* const i_vertices )
+	{
+		const auto triangleCount = i_indexCount / 3;
+		const auto clusterCount = i_clusterStarts.size();
+		if ( clusterCount < 2 )
+		{
+			return;
+		}
+
+		// Each cluster's area-weighted center and normal
+		struct sCluster
+		{
+			uint32_t firstTriangle = 0, triangleCount = 0;
+			double center[3] = {}, normal[3] = {};
+			double area = 0.0;
+			double sortKey = 0.0;
+		};
+		std::vector<sCluster> clusters( clusterCount );
+		double meshCenter[3] = {};
+		double meshArea = 0.0;
+		for ( size_t c = 0; c < clusterCount; ++c )
+		{
+			auto& cluster = clusters[c];
+			cluster.firstTriangle = i_clusterStarts[c];
+			cluster.triangleCount = ( ( ( c + 1 ) < clusterCount ) ? i_clusterStarts[c + 1] : triangleCount ) - cluster.firstTriangle;
+			for ( uint32_t t = cluster.firstTriangle; t < ( cluster.firstTriangle + cluster.triangleCount ); ++t )
+			{
+				const auto& vertex0 = i_vertices[io_indices[( t * 3 ) + 0]];
+				const auto& vertex1 = i_vertices[io_indices[( t * 3 ) + 1]];
+				const auto& vertex2 = i_vertices[io_indices[( t * 3 ) + 2]];
+				const double edge1[3] = { vertex1.x - vertex0.x, vertex1.y - vertex0.y, vertex1.z - vertex0.z };
+				const double edge2[3] = { vertex2.x - vertex0.x, vertex2.y - vertex0.y, vertex2.z - vertex0.z };
+				// Front faces are clockwise (the Direct3D convention that meshes are authored with),
+				// and so this cross product points out of the front face
+				const double normal[3] = {
+					( edge2[1] * edge1[2] ) - ( edge2[2] * edge1[1] ),
+					( edge2[2] * edge1[0] ) - ( edge2[0] * edge1[2] ),
+					( edge2[0] * edge1[1] ) - ( edge2[1] * edge1[0] ) };
+				// The cross product's length is twice the triangle's area
+				const auto area = 0.5 * std::sqrt( ( normal[0] * normal[0] ) + ( normal[1] * normal[1] ) + ( normal[2] * normal[2] ) );
+				const double center[3] = {
+					( vertex0.x + vertex1.x + vertex2.x ) / 3.0,
+					( vertex0.y + vertex1.y + vertex2.y ) / 3.0,
+					( vertex0.z + vertex1.z + vertex2.z ) / 3.0 };
+				for ( int i = 0; i < 3; ++i )
+				{
+					cluster.center[i] += center[i] * area;
+					cluster.normal[i] += normal[i];
+				}
+				cluster.area += area;
+			}
+			for ( int i = 0; i < 3; ++i )
+			{
+				meshCenter[i] += cluster.center[i];
+			}
+			meshArea += cluster.area;
+			if ( cluster.area > 0.0 )
+			{
+				for ( auto& value : cluster.center )
+				{
+					value /= cluster.area;
+				}
+			}
+		}
+		if ( meshArea <= 0.0 )
+		{
+			return;
+		}
+		for ( auto& value : meshCenter )
+		{
+			value /= meshArea;
+		}
+		// A cluster that is far from the middle and faces away from it is likely to hide other clusters
+		for ( auto& cluster : clusters )
+		{
+			const auto normalLength = std::sqrt( ( cluster.normal[0] * cluster.normal[0] ) + ( cluster.normal[1] * cluster.normal[1] )
+				+ ( cluster.normal[2] * cluster.normal[2] ) );
+			if ( normalLength > 0.0 )
+			{
+				for ( int i = 0; i < 3; ++i )
+				{
+					cluster.sortKey += ( cluster.center[i] - meshCenter[i] ) * ( cluster.normal[i] / normalLength );
+				}
+			}
+		}
+		// The sort is stable so that clusters that are equally likely to occlude keep their order for the vertex cache
+		std::vector<uint32_t> order( clusterCount );
+		for ( uint32_t c = 0; c < clusterCount; ++c )
+		{
+			order[c] = c;
+		}
+		std::stable_sort( order.begin(), order.end(), [&clusters]( const uint32_t i_lhs, const uint32_t i_rhs )
+			{
+				return clusters[i_lhs].sortKey > clusters[i_rhs].sortKey;
+			} );
+
+		std::vector<uint32_t> sortedIndices;
+		sortedIndices.reserve( i_indexCount );
+		for ( const auto c : order )
+		{
+			const auto& cluster = clusters[c];
+			sortedIndices.insert( sortedIndices.end(), io_indices + ( cluster.firstTriangle * 3 ),
+				io_indices + ( ( cluster.firstTriangle + cluster.triangleCount ) * 3 ) );
+		}
+		std::copy( sortedIndices.begin(), sortedIndices.end(), io_indices );
+	}
+}
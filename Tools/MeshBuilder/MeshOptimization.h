@@ -0,0 +1,64 @@
+/*
+	These functions reorder a mesh's triangles and vertices when it is built
+	so that the GPU does less work when it draws the mesh
+
+	The mesh format doesn't change, and neither does what the mesh looks like:
+		* The triangles are reordered so that a vertex that has just been shaded is likely to be used again
+			while it is still in the GPU's post-transform vertex cache
+			(this uses "Tipsify" from Sander, Nehab, and Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw")
+		* The clusters of triangles that Tipsify makes are then sorted so that the ones that face outward from the middle of the mesh are drawn first
+			(those are the triangles that are most likely to hide the others, and so fewer pixels are shaded and then drawn over)
+		* The vertices are then renumbered in the order that the triangles first use them
+			so that the vertex fetches move through memory in order
+			(vertices that aren't used by any triangle are removed)
+*/
+
+#ifndef EAE6320_MESHOPTIMIZATION_H
+#define EAE6320_MESHOPTIMIZATION_H
+
+// Includes
+//=========
+
+#include "VertexQuantization.h"
+
+#include <cstdint>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace MeshOptimization
+		{
+			// The size of the FIFO vertex cache that the triangles are ordered for and analyzed with
+			// (real GPUs differ, but an order that is good for one size is usually good for others)
+			constexpr unsigned int vertexCacheSize = 16;
+
+			struct sVertexCacheStatistics
+			{
+				// Average cache miss ratio: How many vertices are shaded per triangle
+				// (0.5 is the best possible for a big regular grid and 3 is the worst)
+				float acmr = 0.0f;
+				// Average transformed vertex ratio: How many times each vertex is shaded
+				// (1 is the best possible)
+				float atvr = 0.0f;
+			};
+			// Simulates drawing the triangles with a FIFO vertex cache
+			sVertexCacheStatistics AnalyzeVertexCache( const uint32_t* const i_indices, const uint32_t i_indexCount, const uint32_t i_vertexCount );
+
+			// Reorders the triangles for the vertex cache and then for overdraw
+			// (the vertices in each triangle stay in the same order, and so the winding order doesn't change)
+			void OptimizeTriangleOrder( uint32_t* const io_indices, const uint32_t i_indexCount,
+				const sSourceVertex* const i_vertices, const uint32_t i_vertexCount );
+
+			// Renumbers the vertices in the order that the indices first use them
+			// and returns the new vertex count
+			uint32_t OptimizeVertexFetch( sSourceVertex* const io_vertices, const uint32_t i_vertexCount,
+				uint32_t* const io_indices, const uint32_t i_indexCount );
+		}
+	}
+}
+
+#endif	// EAE6320_MESHOPTIMIZATION_H
@@ -0,0 +1,218 @@
+// Includes
+//=========
+
+#include "MeshParsingBenchmark.h"
+
+#include "cMeshBuilder.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Platform/Platform.h>
+#include <ostream>
+#include <sstream>
+#include <Tools/AssetBuildLibrary/Functions.h>
+#include <vector>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// The source is formatted the same way that the exporter formats meshes
+	std::string GenerateGridSource( const uint32_t i_sideVertexCount );
+
+	// The average time to load the file with the given parser
+	eae6320::cResult MeasureSecondsPerPass( eae6320::Assets::cMeshBuilder& io_builder, const std::string& i_path,
+		const eae6320::Assets::cMeshBuilder::eParser i_parser, const unsigned int i_passCount,
+		std::vector<eae6320::Assets::sSourceVertex>& o_vertexData, std::vector<uint32_t>& o_indexData, double& o_secondsPerPass );
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Assets::MeshParsingBenchmark::Run( const std::string& i_directory, const uint32_t i_vertexCount, sResults& o_results,
+	const unsigned int i_passCount )
+{
+	EAE6320_ASSERT( i_passCount > 0 );
+	auto result = Results::Success;
+
+	o_results = sResults();
+
+	// Generate the mesh
+	const auto sideVertexCount = std::max( static_cast<uint32_t>( std::ceil( std::sqrt( static_cast<double>( i_vertexCount ) ) ) ), 2u );
+	const auto path = i_directory + "/MeshParsingBenchmark_" + std::to_string( sideVertexCount * sideVertexCount ) + ".mesh";
+	{
+		const auto source = GenerateGridSource( sideVertexCount );
+		std::string errorMessage;
+		if ( !( result = Platform::CreateDirectoryIfItDoesntExist( path, &errorMessage ) )
+			|| !( result = Platform::WriteBinaryFile( path.c_str(), source.data(), source.size(), &errorMessage ) ) )
+		{
+			OutputErrorMessageWithFileInfo( path.c_str(), "The mesh parsing benchmark couldn't write the generated mesh: %s", errorMessage.c_str() );
+			return result;
+		}
+		o_results.fileByteCount = source.size();
+	}
+	// The file is read once without being timed
+	// so that both ways read it from the file cache
+	{
+		Platform::sDataFromFile dataFromFile;
+		std::string errorMessage;
+		if ( !( result = Platform::LoadBinaryFile( path.c_str(), dataFromFile, &errorMessage ) ) )
+		{
+			OutputErrorMessageWithFileInfo( path.c_str(), "The mesh parsing benchmark couldn't read the generated mesh: %s", errorMessage.c_str() );
+			return result;
+		}
+	}
+
+	// Load it both ways
+	cMeshBuilder builder;
+	std::vector<sSourceVertex> vertexData_native, vertexData_lua;
+	std::vector<uint32_t> indexData_native, indexData_lua;
+	if ( !( result = MeasureSecondsPerPass( builder, path, cMeshBuilder::eParser::Native, i_passCount,
+			vertexData_native, indexData_native, o_results.secondsPerPass_native ) )
+		|| !( result = MeasureSecondsPerPass( builder, path, cMeshBuilder::eParser::Lua, i_passCount,
+			vertexData_lua, indexData_lua, o_results.secondsPerPass_lua ) ) )
+	{
+		return result;
+	}
+	o_results.vertexCount = static_cast<uint32_t>( vertexData_native.size() );
+	o_results.indexCount = static_cast<uint32_t>( indexData_native.size() );
+
+	// Both ways must load exactly the same mesh
+	if ( ( vertexData_native.size() != vertexData_lua.size() ) || ( indexData_native.size() != indexData_lua.size() )
+		|| ( !vertexData_native.empty() && ( std::memcmp( vertexData_native.data(), vertexData_lua.data(), sizeof( vertexData_native[0] ) * vertexData_native.size() ) != 0 ) )
+		|| ( !indexData_native.empty() && ( std::memcmp( indexData_native.data(), indexData_lua.data(), sizeof( indexData_native[0] ) * indexData_native.size() ) != 0 ) ) )
+	{
+		result = Results::Failure;
+		EAE6320_ASSERTF( false, "The native parser and Lua loaded different meshes" );
+		OutputErrorMessageWithFileInfo( path.c_str(), "The native parser and Lua loaded different meshes" );
+		return result;
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Assets::MeshParsingBenchmark::RunAndOutput( const std::string& i_directory, const uint32_t i_vertexCount )
+{
+	sResults results;
+	const auto result = Run( i_directory, i_vertexCount, results );
+	if ( result )
+	{
+		std::ostringstream output;
+		output.setf( std::ios::fixed );
+		output.precision( 1 );
+		output << "Loading a mesh source file with " << results.vertexCount << " vertices and " << results.indexCount << " indices ("
+			<< ( static_cast<double>( results.fileByteCount ) / ( 1024.0 * 1024.0 ) ) << " MB): "
+			<< ( results.secondsPerPass_native * 1000.0 ) << " ms parsed natively, "
+			<< ( results.secondsPerPass_lua * 1000.0 ) << " ms run as Lua ("
+			<< ( ( results.secondsPerPass_native > 0.0 ) ? ( results.secondsPerPass_lua / results.secondsPerPass_native ) : 0.0 ) << " times faster)";
+		GetOutputStream() << output.str() << std::endl;
+	}
+	return result;
+}
+
+eae6320::cResult eae6320::Assets::MeshParsingBenchmark::RunAndOutputStandardSizes( const std::string& i_directory )
+{
+	auto result = Results::Success;
+	constexpr uint32_t vertexCounts[] = { 10000, 100000, 1000000 };
+	for ( const auto vertexCount : vertexCounts )
+	{
+		const auto result_size = RunAndOutput( i_directory, vertexCount );
+		if ( !result_size && result )
+		{
+			result = result_size;
+		}
+	}
+	return result;
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	std::string GenerateGridSource( const uint32_t i_sideVertexCount )
+	{
+		const auto vertexCount = i_sideVertexCount * i_sideVertexCount;
+		const auto quadCount = ( i_sideVertexCount - 1 ) * ( i_sideVertexCount - 1 );
+		std::string source;
+		source.reserve( ( static_cast<size_t>( vertexCount ) * 256 ) + ( static_cast<size_t>( quadCount ) * 64 ) );
+		char buffer[512];
+
+		std::snprintf( buffer, sizeof( buffer ), "return\n{\n    --vertexCount:%u\n    vertexData = \n    {\n", vertexCount );
+		source += buffer;
+		const auto scale = 1.0f / static_cast<float>( i_sideVertexCount - 1 );
+		for ( uint32_t row = 0; row < i_sideVertexCount; ++row )
+		{
+			for ( uint32_t column = 0; column < i_sideVertexCount; ++column )
+			{
+				// A gently rolling surface so that none of the elements are the same for every vertex
+				const auto u = static_cast<float>( column ) * scale;
+				const auto v = static_cast<float>( row ) * scale;
+				const auto x = ( u * 2.0f ) - 1.0f;
+				const auto z = ( v * 2.0f ) - 1.0f;
+				const auto y = 0.1f * std::sin( x * 6.0f ) * std::cos( z * 6.0f );
+				const auto slope_x = -0.6f * std::cos( x * 6.0f ) * std::cos( z * 6.0f );
+				const auto slope_z = 0.6f * std::sin( x * 6.0f ) * std::sin( z * 6.0f );
+				const auto normalLength = std::sqrt( ( slope_x * slope_x ) + 1.0f + ( slope_z * slope_z ) );
+				std::snprintf( buffer, sizeof( buffer ),
+					"        --vertexId:%u\n"
+					"        {\n"
+					"            position = {%f, %f, %f,},\n"
+					"            normal = {%f, %f, %f,},\n"
+					"            TexCoord = {%f, %f,},\n"
+					"            Color = {%f, %f, %f, %f,},\n"
+					"        },\n",
+					( row * i_sideVertexCount ) + column,
+					x, y, z,
+					slope_x / normalLength, 1.0f / normalLength, slope_z / normalLength,
+					u, 1.0f - v,
+					u, v, 1.0f - u, 1.0f );
+				source += buffer;
+			}
+		}
+		std::snprintf( buffer, sizeof( buffer ), "    },\n    --indexCount:%u\n    indexData = \n    {\n", quadCount * 6 );
+		source += buffer;
+		for ( uint32_t row = 0; ( row + 1 ) < i_sideVertexCount; ++row )
+		{
+			for ( uint32_t column = 0; ( column + 1 ) < i_sideVertexCount; ++column )
+			{
+				const auto i0 = ( row * i_sideVertexCount ) + column;
+				const auto i1 = i0 + i_sideVertexCount;
+				std::snprintf( buffer, sizeof( buffer ), "        %u, %u, %u, %u, %u, %u,\n", i0, i1 + 1, i0 + 1, i0, i1, i1 + 1 );
+				source += buffer;
+			}
+		}
+		source += "    },\n}\n";
+
+		return source;
+	}
+
+	eae6320::cResult MeasureSecondsPerPass( eae6320::Assets::cMeshBuilder& io_builder, const std::string& i_path,
+		const eae6320::Assets::cMeshBuilder::eParser i_parser, const unsigned int i_passCount,
+		std::vector<eae6320::Assets::sSourceVertex>& o_vertexData, std::vector<uint32_t>& o_indexData, double& o_secondsPerPass )
+	{
+		auto result = eae6320::Results::Success;
+		double secondCount = 0.0;
+		for ( unsigned int i = 0; i < i_passCount; ++i )
+		{
+			o_vertexData.clear();
+			o_indexData.clear();
+			// (each pass starts with empty arrays, the same as when a mesh is built)
+			o_vertexData.shrink_to_fit();
+			o_indexData.shrink_to_fit();
+			const auto time_start = std::chrono::steady_clock::now();
+			if ( !( result = io_builder.LoadSourceMesh( i_path.c_str(), i_parser, o_vertexData, o_indexData ) ) )
+			{
+				return result;
+			}
+			secondCount += std::chrono::duration<double>( std::chrono::steady_clock::now() - time_start ).count();
+		}
+		o_secondsPerPass = secondCount / static_cast<double>( i_passCount );
+		return result;
+	}
+}
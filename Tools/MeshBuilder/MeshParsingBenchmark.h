@@ -0,0 +1,59 @@
+/*
+	This benchmark measures how long it takes to load a mesh source file two ways:
+		* Native
+			(the file is parsed directly; see MeshSourceParser.h)
+		* Lua
+			(the file is run as Lua and the vertices and indices are read from the tables that it returns,
+			which is how meshes used to be loaded)
+
+	The meshes are generated grids whose vertices have every element
+	and are written the same way that exported meshes are,
+	and the benchmark also checks that both ways load exactly the same vertices and indices.
+	Each file is read once before either way is timed,
+	and so it measures loading from the file cache rather than from the disk.
+
+	It is run from the command line:
+		MeshBuilder.exe -benchmark <directory for the generated files> [vertex count]
+*/
+
+#ifndef EAE6320_MESHPARSINGBENCHMARK_H
+#define EAE6320_MESHPARSINGBENCHMARK_H
+
+// Includes
+//=========
+
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <string>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace MeshParsingBenchmark
+		{
+			struct sResults
+			{
+				uint32_t vertexCount = 0;
+				uint32_t indexCount = 0;
+				uint64_t fileByteCount = 0;
+				// The average time to load the file once
+				double secondsPerPass_native = 0.0;
+				double secondsPerPass_lua = 0.0;
+			};
+
+			// A grid with about i_vertexCount vertices is generated in the directory and is loaded i_passCount times each way.
+			// The result is a failure if either way fails or if they don't load the same mesh.
+			cResult Run( const std::string& i_directory, const uint32_t i_vertexCount, sResults& o_results, const unsigned int i_passCount = 3 );
+			// Runs and outputs the results
+			cResult RunAndOutput( const std::string& i_directory, const uint32_t i_vertexCount );
+			// Runs and outputs the results for meshes from ten thousand to a million vertices
+			cResult RunAndOutputStandardSizes( const std::string& i_directory );
+		}
+	}
+}
+
+#endif	// EAE6320_MESHPARSINGBENCHMARK_H
@@ -0,0 +1,547 @@
+// Includes
+//=========
+
+#include "MeshSourceParser.h"
+
+#include <charconv>
+#include <cstdint>
+#include <Engine/Asserts/Asserts.h>
+#include <sstream>
+#include <string_view>
+
+// Helper Class Declaration
+//=========================
+
+namespace
+{
+	// The parser is a single pass over the source:
+	// whitespace and comments are skipped before every token,
+	// and each function parses one level of the mesh table.
+	// The functions return false if the source uses something that isn't supported
+	// (and the reason has already been recorded).
+	class cParser
+	{
+		// Interface
+		//----------
+
+	public:
+
+		cParser( const char* const i_source, const size_t i_sourceSize, std::string* const o_unsupportedReason );
+
+		bool ParseFile( std::vector<eae6320::Assets::sSourceVertex>& o_vertexData, std::vector<uint32_t>& o_indexData );
+
+		// Data
+		//-----
+
+	private:
+
+		const char* m_current;
+		const char* const m_end;
+		unsigned int m_lineNumber = 1;
+		std::string* const m_unsupportedReason;
+
+		// Implementation
+		//---------------
+
+	private:
+
+		// Tables
+
+		bool ParseMeshTable( std::vector<eae6320::Assets::sSourceVertex>& o_vertexData, std::vector<uint32_t>& o_indexData );
+		bool ParseVertexData( std::vector<eae6320::Assets::sSourceVertex>& o_vertexData );
+		bool ParseVertex( eae6320::Assets::sSourceVertex& o_vertex );
+		// Missing values are zero and extra values are ignored (the same as when the file is run as Lua)
+		// (an element that isn't used (e.g. a tangent) is parsed with no values)
+		bool ParseVertexElement( float* const o_values, const unsigned int i_valueCount );
+		bool ParseIndexData( std::vector<uint32_t>& o_indexData );
+
+		// Tokens
+
+		void SkipWhitespaceAndComments();
+		// This is called after "--", and returns false if the comment isn't a long one
+		bool SkipLongComment();
+		// This returns false (without consuming anything) if the next token is a different character
+		bool ConsumeCharacter( const char i_character );
+		// A key is either a name or a quoted string in brackets, and is followed by '='
+		bool ParseKey( std::string_view& o_key );
+		bool ParseName( std::string_view& o_name );
+		bool ParseNumber( double& o_number );
+		// Every entry of a table is followed either by a separator or by the end of the table
+		bool ParseEndOfEntry( bool& o_isEndOfTable );
+
+		bool Unsupported( const char* const i_description );
+		bool Unsupported( const std::string& i_description ) { return Unsupported( i_description.c_str() ); }
+	};
+}
+
+// Interface
+//==========
+
+eae6320::cResult eae6320::Assets::MeshSourceParser::Parse( const char* const i_source, const size_t i_sourceSize,
+	std::vector<sSourceVertex>& o_vertexData, std::vector<uint32_t>& o_indexData, std::string* const o_unsupportedReason )
+{
+	EAE6320_ASSERT( i_source || ( i_sourceSize == 0 ) );
+
+	cParser parser( i_source, i_sourceSize, o_unsupportedReason );
+	if ( parser.ParseFile( o_vertexData, o_indexData ) )
+	{
+		return Results::Success;
+	}
+	else
+	{
+		o_vertexData.clear();
+		o_indexData.clear();
+		return Results::Failure;
+	}
+}
+
+// Helper Class Definition
+//========================
+
+namespace
+{
+	// Interface
+	//----------
+
+	cParser::cParser( const char* const i_source, const size_t i_sourceSize, std::string* const o_unsupportedReason )
+		:
+		m_current( i_source ), m_end( i_source + i_sourceSize ), m_unsupportedReason( o_unsupportedReason )
+	{
+
+	}
+
+	bool cParser::ParseFile( std::vector<eae6320::Assets::sSourceVertex>& o_vertexData, std::vector<uint32_t>& o_indexData )
+	{
+		{
+			SkipWhitespaceAndComments();
+			std::string_view keyword;
+			if ( !ParseName( keyword ) || ( keyword != "return" ) )
+			{
+				return Unsupported( "The file must start by returning a table" );
+			}
+		}
+		if ( !ParseMeshTable( o_vertexData, o_indexData ) )
+		{
+			return false;
+		}
+		// (a return statement can optionally end with a semicolon)
+		ConsumeCharacter( ';' );
+		SkipWhitespaceAndComments();
+		if ( m_current != m_end )
+		{
+			return Unsupported( "There must be nothing after the returned table" );
+		}
+		return true;
+	}
+
+	// Implementation
+	//---------------
+
+	// Tables
+
+	bool cParser::ParseMeshTable( std::vector<eae6320::Assets::sSourceVertex>& o_vertexData, std::vector<uint32_t>& o_indexData )
+	{
+		if ( !ConsumeCharacter( '{' ) )
+		{
+			return Unsupported( "The file must return a table" );
+		}
+		auto hasVertexData = false;
+		auto hasIndexData = false;
+		auto isEndOfTable = ConsumeCharacter( '}' );
+		while ( !isEndOfTable )
+		{
+			std::string_view key;
+			if ( !ParseKey( key ) )
+			{
+				return false;
+			}
+			if ( key == "vertexData" )
+			{
+				if ( !ParseVertexData( o_vertexData ) )
+				{
+					return false;
+				}
+				hasVertexData = true;
+			}
+			else if ( key == "indexData" )
+			{
+				if ( !ParseIndexData( o_indexData ) )
+				{
+					return false;
+				}
+				hasIndexData = true;
+			}
+			else
+			{
+				return Unsupported( "The key \"" + std::string( key ) + "\" isn't part of a mesh" );
+			}
+			if ( !ParseEndOfEntry( isEndOfTable ) )
+			{
+				return false;
+			}
+		}
+		if ( !hasVertexData )
+		{
+			return Unsupported( "The mesh doesn't have any vertexData" );
+		}
+		if ( !hasIndexData )
+		{
+			return Unsupported( "The mesh doesn't have any indexData" );
+		}
+		return true;
+	}
+
+	bool cParser::ParseVertexData( std::vector<eae6320::Assets::sSourceVertex>& o_vertexData )
+	{
+		// (if the key is repeated the last table is used)
+		o_vertexData.clear();
+		if ( !ConsumeCharacter( '{' ) )
+		{
+			return Unsupported( "The vertexData must be a table" );
+		}
+		auto isEndOfTable = ConsumeCharacter( '}' );
+		while ( !isEndOfTable )
+		{
+			o_vertexData.emplace_back();
+			if ( !ParseVertex( o_vertexData.back() ) || !ParseEndOfEntry( isEndOfTable ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool cParser::ParseVertex( eae6320::Assets::sSourceVertex& o_vertex )
+	{
+		if ( !ConsumeCharacter( '{' ) )
+		{
+			return Unsupported( "Every vertex must be a table" );
+		}
+		auto hasPosition = false;
+		auto isEndOfTable = ConsumeCharacter( '}' );
+		while ( !isEndOfTable )
+		{
+			std::string_view key;
+			if ( !ParseKey( key ) )
+			{
+				return false;
+			}
+			auto wasElementParsed = false;
+			if ( key == "position" )
+			{
+				wasElementParsed = ParseVertexElement( &o_vertex.x, 3 );
+				hasPosition = true;
+			}
+			else if ( key == "normal" )
+			{
+				wasElementParsed = ParseVertexElement( &o_vertex.nx, 3 );
+			}
+			else if ( key == "TexCoord" )
+			{
+				wasElementParsed = ParseVertexElement( &o_vertex.u, 2 );
+			}
+			else if ( key == "Color" )
+			{
+				wasElementParsed = ParseVertexElement( &o_vertex.r, 4 );
+			}
+			else
+			{
+				// Other elements that exporters write (e.g. Tangent and Bitangent) are ignored when the file is run as Lua,
+				// and as long as they are lists of numbers they can be skipped
+				wasElementParsed = ParseVertexElement( nullptr, 0 );
+			}
+			if ( !wasElementParsed || !ParseEndOfEntry( isEndOfTable ) )
+			{
+				return false;
+			}
+		}
+		if ( !hasPosition )
+		{
+			return Unsupported( "Every vertex must have a position" );
+		}
+		return true;
+	}
+
+	bool cParser::ParseVertexElement( float* const o_values, const unsigned int i_valueCount )
+	{
+		if ( !ConsumeCharacter( '{' ) )
+		{
+			return Unsupported( "Every vertex element must be a table" );
+		}
+		unsigned int valueCount = 0;
+		auto isEndOfTable = ConsumeCharacter( '}' );
+		while ( !isEndOfTable )
+		{
+			double value;
+			if ( !ParseNumber( value ) )
+			{
+				return false;
+			}
+			if ( valueCount < i_valueCount )
+			{
+				o_values[valueCount] = static_cast<float>( value );
+			}
+			++valueCount;
+			if ( !ParseEndOfEntry( isEndOfTable ) )
+			{
+				return false;
+			}
+		}
+		for ( ; valueCount < i_valueCount; ++valueCount )
+		{
+			o_values[valueCount] = 0.0f;
+		}
+		return true;
+	}
+
+	bool cParser::ParseIndexData( std::vector<uint32_t>& o_indexData )
+	{
+		o_indexData.clear();
+		if ( !ConsumeCharacter( '{' ) )
+		{
+			return Unsupported( "The indexData must be a table" );
+		}
+		auto isEndOfTable = ConsumeCharacter( '}' );
+		while ( !isEndOfTable )
+		{
+			double index;
+			if ( !ParseNumber( index ) )
+			{
+				return false;
+			}
+			// (anything that can't be an index is left for Lua to report)
+			if ( ( index < 0.0 ) || ( index > static_cast<double>( UINT32_MAX ) ) || ( index != static_cast<double>( static_cast<uint32_t>( index ) ) ) )
+			{
+				return Unsupported( "Every index must be a whole number that fits in 32 bits" );
+			}
+			o_indexData.push_back( static_cast<uint32_t>( index ) );
+			if ( !ParseEndOfEntry( isEndOfTable ) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Tokens
+
+	void cParser::SkipWhitespaceAndComments()
+	{
+		while ( m_current < m_end )
+		{
+			const auto character = *m_current;
+			if ( character == '\n' )
+			{
+				++m_lineNumber;
+				++m_current;
+			}
+			else if ( ( character == ' ' ) || ( character == '\t' ) || ( character == '\r' ) || ( character == '\v' ) || ( character == '\f' ) )
+			{
+				++m_current;
+			}
+			else if ( ( character == '-' ) && ( ( m_current + 1 ) < m_end ) && ( m_current[1] == '-' ) )
+			{
+				m_current += 2;
+				if ( !SkipLongComment() )
+				{
+					// A short comment continues until the end of the line
+					while ( ( m_current < m_end ) && ( *m_current != '\n' ) )
+					{
+						++m_current;
+					}
+				}
+			}
+			else
+			{
+				return;
+			}
+		}
+	}
+
+	bool cParser::SkipLongComment()
+	{
+		// A long comment starts with "[[" with any number of '=' between the brackets
+		// and ends with "]]" with the same number of '='
+		if ( ( m_current >= m_end ) || ( *m_current != '[' ) )
+		{
+			return false;
+		}
+		auto* const equalSigns = m_current + 1;
+		auto* afterEqualSigns = equalSigns;
+		while ( ( afterEqualSigns < m_end ) && ( *afterEqualSigns == '=' ) )
+		{
+			++afterEqualSigns;
+		}
+		if ( ( afterEqualSigns >= m_end ) || ( *afterEqualSigns != '[' ) )
+		{
+			return false;
+		}
+		const auto equalSignCount = static_cast<size_t>( afterEqualSigns - equalSigns );
+		m_current = afterEqualSigns + 1;
+		while ( m_current < m_end )
+		{
+			const auto character = *m_current++;
+			if ( character == '\n' )
+			{
+				++m_lineNumber;
+			}
+			else if ( character == ']' )
+			{
+				auto* closingBracket = m_current;
+				while ( ( closingBracket < m_end ) && ( *closingBracket == '=' ) )
+				{
+					++closingBracket;
+				}
+				if ( ( static_cast<size_t>( closingBracket - m_current ) == equalSignCount ) && ( closingBracket < m_end ) && ( *closingBracket == ']' ) )
+				{
+					m_current = closingBracket + 1;
+					return true;
+				}
+			}
+		}
+		// An unfinished comment is left for Lua to report
+		// (the parser will fail because the file ends)
+		return true;
+	}
+
+	bool cParser::ConsumeCharacter( const char i_character )
+	{
+		SkipWhitespaceAndComments();
+		if ( ( m_current < m_end ) && ( *m_current == i_character ) )
+		{
+			++m_current;
+			return true;
+		}
+		return false;
+	}
+
+	bool cParser::ParseKey( std::string_view& o_key )
+	{
+		SkipWhitespaceAndComments();
+		if ( ConsumeCharacter( '[' ) )
+		{
+			// Only plain strings are supported (without any escape sequences)
+			SkipWhitespaceAndComments();
+			if ( ( m_current >= m_end ) || ( ( *m_current != '"' ) && ( *m_current != '\'' ) ) )
+			{
+				return Unsupported( "Only strings are supported as keys in brackets" );
+			}
+			const auto quote = *m_current++;
+			const auto* const keyStart = m_current;
+			while ( ( m_current < m_end ) && ( *m_current != quote ) )
+			{
+				if ( ( *m_current == '\\' ) || ( *m_current == '\n' ) )
+				{
+					return Unsupported( "Keys with escape sequences aren't supported" );
+				}
+				++m_current;
+			}
+			if ( m_current >= m_end )
+			{
+				return Unsupported( "A key isn't finished" );
+			}
+			o_key = std::string_view( keyStart, static_cast<size_t>( m_current - keyStart ) );
+			++m_current;
+			if ( !ConsumeCharacter( ']' ) )
+			{
+				return Unsupported( "A key in brackets must be followed by ']'" );
+			}
+		}
+		else if ( !ParseName( o_key ) )
+		{
+			return Unsupported( "Only keys and values are supported in this table" );
+		}
+		if ( !ConsumeCharacter( '=' ) )
+		{
+			return Unsupported( "The key \"" + std::string( o_key ) + "\" must be followed by '='" );
+		}
+		return true;
+	}
+
+	bool cParser::ParseName( std::string_view& o_name )
+	{
+		const auto isNameStart = []( const char i_character )
+		{
+			return ( ( i_character >= 'a' ) && ( i_character <= 'z' ) ) || ( ( i_character >= 'A' ) && ( i_character <= 'Z' ) ) || ( i_character == '_' );
+		};
+		if ( ( m_current >= m_end ) || !isNameStart( *m_current ) )
+		{
+			return false;
+		}
+		const auto* const nameStart = m_current;
+		while ( ( m_current < m_end ) && ( isNameStart( *m_current ) || ( ( *m_current >= '0' ) && ( *m_current <= '9' ) ) ) )
+		{
+			++m_current;
+		}
+		o_name = std::string_view( nameStart, static_cast<size_t>( m_current - nameStart ) );
+		return true;
+	}
+
+	bool cParser::ParseNumber( double& o_number )
+	{
+		SkipWhitespaceAndComments();
+		auto isNegative = false;
+		if ( ( m_current < m_end ) && ( *m_current == '-' ) )
+		{
+			isNegative = true;
+			++m_current;
+			SkipWhitespaceAndComments();
+		}
+		if ( ( m_current >= m_end ) || !( ( ( *m_current >= '0' ) && ( *m_current <= '9' ) ) || ( *m_current == '.' ) ) )
+		{
+			return Unsupported( "Only numbers are supported as values in this table" );
+		}
+		if ( ( *m_current == '0' ) && ( ( m_current + 1 ) < m_end ) && ( ( m_current[1] == 'x' ) || ( m_current[1] == 'X' ) ) )
+		{
+			return Unsupported( "Hexadecimal numbers aren't supported" );
+		}
+		// The number is converted to a double (correctly rounded) the same as when Lua converts it
+		double number;
+		const auto conversion = std::from_chars( m_current, m_end, number );
+		if ( conversion.ec != std::errc() )
+		{
+			return Unsupported( "A number couldn't be converted" );
+		}
+		m_current = conversion.ptr;
+		if ( m_current < m_end )
+		{
+			const auto character = *m_current;
+			if ( ( ( character >= 'a' ) && ( character <= 'z' ) ) || ( ( character >= 'A' ) && ( character <= 'Z' ) )
+				|| ( ( character >= '0' ) && ( character <= '9' ) ) || ( character == '_' ) || ( character == '.' ) )
+			{
+				return Unsupported( "A number is malformed" );
+			}
+		}
+		o_number = isNegative ? -number : number;
+		return true;
+	}
+
+	bool cParser::ParseEndOfEntry( bool& o_isEndOfTable )
+	{
+		if ( ConsumeCharacter( ',' ) || ConsumeCharacter( ';' ) )
+		{
+			o_isEndOfTable = ConsumeCharacter( '}' );
+			return true;
+		}
+		else if ( ConsumeCharacter( '}' ) )
+		{
+			o_isEndOfTable = true;
+			return true;
+		}
+		else
+		{
+			return Unsupported( "Every entry in a table must be followed by a separator or the end of the table" );
+		}
+	}
+
+	bool cParser::Unsupported( const char* const i_description )
+	{
+		if ( m_unsupportedReason )
+		{
+			std::ostringstream reason;
+			reason << i_description << " (line " << m_lineNumber << ")";
+			*m_unsupportedReason = reason.str();
+		}
+		return false;
+	}
+}
@@ -0,0 +1,66 @@
+/*
+	This parses mesh source files without running them as Lua
+
+	Mesh source files are Lua, but the ones that are exported only use a small subset of it:
+		return
+		{
+			vertexData =
+			{
+				{
+					position = { 0.0, 1.0, 0.0 },
+					normal = { 0.0, 0.0, 1.0 },
+					TexCoord = { 0.0, 1.0 },
+					Color = { 1.0, 1.0, 1.0, 1.0 },
+				},
+				...
+			},
+			indexData = { 0, 2, 3, ... },
+		}
+	(with comments, either separator, and any of the optional vertex elements missing;
+	other vertex elements like Tangent are skipped because they aren't used).
+	The parser reads the file once straight from memory
+	and converts each number directly into the vertex or index that it belongs to,
+	instead of creating a Lua table for every vertex and element and then reading them back one at a time.
+
+	The numbers are converted the same way that Lua converts them
+	(to a double, which is then cast to a float or an index),
+	and so a file that is parsed gives exactly the same mesh as when it is run as Lua.
+	If a file uses anything outside of the subset (e.g. variables, expressions, or other keys in the mesh table)
+	then parsing fails with a description of what wasn't supported
+	and the file should be run as Lua instead
+	(which is also what reports the errors of files that aren't valid).
+*/
+
+#ifndef EAE6320_MESHSOURCEPARSER_H
+#define EAE6320_MESHSOURCEPARSER_H
+
+// Includes
+//=========
+
+#include "VertexQuantization.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <Engine/Results/Results.h>
+#include <string>
+#include <vector>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		namespace MeshSourceParser
+		{
+			// If the file can't be parsed then the reason (with the line number) is returned in o_unsupportedReason
+			// and the vertices and indices should be ignored
+			cResult Parse( const char* const i_source, const size_t i_sourceSize,
+				std::vector<sSourceVertex>& o_vertexData, std::vector<uint32_t>& o_indexData,
+				std::string* const o_unsupportedReason = nullptr );
+		}
+	}
+}
+
+#endif	// EAE6320_MESHSOURCEPARSER_H
@@ -0,0 +1,152 @@
+// Includes
+//=========
+
+#include "VertexQuantization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	uint16_t QuantizeUnorm16( const float i_value );
+	int16_t QuantizeSnorm16( const float i_value );
+	uint8_t QuantizeUnorm8( const float i_value );
+	// This must match DecodeOctahedralNormal() in shaders.inc
+	void EncodeOctahedralNormal( const float i_x, const float i_y, const float i_z, int16_t& o_x, int16_t& o_y );
+	// IEEE 754 binary16, rounded to nearest
+	uint16_t ConvertToHalf( const float i_value );
+}
+
+// Interface
+//==========
+
+void eae6320::Assets::VertexQuantization::Quantize( const sSourceVertex* const i_vertices, const uint32_t i_vertexCount,
+	const Graphics::MeshFormats::sBounds& i_bounds, Graphics::VertexFormats::sVertex_mesh* const o_vertices )
+{
+	// A box that is flat along an axis stores zeros for that axis
+	// (the run-time scale is also zero, and so every vertex ends up on the box's side)
+	float scales[3];
+	for ( int i = 0; i < 3; ++i )
+	{
+		const auto extent = i_bounds.aabbMax[i] - i_bounds.aabbMin[i];
+		EAE6320_ASSERT( extent >= 0.0f );
+		scales[i] = ( extent > 0.0f ) ? ( 1.0f / extent ) : 0.0f;
+	}
+	for ( uint32_t i = 0; i < i_vertexCount; ++i )
+	{
+		const auto& vertex_source = i_vertices[i];
+		auto& vertex = o_vertices[i];
+		vertex.x = QuantizeUnorm16( ( vertex_source.x - i_bounds.aabbMin[0] ) * scales[0] );
+		vertex.y = QuantizeUnorm16( ( vertex_source.y - i_bounds.aabbMin[1] ) * scales[1] );
+		vertex.z = QuantizeUnorm16( ( vertex_source.z - i_bounds.aabbMin[2] ) * scales[2] );
+		vertex.w = 0;
+		EncodeOctahedralNormal( vertex_source.nx, vertex_source.ny, vertex_source.nz, vertex.nx, vertex.ny );
+		vertex.u = ConvertToHalf( vertex_source.u );
+		vertex.v = ConvertToHalf( vertex_source.v );
+		vertex.r = QuantizeUnorm8( vertex_source.r );
+		vertex.g = QuantizeUnorm8( vertex_source.g );
+		vertex.b = QuantizeUnorm8( vertex_source.b );
+		vertex.a = QuantizeUnorm8( vertex_source.a );
+	}
+}
+
+float eae6320::Assets::VertexQuantization::CalculateMaxPositionError( const Graphics::MeshFormats::sBounds& i_bounds )
+{
+	float longestExtent = 0.0f;
+	for ( int i = 0; i < 3; ++i )
+	{
+		longestExtent = std::max( longestExtent, i_bounds.aabbMax[i] - i_bounds.aabbMin[i] );
+	}
+	return ( 0.5f * longestExtent ) / Graphics::VertexFormats::positionQuantizationMax;
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	uint16_t QuantizeUnorm16( const float i_value )
+	{
+		const auto clamped = std::min( std::max( i_value, 0.0f ), 1.0f );
+		return static_cast<uint16_t>( std::lround( clamped * 65535.0f ) );
+	}
+
+	int16_t QuantizeSnorm16( const float i_value )
+	{
+		const auto clamped = std::min( std::max( i_value, -1.0f ), 1.0f );
+		return static_cast<int16_t>( std::lround( clamped * 32767.0f ) );
+	}
+
+	uint8_t QuantizeUnorm8( const float i_value )
+	{
+		const auto clamped = std::min( std::max( i_value, 0.0f ), 1.0f );
+		return static_cast<uint8_t>( std::lround( clamped * 255.0f ) );
+	}
+
+	void EncodeOctahedralNormal( const float i_x, const float i_y, const float i_z, int16_t& o_x, int16_t& o_y )
+	{
+		// The normal is projected onto the octahedron |x| + |y| + |z| = 1
+		const auto length = std::abs( i_x ) + std::abs( i_y ) + std::abs( i_z );
+		if ( length <= 0.0f )
+		{
+			// A missing normal points back (which is what (0, 0) decodes to)
+			o_x = o_y = 0;
+			return;
+		}
+		auto x = i_x / length;
+		auto y = i_y / length;
+		// The bottom half of the octahedron is folded over the top half's corners
+		if ( i_z < 0.0f )
+		{
+			const auto x_folded = ( 1.0f - std::abs( y ) ) * ( ( x >= 0.0f ) ? 1.0f : -1.0f );
+			const auto y_folded = ( 1.0f - std::abs( x ) ) * ( ( y >= 0.0f ) ? 1.0f : -1.0f );
+			x = x_folded;
+			y = y_folded;
+		}
+		o_x = QuantizeSnorm16( x );
+		o_y = QuantizeSnorm16( y );
+	}
+
+	uint16_t ConvertToHalf( const float i_value )
+	{
+		uint32_t bits;
+		static_assert( sizeof( bits ) == sizeof( i_value ), "A float must be 32 bits" );
+		memcpy( &bits, &i_value, sizeof( bits ) );
+		const auto sign = static_cast<uint16_t>( ( bits >> 16 ) & 0x8000 );
+		const auto magnitude = bits & 0x7fffffff;
+		// NaN stays NaN
+		if ( magnitude > 0x7f800000 )
+		{
+			return static_cast<uint16_t>( sign | 0x7e00 );
+		}
+		const auto exponent = static_cast<int>( magnitude >> 23 ) - 127 + 15;
+		// Numbers that are too big for a half (including infinity) become infinity
+		if ( exponent >= 31 )
+		{
+			return static_cast<uint16_t>( sign | 0x7c00 );
+		}
+		auto mantissa = magnitude & 0x007fffff;
+		if ( exponent <= 0 )
+		{
+			// Numbers that are too small for a half's smallest denormal become zero
+			if ( exponent < -10 )
+			{
+				return sign;
+			}
+			// Denormals have an explicit leading 1
+			mantissa |= 0x00800000;
+			const auto shift = static_cast<uint32_t>( 14 - exponent );
+			const auto roundingBit = ( mantissa >> ( shift - 1 ) ) & 1;
+			return static_cast<uint16_t>( sign | ( ( mantissa >> shift ) + roundingBit ) );
+		}
+		// If rounding carries out of the mantissa it correctly increments the exponent
+		// (and the largest values correctly round to infinity)
+		const auto roundingBit = ( mantissa >> 12 ) & 1;
+		return static_cast<uint16_t>( sign | ( ( ( static_cast<uint32_t>( exponent ) << 10 ) | ( mantissa >> 13 ) ) + roundingBit ) );
+	}
+}
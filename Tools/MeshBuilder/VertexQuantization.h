@@ -0,0 +1,56 @@
+/*
+	These functions convert the vertices that are read from a mesh's source file
+	to the compact format that is stored in the binary mesh file (see VertexFormats::sVertex_mesh)
+
+	The vertices are kept at full precision while the mesh is built
+	(the optimizations and the bounds use the authored positions)
+	and are only quantized when the file is written:
+		* Positions are 16 bit normalized fractions of the mesh's bounding box
+		* Normals are octahedral-encoded as two 16 bit normalized values
+		* Texture coordinates are half floats
+		* Colors are 8 bit normalized values
+*/
+
+#ifndef EAE6320_VERTEXQUANTIZATION_H
+#define EAE6320_VERTEXQUANTIZATION_H
+
+// Includes
+//=========
+
+#include <cstdint>
+#include <Engine/Graphics/MeshFormats.h>
+#include <Engine/Graphics/VertexFormats.h>
+
+// Interface
+//==========
+
+namespace eae6320
+{
+	namespace Assets
+	{
+		// A vertex as it is authored
+		// (the elements other than the position are optional in the source file,
+		// and these are the values that are used when they are missing)
+		struct sSourceVertex
+		{
+			float x = 0.0f, y = 0.0f, z = 0.0f;
+			float nx = 0.0f, ny = 0.0f, nz = 1.0f;
+			float u = 0.0f, v = 0.0f;
+			float r = 1.0f, g = 1.0f, b = 1.0f, a = 1.0f;
+		};
+
+		namespace VertexQuantization
+		{
+			// The bounding box must contain every vertex
+			// (the run-time mesh converts the positions back using the same box)
+			void Quantize( const sSourceVertex* const i_vertices, const uint32_t i_vertexCount, const Graphics::MeshFormats::sBounds& i_bounds,
+				Graphics::VertexFormats::sVertex_mesh* const o_vertices );
+
+			// The largest distance that a quantized position can be from the authored one
+			// (this is half of a quantization step along the longest side of the box)
+			float CalculateMaxPositionError( const Graphics::MeshFormats::sBounds& i_bounds );
+		}
+	}
+}
+
+#endif	// EAE6320_VERTEXQUANTIZATION_H
@@ -1,11 +1,37 @@
 #include "cMeshBuilder.h"
+#include "MeshOptimization.h"
+#include "MeshSourceParser.h"
 #include <Tools/AssetBuildLibrary/Functions.h>
+#include <Engine/Graphics/MeshCompression.h>
+#include <Engine/Graphics/MeshFormats.h>
 #include <Engine/Graphics/VertexFormats.h>
 #include <Engine/Platform/Platform.h>
 #include <Engine/ScopeGuard/cScopeGuard.h>
 #include <Engine/Asserts/Asserts.h>
 #include <Engine/Time/Time.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	eae6320::Graphics::MeshFormats::sBounds CalculateBounds(const eae6320::Assets::sSourceVertex* const i_vertexData, const uint32_t i_vertexCount);
+	// The indices are stored as 32 bits while they are loaded
+	// and are narrowed to the size that the file uses when they are written
+	void WriteIndices(std::ofstream& io_file, const uint32_t* const i_indexData, const uint32_t i_indexCount, const uint16_t i_indexSize);
+	// Decodes the compressed sections and compares them with the data that was encoded
+	// (the data that was encoded is what would have been written to an uncompressed file)
+	bool DoCompressedSectionsMatch(const std::vector<uint8_t>& i_vertexSection, const std::vector<uint8_t>& i_indexSection,
+		const std::vector<eae6320::Graphics::VertexFormats::sVertex_mesh>& i_vertexData,
+		const uint32_t* const i_indexData, const uint32_t i_indexCount, const uint16_t i_indexSize);
+}
 
 eae6320::cResult eae6320::Assets::cMeshBuilder::Build(const std::vector<std::string>& i_arguments)
 {
@@ -13,49 +39,223 @@ eae6320::cResult eae6320::Assets::cMeshBuilder::Build(const std::vector<std::str
 
 	std::string* errorMessage = nullptr;
 
+	// Meshes are compressed unless they are built with the "uncompressed" argument
+	auto encoding = Graphics::MeshFormats::eEncoding::Compressed;
+	// Mesh files are only run as Lua if they can't be parsed directly
+	// unless they are built with the "lua" argument
+	auto parser = eParser::Native;
+	for (const auto& argument : i_arguments)
+	{
+		if (argument == "uncompressed")
+		{
+			encoding = Graphics::MeshFormats::eEncoding::Raw;
+		}
+		else if (argument == "lua")
+		{
+			parser = eParser::Lua;
+		}
+		else
+		{
+			OutputErrorMessageWithFileInfo(m_path_source, "\"%s\" is not a valid mesh argument", argument.c_str());
+			return Results::Failure;
+		}
+	}
+
 	//result = eae6320::Platform::CopyFile(m_path_source, m_path_target, false, true, errorMessage);
-	result = LuaToBinary(m_path_source, m_path_target);
+	result = LuaToBinary(m_path_source, m_path_target, encoding, parser);
 
 	if (!result.IsSuccess() && errorMessage != nullptr) OutputErrorMessageWithFileInfo(m_path_source, errorMessage->c_str());
 
 	return result;
 }
 
-eae6320::cResult eae6320::Assets::cMeshBuilder::LuaToBinary(const char* const i_path_source, const char* const i_path_target)
+eae6320::cResult eae6320::Assets::cMeshBuilder::LuaToBinary(const char* const i_path_source, const char* const i_path_target,
+	const Graphics::MeshFormats::eEncoding i_encoding, const eParser i_parser)
 {
 	auto result = Results::Success;
 
 	//Load mesh data from lua file
-	eae6320::Graphics::VertexFormats::sVertex_mesh* vertexData = nullptr;
-	uint16_t* indexData = nullptr;
-	uint16_t vertexCount = 0;
-	uint16_t indexCount = 0;
-
-	if (!(result = LoadMeshFromFile(i_path_source, vertexData, indexData, vertexCount, indexCount)))
+	std::vector<sSourceVertex> sourceVertexData;
+	std::vector<uint32_t> sourceIndexData;
+	if (!(result = LoadSourceMesh(i_path_source, i_parser, sourceVertexData, sourceIndexData)))
 	{
 		//EAE6320_ASSERTF(false, "Load mesh data failed");
 		OutputErrorMessageWithFileInfo(m_path_source, "Load mesh data failed");
 		return result;
 	}
+	auto* const vertexData = sourceVertexData.data();
+	auto* const indexData = sourceIndexData.data();
+	auto vertexCount = static_cast<uint32_t>(sourceVertexData.size());
+	const auto indexCount = static_cast<uint32_t>(sourceIndexData.size());
+
+	// The mesh is drawn as a triangle list
+	// (the optimizations below and the engine both assume that every triangle has three indices)
+	if ((indexCount % 3) != 0)
+	{
+		result = eae6320::Results::InvalidFile;
+		const auto errorMessage = "There are " + std::to_string(indexCount)
+			+ " indices but a triangle list must have a multiple of 3";
+		OutputErrorMessageWithFileInfo(m_path_source, errorMessage.c_str());
+		return result;
+	}
+	// Every index must refer to a vertex
+	// (the narrowest index size is chosen from the vertex count)
+	for (uint32_t i = 0; i < indexCount; ++i)
+	{
+		if (indexData[i] >= vertexCount)
+		{
+			result = eae6320::Results::InvalidFile;
+			const auto errorMessage = "Index " + std::to_string(i) + " is " + std::to_string(indexData[i])
+				+ " but there are only " + std::to_string(vertexCount) + " vertices";
+			OutputErrorMessageWithFileInfo(m_path_source, errorMessage.c_str());
+			return result;
+		}
+	}
+
+	// Reorder the triangles and vertices so that the GPU does less work drawing the mesh
+	// (this doesn't change what the mesh looks like; see MeshOptimization.h)
+	{
+		const auto statistics_source = MeshOptimization::AnalyzeVertexCache(indexData, indexCount, vertexCount);
+		MeshOptimization::OptimizeTriangleOrder(indexData, indexCount, vertexData, vertexCount);
+		vertexCount = MeshOptimization::OptimizeVertexFetch(vertexData, vertexCount, indexData, indexCount);
+		const auto statistics_optimized = MeshOptimization::AnalyzeVertexCache(indexData, indexCount, vertexCount);
+		GetOutputStream() << m_path_source << ": ACMR " << statistics_source.acmr << " -> " << statistics_optimized.acmr
+			<< ", ATVR " << statistics_source.atvr << " -> " << statistics_optimized.atvr
+			<< " (" << vertexCount << " vertices, " << (indexCount / 3) << " triangles)" << std::endl;
+	}
+
+#if defined( EAE6320_PLATFORM_GL )
+	// OpenGL uses the opposite winding order from Direct3D,
+	// and so it is converted here instead of at run time
+	// (the engine gives the graphics API the indices straight from the file)
+	for (uint32_t i = 0; (i + 2) < indexCount; i += 3)
+	{
+		std::swap(indexData[i + 1], indexData[i + 2]);
+	}
+#endif
+
+	// The sections are aligned so that the file can be used directly from memory (see MeshFormats.h)
+	eae6320::Graphics::MeshFormats::sHeader header;
+	header.vertexCount = vertexCount;
+	header.indexCount = indexCount;
+	header.indexSize = eae6320::Graphics::MeshFormats::SelectIndexSize(vertexCount);
+	header.encoding = i_encoding;
+	const auto vertexDataSize = static_cast<uint32_t>(sizeof(eae6320::Graphics::VertexFormats::sVertex_mesh) * vertexCount);
+	const auto indexDataSize = static_cast<uint32_t>(header.indexSize * indexCount);
+	// The bounds are used for culling at run time
+	// and to convert the quantized positions back to local space
+	header.bounds = CalculateBounds(vertexData, vertexCount);
+
+	// The vertices are quantized last so that everything else uses the authored values
+	std::vector<eae6320::Graphics::VertexFormats::sVertex_mesh> quantizedVertexData(vertexCount);
+	VertexQuantization::Quantize(vertexData, vertexCount, header.bounds, quantizedVertexData.data());
+	GetOutputStream() << m_path_source << ": " << sizeof(quantizedVertexData[0]) << " bytes per vertex instead of " << sizeof(*vertexData)
+		<< " (positions are within " << VertexQuantization::CalculateMaxPositionError(header.bounds) << " of the authored ones)" << std::endl;
+
+	// The compressed sections are checked before they are written
+	// so that a mesh that can't be decoded exactly fails to build instead of failing to load
+	std::vector<uint8_t> vertexSection, indexSection;
+	if (i_encoding == eae6320::Graphics::MeshFormats::eEncoding::Compressed)
+	{
+		eae6320::Graphics::MeshCompression::EncodeVertices(quantizedVertexData.data(), vertexCount, vertexSection);
+		eae6320::Graphics::MeshCompression::EncodeIndices(indexData, indexCount, indexSection);
+		if (!DoCompressedSectionsMatch(vertexSection, indexSection, quantizedVertexData, indexData, indexCount, header.indexSize))
+		{
+			OutputErrorMessageWithFileInfo(m_path_source, "The compressed mesh doesn't decode to the same data that was encoded");
+			return eae6320::Results::Failure;
+		}
+		header.vertexSectionSize = static_cast<uint32_t>(vertexSection.size());
+		header.indexSectionSize = static_cast<uint32_t>(indexSection.size());
+		const auto compressedSize = vertexSection.size() + indexSection.size();
+		const auto uncompressedSize = static_cast<uint64_t>(vertexDataSize) + indexDataSize;
+		GetOutputStream() << m_path_source << ": Compressed the geometry from " << uncompressedSize << " to " << compressedSize << " bytes ("
+			<< ((compressedSize > 0) ? (static_cast<double>(uncompressedSize) / static_cast<double>(compressedSize)) : 1.0) << ":1)" << std::endl;
+	}
+	else
+	{
+		header.vertexSectionSize = vertexDataSize;
+		header.indexSectionSize = indexDataSize;
+	}
+	header.vertexOffset = eae6320::Graphics::MeshFormats::AlignSectionOffset(static_cast<uint32_t>(sizeof(header)));
+	header.indexOffset = eae6320::Graphics::MeshFormats::AlignSectionOffset(header.vertexOffset + header.vertexSectionSize);
 
 	std::ofstream targetFile(i_path_target, std::ios::out | std::ios::binary);
 
-	targetFile.write(reinterpret_cast<char*>(&vertexCount), sizeof(vertexCount));
-	targetFile.write(reinterpret_cast<char*>(&indexCount), sizeof(indexCount));
-	targetFile.write(reinterpret_cast<char*>(vertexData), sizeof(*vertexData) * static_cast<uint64_t>(vertexCount));
-	targetFile.write(reinterpret_cast<char*>(indexData), sizeof(*indexData) * static_cast<uint64_t>(indexCount));
+	constexpr char padding[eae6320::Graphics::MeshFormats::sectionAlignment] = {};
+	targetFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	targetFile.write(padding, header.vertexOffset - sizeof(header));
+	if (i_encoding == eae6320::Graphics::MeshFormats::eEncoding::Compressed)
+	{
+		targetFile.write(reinterpret_cast<const char*>(vertexSection.data()), vertexSection.size());
+		targetFile.write(padding, header.indexOffset - (header.vertexOffset + header.vertexSectionSize));
+		targetFile.write(reinterpret_cast<const char*>(indexSection.data()), indexSection.size());
+	}
+	else
+	{
+		targetFile.write(reinterpret_cast<const char*>(quantizedVertexData.data()), vertexDataSize);
+		targetFile.write(padding, header.indexOffset - (header.vertexOffset + vertexDataSize));
+		WriteIndices(targetFile, indexData, indexCount, header.indexSize);
+	}
 
 	targetFile.close();
+	if (!targetFile)
+	{
+		result = eae6320::Results::Failure;
+		OutputErrorMessageWithFileInfo(m_path_source, "Failed to write the binary mesh file");
+	}
+
+	return result;
+}
+
+eae6320::cResult eae6320::Assets::cMeshBuilder::LoadSourceMesh(const char* const i_path_source, const eParser i_parser,
+	std::vector<sSourceVertex>& o_vertexData, std::vector<uint32_t>& o_indexData)
+{
+	auto result = Results::Success;
+
+	// Any errors are reported for this file
+	m_path_source = i_path_source;
 
-	delete[] vertexData;
-	delete[] indexData;
-	vertexData = nullptr;
-	indexData = nullptr;
+	if (i_parser == eParser::Native)
+	{
+		Platform::sMappedFile file;
+		{
+			std::string errorMessage;
+			if (!(result = Platform::MapFile(i_path_source, file, &errorMessage)))
+			{
+				OutputErrorMessageWithFileInfo(i_path_source, errorMessage.c_str());
+				return result;
+			}
+		}
+		std::string unsupportedReason;
+		if (MeshSourceParser::Parse(static_cast<const char*>(file.data), file.size, o_vertexData, o_indexData, &unsupportedReason))
+		{
+			return Results::Success;
+		}
+		// Anything that the parser doesn't support is left to Lua
+		// (which also reports any errors in the file)
+		GetOutputStream() << i_path_source << ": The file is run as Lua because it can't be parsed directly: " << unsupportedReason << std::endl;
+	}
+
+	sSourceVertex* vertexData = nullptr;
+	uint32_t* indexData = nullptr;
+	uint32_t vertexCount = 0;
+	uint32_t indexCount = 0;
+	eae6320::cScopeGuard scopeGuard_deleteData([&vertexData, &indexData]
+		{
+			delete[] vertexData;
+			delete[] indexData;
+		});
+	if (!(result = LoadMeshFromFile(i_path_source, vertexData, indexData, vertexCount, indexCount)))
+	{
+		return result;
+	}
+	o_vertexData.assign(vertexData, vertexData + vertexCount);
+	o_indexData.assign(indexData, indexData + indexCount);
 
 	return result;
 }
 
-eae6320::cResult eae6320::Assets::cMeshBuilder::LoadMeshFromFile(const std::string& i_path, eae6320::Graphics::VertexFormats::sVertex_mesh*& i_vertexData, uint16_t*& i_indexData, uint16_t& i_vertexCount, uint16_t& i_indexCount)
+eae6320::cResult eae6320::Assets::cMeshBuilder::LoadMeshFromFile(const std::string& i_path, sSourceVertex*& i_vertexData, uint32_t*& i_indexData, uint32_t& i_vertexCount, uint32_t& i_indexCount)
 {
 	auto result = eae6320::Results::Success;
 
@@ -266,12 +466,12 @@ eae6320::cResult eae6320::Assets::cMeshBuilder::LoadMeshFromFile(const std::stri
 }
 
 //Load Vertex from lua
-eae6320::cResult eae6320::Assets::cMeshBuilder::LoadVertex(lua_State& io_luaState, eae6320::Graphics::VertexFormats::sVertex_mesh*& i_vertexData, uint16_t& i_vertexCount)
+eae6320::cResult eae6320::Assets::cMeshBuilder::LoadVertex(lua_State& io_luaState, sSourceVertex*& i_vertexData, uint32_t& i_vertexCount)
 {
 	auto result = eae6320::Results::Success;
 	const auto vertexCount = static_cast<int>(luaL_len(&io_luaState, -1));
 	i_vertexCount = vertexCount;
-	i_vertexData = new eae6320::Graphics::VertexFormats::sVertex_mesh[vertexCount];
+	i_vertexData = new sSourceVertex[vertexCount];
 	for (int i = 1; i <= vertexCount; ++i)
 	{
 		lua_pushinteger(&io_luaState, i);
@@ -280,69 +480,62 @@ eae6320::cResult eae6320::Assets::cMeshBuilder::LoadVertex(lua_State& io_luaStat
 			{
 				lua_pop(&io_luaState, 1);
 			});
+		// Only the position is required
+		// (the other elements have default values; see sSourceVertex)
+		auto& vertex = i_vertexData[i - 1];
+		if (!(result = LoadVertexElement(io_luaState, "position", &vertex.x, 3, true))
+			|| !(result = LoadVertexElement(io_luaState, "normal", &vertex.nx, 3, false))
+			|| !(result = LoadVertexElement(io_luaState, "TexCoord", &vertex.u, 2, false))
+			|| !(result = LoadVertexElement(io_luaState, "Color", &vertex.r, 4, false)))
 		{
-			constexpr auto* const key = "position";
-			lua_pushstring(&io_luaState, key);
+			return result;
+		}
+	}
+	return result;
+}
+
+eae6320::cResult eae6320::Assets::cMeshBuilder::LoadVertexElement(lua_State& io_luaState, const char* const i_key, float* const o_values, const int i_valueCount,
+	const bool i_isRequired)
+{
+	auto result = eae6320::Results::Success;
+
+	lua_pushstring(&io_luaState, i_key);
+	lua_gettable(&io_luaState, -2);
+	eae6320::cScopeGuard scopeGuard_popElement([&io_luaState]
+		{
+			lua_pop(&io_luaState, 1);
+		});
+	if (lua_istable(&io_luaState, -1))
+	{
+		for (int j = 1; j <= i_valueCount; ++j)
+		{
+			lua_pushinteger(&io_luaState, j);
 			lua_gettable(&io_luaState, -2);
-			eae6320::cScopeGuard scopeGuard_popPosition([&io_luaState]
+			eae6320::cScopeGuard scopeGuard_popElementArray([&io_luaState]
 				{
 					lua_pop(&io_luaState, 1);
 				});
-			if (lua_istable(&io_luaState, -1))
-			{
-				for (int j = 1; j <= 3; ++j)
-				{
-					lua_pushinteger(&io_luaState, j);
-					lua_gettable(&io_luaState, -2);
-					eae6320::cScopeGuard scopeGuard_popPositionArray([&io_luaState]
-						{
-							lua_pop(&io_luaState, 1);
-						});
-					switch (j)
-					{
-					case 1:
-						i_vertexData[i - 1].x = static_cast<float>(lua_tonumber(&io_luaState, -1));
-						break;
-					case 2:
-						i_vertexData[i - 1].y = static_cast<float>(lua_tonumber(&io_luaState, -1));
-						break;
-					case 3:
-						i_vertexData[i - 1].z = static_cast<float>(lua_tonumber(&io_luaState, -1));
-						break;
-					}
-				}
-			}
-			else
-			{
-				result = eae6320::Results::InvalidFile;
-				const char* str0 = "The value at \"";
-				const char* str1 = key;
-				const char* str2 = "\" must be a table (instead of a ";
-				const char* str3 = luaL_typename(&io_luaState, -1);
-				const char* str4 = ")";
-				char* str = new char[strlen(str0) + strlen(str1) + strlen(str2) + strlen(str3) + strlen(str4) + 1];
-				strcpy(str, str0);
-				strcat(str, str1);
-				strcat(str, str2);
-				strcat(str, str3);
-				strcat(str, str4);
-				//EAE6320_ASSERTF(false, str);
-				OutputErrorMessageWithFileInfo(m_path_source, str);
-				delete[] str;
-				return result;
-			}
+			o_values[j - 1] = static_cast<float>(lua_tonumber(&io_luaState, -1));
 		}
 	}
+	else if (i_isRequired || !lua_isnil(&io_luaState, -1))
+	{
+		result = eae6320::Results::InvalidFile;
+		const auto errorMessage = std::string("The value at \"") + i_key + "\" must be a table (instead of a "
+			+ luaL_typename(&io_luaState, -1) + ")";
+		OutputErrorMessageWithFileInfo(m_path_source, errorMessage.c_str());
+	}
+
 	return result;
 }
 
 //Loda index from lua
-eae6320::cResult eae6320::Assets::cMeshBuilder::LoadIndex(lua_State& io_luaState, uint16_t*& i_indexData, uint16_t& i_indexCount)
+eae6320::cResult eae6320::Assets::cMeshBuilder::LoadIndex(lua_State& io_luaState, uint32_t*& i_indexData, uint32_t& i_indexCount)
 {
 	auto result = eae6320::Results::Success;
 	const auto indexCount = static_cast<int>(luaL_len(&io_luaState, -1));
 	i_indexCount = indexCount;
-	i_indexData = new uint16_t[indexCount];
+	i_indexData = new uint32_t[indexCount];
 	for (int i = 1; i <= indexCount; ++i)
 	{
 		lua_pushinteger(&io_luaState, i);
@@ -351,7 +544,102 @@ eae6320::cResult eae6320::Assets::cMeshBuilder::LoadIndex(lua_State& io_luaState
 			{
 				lua_pop(&io_luaState, 1);
 			});
-		i_indexData[i - 1] = static_cast<uint16_t>(lua_tonumber(&io_luaState, -1));
+		i_indexData[i - 1] = static_cast<uint32_t>(lua_tonumber(&io_luaState, -1));
 	}
 	return result;
-}
\ No newline at end of file
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	eae6320::Graphics::MeshFormats::sBounds CalculateBounds(const eae6320::Assets::sSourceVertex* const i_vertexData, const uint32_t i_vertexCount)
+	{
+		eae6320::Graphics::MeshFormats::sBounds bounds;
+		if (i_vertexCount == 0)
+		{
+			return bounds;
+		}
+		for (int i = 0; i < 3; ++i)
+		{
+			bounds.aabbMin[i] = bounds.aabbMax[i] = (&i_vertexData[0].x)[i];
+		}
+		for (uint32_t v = 1; v < i_vertexCount; ++v)
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				const auto position = (&i_vertexData[v].x)[i];
+				bounds.aabbMin[i] = std::min(bounds.aabbMin[i], position);
+				bounds.aabbMax[i] = std::max(bounds.aabbMax[i], position);
+			}
+		}
+		// The sphere is centered on the box
+		// (this isn't the smallest possible sphere, but it is never much bigger for the shapes that meshes usually have)
+		for (int i = 0; i < 3; ++i)
+		{
+			bounds.sphereCenter[i] = (bounds.aabbMin[i] + bounds.aabbMax[i]) * 0.5f;
+		}
+		float radiusSquared = 0.0f;
+		for (uint32_t v = 0; v < i_vertexCount; ++v)
+		{
+			const auto dx = i_vertexData[v].x - bounds.sphereCenter[0];
+			const auto dy = i_vertexData[v].y - bounds.sphereCenter[1];
+			const auto dz = i_vertexData[v].z - bounds.sphereCenter[2];
+			radiusSquared = std::max(radiusSquared, (dx * dx) + (dy * dy) + (dz * dz));
+		}
+		bounds.sphereRadius = std::sqrt(radiusSquared);
+		return bounds;
+	}
+
+	void WriteIndices(std::ofstream& io_file, const uint32_t* const i_indexData, const uint32_t i_indexCount, const uint16_t i_indexSize)
+	{
+		if (i_indexSize == sizeof(uint32_t))
+		{
+			io_file.write(reinterpret_cast<const char*>(i_indexData), sizeof(*i_indexData) * static_cast<uint64_t>(i_indexCount));
+		}
+		else
+		{
+			EAE6320_ASSERT(i_indexSize == sizeof(uint16_t));
+			std::vector<uint16_t> indices(i_indexData, i_indexData + i_indexCount);
+			io_file.write(reinterpret_cast<const char*>(indices.data()), sizeof(indices[0]) * static_cast<uint64_t>(i_indexCount));
+		}
+	}
+
+	bool DoCompressedSectionsMatch(const std::vector<uint8_t>& i_vertexSection, const std::vector<uint8_t>& i_indexSection,
+		const std::vector<eae6320::Graphics::VertexFormats::sVertex_mesh>& i_vertexData,
+		const uint32_t* const i_indexData, const uint32_t i_indexCount, const uint16_t i_indexSize)
+	{
+		const auto vertexCount = static_cast<uint32_t>(i_vertexData.size());
+		std::vector<eae6320::Graphics::VertexFormats::sVertex_mesh> decodedVertexData(vertexCount);
+		if (!eae6320::Graphics::MeshCompression::DecodeVertices(i_vertexSection.data(), i_vertexSection.size(), decodedVertexData.data(), vertexCount)
+			|| ((vertexCount > 0) && (memcmp(decodedVertexData.data(), i_vertexData.data(), sizeof(i_vertexData[0]) * vertexCount) != 0)))
+		{
+			return false;
+		}
+		std::vector<uint8_t> decodedIndexData(static_cast<size_t>(i_indexSize) * i_indexCount);
+		if (!eae6320::Graphics::MeshCompression::DecodeIndices(i_indexSection.data(), i_indexSection.size(), decodedIndexData.data(), i_indexCount, i_indexSize, vertexCount))
+		{
+			return false;
+		}
+		for (uint32_t i = 0; i < i_indexCount; ++i)
+		{
+			uint32_t index;
+			if (i_indexSize == sizeof(uint32_t))
+			{
+				memcpy(&index, &decodedIndexData[sizeof(uint32_t) * i], sizeof(index));
+			}
+			else
+			{
+				uint16_t index_16;
+				memcpy(&index_16, &decodedIndexData[sizeof(uint16_t) * i], sizeof(index_16));
+				index = index_16;
+			}
+			if (index != i_indexData[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
@@ -1,18 +1,20 @@
-/*EAE6320_CSHADERBUILDER_H
+/*
 	This class builds meshs
 */
 
-#ifndef EAE6320_CSHADERBUILDER_H
-#define EAE6320_CSHADERBUILDER_H
+#ifndef EAE6320_CMESHBUILDER_H
+#define EAE6320_CMESHBUILDER_H
 
 // Includes
 //=========
 
+#include "VertexQuantization.h"
+
 #include <Tools/AssetBuildLibrary/iBuilder.h>
 
 #include <Engine/Graphics/Configuration.h>
-#include <Engine/Graphics/VertexFormats.h>
 #include <External/Lua/Includes.h>
+#include <vector>
 
 // Class Declaration
 //==================
@@ -23,6 +25,27 @@ namespace eae6320
 	{
 		class cMeshBuilder final : public iBuilder
 		{
+			// Interface
+			//==========
+
+		public:
+
+			// Load
+			//-----
+
+			enum class eParser
+			{
+				// The file is parsed directly if it only uses the subset of Lua that meshes need (see MeshSourceParser.h)
+				// and is run as Lua otherwise
+				Native,
+				// The file is always run as Lua
+				Lua,
+			};
+			// This loads the vertices and indices from a mesh source file without building it
+			// (MeshParsingBenchmark uses this to compare the parsers)
+			cResult LoadSourceMesh(const char* const i_path_source, const eParser i_parser,
+				std::vector<sSourceVertex>& o_vertexData, std::vector<uint32_t>& o_indexData);
+
 			// Inherited Implementation
 			//=========================
 
@@ -34,12 +57,16 @@ namespace eae6320
 			cResult Build(const std::vector<std::string>& i_arguments) final;
 
 
-			eae6320::cResult LuaToBinary(const char* const i_path_source, const char* const i_path_target);
-			eae6320::cResult LoadMeshFromFile(const std::string& i_path, eae6320::Graphics::VertexFormats::sVertex_mesh*& i_vertexData, uint16_t*& i_indexData, uint16_t& i_vertexCount, uint16_t& i_indexCount);
-			eae6320::cResult LoadVertex(lua_State& io_luaState, eae6320::Graphics::VertexFormats::sVertex_mesh*& i_vertexData, uint16_t& i_vertexCount);
-			eae6320::cResult LoadIndex(lua_State& io_luaState, uint16_t*& i_indexData, uint16_t& i_indexCount);
+			eae6320::cResult LuaToBinary(const char* const i_path_source, const char* const i_path_target,
+				const Graphics::MeshFormats::eEncoding i_encoding, const eParser i_parser);
+			eae6320::cResult LoadMeshFromFile(const std::string& i_path, sSourceVertex*& i_vertexData, uint32_t*& i_indexData, uint32_t& i_vertexCount, uint32_t& i_indexCount);
+			eae6320::cResult LoadVertex(lua_State& io_luaState, sSourceVertex*& i_vertexData, uint32_t& i_vertexCount);
+			// Loads i_valueCount numbers from the table at i_key in the vertex table at -1
+			// (if the element isn't required and isn't in the vertex table then o_values isn't changed)
+			eae6320::cResult LoadVertexElement(lua_State& io_luaState, const char* const i_key, float* const o_values, const int i_valueCount, const bool i_isRequired);
+			eae6320::cResult LoadIndex(lua_State& io_luaState, uint32_t*& i_indexData, uint32_t& i_indexCount);
 		};
 	}
 }
 
-#endif	// EAE6320_CSHADERBUILDER_H
\ No newline at end of file
+#endif	// EAE6320_CMESHBUILDER_H
\ No newline at end of file
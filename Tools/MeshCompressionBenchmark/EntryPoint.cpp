@@ -0,0 +1,283 @@
+/*
+	This program measures how fast MeshCompression decodes (see MeshCompression.h)
+
+	Each mesh is encoded once and then decoded several times,
+	the decoded geometry is checked against the original,
+	and the encoded size and the decoding rate are output.
+	The meshes are:
+		* Generated grids
+			(smooth neighboring vertices and indices in order, which is what MeshBuilder writes for real meshes)
+		* Generated random vertices and indices
+			(the worst case for the compressor)
+		* Any mesh files that are given on the command line
+			(compressed files are decoded first)
+
+	It only uses the standard library and the platform-independent mesh files,
+	and so it can be built and run on platforms other than Windows, e.g. from the solution directory:
+		g++ -std=c++17 -O2 -DEAE6320_PLATFORM_NULL -I. Tools/MeshCompressionBenchmark/EntryPoint.cpp
+			Engine/Graphics/MeshCompression.cpp Engine/Graphics/MeshFormats.cpp -o MeshCompressionBenchmark
+
+	It is run from the command line:
+		MeshCompressionBenchmark [-passes <count>] [mesh files...]
+*/
+
+// Includes
+//=========
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <Engine/Graphics/MeshCompression.h>
+#include <Engine/Graphics/MeshFormats.h>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	struct sMesh
+	{
+		std::string name;
+		std::vector<eae6320::Graphics::VertexFormats::sVertex_mesh> vertices;
+		std::vector<uint32_t> indices;
+	};
+
+	sMesh GenerateGrid( const uint32_t i_sideVertexCount );
+	sMesh GenerateRandom( const uint32_t i_vertexCount, const uint32_t i_triangleCount );
+	bool LoadMeshFile( const char* const i_path, sMesh& o_mesh );
+
+	// Returns false if the decoded mesh isn't the same as the original
+	bool RunAndOutput( const sMesh& i_mesh, const unsigned int i_passCount );
+}
+
+// Entry Point
+//============
+
+int main( int i_argumentCount, char** i_arguments )
+{
+	unsigned int passCount = 20;
+	std::vector<sMesh> meshes;
+	{
+		meshes.push_back( GenerateGrid( 100 ) );
+		meshes.push_back( GenerateGrid( 317 ) );
+		meshes.push_back( GenerateGrid( 1000 ) );
+		meshes.push_back( GenerateRandom( 10000, 20000 ) );
+		meshes.push_back( GenerateRandom( 100000, 200000 ) );
+	}
+	for ( int i = 1; i < i_argumentCount; ++i )
+	{
+		if ( ( std::strcmp( i_arguments[i], "-passes" ) == 0 ) && ( ( i + 1 ) < i_argumentCount ) )
+		{
+			passCount = std::max( static_cast<unsigned int>( std::strtoul( i_arguments[++i], nullptr, 10 ) ), 1u );
+		}
+		else
+		{
+			sMesh mesh;
+			if ( !LoadMeshFile( i_arguments[i], mesh ) )
+			{
+				return EXIT_FAILURE;
+			}
+			meshes.push_back( std::move( mesh ) );
+		}
+	}
+
+	std::printf( "%-32s %9s %9s %10s %10s %7s %12s\n", "Mesh", "Vertices", "Indices", "Raw (MB)", "Encoded", "Ratio", "Decode MB/s" );
+	bool wereAllMeshesDecodedCorrectly = true;
+	for ( const auto& mesh : meshes )
+	{
+		wereAllMeshesDecodedCorrectly = RunAndOutput( mesh, passCount ) && wereAllMeshesDecodedCorrectly;
+	}
+	return wereAllMeshesDecodedCorrectly ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	sMesh GenerateGrid( const uint32_t i_sideVertexCount )
+	{
+		sMesh mesh;
+		mesh.name = "grid " + std::to_string( i_sideVertexCount ) + "x" + std::to_string( i_sideVertexCount );
+		mesh.vertices.resize( size_t( i_sideVertexCount ) * i_sideVertexCount );
+		const auto maxCoordinate = static_cast<double>( i_sideVertexCount - 1 );
+		for ( uint32_t z = 0; z < i_sideVertexCount; ++z )
+		{
+			for ( uint32_t x = 0; x < i_sideVertexCount; ++x )
+			{
+				const auto fractionX = x / maxCoordinate;
+				const auto fractionZ = z / maxCoordinate;
+				auto& vertex = mesh.vertices[( size_t( z ) * i_sideVertexCount ) + x];
+				// The grid is a gently rolling surface
+				// so that the height and the normal change smoothly like they would in a real mesh
+				const auto height = 0.5 + ( 0.25 * std::sin( fractionX * 6.0 ) * std::cos( fractionZ * 4.0 ) );
+				vertex.x = static_cast<uint16_t>( fractionX * 65535.0 );
+				vertex.y = static_cast<uint16_t>( height * 65535.0 );
+				vertex.z = static_cast<uint16_t>( fractionZ * 65535.0 );
+				vertex.w = 0;
+				vertex.nx = static_cast<int16_t>( -0.3 * std::cos( fractionX * 6.0 ) * std::cos( fractionZ * 4.0 ) * 32767.0 );
+				vertex.ny = static_cast<int16_t>( 0.2 * std::sin( fractionX * 6.0 ) * std::sin( fractionZ * 4.0 ) * 32767.0 );
+				// Positive half floats sort the same way as their bits,
+				// and so the bits of 0.0 to 1.0 (0x0000 to 0x3c00) are interpolated
+				vertex.u = static_cast<uint16_t>( fractionX * 0x3c00 );
+				vertex.v = static_cast<uint16_t>( fractionZ * 0x3c00 );
+				vertex.r = vertex.g = vertex.b = vertex.a = 255;
+			}
+		}
+		for ( uint32_t z = 0; ( z + 1 ) < i_sideVertexCount; ++z )
+		{
+			for ( uint32_t x = 0; ( x + 1 ) < i_sideVertexCount; ++x )
+			{
+				const auto i0 = ( z * i_sideVertexCount ) + x;
+				const auto i1 = i0 + i_sideVertexCount;
+				const uint32_t quad[] = { i0, i1 + 1, i0 + 1, i0, i1, i1 + 1 };
+				mesh.indices.insert( mesh.indices.end(), std::begin( quad ), std::end( quad ) );
+			}
+		}
+		return mesh;
+	}
+
+	sMesh GenerateRandom( const uint32_t i_vertexCount, const uint32_t i_triangleCount )
+	{
+		sMesh mesh;
+		mesh.name = "random " + std::to_string( i_vertexCount );
+		// The seed is fixed so that every run measures the same mesh
+		std::mt19937 randomNumberGenerator( i_vertexCount );
+		mesh.vertices.resize( i_vertexCount );
+		{
+			std::uniform_int_distribution<unsigned int> randomWord( 0, UINT16_MAX );
+			auto* const words = reinterpret_cast<uint16_t*>( mesh.vertices.data() );
+			const auto wordCount = ( sizeof( mesh.vertices[0] ) / sizeof( uint16_t ) ) * mesh.vertices.size();
+			for ( size_t i = 0; i < wordCount; ++i )
+			{
+				words[i] = static_cast<uint16_t>( randomWord( randomNumberGenerator ) );
+			}
+		}
+		mesh.indices.resize( size_t( i_triangleCount ) * 3 );
+		{
+			std::uniform_int_distribution<uint32_t> randomIndex( 0, i_vertexCount - 1 );
+			for ( auto& index : mesh.indices )
+			{
+				index = randomIndex( randomNumberGenerator );
+			}
+		}
+		return mesh;
+	}
+
+	bool LoadMeshFile( const char* const i_path, sMesh& o_mesh )
+	{
+		using namespace eae6320::Graphics;
+
+		std::ifstream file( i_path, std::ios::binary );
+		if ( !file )
+		{
+			std::fprintf( stderr, "Couldn't open \"%s\"\n", i_path );
+			return false;
+		}
+		// The data is stored as uint64_ts so that the header is aligned
+		file.seekg( 0, std::ios::end );
+		const auto fileSize = static_cast<size_t>( file.tellg() );
+		file.seekg( 0, std::ios::beg );
+		std::vector<uint64_t> data( ( fileSize + sizeof( uint64_t ) - 1 ) / sizeof( uint64_t ) );
+		if ( !file.read( reinterpret_cast<char*>( data.data() ), fileSize ) )
+		{
+			std::fprintf( stderr, "Couldn't read \"%s\"\n", i_path );
+			return false;
+		}
+
+		MeshFormats::sSections sections;
+		std::string errorMessage;
+		if ( !MeshFormats::GetSections( data.data(), fileSize, sections, &errorMessage ) )
+		{
+			std::fprintf( stderr, "\"%s\" isn't a valid mesh file: %s\n", i_path, errorMessage.c_str() );
+			return false;
+		}
+		const auto& header = *sections.header;
+		o_mesh.name = i_path;
+		o_mesh.vertices.resize( header.vertexCount );
+		o_mesh.indices.resize( header.indexCount );
+		if ( header.encoding == MeshFormats::eEncoding::Compressed )
+		{
+			if ( !MeshCompression::DecodeVertices( sections.vertexSection, header.vertexSectionSize, o_mesh.vertices.data(), header.vertexCount )
+				|| !MeshCompression::DecodeIndices( sections.indexSection, header.indexSectionSize,
+					o_mesh.indices.data(), header.indexCount, sizeof( uint32_t ), header.vertexCount ) )
+			{
+				std::fprintf( stderr, "\"%s\" couldn't be decoded\n", i_path );
+				return false;
+			}
+		}
+		else
+		{
+			std::copy( sections.vertexData, sections.vertexData + header.vertexCount, o_mesh.vertices.begin() );
+			for ( uint32_t i = 0; i < header.indexCount; ++i )
+			{
+				o_mesh.indices[i] = ( header.indexSize == sizeof( uint16_t ) )
+					? static_cast<const uint16_t*>( sections.indexData )[i] : static_cast<const uint32_t*>( sections.indexData )[i];
+			}
+		}
+		return true;
+	}
+
+	bool RunAndOutput( const sMesh& i_mesh, const unsigned int i_passCount )
+	{
+		using namespace eae6320::Graphics;
+
+		const auto vertexCount = static_cast<uint32_t>( i_mesh.vertices.size() );
+		const auto indexCount = static_cast<uint32_t>( i_mesh.indices.size() );
+		// The indices are decoded to the size that MeshBuilder would have stored them as
+		const auto indexSize = MeshFormats::SelectIndexSize( vertexCount );
+
+		std::vector<uint8_t> encodedVertices, encodedIndices;
+		MeshCompression::EncodeVertices( i_mesh.vertices.data(), vertexCount, encodedVertices );
+		MeshCompression::EncodeIndices( i_mesh.indices.data(), indexCount, encodedIndices );
+
+		std::vector<VertexFormats::sVertex_mesh> decodedVertices( vertexCount );
+		std::vector<uint8_t> decodedIndices( size_t( indexSize ) * indexCount );
+		const auto Decode = [&]()
+		{
+			return MeshCompression::DecodeVertices( encodedVertices.data(), encodedVertices.size(), decodedVertices.data(), vertexCount )
+				&& MeshCompression::DecodeIndices( encodedIndices.data(), encodedIndices.size(),
+					decodedIndices.data(), indexCount, indexSize, vertexCount );
+		};
+
+		// The first decode isn't timed and is checked against the original
+		bool isDecodedMeshCorrect = Decode()
+			&& ( std::memcmp( decodedVertices.data(), i_mesh.vertices.data(), sizeof( decodedVertices[0] ) * vertexCount ) == 0 );
+		for ( uint32_t i = 0; isDecodedMeshCorrect && ( i < indexCount ); ++i )
+		{
+			const uint32_t decodedIndex = ( indexSize == sizeof( uint16_t ) )
+				? reinterpret_cast<const uint16_t*>( decodedIndices.data() )[i] : reinterpret_cast<const uint32_t*>( decodedIndices.data() )[i];
+			isDecodedMeshCorrect = ( decodedIndex == i_mesh.indices[i] );
+		}
+		if ( !isDecodedMeshCorrect )
+		{
+			std::fprintf( stderr, "%s: The decoded mesh isn't the same as the original\n", i_mesh.name.c_str() );
+			return false;
+		}
+
+		const auto time_start = std::chrono::steady_clock::now();
+		for ( unsigned int pass = 0; pass < i_passCount; ++pass )
+		{
+			Decode();
+		}
+		const auto secondsPerPass = std::chrono::duration<double>( std::chrono::steady_clock::now() - time_start ).count() / i_passCount;
+
+		constexpr auto bytesPerMegabyte = 1024.0 * 1024.0;
+		const auto rawByteCount = static_cast<double>( ( sizeof( decodedVertices[0] ) * vertexCount ) + decodedIndices.size() );
+		const auto encodedByteCount = static_cast<double>( encodedVertices.size() + encodedIndices.size() );
+		std::printf( "%-32s %9u %9u %10.2f %10.2f %6.1f%% %12.1f\n",
+			i_mesh.name.c_str(), vertexCount, indexCount, rawByteCount / bytesPerMegabyte, encodedByteCount / bytesPerMegabyte,
+			( encodedByteCount / rawByteCount ) * 100.0, ( rawByteCount / bytesPerMegabyte ) / secondsPerPass );
+		return true;
+	}
+}
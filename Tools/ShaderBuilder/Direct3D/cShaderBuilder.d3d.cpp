@@ -10,6 +10,7 @@
 #include <iostream>
 #include <limits>
 #include <Tools/AssetBuildLibrary/Functions.h>
+#include <vector>
 
 // Helper Class Declaration
 //=========================
@@ -47,20 +48,23 @@ namespace
 	};
 }
 
-// Interface
-//==========
+// Implementation
+//===============
 
-// Build
-//------
+// Platform-Specific Build
+//------------------------
 
-eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::eShaderType i_shaderType, const std::vector<std::string>& i_arguments )
+// The Direct3D compiler can be used from several threads at once
+const bool eae6320::Assets::cShaderBuilder::s_canProgramsBeCompiledConcurrently = true;
+
+eae6320::cResult eae6320::Assets::cShaderBuilder::CompileProgram( const Graphics::eShaderType i_shaderType, const std::string& i_source,
+	const size_t i_programIndex, const size_t i_programCount, sProgram& io_program ) const
 {
 	auto result = Results::Success;
 
-	Platform::sDataFromFile dataFromFile;
 	ID3DBlob* compiledCode = nullptr;
 	ID3DBlob* disassembledCode = nullptr;
-	cScopeGuard scopeGuard( [&compiledCode, &disassembledCode, &dataFromFile]
+	cScopeGuard scopeGuard( [&compiledCode, &disassembledCode]
 		{
 			if ( compiledCode )
 			{
@@ -74,22 +78,18 @@ eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::eShader
 			}
 		} );
 
-	// Load the source code
-	{
-		std::string errorMessage;
-		if ( !( result = Platform::LoadBinaryFile( m_path_source, dataFromFile, &errorMessage ) ) )
-		{
-			OutputErrorMessageWithFileInfo( m_path_source, "Failed to load shader source file: %s", errorMessage.c_str() );
-			return result;
-		}
-	}
 	// Compile it
 	{
-		const D3D_SHADER_MACRO defines[] =
+		std::vector<D3D_SHADER_MACRO> defines;
 		{
-			{ "EAE6320_PLATFORM_D3D" },
-			{}
-		};
+			defines.push_back( { "EAE6320_PLATFORM_D3D" } );
+			// The variant's keywords are #defined as 1
+			for ( const auto& keyword : io_program.definedKeywords )
+			{
+				defines.push_back( { keyword.c_str(), "1" } );
+			}
+			defines.push_back( {} );
+		}
 		cIncludeHelper includeHelper( m_path_source );
 		if ( !( result = includeHelper.Initialize() ) )
 		{
@@ -128,11 +128,11 @@ eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::eShader
 			;
 		constexpr unsigned int notAnFxFile = 0;
 		ID3DBlob* errorMessages = nullptr;
-		const auto result_compile = D3DCompile( dataFromFile.data, dataFromFile.size, m_path_source, defines, &includeHelper, entryPoint,
+		const auto result_compile = D3DCompile( i_source.data(), i_source.size(), m_path_source, defines.data(), &includeHelper, entryPoint,
 			targetProfile, compileConstants, notAnFxFile, &compiledCode, &errorMessages );
 		if ( errorMessages )
 		{
-			std::cerr << static_cast<char*>( errorMessages->GetBufferPointer() );
+			GetErrorOutputStream() << static_cast<char*>( errorMessages->GetBufferPointer() );
 			errorMessages->Release();
 			errorMessages = nullptr;
 		}
@@ -146,64 +146,16 @@ eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::eShader
 			return result;
 		}
 	}
-	// Write the compiled shader to disk
-	{
-		std::string errorMessage;
-		if ( !( result = eae6320::Platform::WriteBinaryFile( m_path_target, compiledCode->GetBufferPointer(), compiledCode->GetBufferSize(), &errorMessage ) ) )
-		{
-			eae6320::Assets::OutputErrorMessageWithFileInfo( m_path_source, errorMessage.c_str() );
-		}
-	}
+	// Keep the compiled program so that it can be written with the others
+	io_program.compiledProgram.assign( static_cast<const char*>( compiledCode->GetBufferPointer() ), compiledCode->GetBufferSize() );
 	// Create a disassembled version of the shader
-	if ( result )
 	{
 		// The following can be #defined
 		// in order to create a human-readable file with the shader instructions
 		// (this can be useful during development to see how code changes affect instruction count)
 #define EAE6320_GRAPHICS_SHOULDDISASSEMBLYBECREATED
 #ifdef EAE6320_GRAPHICS_SHOULDDISASSEMBLYBECREATED
-		const auto path_disassembly = [i_shaderType]( const std::string& i_path_compiledShader )
-		{
-			const auto directory_disassembly = [i_shaderType, &i_path_compiledShader]()
-			{
-				std::string directory_disassembly;
-				if ( !eae6320::Platform::GetEnvironmentVariable( "IntermediateDir", directory_disassembly ) )
-				{
-					const auto pos_lastSlash = i_path_compiledShader.find_last_of( '/' );
-					if ( pos_lastSlash != i_path_compiledShader.npos )
-					{
-						directory_disassembly = i_path_compiledShader.substr( 0, pos_lastSlash + 1 );
-					}
-				}
-				switch ( i_shaderType )
-				{
-				case Graphics::eShaderType::Vertex:
-					directory_disassembly += "vertex/";
-					break;
-				case Graphics::eShaderType::Fragment:
-					directory_disassembly += "fragment/";
-					break;
-				}
-				return directory_disassembly;
-			}();
-			const auto filename = [&i_path_compiledShader]()
-			{
-				const auto filename_withExtension = [&i_path_compiledShader]
-				{
-					const auto pos_lastSlash = i_path_compiledShader.find_last_of( '/' );
-					if ( pos_lastSlash != i_path_compiledShader.npos )
-					{
-						return i_path_compiledShader.substr( pos_lastSlash + 1 );
-					}
-					else
-					{
-						return i_path_compiledShader;
-					}
-				}();
-				return filename_withExtension + ".dasm";
-			}();
-			return directory_disassembly + filename;
-		}( m_path_target );
+		const auto path_disassembly = GetIntermediatePath( i_shaderType, i_programIndex, i_programCount, ".dasm" );
 
 		constexpr unsigned int disassembleConstants = 0;
 		constexpr char* const noComment = nullptr;
@@ -9,7 +9,6 @@
 #include <Engine/Platform/Platform.h>
 #include <Engine/ScopeGuard/cScopeGuard.h>
 #include <Engine/Windows/OpenGl.h>
-#include <External/Mcpp/Includes.h>
 #include <iostream>
 #include <regex>
 #include <sstream>
@@ -39,33 +38,44 @@ namespace
 {
 	eae6320::cResult BuildAndVerifyGeneratedShaderSource( const char* const i_path_source, const char* const i_path_target,
 		const eae6320::Graphics::eShaderType i_shaderType, const std::string& i_source );
-	eae6320::cResult PreProcessShaderSource( const char* const i_path_source, std::string& o_shaderSource_preProcessed );
 	eae6320::cResult SaveGeneratedShaderSource( const char* const i_path, const std::string& i_source );
 }
 
-// Interface
-//==========
+// Implementation
+//===============
 
-// Build
-//------
+// Platform-Specific Build
+//------------------------
 
-eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::eShaderType i_shaderType, const std::vector<std::string>& i_arguments )
+// Each program is verified by compiling it with a hidden OpenGL context
+// (and the GPU vendor that is used to parse the errors is stored globally)
+const bool eae6320::Assets::cShaderBuilder::s_canProgramsBeCompiledConcurrently = false;
+
+eae6320::cResult eae6320::Assets::cShaderBuilder::CompileProgram( const Graphics::eShaderType i_shaderType, const std::string&,
+	const size_t i_programIndex, const size_t i_programCount, sProgram& io_program ) const
 {
 	auto result = Results::Success;
 
-	std::string shaderSource_preProcessed;
-	if ( !( result = PreProcessShaderSource( m_path_source, shaderSource_preProcessed ) ) )
+	// The generated GLSL is saved so that the compiler's errors can refer to its lines
+	// (the preprocessed source is what the compiler sees, not the source file)
+	const auto path_generated = GetIntermediatePath( i_shaderType, i_programIndex, i_programCount, ".glsl" );
 	{
-		return result;
+		std::string errorMessage;
+		if ( !eae6320::Platform::CreateDirectoryIfItDoesntExist( path_generated, &errorMessage ) )
+		{
+			OutputWarningMessageWithFileInfo( path_generated.c_str(), errorMessage.c_str() );
+		}
 	}
-	if ( !( result = SaveGeneratedShaderSource( m_path_target, shaderSource_preProcessed ) ) )
+	if ( !( result = SaveGeneratedShaderSource( path_generated.c_str(), io_program.source_preProcessed ) ) )
 	{
 		return result;
 	}
-	if ( !( result = BuildAndVerifyGeneratedShaderSource( m_path_source, m_path_target, i_shaderType, shaderSource_preProcessed ) ) )
+	if ( !( result = BuildAndVerifyGeneratedShaderSource( m_path_source, path_generated.c_str(), i_shaderType, io_program.source_preProcessed ) ) )
 	{
 		return result;
 	}
+	// OpenGL compiles the GLSL source code at run-time
+	io_program.compiledProgram = io_program.source_preProcessed;
 
 	return result;
 }
@@ -363,17 +373,17 @@ namespace
 											}
 										}
 										const auto convertedErrors = std::regex_replace( compilationInfo, pattern_match, pattern_replace );
-										std::cerr << convertedErrors << std::endl;
+										eae6320::Assets::GetErrorOutputStream() << convertedErrors << std::endl;
 									}
 									catch ( std::regex_error& )
 									{
 										// If the parsing code has an error pass the output directly from the driver
-										std::cerr << compilationInfo << std::endl;
+										eae6320::Assets::GetErrorOutputStream() << compilationInfo << std::endl;
 									}
 								}
 								else
 								{
-									std::cerr << compilationInfo << std::endl;
+									eae6320::Assets::GetErrorOutputStream() << compilationInfo << std::endl;
 								}
 								return result;
 							}
@@ -400,141 +410,6 @@ namespace
 		return result;
 	}
 
-	eae6320::cResult PreProcessShaderSource( const char* const i_path_source, std::string& o_shaderSource_preProcessed )
-	{
-		auto result = eae6320::Results::Success;
-
-		// Get the content directories to use as #include search paths
-		std::string includeSearchPathArgument_engineSourceContentDir, includeSearchPathArgument_gameSourceContentDir;
-		{
-			const std::string prefix = "-I";
-			std::string errorMessage;
-
-			// EngineSourceContentDir
-			{
-				if ( result = eae6320::Platform::GetEnvironmentVariable(
-					"EngineSourceContentDir", includeSearchPathArgument_engineSourceContentDir, &errorMessage ) )
-				{
-					includeSearchPathArgument_engineSourceContentDir = prefix + includeSearchPathArgument_engineSourceContentDir;
-				}
-				else
-				{
-					eae6320::Assets::OutputErrorMessage( "Failed to get the engine's source content directory: %s", errorMessage.c_str() );
-					return result;
-				}
-			}
-			// GameSourceContentDir
-			{
-				if ( result = eae6320::Platform::GetEnvironmentVariable(
-					"GameSourceContentDir", includeSearchPathArgument_gameSourceContentDir, &errorMessage ) )
-				{
-					includeSearchPathArgument_gameSourceContentDir = prefix + includeSearchPathArgument_gameSourceContentDir;
-				}
-				else
-				{
-					eae6320::Assets::OutputErrorMessage( "Failed to get the game's source content directory: %s", errorMessage.c_str() );
-					return result;
-				}
-			}
-		}
-
-		// mcpp consumes non-const char*s
-		// and so an array of temporary strings must be allocated
-		const char* arguments_const [] =
-		{
-			// The command (necessary even though it is being run as a function)
-			"mcpp",
-			// The platform #define
-			"-DEAE6320_PLATFORM_GL",
-			// The #include search paths
-			// (list the game's content path before the engine's
-			// so that if there are identically-named files
-			// the game-specific one will be used)
-			includeSearchPathArgument_gameSourceContentDir.c_str(),
-			includeSearchPathArgument_engineSourceContentDir.c_str(),
-#ifdef EAE6320_GRAPHICS_AREDEBUGSHADERSENABLED
-			// Keep comments
-			"-C",
-#endif
-			// Don't output #line number information
-			"-P",
-			// Treat unknown directives (like #version and #extension) as warnings instead of errors
-			"-a",
-			// The input file to pre-process
-			i_path_source
-		};
-		const auto argumentCount = sizeof( arguments_const ) / sizeof( char* );
-		char* arguments[argumentCount] = {};
-		std::remove_const<decltype( argumentCount )>::type allocatedArgumentCount = 0;
-		eae6320::cScopeGuard scopeGuard_arguments( [&arguments, &allocatedArgumentCount]
-			{
-				for ( size_t i = 0; i < allocatedArgumentCount; ++i )
-				{
-					if ( arguments[i] )
-					{
-						free( arguments[i] );
-						arguments[i] = nullptr;
-					}
-				}
-			} );
-		for ( size_t i = 0; i < argumentCount; ++i )
-		{
-			const auto stringSize = strlen( arguments_const[i] ) + 1;	// NULL terminator
-			char* temporaryString = reinterpret_cast<char*>( malloc( stringSize ) );
-			if ( temporaryString )
-			{
-				memcpy( temporaryString, arguments_const[i], stringSize );
-				arguments[i] = temporaryString;
-			}
-			else
-			{
-				result = eae6320::Results::OutOfMemory;
-				eae6320::Assets::OutputErrorMessage( "Failed to allocate &u bytes of temporary storage for argument #&u (\"%s\")",
-					stringSize, i, arguments_const[i] );
-				return result;
-			}
-		}
-
-		// Configure mcpp to output to buffers instead of files
-		mcpp_use_mem_buffers( 1 );
-		eae6320::cScopeGuard scopeGuard_mcppBuffers( []
-			{
-				// Release mcpp's internal buffers
-				mcpp_use_mem_buffers( 0 );
-			} );
-		// Preprocess the file
-		{
-			const auto result_mcpp = mcpp_lib_main( static_cast<int>( argumentCount ), arguments );
-			if ( result_mcpp == EXIT_SUCCESS )
-			{
-				const auto* const shaderSource_preProcessed = mcpp_get_mem_buffer( static_cast<OUTDEST>( eae6320::mcpp::OUTDEST::Out ) );
-				o_shaderSource_preProcessed = shaderSource_preProcessed ? shaderSource_preProcessed : "";
-			}
-			else
-			{
-				result = eae6320::Results::Failure;
-				std::cerr << mcpp_get_mem_buffer( static_cast<OUTDEST>( eae6320::mcpp::OUTDEST::Err ) );
-				return result;
-			}
-		}
-
-#ifndef EAE6320_GRAPHICS_AREDEBUGSHADERSENABLED
-		// Remove extra new lines
-		try
-		{
-			std::regex pattern_match( R"(((\r\n)|(\n))+)" );
-			const std::string pattern_replace( "\n" );
-			o_shaderSource_preProcessed = std::regex_replace( o_shaderSource_preProcessed, pattern_match, pattern_replace );
-		}
-		catch ( std::regex_error& )
-		{
-
-		}
-#endif
-
-		return result;
-	}
-
 	eae6320::cResult SaveGeneratedShaderSource( const char* const i_path, const std::string& i_shader )
 	{
 		eae6320::cResult result;
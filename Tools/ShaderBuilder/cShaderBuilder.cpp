@@ -3,8 +3,49 @@
 
 #include "cShaderBuilder.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <Engine/Asserts/Asserts.h>
+#include <Engine/Graphics/ShaderFormats.h>
+#include <Engine/Platform/Platform.h>
+#include <Engine/ScopeGuard/cScopeGuard.h>
+#include <External/Mcpp/Includes.h>
+#include <map>
+#include <mutex>
+#include <regex>
+#include <sstream>
+#include <thread>
 #include <Tools/AssetBuildLibrary/Functions.h>
 
+// Static Data
+//============
+
+namespace
+{
+	// mcpp uses global state,
+	// and so only one shader can be preprocessed at a time
+	// (builders that run in the same process as AssetBuildExe can build shaders concurrently)
+	std::mutex s_mutex_mcpp;
+}
+
+// Helper Declarations
+//====================
+
+namespace
+{
+	// Every line that declares keywords is removed
+	// (it is replaced with an empty line so that the line numbers of errors stay the same)
+	// and the declared keywords are added to o_keywords if it isn't null
+	eae6320::cResult RemoveKeywordDeclarations( const char* const i_path_source, std::string& io_source, std::vector<std::string>* const o_keywords );
+	eae6320::cResult PreProcessShaderSource( const char* const i_path_source, const std::vector<std::string>& i_definedKeywords,
+		std::string& o_shaderSource_preProcessed );
+	// 64-bit FNV-1a
+	uint64_t CalculateHash( const std::string& i_source );
+}
+
 // Inherited Implementation
 //=========================
 
@@ -44,3 +85,424 @@ eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const std::vector<std::
 
 	return Build( shaderType, i_arguments );
 }
+
+// Implementation
+//===============
+
+// Build
+//------
+
+eae6320::cResult eae6320::Assets::cShaderBuilder::Build( const Graphics::eShaderType i_shaderType, const std::vector<std::string>& i_arguments )
+{
+	auto result = Results::Success;
+
+	// Load the source code and find its keywords
+	std::string source;
+	std::vector<std::string> keywords;
+	{
+		Platform::sDataFromFile dataFromFile;
+		std::string errorMessage;
+		if ( !( result = Platform::LoadBinaryFile( m_path_source, dataFromFile, &errorMessage ) ) )
+		{
+			OutputErrorMessageWithFileInfo( m_path_source, "Failed to load shader source file: %s", errorMessage.c_str() );
+			return result;
+		}
+		source.assign( static_cast<const char*>( dataFromFile.data ), dataFromFile.size );
+	}
+	if ( !( result = RemoveKeywordDeclarations( m_path_source, source, &keywords ) ) )
+	{
+		return result;
+	}
+	// Preprocess every variant
+	// and only keep a program for each different source
+	const auto variantCount = Graphics::ShaderFormats::GetVariantCount( static_cast<uint16_t>( keywords.size() ) );
+	std::vector<uint32_t> programIndices( variantCount );
+	std::vector<sProgram> programs;
+	{
+		// (different sources can have the same hash, and so every program with the hash is compared)
+		std::multimap<uint64_t, size_t> programsWithHash;
+		for ( uint32_t variantKey = 0; variantKey < variantCount; ++variantKey )
+		{
+			sProgram program;
+			for ( size_t i = 0; i < keywords.size(); ++i )
+			{
+				if ( ( variantKey & ( uint32_t( 1 ) << i ) ) != 0 )
+				{
+					program.definedKeywords.push_back( keywords[i] );
+				}
+			}
+			if ( !( result = PreProcessShaderSource( m_path_source, program.definedKeywords, program.source_preProcessed ) ) )
+			{
+				return result;
+			}
+			const auto hash = CalculateHash( program.source_preProcessed );
+			auto programIndex = programs.size();
+			{
+				const auto range = programsWithHash.equal_range( hash );
+				for ( auto iterator = range.first; iterator != range.second; ++iterator )
+				{
+					if ( programs[iterator->second].source_preProcessed == program.source_preProcessed )
+					{
+						programIndex = iterator->second;
+						break;
+					}
+				}
+			}
+			if ( programIndex == programs.size() )
+			{
+				programsWithHash.insert( std::make_pair( hash, programIndex ) );
+				programs.push_back( std::move( program ) );
+			}
+			programIndices[variantKey] = static_cast<uint32_t>( programIndex );
+		}
+	}
+	// Compile the programs
+	{
+		const auto programCount = programs.size();
+		auto threadCount = s_canProgramsBeCompiledConcurrently ? std::max( std::thread::hardware_concurrency(), 1u ) : 1u;
+		threadCount = static_cast<unsigned int>( std::min( static_cast<size_t>( threadCount ), programCount ) );
+		// The programs are always compiled on other threads
+		// so that capturing their output doesn't affect whatever this thread's output is being captured by
+		std::atomic<size_t> nextProgramIndex( 0 );
+		std::vector<std::thread> threads;
+		threads.reserve( threadCount );
+		for ( unsigned int i = 0; i < threadCount; ++i )
+		{
+			threads.emplace_back( [this, i_shaderType, &source, &programs, programCount, &nextProgramIndex]()
+				{
+					for ( auto programIndex = nextProgramIndex++; programIndex < programCount; programIndex = nextProgramIndex++ )
+					{
+						auto& program = programs[programIndex];
+						std::ostringstream output;
+						CaptureOutput( &output );
+						program.result = CompileProgram( i_shaderType, source, programIndex, programCount, program );
+						CaptureOutput( nullptr );
+						program.output = output.str();
+					}
+				} );
+		}
+		for ( auto& thread : threads )
+		{
+			thread.join();
+		}
+		// The output is in the same order whichever thread compiled each program
+		for ( const auto& program : programs )
+		{
+			GetErrorOutputStream() << program.output;
+			if ( !program.result && result )
+			{
+				result = program.result;
+			}
+		}
+		if ( !result )
+		{
+			return result;
+		}
+	}
+	// Write the programs to disk
+	{
+		Graphics::ShaderFormats::sHeader header;
+		header.keywordCount = static_cast<uint16_t>( keywords.size() );
+		header.programCount = static_cast<uint32_t>( programs.size() );
+		std::vector<Graphics::ShaderFormats::sProgram> programTable( programs.size() );
+		auto offset = static_cast<uint32_t>( sizeof( header ) + ( sizeof( programIndices[0] ) * programIndices.size() )
+			+ ( sizeof( programTable[0] ) * programTable.size() ) );
+		for ( size_t i = 0; i < programs.size(); ++i )
+		{
+			offset = Graphics::ShaderFormats::AlignProgramOffset( offset );
+			programTable[i].offset = offset;
+			programTable[i].size = static_cast<uint32_t>( programs[i].compiledProgram.size() );
+			offset += programTable[i].size;
+		}
+		const auto fileSize = offset;
+		std::string file( fileSize, '\0' );
+		{
+			auto* const fileData = &file[0];
+			size_t offset_table = 0;
+			memcpy( fileData + offset_table, &header, sizeof( header ) );
+			offset_table += sizeof( header );
+			memcpy( fileData + offset_table, programIndices.data(), sizeof( programIndices[0] ) * programIndices.size() );
+			offset_table += sizeof( programIndices[0] ) * programIndices.size();
+			memcpy( fileData + offset_table, programTable.data(), sizeof( programTable[0] ) * programTable.size() );
+			for ( size_t i = 0; i < programs.size(); ++i )
+			{
+				memcpy( fileData + programTable[i].offset, programs[i].compiledProgram.data(), programTable[i].size );
+			}
+		}
+		std::string errorMessage;
+		if ( !( result = Platform::WriteBinaryFile( m_path_target, file.data(), file.size(), &errorMessage ) ) )
+		{
+			OutputErrorMessageWithFileInfo( m_path_source, errorMessage.c_str() );
+			return result;
+		}
+	}
+	if ( !keywords.empty() )
+	{
+		GetOutputStream() << m_path_source << ": " << variantCount << " variants of " << keywords.size() << " keywords use "
+			<< programs.size() << ( ( programs.size() == 1 ) ? " program" : " programs" ) << std::endl;
+	}
+
+	return result;
+}
+
+std::string eae6320::Assets::cShaderBuilder::GetIntermediatePath( const Graphics::eShaderType i_shaderType,
+	const size_t i_programIndex, const size_t i_programCount, const char* const i_extension ) const
+{
+	const std::string path_target( m_path_target );
+	std::string directory;
+	{
+		if ( !Platform::GetEnvironmentVariable( "IntermediateDir", directory ) )
+		{
+			const auto pos_lastSlash = path_target.find_last_of( '/' );
+			if ( pos_lastSlash != path_target.npos )
+			{
+				directory = path_target.substr( 0, pos_lastSlash + 1 );
+			}
+		}
+		switch ( i_shaderType )
+		{
+		case Graphics::eShaderType::Vertex:
+			directory += "vertex/";
+			break;
+		case Graphics::eShaderType::Fragment:
+			directory += "fragment/";
+			break;
+		}
+	}
+	std::string fileName;
+	{
+		const auto pos_lastSlash = path_target.find_last_of( '/' );
+		fileName = ( pos_lastSlash != path_target.npos ) ? path_target.substr( pos_lastSlash + 1 ) : path_target;
+		if ( i_programCount > 1 )
+		{
+			fileName += "." + std::to_string( i_programIndex );
+		}
+		fileName += i_extension;
+	}
+	return directory + fileName;
+}
+
+// Helper Definitions
+//===================
+
+namespace
+{
+	eae6320::cResult RemoveKeywordDeclarations( const char* const i_path_source, std::string& io_source, std::vector<std::string>* const o_keywords )
+	{
+		unsigned int lineNumber = 1;
+		for ( size_t lineStart = 0; lineStart < io_source.size(); ++lineNumber )
+		{
+			auto lineEnd = io_source.find( '\n', lineStart );
+			if ( lineEnd == io_source.npos )
+			{
+				lineEnd = io_source.size();
+			}
+			// Find out if the line is a declaration ("#keywords" with optional whitespace around the '#')
+			auto position = lineStart;
+			const auto SkipWhitespace = [&io_source, &position, lineEnd]()
+			{
+				while ( ( position < lineEnd ) && ( ( io_source[position] == ' ' ) || ( io_source[position] == '\t' ) || ( io_source[position] == '\r' ) ) )
+				{
+					++position;
+				}
+			};
+			const auto IsNameCharacter = []( const char i_character )
+			{
+				return ( std::isalnum( static_cast<unsigned char>( i_character ) ) != 0 ) || ( i_character == '_' );
+			};
+			SkipWhitespace();
+			if ( ( position < lineEnd ) && ( io_source[position] == '#' ) )
+			{
+				++position;
+				SkipWhitespace();
+				constexpr char directive[] = "keywords";
+				constexpr auto directiveLength = sizeof( directive ) - 1;
+				if ( ( io_source.compare( position, directiveLength, directive ) == 0 )
+					&& ( ( ( position + directiveLength ) >= lineEnd ) || !IsNameCharacter( io_source[position + directiveLength] ) ) )
+				{
+					position += directiveLength;
+					if ( o_keywords )
+					{
+						for ( SkipWhitespace(); position < lineEnd; SkipWhitespace() )
+						{
+							const auto keywordStart = position;
+							while ( ( position < lineEnd ) && IsNameCharacter( io_source[position] ) )
+							{
+								++position;
+							}
+							const auto keyword = io_source.substr( keywordStart, position - keywordStart );
+							if ( keyword.empty() || ( std::isdigit( static_cast<unsigned char>( keyword[0] ) ) != 0 ) )
+							{
+								eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_source, lineNumber,
+									"Keywords must be identifiers separated by whitespace" );
+								return eae6320::Results::Failure;
+							}
+							if ( std::find( o_keywords->begin(), o_keywords->end(), keyword ) != o_keywords->end() )
+							{
+								eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_source, lineNumber,
+									"The keyword %s has already been declared", keyword.c_str() );
+								return eae6320::Results::Failure;
+							}
+							if ( o_keywords->size() >= eae6320::Graphics::ShaderFormats::maxKeywordCount )
+							{
+								eae6320::Assets::OutputErrorMessageWithFileInfo( i_path_source, lineNumber,
+									"A shader can't declare more than %u keywords", static_cast<unsigned int>( eae6320::Graphics::ShaderFormats::maxKeywordCount ) );
+								return eae6320::Results::Failure;
+							}
+							o_keywords->push_back( keyword );
+						}
+					}
+					// Remove the declaration but keep the line
+					{
+						const auto hasCarriageReturn = ( lineEnd > lineStart ) && ( io_source[lineEnd - 1] == '\r' );
+						const auto removedLength = ( lineEnd - lineStart ) - ( hasCarriageReturn ? 1 : 0 );
+						io_source.erase( lineStart, removedLength );
+						lineEnd -= removedLength;
+					}
+				}
+			}
+			lineStart = lineEnd + 1;
+		}
+		return eae6320::Results::Success;
+	}
+
+	eae6320::cResult PreProcessShaderSource( const char* const i_path_source, const std::vector<std::string>& i_definedKeywords,
+		std::string& o_shaderSource_preProcessed )
+	{
+		auto result = eae6320::Results::Success;
+
+		// Get the content directories to use as #include search paths
+		std::string includeSearchPathArgument_engineSourceContentDir, includeSearchPathArgument_gameSourceContentDir;
+		{
+			const std::string prefix = "-I";
+			std::string errorMessage;
+
+			// EngineSourceContentDir
+			{
+				if ( result = eae6320::Platform::GetEnvironmentVariable(
+					"EngineSourceContentDir", includeSearchPathArgument_engineSourceContentDir, &errorMessage ) )
+				{
+					includeSearchPathArgument_engineSourceContentDir = prefix + includeSearchPathArgument_engineSourceContentDir;
+				}
+				else
+				{
+					eae6320::Assets::OutputErrorMessage( "Failed to get the engine's source content directory: %s", errorMessage.c_str() );
+					return result;
+				}
+			}
+			// GameSourceContentDir
+			{
+				if ( result = eae6320::Platform::GetEnvironmentVariable(
+					"GameSourceContentDir", includeSearchPathArgument_gameSourceContentDir, &errorMessage ) )
+				{
+					includeSearchPathArgument_gameSourceContentDir = prefix + includeSearchPathArgument_gameSourceContentDir;
+				}
+				else
+				{
+					eae6320::Assets::OutputErrorMessage( "Failed to get the game's source content directory: %s", errorMessage.c_str() );
+					return result;
+				}
+			}
+		}
+
+		std::vector<std::string> arguments_strings =
+		{
+			// The command (necessary even though it is being run as a function)
+			"mcpp",
+			// The platform #define
+#if defined( EAE6320_PLATFORM_D3D )
+			"-DEAE6320_PLATFORM_D3D",
+#elif defined( EAE6320_PLATFORM_GL )
+			"-DEAE6320_PLATFORM_GL",
+#endif
+			// The #include search paths
+			// (list the game's content path before the engine's
+			// so that if there are identically-named files
+			// the game-specific one will be used)
+			includeSearchPathArgument_gameSourceContentDir,
+			includeSearchPathArgument_engineSourceContentDir,
+#ifdef EAE6320_GRAPHICS_AREDEBUGSHADERSENABLED
+			// Keep comments
+			"-C",
+#endif
+			// Don't output #line number information
+			"-P",
+			// Treat unknown directives (like #version and #extension) as warnings instead of errors
+			// (the keywords declaration is also an unknown directive, and it is removed from the output)
+			"-a",
+		};
+		// The variant's keywords
+		// (mcpp #defines them as 1)
+		for ( const auto& keyword : i_definedKeywords )
+		{
+			arguments_strings.push_back( "-D" + keyword );
+		}
+		// The input file to pre-process
+		arguments_strings.push_back( i_path_source );
+		// mcpp consumes non-const char*s,
+		// and so the arguments point to the strings' own (modifiable) characters
+		std::vector<char*> arguments;
+		arguments.reserve( arguments_strings.size() );
+		for ( auto& argument : arguments_strings )
+		{
+			arguments.push_back( &argument[0] );
+		}
+
+		std::lock_guard<std::mutex> lock( s_mutex_mcpp );
+		// Configure mcpp to output to buffers instead of files
+		// (this also releases the buffers from the previous time that mcpp was run.
+		// They aren't released with mcpp_use_mem_buffers( 0 ) afterwards
+		// because it doesn't forget them, and they would then be released twice
+		// when the next variant or shader is preprocessed)
+		mcpp_use_mem_buffers( 1 );
+		// Preprocess the file
+		{
+			const auto result_mcpp = mcpp_lib_main( static_cast<int>( arguments.size() ), arguments.data() );
+			if ( result_mcpp == EXIT_SUCCESS )
+			{
+				const auto* const shaderSource_preProcessed = mcpp_get_mem_buffer( static_cast<OUTDEST>( eae6320::mcpp::OUTDEST::Out ) );
+				o_shaderSource_preProcessed = shaderSource_preProcessed ? shaderSource_preProcessed : "";
+			}
+			else
+			{
+				result = eae6320::Results::Failure;
+				eae6320::Assets::GetErrorOutputStream() << mcpp_get_mem_buffer( static_cast<OUTDEST>( eae6320::mcpp::OUTDEST::Err ) );
+				return result;
+			}
+		}
+		// The keywords declaration isn't part of the program
+		if ( !( result = RemoveKeywordDeclarations( i_path_source, o_shaderSource_preProcessed, nullptr ) ) )
+		{
+			return result;
+		}
+
+#ifndef EAE6320_GRAPHICS_AREDEBUGSHADERSENABLED
+		// Remove extra new lines
+		try
+		{
+			std::regex pattern_match( R"(((\r\n)|(\n))+)" );
+			const std::string pattern_replace( "\n" );
+			o_shaderSource_preProcessed = std::regex_replace( o_shaderSource_preProcessed, pattern_match, pattern_replace );
+		}
+		catch ( std::regex_error& )
+		{
+
+		}
+#endif
+
+		return result;
+	}
+
+	uint64_t CalculateHash( const std::string& i_source )
+	{
+		constexpr uint64_t offsetBasis = 0xcbf29ce484222325;
+		constexpr uint64_t prime = 0x100000001b3;
+		auto hash = offsetBasis;
+		for ( const auto character : i_source )
+		{
+			hash ^= static_cast<uint8_t>( character );
+			hash *= prime;
+		}
+		return hash;
+	}
+}
@@ -1,5 +1,15 @@
 /*
 	This class builds shaders
+
+	A shader source file can declare keywords on a line of its own:
+		#keywords INSTANCED SKINNED
+	and the shader is then built once for every combination of them
+	with the keywords in the combination #defined as 1
+	(so that the source can use "#if INSTANCED").
+	Combinations that are the same after preprocessing are only compiled once,
+	the programs are compiled in parallel if the platform allows it,
+	and they are all written to a single file with a table of which program each variant uses
+	(see Engine/Graphics/ShaderFormats.h).
 */
 
 #ifndef EAE6320_CSHADERBUILDER_H
@@ -10,8 +20,12 @@
 
 #include <Tools/AssetBuildLibrary/iBuilder.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <Engine/Graphics/Configuration.h>
 #include <Engine/Graphics/cShader.h>
+#include <string>
+#include <vector>
 
 // Class Declaration
 //==================
@@ -37,10 +51,38 @@ namespace eae6320
 
 		private:
 
+			// A program is compiled for every variant that preprocesses to a different source
+			struct sProgram
+			{
+				std::vector<std::string> definedKeywords;
+				std::string source_preProcessed;
+				// The platform-specific data that the graphics API is given
+				std::string compiledProgram;
+				// The program can be compiled on another thread,
+				// and so anything that is output while compiling it is kept here and output afterwards
+				std::string output;
+				cResult result = Results::Success;
+			};
+
 			// Build
 			//------
 
 			cResult Build( const Graphics::eShaderType i_shaderType, const std::vector<std::string>& i_arguments );
+
+			// Files that are only written to help with debugging (e.g. disassembly) are written to the intermediate directory
+			// (the program index is only added to the name if there is more than one program)
+			std::string GetIntermediatePath( const Graphics::eShaderType i_shaderType,
+				const size_t i_programIndex, const size_t i_programCount, const char* const i_extension ) const;
+
+			// Platform-Specific Build
+			//------------------------
+
+			// If programs can be compiled concurrently then this is called from several threads at once
+			// (with a different program for each)
+			static const bool s_canProgramsBeCompiledConcurrently;
+			// The source is the shader source file with the keywords declaration removed
+			cResult CompileProgram( const Graphics::eShaderType i_shaderType, const std::string& i_source,
+				const size_t i_programIndex, const size_t i_programCount, sProgram& io_program ) const;
 		};
 	}
 }